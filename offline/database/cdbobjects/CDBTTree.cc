@@ -12,16 +12,130 @@
 #include <TSystem.h>
 #include <TTree.h>
 
+#include <algorithm>
 #include <climits>
 #include <cmath>    // for NAN, isfinite
 #include <cstdint>  // for uint64_t
 #include <iostream>
 #include <limits>   // for numeric_limits, numeric_limits<>::max_digits10
 #include <set>      // for set
+#include <type_traits>
 #include <utility>  // for pair, make_pair
 
 int CDBTTree::verbosity = 0;  // the verbosity can be set by the static SetVerbosity(int v) method
 
+namespace
+{
+  // value used for missing per channel entries
+  template <class T>
+  T missing_value()
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+    else if constexpr (std::is_signed_v<T>)
+    {
+      return std::numeric_limits<T>::min();
+    }
+    else
+    {
+      return std::numeric_limits<T>::max();
+    }
+  }
+
+  template <class T>
+  bool is_missing(T value)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+    {
+      return std::isnan(value);
+    }
+    else
+    {
+      return value == missing_value<T>();
+    }
+  }
+
+  // create one column per branch buffer (except skip), and return the (column, buffer) pairs
+  template <class T, class Store>
+  std::vector<std::pair<std::vector<T> *, const T *>> add_columns(const std::map<std::string, T> &valmap, Store &store, const std::string &skip, std::size_t nentries)
+  {
+    for (const auto &field : valmap)
+    {
+      if (field.first != skip)
+      {
+        store.values.at(store.add(field.first, 0)).reserve(nentries);
+      }
+    }
+    std::vector<std::pair<std::vector<T> *, const T *>> columns;
+    for (std::size_t i = 0; i < store.names.size(); ++i)
+    {
+      columns.emplace_back(&store.values[i], &valmap.find(store.names[i])->second);
+    }
+    return columns;
+  }
+
+  // fill columns from per channel entries
+  template <class T, class Store, class RowFinder>
+  void fill_columns(const std::map<int, std::map<std::string, T>> &entries, Store &store, std::size_t nrows, RowFinder row)
+  {
+    for (const auto &channel : entries)
+    {
+      const int irow = row(channel.first);
+      for (const auto &field : channel.second)
+      {
+        int icolumn = store.find(field.first);
+        if (icolumn < 0)
+        {
+          icolumn = store.add(field.first, nrows);
+        }
+        store.values[icolumn][irow] = field.second;
+      }
+    }
+  }
+
+  // fill per channel entries from columns. Missing values are skipped
+  template <class T, class Store>
+  void fill_entries(const Store &store, const std::vector<int> &rowchannel, std::map<int, std::map<std::string, T>> &entries)
+  {
+    for (std::size_t icolumn = 0; icolumn < store.names.size(); ++icolumn)
+    {
+      const std::vector<T> &column = store.values[icolumn];
+      for (std::size_t irow = 0; irow < column.size(); ++irow)
+      {
+        if (!is_missing(column[irow]))
+        {
+          entries[rowchannel[irow]].emplace(store.names[icolumn], column[irow]);
+        }
+      }
+    }
+  }
+}  // namespace
+
+//_____________________________________________________________________________
+template <class T>
+int CDBTTree::ColumnStore<T>::find(const std::string &fieldname) const
+{
+  for (std::size_t i = 0; i < names.size(); ++i)
+  {
+    if (names[i] == fieldname)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+//_____________________________________________________________________________
+template <class T>
+int CDBTTree::ColumnStore<T>::add(const std::string &fieldname, std::size_t nrows)
+{
+  names.push_back(fieldname);
+  values.emplace_back(nrows, missing_value<T>());
+  return names.size() - 1;
+}
+
 CDBTTree::CDBTTree(const std::string &fname)
   : m_Filename(fname)
 {
@@ -47,6 +161,8 @@ void CDBTTree::SetFloatValue(int channel, const std::string &name, float value)
     std::cout << "That does not work, restructure your code" << std::endl;
     gSystem->Exit(1);
   }
+  BuildEntryMaps();
+  m_ColumnsValid = false;
   m_FloatEntryMap[channel].insert(std::make_pair(fieldname, value));
 }
 
@@ -64,6 +180,8 @@ void CDBTTree::SetDoubleValue(int channel, const std::string &name, double value
     std::cout << "That does not work, restructure your code" << std::endl;
     gSystem->Exit(1);
   }
+  BuildEntryMaps();
+  m_ColumnsValid = false;
   m_DoubleEntryMap[channel].insert(std::make_pair(fieldname, value));
 }
 
@@ -81,6 +199,8 @@ void CDBTTree::SetIntValue(int channel, const std::string &name, int value)
     std::cout << "That does not work, restructure your code" << std::endl;
     gSystem->Exit(1);
   }
+  BuildEntryMaps();
+  m_ColumnsValid = false;
   m_IntEntryMap[channel].insert(std::make_pair(fieldname, value));
 }
 
@@ -98,6 +218,8 @@ void CDBTTree::SetUInt64Value(int channel, const std::string &name, uint64_t val
     std::cout << "That does not work, restructure your code" << std::endl;
     gSystem->Exit(1);
   }
+  BuildEntryMaps();
+  m_ColumnsValid = false;
   m_UInt64EntryMap[channel].insert(std::make_pair(fieldname, value));
 }
 
@@ -108,6 +230,7 @@ void CDBTTree::Commit()
 
 void CDBTTree::WriteMultipleCDBTTree()
 {
+  BuildEntryMaps();
   m_TTree[MultipleEntries] = new TTree(m_TTreeName[MultipleEntries].c_str(), m_TTreeName[MultipleEntries].c_str());
   std::set<int> id_set;
   std::map<std::string, float> floatmap;
@@ -339,6 +462,7 @@ void CDBTTree::WriteSingleCDBTTree()
 
 void CDBTTree::Print()
 {
+  BuildEntryMaps();
   if (!m_FloatEntryMap.empty())
   {
     std::cout << "Number of float entries: " << m_FloatEntryMap.size() << std::endl;
@@ -449,6 +573,7 @@ void CDBTTree::Print()
 
 void CDBTTree::WriteCDBTTree()
 {
+  BuildEntryMaps();
   bool empty_single = m_SingleFloatEntryMap.empty() && m_SingleDoubleEntryMap.empty() &&
                       m_SingleIntEntryMap.empty() && m_SingleUInt64EntryMap.empty();
   if (!empty_single && !m_Locked[SingleEntries])
@@ -545,6 +670,16 @@ void CDBTTree::LoadCalibrations()
     }
     m_TTree[SingleEntries]->GetEntry(0);
   }
+  // per channel values are read directly into columns, replacing any previous content
+  m_FloatEntryMap.clear();
+  m_DoubleEntryMap.clear();
+  m_IntEntryMap.clear();
+  m_UInt64EntryMap.clear();
+  m_FloatColumns.clear();
+  m_DoubleColumns.clear();
+  m_IntColumns.clear();
+  m_UInt64Columns.clear();
+  m_RowChannel.clear();
   if (m_TTree[MultipleEntries] != nullptr)
   {
     TObjArray *branches = m_TTree[MultipleEntries]->GetListOfBranches();
@@ -578,7 +713,17 @@ void CDBTTree::LoadCalibrations()
         m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &(itermap.first)->second);
       }
     }
-    for (auto entry = 0; entry < m_TTree[MultipleEntries]->GetEntries(); ++entry)
+
+    // one column per branch, the channel ID is kept separately
+    const int *idval = &intvalmap.find("IID")->second;
+    const auto nentries = m_TTree[MultipleEntries]->GetEntries();
+    auto floatcolumns = add_columns(floatvalmap, m_FloatColumns, "", nentries);
+    auto doublecolumns = add_columns(doublevalmap, m_DoubleColumns, "", nentries);
+    auto intcolumns = add_columns(intvalmap, m_IntColumns, "IID", nentries);
+    auto uint64columns = add_columns(uint64valmap, m_UInt64Columns, "", nentries);
+    m_RowChannel.reserve(nentries);
+
+    for (auto entry = 0; entry < nentries; ++entry)
     {
       for (auto &field : floatvalmap)
       {
@@ -597,60 +742,30 @@ void CDBTTree::LoadCalibrations()
         field.second = std::numeric_limits<uint64_t>::max();
       }
       m_TTree[MultipleEntries]->GetEntry(entry);
-      int ID = intvalmap.find("IID")->second;
-      std::map<std::string, float> tmp_floatvalmap;
-      for (auto &field : floatvalmap)
+      m_RowChannel.push_back(*idval);
+      for (auto &column : floatcolumns)
       {
-        if (!std::isnan(field.second))
-        {
-          tmp_floatvalmap.insert(std::make_pair(field.first, field.second));
-        }
+        column.first->push_back(*column.second);
       }
-      if (!tmp_floatvalmap.empty())
+      for (auto &column : doublecolumns)
       {
-        m_FloatEntryMap.insert(std::make_pair(ID, tmp_floatvalmap));
+        column.first->push_back(*column.second);
       }
-
-      std::map<std::string, double> tmp_doublevalmap;
-      for (auto &field : doublevalmap)
+      for (auto &column : intcolumns)
       {
-        if (!std::isnan(field.second))
-        {
-          tmp_doublevalmap.insert(std::make_pair(field.first, field.second));
-        }
-      }
-      if (!tmp_doublevalmap.empty())
-      {
-        m_DoubleEntryMap.insert(std::make_pair(ID, tmp_doublevalmap));
-      }
-
-      std::map<std::string, int> tmp_intvalmap;
-      for (auto &field : intvalmap)
-      {
-        if (field.second != std::numeric_limits<int>::min() && field.first != "IID")
-        {
-          tmp_intvalmap.insert(std::make_pair(field.first, field.second));
-        }
+        column.first->push_back(*column.second);
       }
-      if (!tmp_intvalmap.empty())
+      for (auto &column : uint64columns)
       {
-        m_IntEntryMap.insert(std::make_pair(ID, tmp_intvalmap));
-      }
-
-      std::map<std::string, uint64_t> tmp_uint64valmap;
-      for (auto &field : uint64valmap)
-      {
-        if (field.second != std::numeric_limits<uint64_t>::max())
-        {
-          tmp_uint64valmap.insert(std::make_pair(field.first, field.second));
-        }
-      }
-      if (!tmp_uint64valmap.empty())
-      {
-        m_UInt64EntryMap.insert(std::make_pair(ID, tmp_uint64valmap));
+        column.first->push_back(*column.second);
       }
     }
   }
+  BuildRowIndex();
+  m_ColumnsValid = true;
+  m_EntryMapsValid = false;
+  m_Loaded = true;
+
   for (auto *ttree : m_TTree)
   {
     delete ttree;
@@ -662,7 +777,7 @@ void CDBTTree::LoadCalibrations()
 
 float CDBTTree::GetSingleFloatValue(const std::string &name, int verbose)
 {
-  if (m_SingleFloatEntryMap.empty())
+  if (m_SingleFloatEntryMap.empty() && !m_Loaded)
   {
     LoadCalibrations();
   }
@@ -689,23 +804,8 @@ float CDBTTree::GetSingleFloatValue(const std::string &name, int verbose)
 
 float CDBTTree::GetFloatValue(int channel, const std::string &name, int verbose)
 {
-  if (m_FloatEntryMap.empty())
-  {
-    LoadCalibrations();
-  }
-  auto channelmapiter = m_FloatEntryMap.find(channel);
-  if (channelmapiter == m_FloatEntryMap.end())
-  {
-    if (verbosity > 0 || verbose > 0)
-    {
-      std::cout << PHWHERE << " Could not find channel " << channel
-                << " for " << name << " in float calibrations" << std::endl;
-    }
-    return std::numeric_limits<float>::quiet_NaN();
-  }
-  std::string fieldname = "F" + name;
-  auto calibiter = channelmapiter->second.find(fieldname);
-  if (calibiter == channelmapiter->second.end())
+  Column<float> column = GetFloatColumn(name);
+  if (!column.valid())
   {
     if (verbosity > 0 || verbose > 0)
     {
@@ -713,12 +813,24 @@ float CDBTTree::GetFloatValue(int channel, const std::string &name, int verbose)
     }
     return std::numeric_limits<float>::quiet_NaN();
   }
-  return calibiter->second;
+  return GetFloatValue(channel, column, verbose);
+}
+
+CDBTTree::Column<float> CDBTTree::GetFloatColumn(const std::string &name)
+{
+  PrepareColumns();
+  return Column<float>(m_FloatColumns.find("F" + name));
+}
+
+float CDBTTree::GetFloatValue(int channel, Column<float> column, int verbose)
+{
+  PrepareColumns();
+  return GetColumnValue(m_FloatColumns, channel, column.m_Index, "float", verbose);
 }
 
 double CDBTTree::GetSingleDoubleValue(const std::string &name, int verbose)
 {
-  if (m_SingleDoubleEntryMap.empty())
+  if (m_SingleDoubleEntryMap.empty() && !m_Loaded)
   {
     LoadCalibrations();
   }
@@ -745,23 +857,8 @@ double CDBTTree::GetSingleDoubleValue(const std::string &name, int verbose)
 
 double CDBTTree::GetDoubleValue(int channel, const std::string &name, int verbose)
 {
-  if (m_DoubleEntryMap.empty())
-  {
-    LoadCalibrations();
-  }
-  auto channelmapiter = m_DoubleEntryMap.find(channel);
-  if (channelmapiter == m_DoubleEntryMap.end())
-  {
-    if (verbosity > 0 || verbose > 0)
-    {
-      std::cout << PHWHERE << " Could not find channel " << channel
-                << " for " << name << " in double calibrations" << std::endl;
-    }
-    return std::numeric_limits<double>::quiet_NaN();
-  }
-  std::string fieldname = "D" + name;
-  auto calibiter = channelmapiter->second.find(fieldname);
-  if (calibiter == channelmapiter->second.end())
+  Column<double> column = GetDoubleColumn(name);
+  if (!column.valid())
   {
     if (verbosity > 0 || verbose > 0)
     {
@@ -769,12 +866,24 @@ double CDBTTree::GetDoubleValue(int channel, const std::string &name, int verbos
     }
     return std::numeric_limits<double>::quiet_NaN();
   }
-  return calibiter->second;
+  return GetDoubleValue(channel, column, verbose);
+}
+
+CDBTTree::Column<double> CDBTTree::GetDoubleColumn(const std::string &name)
+{
+  PrepareColumns();
+  return Column<double>(m_DoubleColumns.find("D" + name));
+}
+
+double CDBTTree::GetDoubleValue(int channel, Column<double> column, int verbose)
+{
+  PrepareColumns();
+  return GetColumnValue(m_DoubleColumns, channel, column.m_Index, "double", verbose);
 }
 
 int CDBTTree::GetSingleIntValue(const std::string &name, int verbose)
 {
-  if (m_SingleIntEntryMap.empty())
+  if (m_SingleIntEntryMap.empty() && !m_Loaded)
   {
     LoadCalibrations();
   }
@@ -801,23 +910,8 @@ int CDBTTree::GetSingleIntValue(const std::string &name, int verbose)
 
 int CDBTTree::GetIntValue(int channel, const std::string &name, int verbose)
 {
-  if (m_IntEntryMap.empty())
-  {
-    LoadCalibrations();
-  }
-  auto channelmapiter = m_IntEntryMap.find(channel);
-  if (channelmapiter == m_IntEntryMap.end())
-  {
-    if (verbosity > 0 || verbose > 0)
-    {
-      std::cout << PHWHERE << " Could not find channel " << channel
-                << " for " << name << " in int calibrations" << std::endl;
-    }
-    return std::numeric_limits<int>::min();
-  }
-  std::string fieldname = "I" + name;
-  auto calibiter = channelmapiter->second.find(fieldname);
-  if (calibiter == channelmapiter->second.end())
+  Column<int> column = GetIntColumn(name);
+  if (!column.valid())
   {
     if (verbosity > 0 || verbose > 0)
     {
@@ -825,12 +919,24 @@ int CDBTTree::GetIntValue(int channel, const std::string &name, int verbose)
     }
     return std::numeric_limits<int>::min();
   }
-  return calibiter->second;
+  return GetIntValue(channel, column, verbose);
+}
+
+CDBTTree::Column<int> CDBTTree::GetIntColumn(const std::string &name)
+{
+  PrepareColumns();
+  return Column<int>(m_IntColumns.find("I" + name));
+}
+
+int CDBTTree::GetIntValue(int channel, Column<int> column, int verbose)
+{
+  PrepareColumns();
+  return GetColumnValue(m_IntColumns, channel, column.m_Index, "int", verbose);
 }
 
 uint64_t CDBTTree::GetSingleUInt64Value(const std::string &name, int verbose)
 {
-  if (m_SingleUInt64EntryMap.empty())
+  if (m_SingleUInt64EntryMap.empty() && !m_Loaded)
   {
     LoadCalibrations();
   }
@@ -857,29 +963,157 @@ uint64_t CDBTTree::GetSingleUInt64Value(const std::string &name, int verbose)
 
 uint64_t CDBTTree::GetUInt64Value(int channel, const std::string &name, int verbose)
 {
-  if (m_UInt64EntryMap.empty())
+  Column<uint64_t> column = GetUInt64Column(name);
+  if (!column.valid())
   {
-    LoadCalibrations();
+    if (verbosity > 0 || verbose > 0)
+    {
+      std::cout << "Could not find " << name << " among uint64 calibrations for channel " << channel << std::endl;
+    }
+    return std::numeric_limits<uint64_t>::max();
   }
-  auto channelmapiter = m_UInt64EntryMap.find(channel);
-  if (channelmapiter == m_UInt64EntryMap.end())
+  return GetUInt64Value(channel, column, verbose);
+}
+
+CDBTTree::Column<uint64_t> CDBTTree::GetUInt64Column(const std::string &name)
+{
+  PrepareColumns();
+  return Column<uint64_t>(m_UInt64Columns.find("g" + name));
+}
+
+uint64_t CDBTTree::GetUInt64Value(int channel, Column<uint64_t> column, int verbose)
+{
+  PrepareColumns();
+  return GetColumnValue(m_UInt64Columns, channel, column.m_Index, "uint64", verbose);
+}
+
+//_____________________________________________________________________________
+template <class T>
+T CDBTTree::GetColumnValue(const ColumnStore<T> &store, int channel, int column, const std::string &type, int verbose) const
+{
+  if (column < 0 || column >= static_cast<int>(store.values.size()))
   {
     if (verbosity > 0 || verbose > 0)
     {
-      std::cout << "Could not find channel " << channel << " in unint64 calibrations" << std::endl;
+      std::cout << PHWHERE << " invalid column for channel " << channel << " in " << type << " calibrations" << std::endl;
     }
-    return std::numeric_limits<uint64_t>::max();
+    return missing_value<T>();
   }
-  std::string fieldname = "g" + name;
-  auto calibiter = channelmapiter->second.find(fieldname);
-  if (calibiter == channelmapiter->second.end())
+  const int row = Row(channel);
+  if (row < 0)
   {
     if (verbosity > 0 || verbose > 0)
     {
       std::cout << PHWHERE << " Could not find channel " << channel
-                << " for " << name << " in uint64_t calibrations" << std::endl;
+                << " for " << store.names[column].substr(1) << " in " << type << " calibrations" << std::endl;
     }
-    return std::numeric_limits<uint64_t>::max();
+    return missing_value<T>();
+  }
+  return store.values[column][row];
+}
+
+//_____________________________________________________________________________
+void CDBTTree::PrepareColumns()
+{
+  if (m_ColumnsValid)
+  {
+    return;
+  }
+  const bool empty_multiple = m_FloatEntryMap.empty() && m_DoubleEntryMap.empty() &&
+                              m_IntEntryMap.empty() && m_UInt64EntryMap.empty();
+  if (empty_multiple && !m_Loaded)
+  {
+    LoadCalibrations();
+    return;
+  }
+  BuildColumns();
+}
+
+//_____________________________________________________________________________
+void CDBTTree::BuildColumns()
+{
+  std::set<int> channels;
+  for (const auto &entry : m_FloatEntryMap)
+  {
+    channels.insert(entry.first);
+  }
+  for (const auto &entry : m_DoubleEntryMap)
+  {
+    channels.insert(entry.first);
+  }
+  for (const auto &entry : m_IntEntryMap)
+  {
+    channels.insert(entry.first);
+  }
+  for (const auto &entry : m_UInt64EntryMap)
+  {
+    channels.insert(entry.first);
+  }
+  m_RowChannel.assign(channels.begin(), channels.end());
+  BuildRowIndex();
+
+  auto row = [this](int channel)
+  { return Row(channel); };
+  m_FloatColumns.clear();
+  m_DoubleColumns.clear();
+  m_IntColumns.clear();
+  m_UInt64Columns.clear();
+  fill_columns(m_FloatEntryMap, m_FloatColumns, m_RowChannel.size(), row);
+  fill_columns(m_DoubleEntryMap, m_DoubleColumns, m_RowChannel.size(), row);
+  fill_columns(m_IntEntryMap, m_IntColumns, m_RowChannel.size(), row);
+  fill_columns(m_UInt64EntryMap, m_UInt64Columns, m_RowChannel.size(), row);
+  m_ColumnsValid = true;
+}
+
+//_____________________________________________________________________________
+void CDBTTree::BuildEntryMaps() const
+{
+  if (m_EntryMapsValid)
+  {
+    return;
+  }
+  m_FloatEntryMap.clear();
+  m_DoubleEntryMap.clear();
+  m_IntEntryMap.clear();
+  m_UInt64EntryMap.clear();
+  fill_entries(m_FloatColumns, m_RowChannel, m_FloatEntryMap);
+  fill_entries(m_DoubleColumns, m_RowChannel, m_DoubleEntryMap);
+  fill_entries(m_IntColumns, m_RowChannel, m_IntEntryMap);
+  fill_entries(m_UInt64Columns, m_RowChannel, m_UInt64EntryMap);
+  m_EntryMapsValid = true;
+}
+
+//_____________________________________________________________________________
+void CDBTTree::BuildRowIndex()
+{
+  m_DenseRow.clear();
+  m_SparseRow.clear();
+  if (m_RowChannel.empty())
+  {
+    return;
+  }
+
+  // the first row wins for duplicated channels, as for the entry maps
+  const auto [minchannel, maxchannel] = std::minmax_element(m_RowChannel.begin(), m_RowChannel.end());
+  const int64_t range = static_cast<int64_t>(*maxchannel) - *minchannel + 1;
+  if (range <= 4 * static_cast<int64_t>(m_RowChannel.size()) + 1024)
+  {
+    m_MinChannel = *minchannel;
+    m_DenseRow.assign(range, -1);
+    for (std::size_t irow = 0; irow < m_RowChannel.size(); ++irow)
+    {
+      int &row = m_DenseRow[static_cast<int64_t>(m_RowChannel[irow]) - m_MinChannel];
+      if (row < 0)
+      {
+        row = irow;
+      }
+    }
+    return;
+  }
+
+  m_SparseRow.reserve(m_RowChannel.size());
+  for (std::size_t irow = 0; irow < m_RowChannel.size(); ++irow)
+  {
+    m_SparseRow.emplace(m_RowChannel[irow], irow);
   }
-  return calibiter->second;
 }
@@ -4,12 +4,36 @@
 #include <cstdint>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 class TTree;
 
 class CDBTTree
 {
  public:
+  //! handle to a per-channel calibration field, resolved once from its name
+  /*!
+  with Get<Type>Column(name), and then used in Get<Type>Value(channel, column),
+  which avoids the name lookup when looping over channels
+  */
+  template <class T>
+  class Column
+  {
+   public:
+    Column() = default;
+    //! false if the field does not exist
+    bool valid() const { return m_Index >= 0; }
+
+   private:
+    friend class CDBTTree;
+    explicit Column(int index)
+      : m_Index(index)
+    {
+    }
+    int m_Index{-1};
+  };
+
   CDBTTree() = default;
   explicit CDBTTree(const std::string &fname);
   ~CDBTTree();
@@ -33,24 +57,50 @@ class CDBTTree
 
   float GetSingleFloatValue(const std::string &name, int verbose = 0);
   float GetFloatValue(int channel, const std::string &name, int verbose = 0);
-  size_t GetFloatMapSize() const { return m_FloatEntryMap.size(); }
+  Column<float> GetFloatColumn(const std::string &name);
+  float GetFloatValue(int channel, Column<float> column, int verbose = 0);
+  size_t GetFloatMapSize() const { return GetFloatEntryMap().size(); }
 
   double GetSingleDoubleValue(const std::string &name, int verbose = 0);
   double GetDoubleValue(int channel, const std::string &name, int verbose = 0);
-  size_t GetDoubleMapSize() const { return m_DoubleEntryMap.size(); }
+  Column<double> GetDoubleColumn(const std::string &name);
+  double GetDoubleValue(int channel, Column<double> column, int verbose = 0);
+  size_t GetDoubleMapSize() const { return GetDoubleEntryMap().size(); }
 
   int GetSingleIntValue(const std::string &name, int verbose = 0);
   int GetIntValue(int channel, const std::string &name, int verbose = 0);
-  size_t GetIntMapSize() const { return m_IntEntryMap.size(); }
+  Column<int> GetIntColumn(const std::string &name);
+  int GetIntValue(int channel, Column<int> column, int verbose = 0);
+  size_t GetIntMapSize() const { return GetIntEntryMap().size(); }
 
   uint64_t GetSingleUInt64Value(const std::string &name, int verbose = 0);
   uint64_t GetUInt64Value(int channel, const std::string &name, int verbose = 0);
-  size_t GetUInt64MapSize() const { return m_UInt64EntryMap.size(); }
+  Column<uint64_t> GetUInt64Column(const std::string &name);
+  uint64_t GetUInt64Value(int channel, Column<uint64_t> column, int verbose = 0);
+  size_t GetUInt64MapSize() const { return GetUInt64EntryMap().size(); }
 
-  const auto &GetFloatEntryMap() const { return m_FloatEntryMap; }
-  const auto &GetDoubleEntryMap() const { return m_DoubleEntryMap; }
-  const auto &GetIntEntryMap() const { return m_IntEntryMap; }
-  const auto &GetUInt64EntryMap() const { return m_UInt64EntryMap; }
+  //! per channel values, keyed by channel and by type prefixed field name
+  /*! these are built on first use for calibrations read from file, which are stored by column */
+  const std::map<int, std::map<std::string, float>> &GetFloatEntryMap() const
+  {
+    BuildEntryMaps();
+    return m_FloatEntryMap;
+  }
+  const std::map<int, std::map<std::string, double>> &GetDoubleEntryMap() const
+  {
+    BuildEntryMaps();
+    return m_DoubleEntryMap;
+  }
+  const std::map<int, std::map<std::string, int>> &GetIntEntryMap() const
+  {
+    BuildEntryMaps();
+    return m_IntEntryMap;
+  }
+  const std::map<int, std::map<std::string, uint64_t>> &GetUInt64EntryMap() const
+  {
+    BuildEntryMaps();
+    return m_UInt64EntryMap;
+  }
 
   const auto &GetSingleFloatEntryMap() const { return m_SingleFloatEntryMap; }
   const auto &GetSingleDoubleEntryMap() const { return m_SingleDoubleEntryMap; }
@@ -58,6 +108,51 @@ class CDBTTree
   const auto &GetSingleUInt64EntryMap() const { return m_SingleUInt64EntryMap; }
 
  private:
+  //! per channel values of one type, stored by column
+  template <class T>
+  struct ColumnStore
+  {
+    //! type prefixed field names
+    std::vector<std::string> names;
+    //! values, one vector per field, indexed by row. Missing values are set to the type default
+    std::vector<std::vector<T>> values;
+
+    void clear()
+    {
+      names.clear();
+      values.clear();
+    }
+    int find(const std::string &fieldname) const;
+    int add(const std::string &fieldname, std::size_t nrows);
+  };
+
+  //! make sure the columns reflect the current content, loading from file if empty
+  void PrepareColumns();
+
+  //! fill columns from the entry maps
+  void BuildColumns();
+
+  //! fill entry maps from the columns
+  void BuildEntryMaps() const;
+
+  //! build channel to row index from m_RowChannel
+  void BuildRowIndex();
+
+  //! row of a given channel, -1 if not found
+  int Row(int channel) const
+  {
+    if (!m_DenseRow.empty())
+    {
+      const int64_t offset = static_cast<int64_t>(channel) - m_MinChannel;
+      return (offset >= 0 && offset < static_cast<int64_t>(m_DenseRow.size())) ? m_DenseRow[offset] : -1;
+    }
+    auto iter = m_SparseRow.find(channel);
+    return iter == m_SparseRow.end() ? -1 : iter->second;
+  }
+
+  template <class T>
+  T GetColumnValue(const ColumnStore<T> &store, int channel, int column, const std::string &type, int verbose) const;
+
   enum
   {
     SingleEntries = 0,
@@ -69,14 +164,37 @@ class CDBTTree
   bool m_Locked[2] = {false};
 
   std::string m_Filename;
-  std::map<int, std::map<std::string, float>> m_FloatEntryMap;
+
+  //! per channel entries, filled by Set<Type>Value or built from the columns on demand
+  mutable std::map<int, std::map<std::string, float>> m_FloatEntryMap;
+  mutable std::map<int, std::map<std::string, double>> m_DoubleEntryMap;
+  mutable std::map<int, std::map<std::string, int>> m_IntEntryMap;
+  mutable std::map<int, std::map<std::string, uint64_t>> m_UInt64EntryMap;
+
   std::map<std::string, float> m_SingleFloatEntryMap;
-  std::map<int, std::map<std::string, double>> m_DoubleEntryMap;
   std::map<std::string, double> m_SingleDoubleEntryMap;
-  std::map<int, std::map<std::string, int>> m_IntEntryMap;
   std::map<std::string, int> m_SingleIntEntryMap;
-  std::map<int, std::map<std::string, uint64_t>> m_UInt64EntryMap;
   std::map<std::string, uint64_t> m_SingleUInt64EntryMap;
+
+  //! per channel entries, by column. Used for all per channel lookups
+  ColumnStore<float> m_FloatColumns;
+  ColumnStore<double> m_DoubleColumns;
+  ColumnStore<int> m_IntColumns;
+  ColumnStore<uint64_t> m_UInt64Columns;
+
+  //! channel of each row, and the reverse index.
+  /*! the index is a dense array over [m_MinChannel, max channel] unless channels are too sparse */
+  std::vector<int> m_RowChannel;
+  int m_MinChannel{0};
+  std::vector<int> m_DenseRow;
+  std::unordered_map<int, int> m_SparseRow;
+
+  //! true when columns (resp. entry maps) are in sync with the content
+  bool m_ColumnsValid{false};
+  mutable bool m_EntryMapsValid{true};
+
+  //! true once LoadCalibrations was called
+  bool m_Loaded{false};
 };
 
 #endif
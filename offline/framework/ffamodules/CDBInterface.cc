@@ -1,4 +1,5 @@
 #include "CDBInterface.h"
+#include "CDBPayloadCache.h"
 
 #include <sphenixnpc/SphenixClient.h>
 
@@ -55,6 +56,16 @@ CDBInterface::~CDBInterface()
   delete cdbclient;
 }
 
+//____________________________________________________________________________..
+int CDBInterface::InitRun(PHCompositeNode * /*topNode*/)
+{
+  if (!disable && !m_PrefetchDomains.empty())
+  {
+    Prefetch(m_PrefetchDomains);
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 //____________________________________________________________________________..
 int CDBInterface::End(PHCompositeNode *topNode)
 {
@@ -135,43 +146,26 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
   {
     if (m_Payload_Url_Cache.contains(domain_noconst))
     {
-      return m_Payload_Url_Cache[domain_noconst];
+      return LocalCopy(m_Payload_Url_Cache[domain_noconst]);
     }
     std::cout << "calibration " << domain << " not found in local cache" << std::endl;
     return "";
   }
-  recoConsts *rc = recoConsts::instance();
-  if (!rc->FlagExist("CDB_GLOBALTAG"))
-  {
-    std::cout << PHWHERE << "CDB_GLOBALTAG flag needs to be set via" << std::endl;
-    std::cout << "rc->set_StringFlag(\"CDB_GLOBALTAG\",<global tag>)" << std::endl;
-    gSystem->Exit(1);
-  }
-  if (!rc->FlagExist("TIMESTAMP"))
-  {
-    std::cout << PHWHERE << "TIMESTAMP flag needs to be set via" << std::endl;
-    std::cout << "rc->set_uint64Flag(\"TIMESTAMP\",<64 bit timestamp>)" << std::endl;
-    gSystem->Exit(1);
-  }
-  if (cdbclient == nullptr)
-  {
-    cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
-  }
-  uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
+  uint64_t timestamp = InitClient();
   if (Verbosity() > 0)
   {
-    std::cout << "Global Tag: " << rc->get_StringFlag("CDB_GLOBALTAG")
+    std::cout << "Global Tag: " << recoConsts::instance()->get_StringFlag("CDB_GLOBALTAG")
               << ", domain: " << domain_noconst
               << ", timestamp: " << timestamp;
   }
-  std::string return_url = cdbclient->getCalibration(domain_noconst, timestamp);
+  std::string return_url = Resolve(domain_noconst, timestamp);
   if (return_url.empty())
   {
     if (!disable_default)
     {
       std::string domain_copy = domain_noconst;
       domain_noconst = domain_noconst + "_default";
-      return_url = cdbclient->getCalibration(domain_noconst, timestamp);
+      return_url = Resolve(domain_noconst, timestamp);
       if (return_url.empty())
       {
         if (Verbosity() > 0)
@@ -207,29 +201,12 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
                 << ", time stamp: " << timestamp << std::endl;
     }
   }
-  return return_url;
+  return LocalCopy(return_url);
 }
 
 void CDBInterface::DumpCalibrations(const std::string &filename)
 {
-  recoConsts *rc = recoConsts::instance();
-  if (!rc->FlagExist("CDB_GLOBALTAG"))
-  {
-    std::cout << PHWHERE << "CDB_GLOBALTAG flag needs to be set via" << std::endl;
-    std::cout << "rc->set_StringFlag(\"CDB_GLOBALTAG\",<global tag>)" << std::endl;
-    gSystem->Exit(1);
-  }
-  if (!rc->FlagExist("TIMESTAMP"))
-  {
-    std::cout << PHWHERE << "TIMESTAMP flag needs to be set via" << std::endl;
-    std::cout << "rc->set_uint64Flag(\"TIMESTAMP\",<64 bit timestamp>)" << std::endl;
-    gSystem->Exit(1);
-  }
-  if (cdbclient == nullptr)
-  {
-    cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
-  }
-  uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
+  uint64_t timestamp = InitClient();
   cdbclient->DumpCalibrations(timestamp, filename);
   return;
 }
@@ -280,3 +257,127 @@ void CDBInterface::ReadCalibrationsFromFile(const std::string &filename)
   }
   return;
 }
+
+void CDBInterface::SetLocalCache(const std::string &directory, uint64_t max_size)
+{
+  m_LocalCache = std::make_unique<CDBPayloadCache>(directory, max_size);
+  m_LocalCache->Verbosity(Verbosity());
+}
+
+int CDBInterface::Prefetch(const std::set<std::string> &domains)
+{
+  if (disable)
+  {
+    return 0;
+  }
+  uint64_t timestamp = 0;
+  if (!m_Read_From_File_Flag)
+  {
+    timestamp = InitClient();
+    LoadUrlDict(timestamp);
+  }
+  int nfound = 0;
+  for (const auto &domain : domains)
+  {
+    std::string url;
+    if (m_Read_From_File_Flag)
+    {
+      auto iter = m_Payload_Url_Cache.find(domain);
+      if (iter != m_Payload_Url_Cache.end())
+      {
+        url = iter->second;
+      }
+    }
+    else
+    {
+      url = Resolve(domain, timestamp);
+      if (url.empty() && !disable_default)
+      {
+        url = Resolve(domain + "_default", timestamp);
+      }
+    }
+    if (url.empty())
+    {
+      if (Verbosity() > 0)
+      {
+        std::cout << "CDBInterface::Prefetch: no payload found for " << domain << std::endl;
+      }
+      continue;
+    }
+    ++nfound;
+    LocalCopy(url);
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "CDBInterface::Prefetch: resolved " << nfound << " of " << domains.size() << " domains" << std::endl;
+  }
+  return nfound;
+}
+
+uint64_t CDBInterface::InitClient()
+{
+  recoConsts *rc = recoConsts::instance();
+  if (!rc->FlagExist("CDB_GLOBALTAG"))
+  {
+    std::cout << PHWHERE << "CDB_GLOBALTAG flag needs to be set via" << std::endl;
+    std::cout << "rc->set_StringFlag(\"CDB_GLOBALTAG\",<global tag>)" << std::endl;
+    gSystem->Exit(1);
+  }
+  if (!rc->FlagExist("TIMESTAMP"))
+  {
+    std::cout << PHWHERE << "TIMESTAMP flag needs to be set via" << std::endl;
+    std::cout << "rc->set_uint64Flag(\"TIMESTAMP\",<64 bit timestamp>)" << std::endl;
+    gSystem->Exit(1);
+  }
+  if (cdbclient == nullptr)
+  {
+    cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
+  }
+  return rc->get_uint64Flag("TIMESTAMP");
+}
+
+void CDBInterface::LoadUrlDict(uint64_t timestamp)
+{
+  m_UrlDict.clear();
+  nlohmann::json resp = cdbclient->getUrlDict(timestamp);
+  if (resp["code"] != 0)
+  {
+    // fall back to one query per domain
+    std::cout << PHWHERE << " cannot prefetch payload urls: " << resp << std::endl;
+    m_UseUrlDict = false;
+    return;
+  }
+  for (const auto &piov : resp["msg"].items())
+  {
+    if (piov.value().is_string())
+    {
+      m_UrlDict[piov.key()] = piov.value().get<std::string>();
+    }
+  }
+  m_UrlDictTimestamp = timestamp;
+  m_UseUrlDict = true;
+}
+
+std::string CDBInterface::Resolve(const std::string &domain, uint64_t timestamp)
+{
+  if (m_UseUrlDict && timestamp != m_UrlDictTimestamp)
+  {
+    // new timestamp, one query gives all domains again
+    LoadUrlDict(timestamp);
+  }
+  if (!m_UseUrlDict)
+  {
+    return cdbclient->getCalibration(domain, timestamp);
+  }
+  auto iter = m_UrlDict.find(domain);
+  return (iter == m_UrlDict.end()) ? "" : iter->second;
+}
+
+std::string CDBInterface::LocalCopy(const std::string &url)
+{
+  if (!m_LocalCache)
+  {
+    return url;
+  }
+  return m_LocalCache->get(url);
+}
@@ -7,10 +7,12 @@
 
 #include <cstdint>  // for uint64_t
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <tuple>  // for tuple
 
+class CDBPayloadCache;
 class SphenixClient;
 
 class CDBInterface : public SubsysReco
@@ -20,6 +22,9 @@ class CDBInterface : public SubsysReco
 
   ~CDBInterface() override;
 
+  /// Prefetch the domains registered with AddPrefetchDomain
+  int InitRun(PHCompositeNode *topNode) override;
+
   /// Called at the end of all processing.
   int End(PHCompositeNode *topNode) override;
 
@@ -38,9 +43,32 @@ class CDBInterface : public SubsysReco
   void DumpCalibrations(const std::string &filename);
   void ReadCalibrationsFromFile(const std::string &filename);
 
+  /// copy payloads into a node local directory, removing least recently used ones above max_size (in bytes)
+  void SetLocalCache(const std::string &directory, uint64_t max_size = 10000000000ULL);
+
+  /// register a domain which will be needed, to be resolved at InitRun
+  void AddPrefetchDomain(const std::string &domain) { m_PrefetchDomains.insert(domain); }
+
+  /// resolve all domains with a single database query, copying their payloads
+  /// into the local cache if enabled. Subsequent getUrl calls for the same
+  /// timestamp use the result of this query. Returns the number of domains found
+  int Prefetch(const std::set<std::string> &domains);
+
  private:
   CDBInterface(const std::string &name = "CDBInterface");
 
+  /// check flags and create the db client if needed, returns the timestamp
+  uint64_t InitClient();
+
+  /// fetch urls of all domains for a timestamp with a single query
+  void LoadUrlDict(uint64_t timestamp);
+
+  /// payload url of a domain, from the prefetched urls if available
+  std::string Resolve(const std::string &domain, uint64_t timestamp);
+
+  /// local copy of a payload if the local cache is enabled
+  std::string LocalCopy(const std::string &url);
+
   static CDBInterface *__instance;
   SphenixClient *cdbclient{nullptr};
   bool disable{false};
@@ -48,6 +76,16 @@ class CDBInterface : public SubsysReco
   bool m_Read_From_File_Flag{false};
   std::map<std::string, std::string> m_Payload_Url_Cache;
   std::set<std::tuple<std::string, std::string, uint64_t>> m_UrlVector;
+
+  std::unique_ptr<CDBPayloadCache> m_LocalCache;
+
+  /// domains to prefetch at InitRun
+  std::set<std::string> m_PrefetchDomains;
+
+  /// urls of all domains valid for m_UrlDictTimestamp, filled by Prefetch
+  std::map<std::string, std::string> m_UrlDict;
+  uint64_t m_UrlDictTimestamp{0};
+  bool m_UseUrlDict{false};
 };
 
 #endif  // FFAMODULES_CDBINTERFACE_H
@@ -0,0 +1,170 @@
+#include "CDBPayloadCache.h"
+
+#include <phool/phool.h>
+
+#include <unistd.h>  // for getpid
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <system_error>
+#include <utility>  // for pair
+#include <vector>
+
+namespace
+{
+  // files used more recently than this are never evicted
+  constexpr std::chrono::seconds EVICTION_GRACE{60};
+
+  const std::string TMP_EXTENSION = ".tmp";
+
+  // 64 bit FNV-1a hash
+  uint64_t fnv1a(const std::string &s)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : s)
+    {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+}  // namespace
+
+CDBPayloadCache::CDBPayloadCache(const std::string &directory, uint64_t max_size)
+  : m_Directory(directory)
+  , m_MaxSize(max_size)
+{
+  std::error_code ec;
+  std::filesystem::create_directories(m_Directory, ec);
+  if (ec)
+  {
+    std::cout << PHWHERE << " cannot create payload cache directory " << m_Directory
+              << ": " << ec.message() << std::endl;
+  }
+}
+
+//____________________________________________________________________________..
+std::string CDBPayloadCache::get(const std::string &url)
+{
+  std::error_code ec;
+  const std::filesystem::path source(url);
+  if (url.empty() || !std::filesystem::is_regular_file(source, ec))
+  {
+    return url;
+  }
+  const uint64_t size = std::filesystem::file_size(source, ec);
+  if (ec)
+  {
+    return url;
+  }
+  if (size > m_MaxSize)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << "CDBPayloadCache: " << url << " exceeds cache size, not cached" << std::endl;
+    }
+    return url;
+  }
+  const auto mtime = std::filesystem::last_write_time(source, ec).time_since_epoch().count();
+  if (ec)
+  {
+    return url;
+  }
+
+  std::ostringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0')
+       << fnv1a(url + '\n' + std::to_string(size) + '\n' + std::to_string(mtime))
+       << '_' << source.filename().string();
+  const std::filesystem::path target = std::filesystem::path(m_Directory) / name.str();
+
+  if (std::filesystem::is_regular_file(target, ec) && std::filesystem::file_size(target, ec) == size)
+  {
+    // cache hit, mark as recently used
+    std::filesystem::last_write_time(target, std::filesystem::file_time_type::clock::now(), ec);
+    if (Verbosity() > 1)
+    {
+      std::cout << "CDBPayloadCache: using " << target << " for " << url << std::endl;
+    }
+    return target.string();
+  }
+
+  if (!add(source, target))
+  {
+    return url;
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "CDBPayloadCache: copied " << url << " to " << target << std::endl;
+  }
+  evict(target);
+  return target.string();
+}
+
+//____________________________________________________________________________..
+bool CDBPayloadCache::add(const std::filesystem::path &source, const std::filesystem::path &target) const
+{
+  // copy under a process unique name, then rename, which is atomic
+  const std::filesystem::path tmpname = target.string() + "." + std::to_string(getpid()) + TMP_EXTENSION;
+  std::error_code ec;
+  std::filesystem::copy_file(source, tmpname, std::filesystem::copy_options::overwrite_existing, ec);
+  if (!ec)
+  {
+    std::filesystem::rename(tmpname, target, ec);
+  }
+  if (ec)
+  {
+    std::cout << PHWHERE << " cannot copy " << source << " to payload cache " << m_Directory
+              << ": " << ec.message() << std::endl;
+    std::filesystem::remove(tmpname, ec);
+    return false;
+  }
+  return true;
+}
+
+//____________________________________________________________________________..
+void CDBPayloadCache::evict(const std::filesystem::path &keep) const
+{
+  std::error_code ec;
+  std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> files;
+  uint64_t total = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(m_Directory, ec))
+  {
+    // skip copies in progress
+    if (!entry.is_regular_file(ec) || entry.path().extension() == TMP_EXTENSION)
+    {
+      continue;
+    }
+    total += entry.file_size(ec);
+    files.emplace_back(entry.last_write_time(ec), entry.path());
+  }
+  if (total <= m_MaxSize)
+  {
+    return;
+  }
+
+  std::sort(files.begin(), files.end());
+  const auto newest_evictable = std::filesystem::file_time_type::clock::now() - EVICTION_GRACE;
+  for (const auto &file : files)
+  {
+    if (total <= m_MaxSize || file.first > newest_evictable)
+    {
+      break;
+    }
+    if (file.second == keep)
+    {
+      continue;
+    }
+    const uint64_t size = std::filesystem::file_size(file.second, ec);
+    if (!ec && std::filesystem::remove(file.second, ec))
+    {
+      total -= size;
+      if (Verbosity() > 0)
+      {
+        std::cout << "CDBPayloadCache: evicted " << file.second << std::endl;
+      }
+    }
+  }
+}
@@ -0,0 +1,52 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFAMODULES_CDBPAYLOADCACHE_H
+#define FFAMODULES_CDBPAYLOADCACHE_H
+
+#include <cstdint>  // for uint64_t
+#include <filesystem>
+#include <string>
+
+/// local on-disk copy of calibration payloads
+/**
+   Payloads are copied from the shared filesystem into a node local directory,
+   shared by all jobs running on the node. A cached file is named after a hash
+   of the payload url, size and modification time (followed by the original
+   file name), so a payload which changes in place gets a new entry.
+   Files are written under a temporary name and renamed, so concurrent jobs
+   never see partial copies.
+   When the total size exceeds the limit, least recently used files are removed.
+   Files used within the last minute are never removed, since another job may
+   be about to open them.
+   Urls which are not local regular files (e.g. xrootd) are not cached.
+*/
+class CDBPayloadCache
+{
+ public:
+  CDBPayloadCache(const std::string &directory, uint64_t max_size);
+
+  ~CDBPayloadCache() = default;
+
+  /// local copy of a payload, copied into the cache if needed.
+  /// returns the url unchanged if it cannot be cached
+  std::string get(const std::string &url);
+
+  const std::string &directory() const { return m_Directory; }
+  uint64_t max_size() const { return m_MaxSize; }
+
+  void Verbosity(int i) { m_Verbosity = i; }
+  int Verbosity() const { return m_Verbosity; }
+
+ private:
+  /// copy payload into the cache. Returns false on failure
+  bool add(const std::filesystem::path &source, const std::filesystem::path &target) const;
+
+  /// remove least recently used files until the cache fits its size limit
+  void evict(const std::filesystem::path &keep) const;
+
+  std::string m_Directory;
+  uint64_t m_MaxSize{0};
+  int m_Verbosity{0};
+};
+
+#endif  // FFAMODULES_CDBPAYLOADCACHE_H
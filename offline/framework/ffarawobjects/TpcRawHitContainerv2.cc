@@ -3,6 +3,8 @@
 
 #include <TClonesArray.h>
 
+#include <utility>
+
 static const int NTPCHITS = 10000;
 
 TpcRawHitContainerv2::TpcRawHitContainerv2()
@@ -52,6 +54,13 @@ TpcRawHit *TpcRawHitContainerv2::AddHit()
 
 TpcRawHit *TpcRawHitContainerv2::AddHit(TpcRawHit *tpchit)
 {
+  if (tpchit->IsA() == TpcRawHitv2::Class())
+  {
+    // adopt the adc values of the input hit (which is left empty) instead of copying them one by one
+    TpcRawHit *newhit = new ((*TpcRawHitsTCArray)[TpcRawHitsTCArray->GetLast() + 1])
+        TpcRawHitv2(std::move(*(static_cast<TpcRawHitv2 *>(tpchit))));  // NOLINT(cppcoreguidelines-pro-type-static-cast-downcast)
+    return newhit;
+  }
   TpcRawHit *newhit = new ((*TpcRawHitsTCArray)[TpcRawHitsTCArray->GetLast() + 1]) TpcRawHitv2(tpchit);
   return newhit;
 }
@@ -27,6 +27,28 @@ TpcRawHitv2::TpcRawHitv2(TpcRawHit *tpchit)
   }
 }
 
+// cppcheck-suppress accessMoved
+TpcRawHitv2::TpcRawHitv2(TpcRawHitv2 &&other) noexcept
+  : TpcRawHit(other)
+  , bco(other.bco)
+  , gtm_bco(other.gtm_bco)
+  , packetid(other.packetid)
+  , fee(other.fee)
+  , channel(other.channel)
+  , sampaaddress(other.sampaaddress)
+  , sampachannel(other.sampachannel)
+  , samples(other.samples)
+  , type(other.type)
+  , userword(other.userword)
+  , checksum(other.checksum)
+  , data_parity(other.data_parity)
+  , checksumerror(other.checksumerror)
+  , parityerror(other.parityerror)
+  , adcmap(std::move(other.adcmap))
+{
+  other.adcmap.clear();
+}
+
 void TpcRawHitv2::identify(std::ostream &os) const
 {
   os << "BCO: 0x" << std::hex << bco << std::dec << std::endl;
@@ -8,12 +8,14 @@
 #include <cassert>
 #include <limits>
 #include <map>
+#include <utility>
 
 class TpcRawHitv2 : public TpcRawHit
 {
  public:
   TpcRawHitv2() = default;
   TpcRawHitv2(TpcRawHit *tpchit);
+  TpcRawHitv2(TpcRawHitv2 &&other) noexcept;
   ~TpcRawHitv2() override = default;
 
   /** identify Function from PHObject
@@ -0,0 +1,215 @@
+#ifndef FUN4ALLRAW_BCOWINDOW_H
+#define FUN4ALLRAW_BCOWINDOW_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+//! sorted window of the beam clocks seen by a streaming input
+/*!
+  Beam clocks are kept in ascending order in one contiguous buffer, together
+  with a bitmask of the FEEs which sent data for them. Beam clocks mostly
+  arrive in order, so an insertion is an append or an update of the last
+  entry. Consumed beam clocks are dropped from the front by moving a head
+  index, and the buffer is compacted once the dropped entries make up half
+  of it. This replaces std::set<uint64_t> and std::map<uint64_t, std::set<int>>,
+  which allocate one node per beam clock and per FEE.
+*/
+class BcoWindow
+{
+ public:
+  //! FEE ids must be smaller than this to be recorded in the mask
+  static constexpr unsigned int MaxFee = 64;
+
+  struct Entry
+  {
+    uint64_t bco{0};
+    //! bit i is set if FEE i sent data for this beam clock
+    uint64_t fees{0};
+
+    bool hasFee(const unsigned int fee) const { return fee < MaxFee && ((fees >> fee) & 1U); }
+
+    //! ids of the FEEs which sent data for this beam clock, in ascending order
+    std::vector<int> feeList() const
+    {
+      std::vector<int> list;
+      for (unsigned int fee = 0; fee < MaxFee; ++fee)
+      {
+        if (hasFee(fee))
+        {
+          list.push_back(fee);
+        }
+      }
+      return list;
+    }
+  };
+
+  using const_iterator = std::vector<Entry>::const_iterator;
+
+  const_iterator begin() const { return m_Entries.begin() + m_Head; }
+  const_iterator end() const { return m_Entries.end(); }
+  bool empty() const { return m_Head == m_Entries.size(); }
+  std::size_t size() const { return m_Entries.size() - m_Head; }
+
+  //! lowest and highest beam clock, the window must not be empty
+  uint64_t front() const { return m_Entries[m_Head].bco; }
+  uint64_t back() const { return m_Entries.back().bco; }
+
+  //! first entry with a beam clock not less than bco
+  const_iterator lower_bound(const uint64_t bco) const
+  {
+    return std::lower_bound(begin(), end(), bco, [](const Entry &entry, const uint64_t value)
+                            { return entry.bco < value; });
+  }
+
+  bool contains(const uint64_t bco) const
+  {
+    auto iter = lower_bound(bco);
+    return iter != end() && iter->bco == bco;
+  }
+
+  //! add a beam clock
+  void insert(const uint64_t bco) { find_or_insert(bco); }
+
+  //! add a beam clock and mark the FEE which sent it
+  void insert(const uint64_t bco, const unsigned int fee)
+  {
+    Entry &entry = find_or_insert(bco);
+    if (fee < MaxFee)
+    {
+      entry.fees |= uint64_t{1} << fee;
+    }
+  }
+
+  //! remove a single beam clock
+  void erase(const uint64_t bco)
+  {
+    auto iter = lower_bound(bco);
+    if (iter == end() || iter->bco != bco)
+    {
+      return;
+    }
+    if (iter == begin())
+    {
+      ++m_Head;
+      compact();
+      return;
+    }
+    m_Entries.erase(iter);
+  }
+
+  //! remove all beam clocks up to and including bco
+  void erase_up_to(const uint64_t bco)
+  {
+    auto iter = std::upper_bound(begin(), end(), bco, [](const uint64_t value, const Entry &entry)
+                                 { return value < entry.bco; });
+    m_Head = iter - m_Entries.begin();
+    compact();
+  }
+
+  void clear()
+  {
+    m_Entries.clear();
+    m_Head = 0;
+  }
+
+ private:
+  Entry &find_or_insert(const uint64_t bco)
+  {
+    if (empty() || m_Entries.back().bco < bco)
+    {
+      m_Entries.push_back({bco, 0});
+      return m_Entries.back();
+    }
+    if (m_Entries.back().bco == bco)
+    {
+      return m_Entries.back();
+    }
+    auto iter = m_Entries.begin() + (lower_bound(bco) - m_Entries.cbegin());
+    if (iter->bco != bco)
+    {
+      iter = m_Entries.insert(iter, {bco, 0});
+    }
+    return *iter;
+  }
+
+  void compact()
+  {
+    if (m_Head == m_Entries.size())
+    {
+      clear();
+    }
+    else if (m_Head > m_Entries.size() / 2)
+    {
+      m_Entries.erase(m_Entries.begin(), m_Entries.begin() + m_Head);
+      m_Head = 0;
+    }
+  }
+
+  std::vector<Entry> m_Entries;
+  //! index of the first live entry
+  std::size_t m_Head{0};
+};
+
+//! last beam clock seen for every FEE, kept in a flat vector sorted by FEE id
+/*!
+  There are a few dozen FEEs per input at most and the map is updated for
+  every hit, mostly for the FEE of the previous hit, so the last position
+  is checked before searching.
+*/
+class FeeBcoMap
+{
+ public:
+  using value_type = std::pair<int, uint64_t>;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  const_iterator begin() const { return m_Entries.begin(); }
+  const_iterator end() const { return m_Entries.end(); }
+  bool empty() const { return m_Entries.empty(); }
+  std::size_t size() const { return m_Entries.size(); }
+
+  //! set the last beam clock of a FEE
+  void set(const int fee, const uint64_t bco)
+  {
+    if (m_Last < m_Entries.size() && m_Entries[m_Last].first == fee)
+    {
+      m_Entries[m_Last].second = bco;
+      return;
+    }
+    auto iter = find(fee);
+    if (iter == m_Entries.end() || iter->first != fee)
+    {
+      iter = m_Entries.insert(iter, {fee, bco});
+    }
+    else
+    {
+      iter->second = bco;
+    }
+    m_Last = iter - m_Entries.begin();
+  }
+
+  void erase(const int fee)
+  {
+    auto iter = find(fee);
+    if (iter != m_Entries.end() && iter->first == fee)
+    {
+      m_Entries.erase(iter);
+    }
+    m_Last = m_Entries.size();
+  }
+
+ private:
+  std::vector<value_type>::iterator find(const int fee)
+  {
+    return std::lower_bound(m_Entries.begin(), m_Entries.end(), fee, [](const value_type &entry, const int value)
+                            { return entry.first < value; });
+  }
+
+  std::vector<value_type> m_Entries;
+  //! position of the last updated FEE
+  std::size_t m_Last{0};
+};
+
+#endif
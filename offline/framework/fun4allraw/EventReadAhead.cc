@@ -0,0 +1,89 @@
+#include "EventReadAhead.h"
+
+#include <Event/Event.h>
+#include <Event/Eventiterator.h>
+
+#include <algorithm>  // for max
+
+//_____________________________________________________________________________
+EventReadAhead::EventReadAhead(Eventiterator *evtiter, const unsigned int depth)
+  : m_EventIterator(evtiter)
+  , m_Depth(std::max(1U, depth))
+  , m_Thread(&EventReadAhead::run, this)
+{
+}
+
+//_____________________________________________________________________________
+EventReadAhead::~EventReadAhead()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Stop = true;
+  }
+  m_NotFull.notify_one();
+  m_Thread.join();
+  for (auto *evt : m_Queue)
+  {
+    delete evt;
+  }
+}
+
+//_____________________________________________________________________________
+Event *EventReadAhead::getNextEvent()
+{
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  m_NotEmpty.wait(lock, [this]
+                  { return !m_Queue.empty() || m_EndOfFile; });
+  if (m_Queue.empty())
+  {
+    return nullptr;
+  }
+  Event *evt = m_Queue.front();
+  m_Queue.pop_front();
+  lock.unlock();
+  m_NotFull.notify_one();
+  return evt;
+}
+
+//_____________________________________________________________________________
+void EventReadAhead::run()
+{
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_Mutex);
+      m_NotFull.wait(lock, [this]
+                     { return m_Queue.size() < m_Depth || m_Stop; });
+      if (m_Stop)
+      {
+        return;
+      }
+    }
+
+    // the iterator is only touched by this thread
+    Event *evt = m_EventIterator->getNextEvent();
+    if (evt)
+    {
+      // the event data may point into the iterator buffer which is reused
+      // by the next reads, give the event its own copy
+      evt->convert();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      if (evt)
+      {
+        m_Queue.push_back(evt);
+      }
+      else
+      {
+        m_EndOfFile = true;
+      }
+    }
+    m_NotEmpty.notify_one();
+    if (!evt)
+    {
+      return;
+    }
+  }
+}
@@ -0,0 +1,58 @@
+#ifndef FUN4ALLRAW_EVENTREADAHEAD_H
+#define FUN4ALLRAW_EVENTREADAHEAD_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+class Event;
+class Eventiterator;
+
+//! reads events of an open file ahead on its own thread
+/*!
+  A producer thread calls getNextEvent() on the event iterator and keeps up
+  to depth events in a queue, so reading and unpacking the next events of a
+  file overlaps with the processing of the current ones on the main thread.
+  getNextEvent() blocks until an event is available and returns nullptr at
+  the end of the file, like the iterator itself. The file rollover stays with
+  the caller: the read-ahead is dropped on fileclose and a new one is started
+  for the next file.
+
+  The event iterator must not be used by anybody else and must outlive this
+  object. Events left in the queue are deleted on destruction.
+*/
+class EventReadAhead
+{
+ public:
+  EventReadAhead(Eventiterator *evtiter, const unsigned int depth);
+
+  //! stops and joins the producer thread
+  ~EventReadAhead();
+
+  EventReadAhead(const EventReadAhead &) = delete;
+  EventReadAhead &operator=(const EventReadAhead &) = delete;
+
+  //! next event, nullptr at end of file. The caller takes ownership
+  Event *getNextEvent();
+
+ private:
+  //! producer main loop
+  void run();
+
+  Eventiterator *m_EventIterator{nullptr};
+  unsigned int m_Depth{1};
+
+  //! protects the state below
+  std::mutex m_Mutex;
+  std::condition_variable m_NotEmpty;
+  std::condition_variable m_NotFull;
+
+  std::deque<Event *> m_Queue;
+  bool m_EndOfFile{false};
+  bool m_Stop{false};
+
+  std::thread m_Thread;
+};
+
+#endif
@@ -44,8 +44,10 @@
 #include <cstdint>  // for uint64_t, uint16_t
 #include <cstdlib>
 #include <format>
+#include <initializer_list>
 #include <iostream>  // for operator<<, basic_ostream, endl
 #include <utility>   // for pair
+#include <vector>
 
 Fun4AllStreamingInputManager::Fun4AllStreamingInputManager(const std::string &name, const std::string &dstnodename, const std::string &topnodename)
   : Fun4AllInputManager(name, dstnodename, topnodename)
@@ -445,6 +447,7 @@ void Fun4AllStreamingInputManager::registerStreamingInput(SingleStreamingInput *
     evtin->CreateDSTNode(m_topNode);
   }
   evtin->ConfigureStreamingInputManager();
+  evtin->ReadAheadDepth(m_ReadAheadDepth);
   switch (system)
   {
   case InputManagerType::MVTX:
@@ -716,17 +719,18 @@ int Fun4AllStreamingInputManager::FillIntt()
   for (auto &p : m_InttInputVector)
   {
     // this is on a per packet basis
-    auto bcl_stack = p->BclkStackMap();
-    auto feebclstack = p->getFeeGTML1BCOMap();
+    const auto &bcl_stack = p->BclkStackMap();
+    const auto &feebclstack = p->getFeeGTML1BCOMap();
     int packet_id = bcl_stack.begin()->first;
     int histo_to_fill = (packet_id % 10) - 1;
 
     std::set<int> feeidset;
     int fee = 0;
-    for (auto &[feeid, gtmbcoset] : feebclstack)
+    for (const auto &[feeid, gtmbcoset] : feebclstack)
     {
-      for (const auto &bcl : gtmbcoset)
+      for (const auto &entry : gtmbcoset)
       {
+        const uint64_t bcl = entry.bco;
         auto diff = (m_RefBCO > bcl) ? m_RefBCO - bcl : bcl - m_RefBCO;
         h_bcodiff_intt[histo_to_fill]->Fill(feeid, diff);
         if (diff <= m_intt_bco_range)
@@ -749,17 +753,21 @@ int Fun4AllStreamingInputManager::FillIntt()
     bool thispacket = false;
     h_refbco_intt[histo_to_fill]->Fill(refbcobitshift);
 
-    for (auto &[packetid, gtmbcoset] : bcl_stack)
+    // the stacks are sorted, only the first beam clock above the lower edge
+    // of the range can be the closest match
+    const uint64_t lowest_bco = (m_RefBCO >= m_intt_bco_range) ? m_RefBCO - m_intt_bco_range + 1 : 0;
+    for (const auto &[packetid, gtmbcoset] : bcl_stack)
     {
-      for (const auto &gtmbco : gtmbcoset)
+      auto gtmbco = gtmbcoset.lower_bound(lowest_bco);
+      if (gtmbco == gtmbcoset.end())
       {
-        auto diff = (m_RefBCO > gtmbco) ? m_RefBCO - gtmbco : gtmbco - m_RefBCO;
-        if (diff < m_intt_bco_range)
-        {
-          thispacket = true;
-          h_gl1tagged_intt[histo_to_fill]->Fill(refbcobitshift);
-          break;
-        }
+        continue;
+      }
+      auto diff = (m_RefBCO > gtmbco->bco) ? m_RefBCO - gtmbco->bco : gtmbco->bco - m_RefBCO;
+      if (diff < m_intt_bco_range)
+      {
+        thispacket = true;
+        h_gl1tagged_intt[histo_to_fill]->Fill(refbcobitshift);
       }
     }
 
@@ -928,16 +936,17 @@ int Fun4AllStreamingInputManager::FillMvtx()
   std::map<int, std::set<int>> taggedPacketsFEEs;
   for (auto &p : m_MvtxInputVector)
   {
-    auto gtml1bcoset_perfee = p->getFeeGTML1BCOMap();
+    const auto &gtml1bcoset_perfee = p->getFeeGTML1BCOMap();
     //    int feecounter = 0;
-    for (auto &[feeid, gtmbcoset] : gtml1bcoset_perfee)
+    for (const auto &[feeid, gtmbcoset] : gtml1bcoset_perfee)
     {
       auto link = MvtxRawDefs::decode_feeid(feeid);
       auto [felix, endpoint] = MvtxRawDefs::get_flx_endpoint(link.layer, link.stave);
       auto packetid = felix * 2 + endpoint;
 
-      for (const auto &gtmbco : gtmbcoset)
+      for (const auto &entry : gtmbcoset)
       {
+        const uint64_t gtmbco = entry.bco;
         auto diff = (m_RefBCO > gtmbco) ? m_RefBCO - gtmbco : gtmbco - m_RefBCO;
         h_bcoGL1LL1diff[packetid]->Fill(diff);
         if (diff <= 3)
@@ -1238,6 +1247,18 @@ void Fun4AllStreamingInputManager::SetMvtxBcoRange(const unsigned int i)
   m_mvtx_bco_range = std::max(i, m_mvtx_bco_range);
 }
 
+void Fun4AllStreamingInputManager::ReadAhead(const unsigned int depth)
+{
+  m_ReadAheadDepth = depth;
+  for (auto *inputvector : {&m_Gl1InputVector, &m_InttInputVector, &m_MicromegasInputVector, &m_MvtxInputVector, &m_TpcInputVector})
+  {
+    for (auto *iter : *inputvector)
+    {
+      iter->ReadAheadDepth(depth);
+    }
+  }
+}
+
 int Fun4AllStreamingInputManager::FillInttPool()
 {
   uint64_t ref_bco_minus_range = 0;
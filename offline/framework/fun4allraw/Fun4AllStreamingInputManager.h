@@ -67,6 +67,11 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   int FillTpcPool();
   void Streaming(bool b = true) { m_StreamingFlag = b; }
 
+  //! let every registered input read up to depth events ahead on its own thread
+  /*! file reading then overlaps with the bco synchronization and reconstruction.
+      0 (default) reads events on demand. Takes effect with the next opened file */
+  void ReadAhead(const unsigned int depth);
+
   void runMvtxTriggered(bool b = true) { m_mvtx_is_triggered = b; }
 
  private:
@@ -118,6 +123,7 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   unsigned int m_mvtx_negative_bco{0};
   unsigned int m_tpc_bco_range{0};
   unsigned int m_tpc_negative_bco{0};
+  unsigned int m_ReadAheadDepth{0};
 
   bool m_gl1_registered_flag{false};
   bool m_intt_registered_flag{false};
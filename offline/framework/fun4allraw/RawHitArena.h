@@ -0,0 +1,140 @@
+#ifndef FUN4ALLRAW_RAWHITARENA_H
+#define FUN4ALLRAW_RAWHITARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//! storage for the raw hits of the streaming pool inputs
+/*!
+  Hits are constructed in place in blocks of hits, grouped by beam clock,
+  instead of being allocated one by one. When a beam clock has been consumed,
+  release() destroys its hits and keeps the blocks for reuse, so after the
+  first few time frames decoding does not allocate hits anymore.
+  Pointers to hits stay valid until their beam clock is released.
+*/
+template <class T>
+class RawHitArena
+{
+ public:
+  explicit RawHitArena(const std::size_t blocksize = 1024)
+    : m_BlockSize(blocksize)
+  {
+  }
+
+  ~RawHitArena() { clear(); }
+
+  RawHitArena(const RawHitArena &) = delete;
+  RawHitArena &operator=(const RawHitArena &) = delete;
+
+  //! construct a new hit for a given beam clock
+  template <class... Args>
+  T *allocate(const uint64_t bclk, Args &&...args)
+  {
+    if (!m_LastBlocks || bclk != m_LastBclk)
+    {
+      m_LastBclk = bclk;
+      m_LastBlocks = &m_Blocks[bclk];
+    }
+    if (m_LastBlocks->empty() || m_LastBlocks->back().used == m_BlockSize)
+    {
+      m_LastBlocks->push_back(get_block());
+    }
+    Block &block = m_LastBlocks->back();
+    T *hit = new (&block.storage[block.used]) T(std::forward<Args>(args)...);
+    ++block.used;
+    return hit;
+  }
+
+  //! destroy hits of all beam clocks up to and including bclk
+  void release(const uint64_t bclk)
+  {
+    auto end = m_Blocks.upper_bound(bclk);
+    for (auto iter = m_Blocks.begin(); iter != end; ++iter)
+    {
+      for (auto &block : iter->second)
+      {
+        destroy(block);
+        m_FreeBlocks.push_back(std::move(block));
+      }
+    }
+    m_Blocks.erase(m_Blocks.begin(), end);
+    m_LastBlocks = nullptr;
+  }
+
+  //! destroy all hits
+  void clear()
+  {
+    for (auto &iter : m_Blocks)
+    {
+      for (auto &block : iter.second)
+      {
+        destroy(block);
+      }
+    }
+    m_Blocks.clear();
+    m_LastBlocks = nullptr;
+  }
+
+  //! number of hits of a given beam clock
+  std::size_t size(const uint64_t bclk) const
+  {
+    auto iter = m_Blocks.find(bclk);
+    if (iter == m_Blocks.end())
+    {
+      return 0;
+    }
+    std::size_t n = 0;
+    for (const auto &block : iter->second)
+    {
+      n += block.used;
+    }
+    return n;
+  }
+
+ private:
+  struct Block
+  {
+    std::unique_ptr<std::aligned_storage_t<sizeof(T), alignof(T)>[]> storage;
+    std::size_t used{0};
+  };
+
+  Block get_block()
+  {
+    if (m_FreeBlocks.empty())
+    {
+      return Block{std::make_unique<std::aligned_storage_t<sizeof(T), alignof(T)>[]>(m_BlockSize), 0};
+    }
+    Block block = std::move(m_FreeBlocks.back());
+    m_FreeBlocks.pop_back();
+    return block;
+  }
+
+  static void destroy(Block &block)
+  {
+    for (std::size_t i = 0; i < block.used; ++i)
+    {
+      std::launder(reinterpret_cast<T *>(&block.storage[i]))->~T();
+    }
+    block.used = 0;
+  }
+
+  std::size_t m_BlockSize{1024};
+
+  //! blocks in use, for each beam clock
+  std::map<uint64_t, std::vector<Block>> m_Blocks;
+
+  //! blocks of released beam clocks, for reuse
+  std::vector<Block> m_FreeBlocks;
+
+  //! blocks of the last used beam clock, to avoid a map lookup for consecutive hits
+  uint64_t m_LastBclk{0};
+  std::vector<Block> *m_LastBlocks{nullptr};
+};
+
+#endif
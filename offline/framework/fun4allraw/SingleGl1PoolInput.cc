@@ -56,7 +56,7 @@ void SingleGl1PoolInput::FillPool(const unsigned int /*nbclks*/)
   //  std::set<uint64_t> saved_beamclocks;
   while (GetSomeMoreEvents())
   {
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
+    std::unique_ptr<Event> evt(GetNextEvent());
     while (!evt)
     {
       fileclose();
@@ -65,7 +65,7 @@ void SingleGl1PoolInput::FillPool(const unsigned int /*nbclks*/)
         AllDone(1);
         return;
       }
-      evt.reset(GetEventiterator()->getNextEvent());
+      evt.reset(GetNextEvent());
     }
     if (Verbosity() > 2)
     {
@@ -82,7 +82,7 @@ void SingleGl1PoolInput::FillPool(const unsigned int /*nbclks*/)
       if (evt->getEvtType() == ENDRUNEVENT)
       {
         AllDone(1);
-        std::unique_ptr<Event> nextevt(GetEventiterator()->getNextEvent());
+        std::unique_ptr<Event> nextevt(GetNextEvent());
         if (nextevt)
         {
           std::cout << PHWHERE << " Found event after End Run Event " << std::endl;
@@ -170,10 +170,10 @@ void SingleGl1PoolInput::Print(const std::string &what) const
   
   if (what == "ALL" || what == "FEEBCLK")
   {
-    for (auto bcliter : m_FEEBclkMap)
+    for (const auto &bcliter : m_FEEBclkMap)
     {
       std::cout << PHWHERE << " bclk: 0x"
-                << std::hex << bcliter << std::dec << std::endl;
+                << std::hex << bcliter.bco << std::dec << std::endl;
     }
   }
   if (what == "ALL" || what == "STORAGE")
@@ -190,9 +190,9 @@ void SingleGl1PoolInput::Print(const std::string &what) const
   }
   if (what == "ALL" || what == "STACK")
   {
-    for (auto iter : m_BclkStack)
+    for (const auto &iter : m_BclkStack)
     {
-      std::cout << PHWHERE << "stacked bclk: 0x" << std::hex << iter << std::dec << std::endl;
+      std::cout << PHWHERE << "stacked bclk: 0x" << std::hex << iter.bco << std::dec << std::endl;
     }
   }
 }
@@ -219,10 +219,10 @@ void SingleGl1PoolInput::CleanupUsedPackets(const uint64_t bclk)
 
   for (auto iter : toclearbclk)
   {
-    m_FEEBclkMap.erase(iter);
-    m_BclkStack.erase(iter);
     m_Gl1RawHitMap.erase(iter);
   }
+  m_FEEBclkMap.erase_up_to(bclk);
+  m_BclkStack.erase_up_to(bclk);
 }
 
 bool SingleGl1PoolInput::CheckPoolDepth(const uint64_t bclk)
@@ -232,18 +232,18 @@ bool SingleGl1PoolInput::CheckPoolDepth(const uint64_t bclk)
   //   std::cout << PHWHERE << "not all FEEs in map: " << m_FEEBclkMap.size() << std::endl;
   //   return true;
   // }
-  for (auto iter : m_FEEBclkMap)
+  for (const auto &iter : m_FEEBclkMap)
   {
     if (Verbosity() > 2)
     {
-      std::cout << PHWHERE << "my bclk 0x" << std::hex << iter
+      std::cout << PHWHERE << "my bclk 0x" << std::hex << iter.bco
                 << " req: 0x" << bclk << std::dec << std::endl;
     }
-    if (iter < bclk)
+    if (iter.bco < bclk)
     {
       if (Verbosity() > 1)
       {
-        std::cout << PHWHERE << "FEE " << iter << " beamclock 0x" << std::hex << iter
+        std::cout << PHWHERE << "FEE " << iter.bco << " beamclock 0x" << std::hex << iter.bco
                   << " smaller than req bclk: 0x" << bclk << std::dec << std::endl;
       }
       return false;
@@ -255,7 +255,7 @@ bool SingleGl1PoolInput::CheckPoolDepth(const uint64_t bclk)
 void SingleGl1PoolInput::ClearCurrentEvent()
 {
   // called interactively, to get rid of the current event
-  uint64_t currentbclk = *m_BclkStack.begin();
+  uint64_t currentbclk = m_BclkStack.front();
   //  std::cout << PHWHERE << "clearing bclk 0x" << std::hex << currentbclk << std::dec << std::endl;
   CleanupUsedPackets(currentbclk);
   // m_BclkStack.erase(currentbclk);
@@ -1,12 +1,12 @@
 #ifndef FUN4ALLRAW_SINGLEGL1POOLINPUT_H
 #define FUN4ALLRAW_SINGLEGL1POOLINPUT_H
 
+#include "BcoWindow.h"
 #include "SingleStreamingInput.h"
 
 #include <cstdint>
 #include <list>
 #include <map>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -36,8 +36,8 @@ class SingleGl1PoolInput : public SingleStreamingInput
   std::map<unsigned int, uint64_t> m_packet_bco;
 
   std::map<uint64_t, std::vector<Gl1Packet *>> m_Gl1RawHitMap;
-  std::set<uint64_t> m_FEEBclkMap;
-  std::set<uint64_t> m_BclkStack;
+  BcoWindow m_FEEBclkMap;
+  BcoWindow m_BclkStack;
 };
 
 #endif
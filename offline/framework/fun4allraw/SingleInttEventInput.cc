@@ -65,7 +65,7 @@ void SingleInttEventInput::FillPool(const uint64_t minBCO)
   //  std::set<uint64_t> saved_beamclocks;
   while (GetSomeMoreEvents(0))
   {
-    Event *evt = GetEventiterator()->getNextEvent();
+    Event *evt = GetNextEvent();
     while (!evt)
     {
       fileclose();
@@ -74,7 +74,7 @@ void SingleInttEventInput::FillPool(const uint64_t minBCO)
         AllDone(1);
         return;
       }
-      evt = GetEventiterator()->getNextEvent();
+      evt = GetNextEvent();
     }
     if (Verbosity() > 2)
     {
@@ -184,8 +184,8 @@ void SingleInttEventInput::FillPool(const uint64_t minBCO)
             gtm_bco += 0x10000000000;  // rollover makes sure our bclks are ascending even if we roll over the 40 bit counter
           }
           m_PreviousClock[FEE] = gtm_bco;
-          m_BeamClockFEE[gtm_bco].insert(FEE);
-          m_FEEBclkMap[FEE] = gtm_bco;
+          m_BeamClockFEE.insert(gtm_bco, FEE);
+          m_FEEBclkMap.set(FEE, gtm_bco);
           if (Verbosity() > 2)
           {
             std::cout << "evtno: " << EventSequence
@@ -217,8 +217,8 @@ void SingleInttEventInput::Print(const std::string &what) const
   {
     for (const auto &bcliter : m_BeamClockFEE)
     {
-      std::cout << "Beam clock 0x" << std::hex << bcliter.first << std::dec << std::endl;
-      for (auto feeiter : bcliter.second)
+      std::cout << "Beam clock 0x" << std::hex << bcliter.bco << std::dec << std::endl;
+      for (auto feeiter : bcliter.feeList())
       {
         std::cout << "FEM: " << feeiter << std::endl;
       }
@@ -251,12 +251,12 @@ void SingleInttEventInput::Print(const std::string &what) const
     {
       for (const auto &bclk : bclkstack)
       {
-        std::cout << "stacked bclk: 0x" << std::hex << bclk << std::dec << std::endl;
+        std::cout << "stacked bclk: 0x" << std::hex << bclk.bco << std::dec << std::endl;
       }
     }
-    for (auto iter : m_BclkStack)
+    for (const auto &iter : m_BclkStack)
     {
-      std::cout << "stacked bclk: 0x" << std::hex << iter << std::dec << std::endl;
+      std::cout << "stacked bclk: 0x" << std::hex << iter.bco << std::dec << std::endl;
     }
   }
 }
@@ -316,7 +316,7 @@ bool SingleInttEventInput::CheckPoolDepth(const uint64_t bclk)
 void SingleInttEventInput::ClearCurrentEvent()
 {
   // called interactively, to get rid of the current event
-  uint64_t currentbclk = *(m_BclkStackPacketMap.begin()->second).begin();
+  uint64_t currentbclk = m_BclkStackPacketMap.begin()->second.front();
   //  std::cout << "clearing bclk 0x" << std::hex << currentbclk << std::dec << std::endl;
   CleanupUsedPackets(currentbclk);
   // m_BclkStack.erase(currentbclk);
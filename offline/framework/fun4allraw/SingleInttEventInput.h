@@ -1,12 +1,12 @@
 #ifndef FUN4ALLRAW_SINGLEINTTEVENTINPUT_H
 #define FUN4ALLRAW_SINGLEINTTEVENTINPUT_H
 
+#include "BcoWindow.h"
 #include "SingleStreamingInput.h"
 
 #include <array>
 #include <cstdint>  // for uint64_t
 #include <map>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -31,8 +31,8 @@ class SingleInttEventInput : public SingleStreamingInput
   void SetBcoRange(const unsigned int value) { m_BcoRange = value; }
   void ConfigureStreamingInputManager() override;
   void SetNegativeBco(const unsigned int value) { m_NegativeBco = value; }
-  const std::set<uint64_t> &BclkStack() const override { return m_BclkStack; }
-  const std::map<uint64_t, std::set<int>> &BeamClockFEE() const override { return m_BeamClockFEE; }
+  const BcoWindow &BclkStack() const override { return m_BclkStack; }
+  const BcoWindow &BeamClockFEE() const override { return m_BeamClockFEE; }
 
  private:
   Packet **plist{nullptr};
@@ -43,10 +43,10 @@ class SingleInttEventInput : public SingleStreamingInput
 
   std::array<uint64_t, 14> m_PreviousClock{};
   std::array<uint64_t, 14> m_Rollover{};
-  std::map<uint64_t, std::set<int>> m_BeamClockFEE;
+  BcoWindow m_BeamClockFEE;
   std::map<uint64_t, std::vector<InttRawHit *>> m_InttRawHitMap;
-  std::map<int, uint64_t> m_FEEBclkMap;
-  std::set<uint64_t> m_BclkStack;
+  FeeBcoMap m_FEEBclkMap;
+  BcoWindow m_BclkStack;
   std::map<int, intt_pool *> poolmap;
 };
 
@@ -71,7 +71,7 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
   //  std::set<uint64_t> saved_beamclocks;
   while (GetSomeMoreEvents(0))
   {
-    Event *evt = GetEventiterator()->getNextEvent();
+    Event *evt = GetNextEvent();
     while (!evt)
     {
       fileclose();
@@ -80,7 +80,7 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
         AllDone(1);
         return;
       }
-      evt = GetEventiterator()->getNextEvent();
+      evt = GetNextEvent();
     }
     if (Verbosity() > 2)
     {
@@ -287,11 +287,22 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
             {
               continue;
             }
-            auto newhit = std::make_unique<InttRawHitv2>();
             int FEE = pool->iValue(j, "FEE");
+            // the hit keeps the bco before rollover correction
+            const uint64_t hit_bco = gtm_bco;
+            gtm_bco += m_Rollover[FEE];
+
+            if (gtm_bco < m_PreviousClock[FEE])
+            {
+              m_Rollover[FEE] += 0x10000000000;
+              gtm_bco += 0x10000000000;  // rollover makes sure our bclks are ascending even if we roll over the 40 bit counter
+            }
+            m_PreviousClock[FEE] = gtm_bco;
+
+            InttRawHitv2 *newhit = m_InttRawHitArena.allocate(gtm_bco);
             newhit->set_packetid(pool->getIdentifier());
             newhit->set_fee(FEE);
-            newhit->set_bco(gtm_bco);
+            newhit->set_bco(hit_bco);
             newhit->set_adc(pool->iValue(j, "ADC"));
             newhit->set_amplitude(pool->iValue(j, "AMPLITUDE"));
             newhit->set_chip_id(pool->iValue(j, "CHIP_ID"));
@@ -301,16 +312,8 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
             newhit->set_full_FPHX(pool->iValue(j, "FULL_FPHX"));
             newhit->set_full_ROC(pool->iValue(j, "FULL_ROC"));
             newhit->set_event_counter(pool->iValue(j, "EVENT_COUNTER"));
-            gtm_bco += m_Rollover[FEE];
-
-            if (gtm_bco < m_PreviousClock[FEE])
-            {
-              m_Rollover[FEE] += 0x10000000000;
-              gtm_bco += 0x10000000000;  // rollover makes sure our bclks are ascending even if we roll over the 40 bit counter
-            }
-            m_PreviousClock[FEE] = gtm_bco;
-            m_BeamClockFEE[gtm_bco].insert(FEE);
-            m_FEEBclkMap[FEE] = gtm_bco;
+            m_BeamClockFEE.insert(gtm_bco, FEE);
+            m_FEEBclkMap.set(FEE, gtm_bco);
             if (Verbosity() > 2)
             {
               std::cout << "evtno: " << EventSequence
@@ -324,9 +327,9 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
             }
             if (StreamingInputManager())
             {
-              StreamingInputManager()->AddInttRawHit(gtm_bco, newhit.get());
+              StreamingInputManager()->AddInttRawHit(gtm_bco, newhit);
             }
-            m_InttRawHitMap[gtm_bco].push_back(newhit.release());
+            m_InttRawHitMap[gtm_bco].push_back(newhit);
           }
         }
         //    Print("FEEBCLK");
@@ -342,8 +345,8 @@ void SingleInttPoolInput::Print(const std::string &what) const
   {
     for (const auto &bcliter : m_BeamClockFEE)
     {
-      std::cout << "Beam clock 0x" << std::hex << bcliter.first << std::dec << std::endl;
-      for (auto feeiter : bcliter.second)
+      std::cout << "Beam clock 0x" << std::hex << bcliter.bco << std::dec << std::endl;
+      for (auto feeiter : bcliter.feeList())
       {
         std::cout << "FEM: " << feeiter << std::endl;
       }
@@ -376,28 +379,22 @@ void SingleInttPoolInput::Print(const std::string &what) const
     {
       for (const auto &bclk : bclkstack)
       {
-        std::cout << "stacked bclk: 0x" << std::hex << bclk << std::dec << std::endl;
+        std::cout << "stacked bclk: 0x" << std::hex << bclk.bco << std::dec << std::endl;
       }
     }
-    for (auto iter : m_BclkStack)
+    for (const auto &iter : m_BclkStack)
     {
-      std::cout << "stacked bclk: 0x" << std::hex << iter << std::dec << std::endl;
+      std::cout << "stacked bclk: 0x" << std::hex << iter.bco << std::dec << std::endl;
     }
   }
 }
 
 void SingleInttPoolInput::CleanupUsedPackets(const uint64_t bclk)
 {
-  m_BclkStack.erase(m_BclkStack.begin(), m_BclkStack.upper_bound(bclk));
-  m_BeamClockFEE.erase(m_BeamClockFEE.begin(), m_BeamClockFEE.upper_bound(bclk));
-  for (auto it = m_InttRawHitMap.begin(); it != m_InttRawHitMap.end() && (it->first <= bclk); it = m_InttRawHitMap.erase(it))
-  {
-    for (const auto &rawhit : it->second)
-    {
-      delete rawhit;
-    }
-  }
+  m_BclkStack.erase_up_to(bclk);
+  m_BeamClockFEE.erase_up_to(bclk);
   m_InttRawHitMap.erase(m_InttRawHitMap.begin(), m_InttRawHitMap.upper_bound(bclk));
+  m_InttRawHitArena.release(bclk);
 }
 
 bool SingleInttPoolInput::CheckPoolDepth(const uint64_t bclk)
@@ -425,7 +422,7 @@ bool SingleInttPoolInput::CheckPoolDepth(const uint64_t bclk)
 void SingleInttPoolInput::ClearCurrentEvent()
 {
   // called interactively, to get rid of the current event
-  uint64_t currentbclk = *(m_BclkStackPacketMap.begin()->second).begin();
+  uint64_t currentbclk = m_BclkStackPacketMap.begin()->second.front();
   //  std::cout << "clearing bclk 0x" << std::hex << currentbclk << std::dec << std::endl;
   CleanupUsedPackets(currentbclk);
   // m_BclkStack.erase(currentbclk);
@@ -1,13 +1,16 @@
 #ifndef FUN4ALLRAW_SINGLEINTTPOOLINPUT_H
 #define FUN4ALLRAW_SINGLEINTTPOOLINPUT_H
 
+#include "BcoWindow.h"
+#include "RawHitArena.h"
 #include "SingleStreamingInput.h"
 
+#include <ffarawobjects/InttRawHitv2.h>
+
 #include <array>
 #include <cstdint>  // for uint64_t
 #include <iostream>
 #include <map>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -41,8 +44,8 @@ class SingleInttPoolInput : public SingleStreamingInput
   void ConfigureStreamingInputManagerLocal(const int runnumber);
   void SetNegativeBco(const unsigned int value) { m_NegativeBco = value; }
   unsigned int GetNegativeBco() const { return m_NegativeBco; }
-  const std::set<uint64_t> &BclkStack() const override { return m_BclkStack; }
-  const std::map<uint64_t, std::set<int>> &BeamClockFEE() const override { return m_BeamClockFEE; }
+  const BcoWindow &BclkStack() const override { return m_BclkStack; }
+  const BcoWindow &BeamClockFEE() const override { return m_BeamClockFEE; }
 
   void streamingMode(const bool isStreaming);
   bool IsStreaming(int runnumber);
@@ -56,10 +59,12 @@ class SingleInttPoolInput : public SingleStreamingInput
   bool m_SkipEarlyEvents{true};
   std::array<uint64_t, 14> m_PreviousClock{};
   std::array<uint64_t, 14> m_Rollover{};
-  std::map<uint64_t, std::set<int>> m_BeamClockFEE;
+  BcoWindow m_BeamClockFEE;
   std::map<uint64_t, std::vector<InttRawHit *>> m_InttRawHitMap;
-  std::map<int, uint64_t> m_FEEBclkMap;
-  std::set<uint64_t> m_BclkStack;
+  //! owns the hits in m_InttRawHitMap
+  RawHitArena<InttRawHitv2> m_InttRawHitArena;
+  FeeBcoMap m_FEEBclkMap;
+  BcoWindow m_BclkStack;
 
   std::map<int, intt_pool *> poolmap;
 };
@@ -128,7 +128,7 @@ void SingleMicromegasPoolInput_v1::FillPool(const unsigned int /*nbclks*/)
 
   while (GetSomeMoreEvents())
   {
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
+    std::unique_ptr<Event> evt(GetNextEvent());
     while (!evt)
     {
       fileclose();
@@ -139,7 +139,7 @@ void SingleMicromegasPoolInput_v1::FillPool(const unsigned int /*nbclks*/)
       }
 
       // get next event
-      evt.reset(GetEventiterator()->getNextEvent());
+      evt.reset(GetNextEvent());
     }
 
     if (Verbosity() > 2)
@@ -321,8 +321,8 @@ void SingleMicromegasPoolInput_v1::FillPool(const unsigned int /*nbclks*/)
           newhit->move_adc_waveform(first, std::move(values));
         }
 
-        m_BeamClockFEE[gtm_bco].insert(fee_id);
-        m_FEEBclkMap[fee_id] = gtm_bco;
+        m_BeamClockFEE.insert(gtm_bco, fee_id);
+        m_FEEBclkMap.set(fee_id, gtm_bco);
         if (Verbosity() > 2)
         {
           std::cout << "evtno: " << EventSequence
@@ -350,8 +350,8 @@ void SingleMicromegasPoolInput_v1::Print(const std::string& what) const
   {
     for (const auto& bcliter : m_BeamClockFEE)
     {
-      std::cout << "Beam clock 0x" << std::hex << bcliter.first << std::dec << std::endl;
-      for (auto feeiter : bcliter.second)
+      std::cout << "Beam clock 0x" << std::hex << bcliter.bco << std::dec << std::endl;
+      for (auto feeiter : bcliter.feeList())
       {
         std::cout << "FEM: " << feeiter << std::endl;
       }
@@ -386,7 +386,7 @@ void SingleMicromegasPoolInput_v1::Print(const std::string& what) const
   {
     for (const auto& iter : m_BclkStack)
     {
-      std::cout << "stacked bclk: 0x" << std::hex << iter << std::dec << std::endl;
+      std::cout << "stacked bclk: 0x" << std::hex << iter.bco << std::dec << std::endl;
     }
   }
 }
@@ -411,8 +411,8 @@ void SingleMicromegasPoolInput_v1::CleanupUsedPackets(const uint64_t bclk, bool
 
   // cleanup bco stacks
   /* it erases all elements for which the bco is no greater than the provided one */
-  m_BclkStack.erase(m_BclkStack.begin(), m_BclkStack.upper_bound(bclk));
-  m_BeamClockFEE.erase(m_BeamClockFEE.begin(), m_BeamClockFEE.upper_bound(bclk));
+  m_BclkStack.erase_up_to(bclk);
+  m_BeamClockFEE.erase_up_to(bclk);
   m_BeamClockPacket.erase(m_BeamClockPacket.begin(), m_BeamClockPacket.upper_bound(bclk));
 
   // cleanup matching information
@@ -426,7 +426,7 @@ void SingleMicromegasPoolInput_v1::CleanupUsedPackets(const uint64_t bclk, bool
 void SingleMicromegasPoolInput_v1::ClearCurrentEvent()
 {
   std::cout << "SingleMicromegasPoolInput_v1::ClearCurrentEvent." << std::endl;
-  uint64_t currentbclk = *m_BclkStack.begin();
+  uint64_t currentbclk = m_BclkStack.front();
   CleanupUsedPackets(currentbclk);
   return;
 }
@@ -1,6 +1,7 @@
 #ifndef FUN4ALLRAW_SINGLEMICROMEGASPOOLINPUT_V1_H
 #define FUN4ALLRAW_SINGLEMICROMEGASPOOLINPUT_V1_H
 
+#include "BcoWindow.h"
 #include "MicromegasBcoMatchingInformation_v1.h"
 #include "SingleStreamingInput.h"
 
@@ -70,14 +71,14 @@ class SingleMicromegasPoolInput_v1 : public SingleStreamingInput
   std::map<uint64_t, std::set<int>> m_BeamClockPacket;
 
   //! store list of FEE that have data for a given beam clock
-  std::map<uint64_t, std::set<int>> m_BeamClockFEE;
+  BcoWindow m_BeamClockFEE;
 
   //! store list of raw hits matching a given bco
   std::map<uint64_t, std::vector<MicromegasRawHit *>> m_MicromegasRawHitMap;
 
   //! store current list of BCO on a per fee basis.
   /** only packets for which a given FEE have data are stored */
-  std::map<int, uint64_t> m_FEEBclkMap;
+  FeeBcoMap m_FEEBclkMap;
 
   //! store current list of BCO
   /**
@@ -85,7 +86,7 @@ class SingleMicromegasPoolInput_v1 : public SingleStreamingInput
    * disregarding whether there is data associated to it or not
    * this allows to keep track of dropped data, also in zero-suppression mode
    */
-  std::set<uint64_t> m_BclkStack;
+  BcoWindow m_BclkStack;
 
   //! map bco_information_t to packet id
   using bco_matching_information_map_t = std::map<unsigned int, MicromegasBcoMatchingInformation_v1>;
@@ -247,7 +247,7 @@ void SingleMicromegasPoolInput_v2::FillPool(const uint64_t target_bco)
 
   while( is_more_data_required(target_bco) )
   {
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
+    std::unique_ptr<Event> evt(GetNextEvent());
     while (!evt)
     {
       fileclose();
@@ -258,7 +258,7 @@ void SingleMicromegasPoolInput_v2::FillPool(const uint64_t target_bco)
       }
 
       // get next event
-      evt.reset(GetEventiterator()->getNextEvent());
+      evt.reset(GetNextEvent());
     }
 
     if (Verbosity() > 2)
@@ -325,8 +325,8 @@ void SingleMicromegasPoolInput_v2::Print(const std::string& what) const
   {
     for (const auto& bcliter : m_BeamClockFEE)
     {
-      std::cout << "Beam clock 0x" << std::hex << bcliter.first << std::dec << std::endl;
-      for (auto feeiter : bcliter.second)
+      std::cout << "Beam clock 0x" << std::hex << bcliter.bco << std::dec << std::endl;
+      for (auto feeiter : bcliter.feeList())
       {
         std::cout << "FEM: " << feeiter << std::endl;
       }
@@ -364,7 +364,7 @@ void SingleMicromegasPoolInput_v2::CleanupUsedPackets(const uint64_t bclk, bool
   }
 
   // cleanup bco stacks
-  m_BeamClockFEE.erase(m_BeamClockFEE.begin(), m_BeamClockFEE.upper_bound(bclk));
+  m_BeamClockFEE.erase_up_to(bclk);
   m_BeamClockPacket.erase(m_BeamClockPacket.begin(), m_BeamClockPacket.upper_bound(bclk));
 
   // cleanup matching information
@@ -939,7 +939,7 @@ void SingleMicromegasPoolInput_v2::process_fee_data(int packet_id, unsigned int
       newhit->move_adc_waveform(start_t, std::move(adc));
     }
 
-    m_BeamClockFEE[gtm_bco].insert(fee_id);
+    m_BeamClockFEE.insert(gtm_bco, fee_id);
 
     // add hit to streaming input manager
     if (StreamingInputManager())
@@ -1,6 +1,7 @@
 #ifndef FUN4ALLRAW_SINGLEMICROMEGASPOOLINPUT_V2_H
 #define FUN4ALLRAW_SINGLEMICROMEGASPOOLINPUT_V2_H
 
+#include "BcoWindow.h"
 #include "MicromegasBcoMatchingInformation_v2.h"
 #include "SingleStreamingInput.h"
 
@@ -151,7 +152,7 @@ class SingleMicromegasPoolInput_v2 : public SingleStreamingInput
   std::map<uint64_t, std::set<int>> m_BeamClockPacket;
 
   /// store list of FEE that have data for a given beam clock
-  std::map<uint64_t, std::set<int>> m_BeamClockFEE;
+  BcoWindow m_BeamClockFEE;
 
   /// list of raw hits
   using rawhit_list_t = std::vector<MicromegasRawHit*>;
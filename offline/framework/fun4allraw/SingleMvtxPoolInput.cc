@@ -67,7 +67,7 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
   //  std::set<uint64_t> saved_beamclocks;
   while (GetSomeMoreEvents())
   {
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
+    std::unique_ptr<Event> evt(GetNextEvent());
     while (!evt)
     {
       fileclose();
@@ -76,7 +76,7 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
         AllDone(1);
         return;
       }
-      evt.reset(GetEventiterator()->getNextEvent());
+      evt.reset(GetNextEvent());
     }
     if (Verbosity() > 2)
     {
@@ -160,7 +160,7 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
             auto strb_bc = pool->get_TRG_IR_BC(feeId, i_strb);
             auto num_hits = pool->get_TRG_NR_HITS(feeId, i_strb);
             m_BclkStack.insert(strb_bco);
-            m_FEEBclkMap[feeId] = strb_bco;
+            m_FEEBclkMap.set(feeId, strb_bco);
 
             if (strb_bco < minBCO)
             {
@@ -177,7 +177,7 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
             auto hits = pool->get_hits(feeId, i_strb);
             for (auto &&hit : hits)
             {
-              auto newhit = std::make_unique<MvtxRawHitv1>();
+              MvtxRawHitv1 *newhit = m_MvtxRawHitArena.allocate(strb_bco);
               newhit->set_bco(strb_bco);
               newhit->set_strobe_bc(strb_bc);
               newhit->set_chip_bc(hit->bunchcounter);
@@ -189,9 +189,9 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
               newhit->set_col(hit->col_pos);
               if (StreamingInputManager())
               {
-                StreamingInputManager()->AddMvtxRawHit(strb_bco, newhit.get());
+                StreamingInputManager()->AddMvtxRawHit(strb_bco, newhit);
               }
-              m_MvtxRawHitMap[strb_bco].push_back(newhit.release());
+              m_MvtxRawHitMap[strb_bco].push_back(newhit);
             }
             if (StreamingInputManager())
             {
@@ -205,13 +205,13 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
     for (const auto &lv1Bco : gtmL1BcoSet)
     {
       auto it = m_BclkStack.lower_bound(lv1Bco);
-//      auto const strb_it = (it == m_BclkStack.begin()) ? (*it == lv1Bco ? it : m_BclkStack.cend()) : --it;
+//      auto const strb_it = (it == m_BclkStack.begin()) ? (it->bco == lv1Bco ? it : m_BclkStack.cend()) : --it;
 // this is equivalent but human readable for the above:
       auto strb_it = m_BclkStack.cend(); 
 
       if (it == m_BclkStack.begin())
       {
-	if (*it == lv1Bco)
+	if (it != m_BclkStack.cend() && it->bco == lv1Bco)
 	{
 	  strb_it = it;
 	}
@@ -232,7 +232,7 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
       {
         if (StreamingInputManager())
         {
-          StreamingInputManager()->AddMvtxL1TrgBco(*strb_it, lv1Bco);
+          StreamingInputManager()->AddMvtxL1TrgBco(strb_it->bco, lv1Bco);
         }
       }
       else if (m_BclkStack.empty())
@@ -243,7 +243,7 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
       {
         std::cout << "ERROR: lv1Bco: 0x" << std::hex << lv1Bco << std::dec
                   << " is less than minimun strobe bco 0x" << std::hex
-                  << *m_BclkStack.begin() << std::dec << std::endl;
+                  << m_BclkStack.front() << std::dec << std::endl;
         // assert(0);
       }
     }
@@ -279,7 +279,7 @@ void SingleMvtxPoolInput::Print(const std::string &what) const
   {
     for (const auto &iter : m_BclkStack)
     {
-      std::cout << "stacked bclk: 0x" << std::hex << iter << std::dec << std::endl;
+      std::cout << "stacked bclk: 0x" << std::hex << iter.bco << std::dec << std::endl;
     }
   }
   if (what == "ALL" || what == "GET_NR_STROBES")
@@ -293,19 +293,13 @@ void SingleMvtxPoolInput::Print(const std::string &what) const
 
 void SingleMvtxPoolInput::CleanupUsedPackets(const uint64_t bclk)
 {
-  m_BclkStack.erase(m_BclkStack.begin(), m_BclkStack.upper_bound(bclk));
-  for (auto it = m_MvtxRawHitMap.begin(); it != m_MvtxRawHitMap.end() && (it->first <= bclk); it = m_MvtxRawHitMap.erase(it))
-  {
-    for (const auto &rawhit : it->second)
-    {
-      delete rawhit;
-    }
-  }
+  m_BclkStack.erase_up_to(bclk);
   m_MvtxRawHitMap.erase(m_MvtxRawHitMap.begin(), m_MvtxRawHitMap.upper_bound(bclk));
+  m_MvtxRawHitArena.release(bclk);
   m_FeeStrobeMap.erase(m_FeeStrobeMap.begin(), m_FeeStrobeMap.upper_bound(bclk));
   for (auto &[feeid, gtmbcoset] : m_FeeGTML1BCOMap)
   {
-    gtmbcoset.erase(gtmbcoset.begin(), gtmbcoset.upper_bound(bclk));
+    gtmbcoset.erase_up_to(bclk);
   }
 }
 
@@ -341,7 +335,7 @@ bool SingleMvtxPoolInput::CheckPoolDepth(const uint64_t bclk)
 void SingleMvtxPoolInput::ClearCurrentEvent()
 {
   // called interactively, to get rid of the current event
-  uint64_t currentbclk = *m_BclkStack.begin();
+  uint64_t currentbclk = m_BclkStack.front();
   //  std::cout << "clearing bclk 0x" << std::hex << currentbclk << std::dec << std::endl;
   CleanupUsedPackets(currentbclk);
   // m_BclkStack.erase(currentbclk);
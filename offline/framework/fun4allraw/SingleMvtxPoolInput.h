@@ -1,8 +1,12 @@
 #ifndef FUN4ALLRAW_SINGLEMVTXPOOLINPUT_H
 #define FUN4ALLRAW_SINGLEMVTXPOOLINPUT_H
 
+#include "BcoWindow.h"
+#include "RawHitArena.h"
 #include "SingleStreamingInput.h"
 
+#include <ffarawobjects/MvtxRawHitv1.h>
+
 #include <algorithm>
 #include <map>
 #include <vector>
@@ -46,9 +50,11 @@ class SingleMvtxPoolInput : public SingleStreamingInput
   std::string m_rawEventHeaderName = "MVTXRAWEVTHEADER";
 
   std::map<uint64_t, std::vector<MvtxRawHit *>> m_MvtxRawHitMap;
-  std::map<int, uint64_t> m_FEEBclkMap;
+  //! owns the hits in m_MvtxRawHitMap
+  RawHitArena<MvtxRawHitv1> m_MvtxRawHitArena;
+  FeeBcoMap m_FEEBclkMap;
   std::map<int, uint64_t> m_FeeStrobeMap;
-  std::set<uint64_t> m_BclkStack;
+  BcoWindow m_BclkStack;
   std::set<uint64_t> gtmL1BcoSet;  // GTM L1 BCO
   std::map<int, mvtx_pool *> poolmap;
 
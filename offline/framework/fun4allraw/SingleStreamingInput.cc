@@ -1,5 +1,7 @@
 #include "SingleStreamingInput.h"
 
+#include "EventReadAhead.h"
+
 #include <fun4all/DBInterface.h>
 
 #include <phool/phool.h>
@@ -9,7 +11,7 @@
 
 #include <cstdint>   // for uint64_t
 #include <iostream>  // for operator<<, basic_ostream, endl
-#include <set>
+#include <memory>
 #include <utility>  // for pair
 
 SingleStreamingInput::SingleStreamingInput(const std::string &name)
@@ -19,6 +21,8 @@ SingleStreamingInput::SingleStreamingInput(const std::string &name)
 
 SingleStreamingInput::~SingleStreamingInput()
 {
+  // the read-ahead thread uses the iterator, stop it first
+  m_ReadAhead.reset();
   delete m_EventIterator;
 }
 
@@ -49,6 +53,10 @@ int SingleStreamingInput::fileopen(const std::string &filenam)
     return -1;
   }
   IsOpen(1);
+  if (m_ReadAheadDepth > 0)
+  {
+    m_ReadAhead = std::make_unique<EventReadAhead>(m_EventIterator, m_ReadAheadDepth);
+  }
   AddToFileOpened(fname);  // add file to the list of files which were opened
   return 0;
 }
@@ -60,6 +68,7 @@ int SingleStreamingInput::fileclose()
     std::cout << Name() << ": fileclose: No Input file open" << std::endl;
     return -1;
   }
+  m_ReadAhead.reset();
   delete m_EventIterator;
   m_EventIterator = nullptr;
   IsOpen(0);
@@ -69,14 +78,23 @@ int SingleStreamingInput::fileclose()
   return 0;
 }
 
+Event *SingleStreamingInput::GetNextEvent()
+{
+  if (m_ReadAhead)
+  {
+    return m_ReadAhead->getNextEvent();
+  }
+  return m_EventIterator->getNextEvent();
+}
+
 void SingleStreamingInput::Print(const std::string &what) const
 {
   if (what == "ALL" || what == "FEE")
   {
     for (const auto &bcliter : m_BeamClockFEE)
     {
-      std::cout << "Beam clock 0x" << std::hex << bcliter.first << std::dec << std::endl;
-      for (auto feeiter : bcliter.second)
+      std::cout << "Beam clock 0x" << std::hex << bcliter.bco << std::dec << std::endl;
+      for (auto feeiter : bcliter.feeList())
       {
         std::cout << "FEM: " << feeiter << std::endl;
       }
@@ -92,9 +110,9 @@ void SingleStreamingInput::Print(const std::string &what) const
   }
   if (what == "ALL" || what == "STACK")
   {
-    for (auto iter : m_BclkStack)
+    for (const auto &iter : m_BclkStack)
     {
-      std::cout << "stacked bclk: 0x" << std::hex << iter << std::dec << std::endl;
+      std::cout << "stacked bclk: 0x" << std::hex << iter.bco << std::dec << std::endl;
     }
   }
 }
@@ -129,7 +147,7 @@ bool SingleStreamingInput::CheckPoolDepth(const uint64_t bclk)
 void SingleStreamingInput::ClearCurrentEvent()
 {
   // called interactively, to get rid of the current event
-  uint64_t currentbclk = *m_BclkStack.begin();
+  uint64_t currentbclk = m_BclkStack.front();
   std::cout << "clearing bclk 0x" << std::hex << currentbclk << std::dec << std::endl;
   CleanupUsedPackets(currentbclk);
   m_BclkStack.erase(currentbclk);
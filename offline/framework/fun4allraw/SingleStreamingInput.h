@@ -1,14 +1,18 @@
 #ifndef FUN4ALLRAW_SINGLESTREAMINGINPUT_H
 #define FUN4ALLRAW_SINGLESTREAMINGINPUT_H
 
+#include "BcoWindow.h"
+
 #include <fun4all/Fun4AllBase.h>
 #include <fun4all/InputFileHandler.h>
 
 #include <cstdint>  // for uint64_t
 #include <map>
-#include <set>
+#include <memory>
 #include <string>
 
+class Event;
+class EventReadAhead;
 class Eventiterator;
 class Fun4AllEvtInputPoolManager;
 class Fun4AllStreamingInputManager;
@@ -20,6 +24,12 @@ class SingleStreamingInput : public Fun4AllBase, public InputFileHandler
   explicit SingleStreamingInput(const std::string &name);
   ~SingleStreamingInput() override;
   virtual Eventiterator *GetEventIterator() { return m_EventIterator; }
+  //! next event of the open file, nullptr at end of file. The caller takes ownership
+  Event *GetNextEvent();
+  //! read up to depth events ahead on a separate thread, 0 (default) disables it
+  /*! takes effect when the next file is opened */
+  void ReadAheadDepth(const unsigned int depth) { m_ReadAheadDepth = depth; }
+  unsigned int ReadAheadDepth() const { return m_ReadAheadDepth; }
   virtual void FillPool(const uint64_t) { return; }
   virtual void FillPool(const unsigned int = 1) { return; }
   virtual int FillPoolStatus() const { return 0; }
@@ -54,12 +64,13 @@ class SingleStreamingInput : public Fun4AllBase, public InputFileHandler
   virtual int SubsystemEnum() const { return m_SubsystemEnum; }
   void MaxBclkDiff(uint64_t ui) { m_MaxBclkSpread = ui; }
   uint64_t MaxBclkDiff() const { return m_MaxBclkSpread; }
-  virtual const std::map<int, std::set<uint64_t>> &BclkStackMap() const { return m_BclkStackPacketMap; }
-  virtual const std::set<uint64_t> &BclkStack() const { return m_BclkStack; }
-  virtual const std::map<uint64_t, std::set<int>> &BeamClockFEE() const { return m_BeamClockFEE; }
+  virtual const std::map<int, BcoWindow> &BclkStackMap() const { return m_BclkStackPacketMap; }
+  virtual const BcoWindow &BclkStack() const { return m_BclkStack; }
+  //! beam clocks with the FEEs which sent data for them
+  virtual const BcoWindow &BeamClockFEE() const { return m_BeamClockFEE; }
   void setHitContainerName(const std::string &name) { m_rawHitContainerName = name; }
   const std::string &getHitContainerName() const { return m_rawHitContainerName; }
-  const std::map<int, std::set<uint64_t>> &getFeeGTML1BCOMap() const { return m_FeeGTML1BCOMap; }
+  const std::map<int, BcoWindow> &getFeeGTML1BCOMap() const { return m_FeeGTML1BCOMap; }
 
   void SetStandaloneMode(bool mode) { m_standalone_mode = mode; }
   bool IsStandaloneMode() const { return m_standalone_mode; }  
@@ -71,51 +82,30 @@ class SingleStreamingInput : public Fun4AllBase, public InputFileHandler
   virtual void FillBcoQA(uint64_t /*gtm_bco*/) {};
 
   void clearPacketBClkStackMap(const uint64_t& bclk)
-
   {
-    for(auto& [packetid, set] : m_BclkStackPacketMap)
+    for (auto &[packetid, window] : m_BclkStackPacketMap)
     {
-    
-      for(auto it = set.begin(); it != set.end();)
-    {
-      if(*it <= bclk)
-      {
-        it = set.erase(it);
-      }
-      else
-      {
-        ++it;
-      }
-    }
+      window.erase_up_to(bclk);
     }
   }
   void clearFeeGTML1BCOMap(const uint64_t &bclk)
   {
-    for (auto &[key, set] : m_FeeGTML1BCOMap)
+    for (auto &[key, window] : m_FeeGTML1BCOMap)
     {
-      for(auto it = set.begin(); it != set.end();)
-      {
-        if(*it <= bclk)
-        {
-          it = set.erase(it);
-        }
-        else
-        {
-          ++it;
-        }
-      }
-      
+      window.erase_up_to(bclk);
     }
   }
 
  protected:
-  std::map<int, std::set<uint64_t>> m_BclkStackPacketMap;
-  std::map<int, std::set<uint64_t>> m_FeeGTML1BCOMap;
+  std::map<int, BcoWindow> m_BclkStackPacketMap;
+  std::map<int, BcoWindow> m_FeeGTML1BCOMap;
   std::string m_rawHitContainerName = "";
   bool m_standalone_mode = false;
 
  private:
   Eventiterator *m_EventIterator{nullptr};
+  std::unique_ptr<EventReadAhead> m_ReadAhead;
+  unsigned int m_ReadAheadDepth{0};
   //  Fun4AllEvtInputPoolManager *m_InputMgr {nullptr};
   Fun4AllStreamingInputManager *m_StreamingInputMgr{nullptr};
   uint64_t m_MaxBclkSpread{1000000};
@@ -124,9 +114,9 @@ class SingleStreamingInput : public Fun4AllBase, public InputFileHandler
   int m_EventsThisFile{0};
   int m_AllDone{0};
   int m_SubsystemEnum{0};
-  std::map<uint64_t, std::set<int>> m_BeamClockFEE;
-  std::map<int, uint64_t> m_FEEBclkMap;
-  std::set<uint64_t> m_BclkStack;
+  BcoWindow m_BeamClockFEE;
+  FeeBcoMap m_FEEBclkMap;
+  BcoWindow m_BclkStack;
 };
 
 #endif
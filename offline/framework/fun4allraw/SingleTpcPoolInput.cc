@@ -45,7 +45,7 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
   //  std::set<uint64_t> saved_beamclocks;
   while (GetSomeMoreEvents(0))
   {
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
+    std::unique_ptr<Event> evt(GetNextEvent());
     while (!evt)
     {
       fileclose();
@@ -54,7 +54,7 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
         AllDone(1);
         return;
       }
-      evt.reset(GetEventiterator()->getNextEvent());
+      evt.reset(GetNextEvent());
     }
     if (Verbosity() > 2)
     {
@@ -149,10 +149,6 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
           // store
           skipthis = false;
           previous_bco = gtm_bco;
-          if (!m_BclkStackPacketMap.contains(packet_id))
-          {
-            m_BclkStackPacketMap.insert(std::make_pair(packet_id, std::set<uint64_t>()));
-          }
           m_BclkStackPacketMap[packet_id].insert(gtm_bco);
         }
       }
@@ -192,7 +188,7 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
             continue;
           }
           bool parityerror = (packet->iValue(wf, "DATAPARITYERROR") > 0);
-          auto newhit = std::make_unique<TpcRawHitv2>();
+          TpcRawHitv2 *newhit = m_TpcRawHitArena.allocate(gtm_bco);
           int FEE = packet->iValue(wf, "FEE");
           newhit->set_bco(packet->iValue(wf, "BCO"));
 
@@ -232,14 +228,15 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
             // if(adval >= 64000){ newhit->set_samples(is); break;}
 
             // With this, the hit is unseen from clusterizer
-            if (adval <= 64000)
+            // zero values are not stored, as when copying a hit
+            if (adval > 0 && adval <= 64000)
             {
               newhit->set_adc(is, adval);
             }
           }
 
-          m_BeamClockFEE[gtm_bco].insert(FEE);
-          m_FEEBclkMap[FEE] = gtm_bco;
+          m_BeamClockFEE.insert(gtm_bco, FEE);
+          m_FEEBclkMap.set(FEE, gtm_bco);
           if (Verbosity() > 2)
           {
             std::cout << "evtno: " << EventSequence
@@ -253,9 +250,9 @@ void SingleTpcPoolInput::FillPool(const uint64_t minBCO)
           // {
           if (StreamingInputManager())
           {
-            StreamingInputManager()->AddTpcRawHit(gtm_bco, newhit.get());
+            StreamingInputManager()->AddTpcRawHit(gtm_bco, newhit);
           }
-          m_TpcRawHitMap[gtm_bco].push_back(newhit.release());
+          m_TpcRawHitMap[gtm_bco].push_back(newhit);
           m_BclkStack.insert(gtm_bco);
           //	}
         }
@@ -274,8 +271,8 @@ void SingleTpcPoolInput::Print(const std::string &what) const
   {
     for (const auto &bcliter : m_BeamClockFEE)
     {
-      std::cout << "Beam clock 0x" << std::hex << bcliter.first << std::dec << std::endl;
-      for (auto feeiter : bcliter.second)
+      std::cout << "Beam clock 0x" << std::hex << bcliter.bco << std::dec << std::endl;
+      for (auto feeiter : bcliter.feeList())
       {
         std::cout << "FEM: " << feeiter << std::endl;
       }
@@ -312,9 +309,9 @@ void SingleTpcPoolInput::Print(const std::string &what) const
   }
   if (what == "ALL" || what == "STACK")
   {
-    for (auto iter : m_BclkStack)
+    for (const auto &iter : m_BclkStack)
     {
-      std::cout << "stacked bclk: 0x" << std::hex << iter << std::dec << std::endl;
+      std::cout << "stacked bclk: 0x" << std::hex << iter.bco << std::dec << std::endl;
     }
   }
 }
@@ -331,10 +328,6 @@ void SingleTpcPoolInput::CleanupUsedPackets(const uint64_t bclk)
   {
     if (iter.first <= bclk)
     {
-      for (auto *pktiter : iter.second)
-      {
-        delete pktiter;
-      }
       toclearbclk.push_back(iter.first);
     }
     else
@@ -352,6 +345,7 @@ void SingleTpcPoolInput::CleanupUsedPackets(const uint64_t bclk)
     m_BeamClockFEE.erase(iter);
     m_TpcRawHitMap.erase(iter);
   }
+  m_TpcRawHitArena.release(bclk);
 }
 
 bool SingleTpcPoolInput::CheckPoolDepth(const uint64_t bclk)
@@ -384,7 +378,7 @@ bool SingleTpcPoolInput::CheckPoolDepth(const uint64_t bclk)
 void SingleTpcPoolInput::ClearCurrentEvent()
 {
   // called interactively, to get rid of the current event
-  uint64_t currentbclk = *m_BclkStack.begin();
+  uint64_t currentbclk = m_BclkStack.front();
   //  std::cout << "clearing bclk 0x" << std::hex << currentbclk << std::dec << std::endl;
   CleanupUsedPackets(currentbclk);
   // m_BclkStack.erase(currentbclk);
@@ -1,12 +1,15 @@
 #ifndef FUN4ALLRAW_SINGLETPCPOOLINPUT_H
 #define FUN4ALLRAW_SINGLETPCPOOLINPUT_H
 
+#include "BcoWindow.h"
+#include "RawHitArena.h"
 #include "SingleStreamingInput.h"
 
+#include <ffarawobjects/TpcRawHitv2.h>
+
 #include <array>
 #include <list>
 #include <map>
-#include <set>
 #include <string>
 #include <vector>
 
@@ -30,7 +33,7 @@ class SingleTpcPoolInput : public SingleStreamingInput
   void SetMaxTpcTimeSamples(const unsigned int i) { m_max_tpc_time_samples = i; }
   void ConfigureStreamingInputManager() override;
   void SetNegativeBco(const unsigned int value) { m_NegativeBco = value; }
-  const std::map<int, std::set<uint64_t>> &BclkStackMap() const override { return m_BclkStackPacketMap; }
+  const std::map<int, BcoWindow> &BclkStackMap() const override { return m_BclkStackPacketMap; }
 
  private:
   unsigned int m_NumSpecialEvents{0};
@@ -41,10 +44,12 @@ class SingleTpcPoolInput : public SingleStreamingInput
   //! map bco to packet
   std::map<unsigned int, uint64_t> m_packet_bco;
 
-  std::map<uint64_t, std::set<int>> m_BeamClockFEE;
+  BcoWindow m_BeamClockFEE;
   std::map<uint64_t, std::vector<TpcRawHit *>> m_TpcRawHitMap;
-  std::map<int, uint64_t> m_FEEBclkMap;
-  std::set<uint64_t> m_BclkStack;
+  //! owns the hits in m_TpcRawHitMap
+  RawHitArena<TpcRawHitv2> m_TpcRawHitArena{256};
+  FeeBcoMap m_FEEBclkMap;
+  BcoWindow m_BclkStack;
 };
 
 #endif
@@ -14,6 +14,7 @@
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/InputFileHandlerReturnCodes.h>
 
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>  // for PHTimer
 
 #include <TAxis.h>
@@ -32,8 +33,12 @@
 #include <Event/Eventiterator.h>
 #include <Event/fileEventiterator.h>
 
+#include <algorithm>
+#include <iterator>  // for prev
 #include <memory>
 #include <set>
+#include <utility>  // for pair
+#include <vector>
 
 SingleTpcTimeFrameInput::SingleTpcTimeFrameInput(const std::string &name)
   : SingleStreamingInput(name)
@@ -220,7 +225,7 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
     }
 
     TimeTracker getNextEventTimer(m_getNextEventTimer, "getNextEvent", m_hNorm);
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
+    std::unique_ptr<Event> evt(GetNextEvent());
     while (!evt)
     {
       fileclose();
@@ -229,7 +234,7 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
         AllDone(1);
         return;
       }
-      evt.reset(GetEventiterator()->getNextEvent());
+      evt.reset(GetNextEvent());
       RunNumber(0);
     }
 
@@ -270,24 +275,23 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
     getNextEventTimer.stop();
 
     TimeTracker ProcessPacketTimer(m_ProcessPacketTimer, "ProcessPacket", m_hNorm);
+
+    // create the builders for this event sequentially, then decode the packets
+    auto cleanup_packets = [&]()
+    {
+      for (int j = 0; j < npackets; ++j)
+      {
+        delete plist[j];
+        plist[j] = nullptr;
+      }
+    };
+
     for (int i = 0; i < npackets; i++)
     {
       // keep pointer to local packet
       auto &packet = plist[i];
       assert(packet);
 
-      auto cleanup_remaining_packets = [&](const int first_index)
-      {
-        for (int j = first_index; j < npackets; ++j)
-        {
-          if (plist[j])
-          {
-            delete plist[j];
-            plist[j] = nullptr;
-          }
-        }
-      };
-
       // get packet id
       const auto packet_id = packet->getIdentifier();
 
@@ -312,7 +316,7 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
                   << " to " << hit_format << ". Aborting run." << std::endl;
         packet->identify();
         m_FillPoolStatus = Fun4AllReturnCodes::ABORTRUN;
-        cleanup_remaining_packets(i);
+        cleanup_packets();
         return;
       }
 
@@ -343,7 +347,7 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
                     << " for packet id " << packet_id << ". Aborting run." << std::endl;
           packet->identify();
           m_FillPoolStatus = Fun4AllReturnCodes::ABORTRUN;
-          cleanup_remaining_packets(i);
+          cleanup_packets();
           return;
         }
 
@@ -360,27 +364,14 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
           m_TpcTimeFrameBuilderMap[packet_id]->SaveBXCounterSyncCDBTTree(m_bxCounterSyncCDBTTreeName);
         }
       }
-
-      if (Verbosity() > 1)
-      {
-        packet->identify();
-      }
-
-      assert(m_TpcTimeFrameBuilderMap[packet_id]);
-      const int process_packet_status = m_TpcTimeFrameBuilderMap[packet_id]->ProcessPacket(packet);
-      if (process_packet_status < 0)
-      {
-        std::cout << __PRETTY_FUNCTION__ << ": Error : TPC packet builder returned " << process_packet_status
-                  << " for packet id " << packet_id << ". Aborting run." << std::endl;
-        m_FillPoolStatus = process_packet_status;
-        cleanup_remaining_packets(i);
-        return;
-      }
-      // require_more_data = require_more_data or m_TpcTimeFrameBuilderMap[packet_id]->isMoreDataRequired(targetBCO);
-
-      delete packet;
-      packet = nullptr;
     }  //     for (int i = 0; i < npackets; i++)
+
+    const int process_packet_status = ProcessPackets(npackets);
+    if (process_packet_status < 0)
+    {
+      m_FillPoolStatus = process_packet_status;
+      return;
+    }
     ProcessPacketTimer.stop();
 
   }  // while (require_more_data)
@@ -400,6 +391,81 @@ void SingleTpcTimeFrameInput::FillPool(const uint64_t targetBCO)
   TimeTracker getTimeFrameTimer(m_getTimeFrameTimer, "getTimeFrame", m_hNorm);
 }
 
+int SingleTpcTimeFrameInput::ProcessPackets(const int npackets)
+{
+  // group packets by builder, keeping their order. Builders are independent
+  std::vector<std::pair<TpcTimeFrameBuilderBase *, std::vector<int>>> jobs;
+  for (int i = 0; i < npackets; i++)
+  {
+    if (!plist[i])
+    {
+      continue;
+    }
+    TpcTimeFrameBuilderBase *builder = m_TpcTimeFrameBuilderMap[plist[i]->getIdentifier()];
+    assert(builder);
+    auto job = std::find_if(jobs.begin(), jobs.end(), [builder](const auto &j)
+                            { return j.first == builder; });
+    if (job == jobs.end())
+    {
+      jobs.emplace_back(builder, std::vector<int>());
+      job = std::prev(jobs.end());
+    }
+    job->second.push_back(i);
+  }
+
+  std::vector<int> status(npackets, 0);
+  auto process = [this, &jobs, &status](std::size_t ijob, unsigned int /*worker*/)
+  {
+    for (const int i : jobs[ijob].second)
+    {
+      if (Verbosity() > 1)
+      {
+        plist[i]->identify();
+      }
+      status[i] = jobs[ijob].first->ProcessPacket(plist[i]);
+      if (status[i] < 0)
+      {
+        break;
+      }
+    }
+  };
+
+  // the digital current debug TTrees of all builders share the same output file
+  if (m_NThreads == 1 || jobs.size() < 2 || !m_digitalCurrentDebugTTreeName.empty())
+  {
+    for (std::size_t ijob = 0; ijob < jobs.size(); ++ijob)
+    {
+      process(ijob, 0);
+    }
+  }
+  else
+  {
+    if (!m_ThreadPool)
+    {
+      m_ThreadPool = std::make_unique<PHThreadPool>(m_NThreads);
+      if (Verbosity() > 0)
+      {
+        std::cout << PHWHERE << Name() << " using " << m_ThreadPool->size() << " threads to decode packets" << std::endl;
+      }
+    }
+    m_ThreadPool->parallel_for(jobs.size(), process);
+  }
+
+  int result = 0;
+  for (int i = 0; i < npackets; i++)
+  {
+    if (status[i] < 0 && result == 0)
+    {
+      std::cout << __PRETTY_FUNCTION__ << ": Error : TPC packet builder returned " << status[i]
+                << " for packet id " << plist[i]->getIdentifier() << ". Aborting run." << std::endl;
+      result = status[i];
+    }
+    delete plist[i];
+    plist[i] = nullptr;
+  }
+  return result;
+}
+
 void SingleTpcTimeFrameInput::Print(const std::string & /*what*/) const
 {
 }
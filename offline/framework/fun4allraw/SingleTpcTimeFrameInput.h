@@ -6,12 +6,14 @@
 #include <array>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 class TpcRawHit;
 class Packet;
+class PHThreadPool;
 class TpcTimeFrameBuilderBase;
 class PHTimer;
 class TH1;
@@ -38,6 +40,10 @@ class SingleTpcTimeFrameInput : public SingleStreamingInput
 
   void AddPacketID(const int packetID) { m_SelectedPacketIDs.insert(packetID); }
 
+  //! number of threads used to decode the packets of an event, one builder per thread.
+  /*! 1 (default) decodes sequentially, 0 uses one thread per hardware thread */
+  void SetNThreads(const unsigned int n) { m_NThreads = n; }
+
   void setDigitalCurrentDebugTTreeName(const std::string &name)
   {
     m_digitalCurrentDebugTTreeName = name;
@@ -59,6 +65,10 @@ class SingleTpcTimeFrameInput : public SingleStreamingInput
   unsigned int m_BcoRange{0};
   unsigned int m_NegativeBco{0};
 
+  //! decode the packets of an event, concurrently for different builders.
+  /*! returns the status of the first failing packet, or 0. All packets are deleted */
+  int ProcessPackets(const int npackets);
+
   //! packet ID -> TimeFrame builder
   std::map<int, TpcTimeFrameBuilderBase *> m_TpcTimeFrameBuilderMap;
   std::map<int, int> m_TpcTimeFrameBuilderHitFormatMap;
@@ -87,6 +97,10 @@ class SingleTpcTimeFrameInput : public SingleStreamingInput
   };
 
   int m_FillPoolStatus{0};
+
+  unsigned int m_NThreads{1};
+  std::unique_ptr<PHThreadPool> m_ThreadPool;
+
   std::string m_digitalCurrentDebugTTreeName;
   std::string m_bxCounterSyncCDBTTreeName;
 };
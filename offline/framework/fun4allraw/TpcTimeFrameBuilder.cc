@@ -24,6 +24,7 @@
 #include <TTree.h>
 #include <TVector3.h>
 
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <limits>
@@ -413,8 +414,7 @@ void TpcTimeFrameBuilder::CleanupUsedPackets(const uint64_t& bclk)
 
 int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 {
-  static size_t call_count = 0;
-  ++call_count;
+  ++m_call_count;
 
   if (m_verbosity > 1)
   {
@@ -492,7 +492,7 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
   }
 
   assert(m_packetTimer);
-  if ((m_verbosity == 1 && (call_count % 1000) == 0) || (m_verbosity > 1))
+  if ((m_verbosity == 1 && (m_call_count % 1000) == 0) || (m_verbosity > 1))
   {
     std::cout << __PRETTY_FUNCTION__ << "\t- : received packet ";
     packet->identify();
@@ -607,10 +607,7 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 
       if (fee_id < MAX_FEECOUNT)
       {
-        for (const uint16_t& i : dma_word_data.data)
-        {
-          m_feeData[fee_id].push_back(i);
-        }
+        m_feeData[fee_id].push(dma_word_data.data, DAM_DMA_WORD_LENGTH - 1);
         m_hNorm->Fill("DMA_WORD_FEE", 1);
 
         // immediate fee buffer processing to reduce memory consuption
@@ -659,7 +656,7 @@ int TpcTimeFrameBuilder::ProcessPacket(Packet* packet)
 
   m_packetTimer->stop();
   assert(h_ProcessPacket_Time);
-  h_ProcessPacket_Time->Fill(call_count, m_packetTimer->elapsed());
+  h_ProcessPacket_Time->Fill(m_call_count, m_packetTimer->elapsed());
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -674,7 +671,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
   }
 
   assert(fee < m_feeData.size());
-  std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  FeeDataBuffer& data_buffer = m_feeData[fee];
 
   while (HEADER_LENGTH <= data_buffer.size())
   {
@@ -703,7 +700,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
           std::cout << __PRETTY_FUNCTION__ << "\t- : Error : Invalid FEE magic key at position 1 0x" << std::hex << data_buffer[1] << std::dec << std::endl;
         }
         m_hFEEDataStream->Fill(fee, "WordSkipped", 1);
-        data_buffer.pop_front();
+        data_buffer.pop(1);
         continue;
       }
       assert(data_buffer[1] == FEE_PACKET_MAGIC_KEY_1);
@@ -715,7 +712,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
           std::cout << __PRETTY_FUNCTION__ << "\t- : Error : Invalid FEE magic key at position 2 0x" << std::hex << data_buffer[2] << std::dec << std::endl;
         }
         m_hFEEDataStream->Fill(fee, "WordSkipped", 1);
-        data_buffer.pop_front();
+        data_buffer.pop(1);
         continue;
       }
       assert(data_buffer[2] == FEE_PACKET_MAGIC_KEY_2);
@@ -730,7 +727,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
         std::cout << __PRETTY_FUNCTION__ << "\t- : Error : Invalid FEE pkt_length " << pkt_length << std::endl;
       }
       m_hFEEDataStream->Fill(fee, "InvalidLength", 1);
-      data_buffer.pop_front();
+      data_buffer.pop(1);
       continue;
     }
 
@@ -749,13 +746,13 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
 
     if (is_digital_current)
     {
-      process_fee_data_digital_current(fee, data_buffer);
+      process_fee_data_digital_current(fee, data_buffer.data());
     }
     else
     {
-      process_fee_data_waveform(fee, data_buffer);
+      process_fee_data_waveform(fee, data_buffer.data());
     }
-    data_buffer.erase(data_buffer.begin(), data_buffer.begin() + pkt_length + 1);
+    data_buffer.pop(pkt_length + 1);
     m_hFEEDataStream->Fill(fee, "WordValid", pkt_length + 1);
 
   }  //     while (HEADER_LENGTH < data_buffer.size())
@@ -763,7 +760,7 @@ int TpcTimeFrameBuilder::process_fee_data(unsigned int fee)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, const uint16_t* data_buffer)
 {
   const uint16_t& pkt_length = data_buffer[0];
 
@@ -782,7 +779,7 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
 
   if (!m_fastBCOSkip)
   {
-    auto crc_parity = crc16_parity(fee, pkt_length);
+    auto crc_parity = crc16_parity(data_buffer, pkt_length);
     payload.calc_crc = crc_parity.first;
     payload.calc_parity = crc_parity.second;
 
@@ -924,16 +921,10 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
 
     // Format is (N sample) (start time), (1st sample)... (Nth sample)
     size_t pos = HEADER_LENGTH;
-    std::deque<uint16_t>::const_iterator data_buffer_iterator = data_buffer.cbegin();
-    std::advance(data_buffer_iterator, pos);
     while (pos + 2 < pkt_length)
     {
-      const uint16_t& nsamp = *data_buffer_iterator;
-      ++pos;
-      ++data_buffer_iterator;
-      const uint16_t& start_t = *data_buffer_iterator;
-      ++pos;
-      ++data_buffer_iterator;
+      const uint16_t& nsamp = data_buffer[pos++];
+      const uint16_t& start_t = data_buffer[pos++];
       if (m_verbosity > 3)
       {
         std::cout << __PRETTY_FUNCTION__ << ": nsamp: " << nsamp
@@ -961,18 +952,13 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
       }
 
       const unsigned int fee_sampa_address = fee * MAX_SAMPA + payload.sampa_address;
-      std::vector<uint16_t> adc(nsamp);
+      const uint16_t* adc = data_buffer + pos;
       for (int j = 0; j < nsamp; j++)
       {
-        const uint16_t& adc_value = *data_buffer_iterator;
-
-        adc[j] = adc_value;
-        m_hFEESAMPAADC->Fill(start_t + j, fee_sampa_address, adc_value);
-
-        ++pos;
-        ++data_buffer_iterator;  // data_buffer[pos++];
+        m_hFEESAMPAADC->Fill(start_t + j, fee_sampa_address, adc[j]);
       }
-      payload.waveforms.emplace_back(start_t, std::move(adc));
+      payload.waveforms.push_back({start_t, nsamp, adc});
+      pos += nsamp;
 
       //   // an exception to deal with the last sample that is missing in the current hit format
       //   if (pos + 1 == pkt_length) break;
@@ -1005,9 +991,9 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
       // hit->set_parity(payload.data_parity);
       hit->set_parityerror(payload.data_parity != payload.calc_parity);
 
-      for (std::pair<uint16_t, std::vector<uint16_t>>& waveform : payload.waveforms)
+      for (const fee_payload::waveform_span& waveform : payload.waveforms)
       {
-        hit->move_adc_waveform(waveform.first, std::move(waveform.second));
+        hit->move_adc_waveform(waveform.start_t, std::vector<uint16_t>(waveform.adc, waveform.adc + waveform.nsamp));
       }
     }
   }  //     if (not m_fastBCOSkip)
@@ -1015,7 +1001,7 @@ void TpcTimeFrameBuilder::process_fee_data_waveform(const unsigned int& fee, std
   return;
 }
 
-void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int& fee, std::deque<uint16_t>& data_buffer)
+void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int& fee, const uint16_t* data_buffer)
 {
   if (m_verbosity > 2)
   {
@@ -1068,7 +1054,7 @@ void TpcTimeFrameBuilder::process_fee_data_digital_current(const unsigned int& f
   }
 
   payload.data_crc = data_buffer[pkt_length];
-  auto crc_parity = crc16_parity(fee, pkt_length);
+  auto crc_parity = crc16_parity(data_buffer, pkt_length);
   payload.calc_crc = crc_parity.first;
   // payload.calc_parity = crc_parity.second;
 
@@ -1258,86 +1244,68 @@ int TpcTimeFrameBuilder::decode_gtm_data(const TpcTimeFrameBuilder::dma_word& gt
   return 0;
 }
 
-uint16_t TpcTimeFrameBuilder::reverseBits(const uint16_t x) const
-{
-  uint16_t n = x;
-  n = (static_cast<uint16_t>(n >> 1U) & 0x55555555U) | (static_cast<uint16_t>(n << 1U) & 0xaaaaaaaaU);
-  n = (static_cast<uint16_t>(n >> 2U) & 0x33333333U) | (static_cast<uint16_t>(n << 2U) & 0xccccccccU);
-  n = (static_cast<uint16_t>(n >> 4U) & 0x0f0f0f0fU) | (static_cast<uint16_t>(n << 4U) & 0xf0f0f0f0U);
-  n = (static_cast<uint16_t>(n >> 8U) & 0x00ff00ffU) | (static_cast<uint16_t>(n << 8U) & 0xff00ff00U);
-  // n = (n >> 16U) & 0x0000ffffU | (n << 16U) & 0xffff0000U;
-  return n;
-}
-
-std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const uint32_t fee, const uint16_t l) const
+namespace
 {
-  const std::deque<uint16_t>& data_buffer = m_feeData[fee];
-  assert(l < data_buffer.size());
-
-  std::deque<uint16_t>::const_iterator it = data_buffer.begin();
-
-  uint16_t crc = 0xffffU;
-  uint16_t data_parity = 0U;
-
-  for (int i = 0; i < l; ++i, ++it)
+  // one CRC16 step over a 16 bit word, polynomial 0x8005, msb first.
+  // This is the bit reversed equivalent of the FEE CRC, which runs the reflected polynomial 0xa001
+  // over bit reversed words, so that neither data nor result need to be reversed
+  constexpr uint16_t crc16_word(uint16_t v)
   {
-    const uint16_t& x = *it;
-
-    crc ^= reverseBits(x);
-    for (uint16_t k = 0; k < 16U; k++)
-    {
-      crc = crc & 1U ? static_cast<uint16_t>(crc >> 1U) ^ 0xa001U : crc >> 1U;
-    }
-
-    // parity on data payload only
-    if (i >= HEADER_LENGTH)
+    for (int k = 0; k < 16; ++k)
     {
-      // fast parity
-      uint16_t word = x & uint16_t((1U << 10U) - 1U);
-      word = word ^ static_cast<uint16_t>(word >> 1U);
-      word = word ^ static_cast<uint16_t>(word >> 2U);
-      word = word ^ static_cast<uint16_t>(word >> 4U);
-      word = word ^ static_cast<uint16_t>(word >> 8U);
-      data_parity ^= word & 1U;
+      v = (v & 0x8000U) ? static_cast<uint16_t>(static_cast<uint16_t>(v << 1U) ^ 0x8005U) : static_cast<uint16_t>(v << 1U);
     }
+    return v;
   }
-  crc = reverseBits(crc);
-  return std::make_pair(crc, data_parity);
-}
 
-namespace
-{
-  // streamer for lists
-  template <class T>
-  std::ostream& operator<<(std::ostream& o, const std::list<T>& list)
+  // the step is linear in the crc register, so it splits into one table lookup per byte
+  struct crc16_tables
   {
-    if (list.empty())
-    {
-      o << "{}";
-    }
-    else
+    std::array<uint16_t, 256> high{};
+    std::array<uint16_t, 256> low{};
+
+    constexpr crc16_tables()
     {
-      const bool is_hex = (o.flags() & std::ios_base::hex);
-      o << "{ ";
-      bool first = true;
-      for (const auto& value : list)
+      for (uint16_t b = 0; b < 256; ++b)
       {
-        if (!first)
-        {
-          o << ", ";
-        }
-        if (is_hex)
-        {
-          o << "0x";
-        }
-        o << value;
-        first = false;
+        high[b] = crc16_word(static_cast<uint16_t>(b << 8U));
+        low[b] = crc16_word(b);
       }
-      o << "\t- }";
     }
-    return o;
+  };
+
+  constexpr crc16_tables CRC16_TABLES;
+}  // namespace
+
+std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const uint16_t* data, const uint16_t l)
+{
+  uint16_t crc = 0xffffU;
+  for (int i = 0; i < l; ++i)
+  {
+    const uint16_t v = crc ^ data[i];
+    crc = CRC16_TABLES.high[v >> 8U] ^ CRC16_TABLES.low[v & 0xffU];
+  }
+
+  // parity on data payload only.
+  // The parity of all words is the parity of their xor, which vectorizes
+  uint16_t word = 0;
+  for (int i = HEADER_LENGTH; i < l; ++i)
+  {
+    word ^= data[i];
   }
+  word &= uint16_t((1U << 10U) - 1U);
+  word = word ^ static_cast<uint16_t>(word >> 1U);
+  word = word ^ static_cast<uint16_t>(word >> 2U);
+  word = word ^ static_cast<uint16_t>(word >> 4U);
+  word = word ^ static_cast<uint16_t>(word >> 8U);
+  const uint16_t data_parity = word & 1U;
+
+  return std::make_pair(crc, data_parity);
+}
 
+namespace
+{
+  // streamer for vectors
   template <class T>
   std::ostream& operator<<(std::ostream& o, const std::vector<T>& list)
   {
@@ -1506,12 +1474,6 @@ bool TpcTimeFrameBuilder::BcoMatchingInformation::isMoreDataRequired(const uint6
               << " as their is NO m_bco_reference nor m_bco_reference_candidate_list"
               << std::endl;
 
-    std::cout << "  m_gtm_bco_trigger_map:" << std::endl;
-    for (const auto& trig : m_gtm_bco_trigger_map)
-    {
-      std::cout << " - 0x" << std::hex << trig.first << std::dec << "(Diff = " << trig.first - bco_correction << ") " << std::endl;
-    }
-
     std::cout << "  m_bco_matching_list:" << std::endl;
     for (const auto& trig : m_bco_matching_list)
     {
@@ -1553,7 +1515,7 @@ void TpcTimeFrameBuilder::BcoMatchingInformation::print_gtm_bco_information() co
     // also print predicted fee bco
     if (is_verified())
     {
-      std::list<uint32_t> fee_bco_predicted_list;
+      std::vector<uint32_t> fee_bco_predicted_list;
       std::transform(
           m_gtm_bco_trig_list.begin(),
           m_gtm_bco_trig_list.end(),
@@ -1687,7 +1649,7 @@ void TpcTimeFrameBuilder::BcoMatchingInformation::save_gtm_bco_information(const
         }
       }
 
-      while (m_bco_reference_candidate_list.size() > m_max_bco_reference_candidate_list_size)
+      if (m_bco_reference_candidate_list.size() > m_max_bco_reference_candidate_list_size)
       {
         if (m_verbosity > 1)
         {
@@ -1701,7 +1663,9 @@ void TpcTimeFrameBuilder::BcoMatchingInformation::save_gtm_bco_information(const
                     << std::endl;
         }
 
-        m_bco_reference_candidate_list.pop_front();
+        m_bco_reference_candidate_list.erase(
+            m_bco_reference_candidate_list.begin(),
+            m_bco_reference_candidate_list.end() - m_max_bco_reference_candidate_list_size);
       }
 
     }  //     if (modebits & (1U << ELINK_HEARTBEAT_T))
@@ -1832,12 +1796,13 @@ std::optional<uint64_t> TpcTimeFrameBuilder::BcoMatchingInformation::find_refere
         }
       }
 
-      // remove the older candidate from the list
-      while (m_bco_reference_candidate_list.begin()->first != gtm_bco)
-      {
-        m_bco_reference_candidate_list.pop_front();
-      }
-      m_bco_reference_candidate_list.pop_front();
+      // remove the older candidates from the list, together with the matched one
+      const auto matched = std::find_if(
+          m_bco_reference_candidate_list.begin(),
+          m_bco_reference_candidate_list.end(),
+          [gtm_bco](const m_gtm_fee_bco_matching_pair_t& pair)
+          { return pair.first == gtm_bco; });
+      m_bco_reference_candidate_list.erase(m_bco_reference_candidate_list.begin(), std::next(matched));
 
       if (m_verbosity > 1)
       {
@@ -2036,13 +2001,13 @@ std::optional<uint64_t> TpcTimeFrameBuilder::BcoMatchingInformation::find_gtm_bc
 void TpcTimeFrameBuilder::BcoMatchingInformation::cleanup()
 {
   // remove old gtm_bco and matching
-  while (m_gtm_bco_trig_list.size() > m_max_matching_data_size)
+  if (m_gtm_bco_trig_list.size() > m_max_matching_data_size)
   {
-    m_gtm_bco_trig_list.pop_front();
+    m_gtm_bco_trig_list.erase(m_gtm_bco_trig_list.begin(), m_gtm_bco_trig_list.end() - m_max_matching_data_size);
   }
-  while (m_bco_matching_list.size() > m_max_matching_data_size)
+  if (m_bco_matching_list.size() > m_max_matching_data_size)
   {
-    m_bco_matching_list.pop_front();
+    m_bco_matching_list.erase(m_bco_matching_list.begin(), m_bco_matching_list.end() - m_max_matching_data_size);
   }
 
   // clear orphans
@@ -2053,10 +2018,9 @@ void TpcTimeFrameBuilder::BcoMatchingInformation::cleanup()
 void TpcTimeFrameBuilder::BcoMatchingInformation::cleanup(uint64_t ref_bco)
 {
   // erase all elements from bco_list that are less than or equal to ref_bco
-  m_gtm_bco_trig_list.erase(std::remove_if(m_gtm_bco_trig_list.begin(), m_gtm_bco_trig_list.end(),
-                                           [ref_bco](const uint64_t& bco)
-                                           { return bco <= ref_bco; }),
-                            m_gtm_bco_trig_list.end());
+  // the list is sorted in time, so these are at the front
+  m_gtm_bco_trig_list.erase(m_gtm_bco_trig_list.begin(),
+                            std::upper_bound(m_gtm_bco_trig_list.begin(), m_gtm_bco_trig_list.end(), ref_bco));
 
   // erase all elements from bco_list that are less than or equal to ref_bco
   m_bco_matching_list.erase(std::remove_if(m_bco_matching_list.begin(), m_bco_matching_list.end(),
@@ -5,11 +5,9 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <deque>
 #include <functional>
 #include <iostream>
 #include <limits>
-#include <list>
 #include <map>
 #include <optional>
 #include <queue>
@@ -74,8 +72,8 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
 
   int m_hitFormat = -1;
 
-  uint16_t reverseBits(const uint16_t x) const;
-  std::pair<uint16_t, uint16_t> crc16_parity(const uint32_t fee, const uint16_t l) const;
+  //! CRC16 and parity of the first l words of a FEE packet
+  static std::pair<uint16_t, uint16_t> crc16_parity(const uint16_t *data, const uint16_t l);
 
   //! DMA word structure
   struct dma_word
@@ -84,10 +82,77 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
     uint16_t data[DAM_DMA_WORD_LENGTH - 1] = {0};
   };
 
+  //! fixed capacity buffer of the data words received from one FEE
+  /*!
+   * words are kept contiguous, so that packets are decoded in place.
+   * When the end of the storage is reached, the unread words, at most one
+   * incomplete packet, are moved back to the front.
+   */
+  class FeeDataBuffer
+  {
+   public:
+    //! number of words. Must hold the longest packet plus one DMA word
+    static const size_t CAPACITY = 4096;
+
+    FeeDataBuffer()
+      : m_data(CAPACITY)
+    {
+    }
+
+    //! append words
+    void push(const uint16_t *words, const size_t n)
+    {
+      if (m_end + n > CAPACITY)
+      {
+        compact();
+      }
+      if (m_end + n > CAPACITY)
+      {
+        // cannot happen as long as the buffer is processed after each DMA word
+        std::cout << "TpcTimeFrameBuilder::FeeDataBuffer::push - Error: buffer overflow, dropping "
+                  << m_end + n - CAPACITY << " words" << std::endl;
+        pop(m_end + n - CAPACITY);
+        compact();
+      }
+      std::copy(words, words + n, m_data.begin() + m_end);
+      m_end += n;
+    }
+
+    //! remove the first n words
+    void pop(const size_t n)
+    {
+      m_begin = std::min(m_begin + n, m_end);
+      if (m_begin == m_end)
+      {
+        m_begin = m_end = 0;
+      }
+    }
+
+    //! first unread word
+    const uint16_t *data() const { return m_data.data() + m_begin; }
+    uint16_t operator[](const size_t i) const { return m_data[m_begin + i]; }
+    size_t size() const { return m_end - m_begin; }
+    bool empty() const { return m_begin == m_end; }
+
+   private:
+    void compact()
+    {
+      std::copy(m_data.begin() + m_begin, m_data.begin() + m_end, m_data.begin());
+      m_end -= m_begin;
+      m_begin = 0;
+    }
+
+    std::vector<uint16_t> m_data;
+    size_t m_begin = 0;
+    size_t m_end = 0;
+  };
+
   int decode_gtm_data(const dma_word &gtm_word);
   int process_fee_data(unsigned int fee_id);
-  void process_fee_data_waveform(const unsigned int &fee_id, std::deque<uint16_t> &data_buffer);
-  void process_fee_data_digital_current(const unsigned int &fee_id, std::deque<uint16_t> &data_buffer);
+
+  //! decode one packet, read in place from the FEE buffer. data[0] is the packet length
+  void process_fee_data_waveform(const unsigned int &fee_id, const uint16_t *data_buffer);
+  void process_fee_data_digital_current(const unsigned int &fee_id, const uint16_t *data_buffer);
 
   struct gtm_payload
   {
@@ -121,7 +186,14 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
     uint16_t data_parity = 0;
     uint16_t calc_parity = 0;
 
-    std::vector<std::pair<uint16_t, std::vector<uint16_t>>> waveforms;
+    //! waveform samples, pointing into the FEE buffer
+    struct waveform_span
+    {
+      uint16_t start_t = 0;
+      uint16_t nsamp = 0;
+      const uint16_t *adc = nullptr;
+    };
+    std::vector<waveform_span> waveforms;
   };
 
   struct digital_current_payload
@@ -315,8 +387,8 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
 
     bool m_verified_from_data = false;
 
-    //! list of available bco, sorted in time with rollover corrected
-    std::list<uint64_t> m_gtm_bco_trig_list;
+    //! available bco, sorted in time with rollover corrected
+    std::vector<uint64_t> m_gtm_bco_trig_list;
 
     //! last digital current readout GTM BCO
     m_gtm_fee_bco_matching_pair_t m_gtm_bco_dc_read = {0, 0};
@@ -326,17 +398,15 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
 
     // std::optional< std::pair< uint64_t, uint32_t > > m_bco_reference_candidate = std::nullopt;
     //! not yet matched heart beats
-    std::list<m_gtm_fee_bco_matching_pair_t> m_bco_reference_candidate_list;
+    std::vector<m_gtm_fee_bco_matching_pair_t> m_bco_reference_candidate_list;
     static constexpr unsigned int m_max_bco_reference_candidate_list_size = 16;
 
     // //! list of heart beat GTM BCO that is still to be matched
     // std::queue<uint64_t> m_heartbeat_gtm_bco_queue;
     // static constexpr unsigned int m_max_heartbeat_queue_size = 16;
 
-    //! list of available GTM -> FEE bco mapping for trigger association
-    std::map<uint64_t, uint32_t> m_gtm_bco_trigger_map;
-
-    std::list<m_fee_gtm_bco_matching_pair_t> m_bco_matching_list;
+    //! FEE -> GTM bco mapping for trigger association, in order of matching
+    std::vector<m_fee_gtm_bco_matching_pair_t> m_bco_matching_list;
 
     //! keep track or  fee_bco for which no gtm_bco is found
     std::set<uint32_t> m_orphans;
@@ -374,7 +444,7 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
   };  //   class BcoMatchingInformation
 
  private:
-  std::vector<std::deque<uint16_t>> m_feeData;
+  std::vector<FeeDataBuffer> m_feeData;
 
   std::map<int, std::set<int>> m_maskedFEEs;
 
@@ -401,6 +471,9 @@ class TpcTimeFrameBuilder : public TpcTimeFrameBuilderBase
 
   PHTimer *m_packetTimer = nullptr;
 
+  //! number of processed packets. Per builder, so that builders can run in separate threads
+  size_t m_call_count = 0;
+
   TH1 *m_hNorm = nullptr;
   TH2 *m_hFEEDataStream = nullptr;
   TH1 *m_hFEEChannelPacketCount = nullptr;
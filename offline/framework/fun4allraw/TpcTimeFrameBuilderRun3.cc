@@ -1260,8 +1260,7 @@ void TpcTimeFrameBuilderRun3::CleanupUsedPackets(const uint64_t& bclk)
 
 int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
 {
-  static size_t call_count = 0;
-  ++call_count;
+  ++m_call_count;
 
   if (m_verbosity > 1)
   {
@@ -1312,7 +1311,7 @@ int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
   }
 
   assert(m_packetTimer);
-  if ((m_verbosity == 1 && (call_count % 1000) == 0) || (m_verbosity > 1))
+  if ((m_verbosity == 1 && (m_call_count % 1000) == 0) || (m_verbosity > 1))
   {
     std::cout << __PRETTY_FUNCTION__ << "\t- : received packet ";
     packet->identify();
@@ -1564,7 +1563,7 @@ int TpcTimeFrameBuilderRun3::ProcessPacket(Packet* packet)
 
   m_packetTimer->stop();
   assert(h_ProcessPacket_Time);
-  h_ProcessPacket_Time->Fill(call_count, m_packetTimer->elapsed());
+  h_ProcessPacket_Time->Fill(m_call_count, m_packetTimer->elapsed());
 
   // Track final buffer usage at end of ProcessPacket
   if (m_verbosity >= 1)
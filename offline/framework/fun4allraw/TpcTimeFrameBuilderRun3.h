@@ -489,6 +489,9 @@ class TpcTimeFrameBuilderRun3 : public TpcTimeFrameBuilderBase
 
   PHTimer *m_packetTimer = nullptr;
 
+  //! number of processed packets. Per builder, so that builders can run in separate threads
+  size_t m_call_count = 0;
+
   TH1 *m_hNorm = nullptr;
   TH2 *m_hFEEDataStream = nullptr;
   TH1 *m_hFEEChannelPacketCount = nullptr;
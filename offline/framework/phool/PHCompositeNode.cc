@@ -51,7 +51,9 @@ bool PHCompositeNode::addNode(PHNode* newNode)
   // No conflict, so we can append the new node.
   //
   newNode->setParent(this);
-  return (subNodes.append(newNode));
+  bool success = subNodes.append(newNode);
+  subTreeChanged();
+  return success;
 }
 
 void PHCompositeNode::prune()
@@ -79,6 +81,7 @@ void PHCompositeNode::forgetMe(PHNode* child)
   // do not remove the child from the list,
   // otherwise the clearanddestroy() bookkeeping gets
   // confused and deletes only every other node
+  subTreeChanged();
   if (deleteMe)
   {
     return;
@@ -126,3 +129,51 @@ void PHCompositeNode::print(const std::string& path)
     thisNode->print(newPath);
   }
 }
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void PHCompositeNode::subTreeChanged()
+{
+  ++subTreeVersion;
+  if (parent)
+  {
+    parent->subTreeChanged();
+  }
+}
+
+PHNode* PHCompositeNode::lookup(const std::string& nodename)
+{
+  std::lock_guard<std::mutex> lock(indexMutex);
+  updateIndex();
+  auto iter = nodeIndex.find(nodename);
+  return (iter == nodeIndex.end()) ? nullptr : iter->second;
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void PHCompositeNode::updateIndex()
+{
+  // called with indexMutex locked
+  const unsigned long version = subTreeVersion;
+  if (indexVersion == version)
+  {
+    return;
+  }
+
+  // each sub-node is followed by the index of its own sub-tree, updated first if needed.
+  // Existing entries are never overwritten, so the first node of a given name
+  // in depth first order is kept
+  nodeIndex.clear();
+  PHPointerListIterator<PHNode> nodeIter(subNodes);
+  PHNode* thisNode;
+  while ((thisNode = nodeIter()))
+  {
+    nodeIndex.emplace(thisNode->getName(), thisNode);
+    if (thisNode->getType() == "PHCompositeNode")
+    {
+      auto* subTree = dynamic_cast<PHCompositeNode*>(thisNode);
+      std::lock_guard<std::mutex> lock(subTree->indexMutex);
+      subTree->updateIndex();
+      nodeIndex.insert(subTree->nodeIndex.begin(), subTree->nodeIndex.end());
+    }
+  }
+  indexVersion = version;
+}
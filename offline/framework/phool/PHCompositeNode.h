@@ -7,7 +7,10 @@
 #include "PHNode.h"
 #include "PHPointerList.h"
 
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 class PHIOManager;
 
@@ -37,6 +40,22 @@ class PHCompositeNode : public PHNode
   void print(const std::string & = "") override;
   bool write(PHIOManager *, const std::string & = "") override;
 
+  //
+  // First node with the given name in the sub-tree, in the same
+  // (depth first) order as a recursive search. Uses a name index
+  // which is rebuilt after the sub-tree changed. Only the indices of the
+  // changed node's parents are rebuilt, the ones of unchanged sub-trees are reused
+  //
+  PHNode *lookup(const std::string &);
+
+  //
+  // Incremented whenever a node is added, removed or renamed in the sub-tree.
+  // The node tree is only modified from the main thread, the version can be
+  // read from any thread
+  //
+  unsigned long treeVersion() const { return subTreeVersion; }
+  void subTreeChanged() override;
+
  protected:
   void forgetMe(PHNode *) override;
   PHPointerList<PHNode> subNodes;
@@ -44,6 +63,12 @@ class PHCompositeNode : public PHNode
 
  private:
   PHCompositeNode() = delete;
+  void updateIndex();
+
+  std::unordered_map<std::string, PHNode *> nodeIndex;
+  std::atomic<unsigned long> subTreeVersion{1};
+  unsigned long indexVersion = 0;
+  std::mutex indexMutex;
 };
 
 #endif
@@ -32,10 +32,21 @@ class PHNode
   const std::string &getName() const { return name; }
   const std::string &getClass() const { return objectclass; }
   void setParent(PHNode *p) { parent = p; }
-  void setName(const std::string &n) { name = n; }
+  void setName(const std::string &n)
+  {
+    name = n;
+    if (parent)
+    {
+      parent->subTreeChanged();
+    }
+  }
   void setObjectType(const std::string &n) { objecttype = n; }
   void makeTransient() { persistent = false; }
 
+  // called when a node below this one is added, removed or renamed.
+  // Composite nodes invalidate their name index and pass it on to their parent
+  virtual void subTreeChanged() {}
+
  protected:
   PHNode *parent{nullptr};
   bool persistent{true};
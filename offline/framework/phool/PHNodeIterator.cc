@@ -42,39 +42,25 @@ void PHNodeIterator::print()
   currentNode->print();
 }
 
-// NOLINTNEXTLINE(misc-no-recursion)
 PHNode* PHNodeIterator::findFirst(const std::string& requiredType, const std::string& requiredName)
 {
-  PHPointerListIterator<PHNode> iter(currentNode->subNodes);
-  PHNode* thisNode;
-  while ((thisNode = iter()))
+  // the indexed lookup gives the answer unless an earlier node of the same name has another type
+  PHNode* firstNode = currentNode->lookup(requiredName);
+  if (!firstNode || firstNode->getType() == requiredType)
   {
-    if (thisNode->getType() == requiredType && thisNode->getName() == requiredName)
-    {
-      return thisNode;
-    }
-
-    if (thisNode->getType() == "PHCompositeNode")
-    {
-      PHNodeIterator nodeIter(dynamic_cast<PHCompositeNode*>(thisNode));
-      PHNode* nodeFoundInSubTree = nodeIter.findFirst(requiredType, requiredName);
-      if (nodeFoundInSubTree)
-      {
-        return nodeFoundInSubTree;
-      }
-    }
+    return firstNode;
   }
-  return nullptr;
+  return findFirstOfType(requiredType, requiredName);
 }
 
 // NOLINTNEXTLINE(misc-no-recursion)
-PHNode* PHNodeIterator::findFirst(const std::string& requiredName)
+PHNode* PHNodeIterator::findFirstOfType(const std::string& requiredType, const std::string& requiredName)
 {
   PHPointerListIterator<PHNode> iter(currentNode->subNodes);
   PHNode* thisNode;
   while ((thisNode = iter()))
   {
-    if (thisNode->getName() == requiredName)
+    if (thisNode->getType() == requiredType && thisNode->getName() == requiredName)
     {
       return thisNode;
     }
@@ -82,7 +68,7 @@ PHNode* PHNodeIterator::findFirst(const std::string& requiredName)
     if (thisNode->getType() == "PHCompositeNode")
     {
       PHNodeIterator nodeIter(dynamic_cast<PHCompositeNode*>(thisNode));
-      PHNode* nodeFoundInSubTree = nodeIter.findFirst(requiredName);
+      PHNode* nodeFoundInSubTree = nodeIter.findFirstOfType(requiredType, requiredName);
       if (nodeFoundInSubTree)
       {
         return nodeFoundInSubTree;
@@ -92,6 +78,11 @@ PHNode* PHNodeIterator::findFirst(const std::string& requiredName)
   return nullptr;
 }
 
+PHNode* PHNodeIterator::findFirst(const std::string& requiredName)
+{
+  return currentNode->lookup(requiredName);
+}
+
 bool PHNodeIterator::cd(const std::string& pathString)
 {
   bool success = true;
@@ -33,6 +33,9 @@ class PHNodeIterator
   PHCompositeNode* get_currentNode() const { return currentNode; }
 
  protected:
+  // recursive search, used when the name index is not sufficient
+  PHNode* findFirstOfType(const std::string&, const std::string&);
+
   PHCompositeNode* currentNode {nullptr};
   PHPointerList<PHNode> subNodeList;
 };
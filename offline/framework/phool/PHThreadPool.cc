@@ -0,0 +1,113 @@
+#include "PHThreadPool.h"
+
+#include <algorithm>
+
+//_____________________________________________________________________________
+PHThreadPool::PHThreadPool(unsigned int nthreads)
+{
+  if (nthreads == 0)
+  {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  // the calling thread acts as worker 0
+  m_workers.reserve(nthreads - 1);
+  for (unsigned int id = 1; id < nthreads; ++id)
+  {
+    m_workers.emplace_back(&PHThreadPool::worker_loop, this, id);
+  }
+}
+
+//_____________________________________________________________________________
+PHThreadPool::~PHThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_start_cv.notify_all();
+  for (auto& worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+//_____________________________________________________________________________
+void PHThreadPool::parallel_for(std::size_t n, const Task& task)
+{
+  if (n == 0)
+  {
+    return;
+  }
+
+  // nothing to share, avoid waking up the workers
+  if (m_workers.empty() || n == 1)
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      task(i, 0);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> call_lock(m_call_mutex);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_ntasks = n;
+    m_next.store(0, std::memory_order_relaxed);
+    m_active = m_workers.size();
+    ++m_generation;
+  }
+  m_start_cv.notify_all();
+
+  run_tasks(0);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done_cv.wait(lock, [this]
+                 { return m_active == 0; });
+  m_task = nullptr;
+}
+
+//_____________________________________________________________________________
+void PHThreadPool::worker_loop(unsigned int id)
+{
+  uint64_t generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_start_cv.wait(lock, [this, generation]
+                      { return m_stop || m_generation != generation; });
+      if (m_stop)
+      {
+        return;
+      }
+      generation = m_generation;
+    }
+
+    run_tasks(id);
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (--m_active == 0)
+      {
+        m_done_cv.notify_one();
+      }
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void PHThreadPool::run_tasks(unsigned int id)
+{
+  while (true)
+  {
+    const std::size_t i = m_next.fetch_add(1, std::memory_order_relaxed);
+    if (i >= m_ntasks)
+    {
+      return;
+    }
+    (*m_task)(i, id);
+  }
+}
@@ -0,0 +1,72 @@
+#ifndef PHOOL_PHTHREADPOOL_H
+#define PHOOL_PHTHREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! persistent, bounded pool of worker threads
+/*!
+  The workers are started once and are reused for every call to parallel_for,
+  so modules can keep a pool across events instead of creating and joining
+  one thread per work item. Work items are handed out dynamically: each worker
+  (including the calling thread) grabs the next free index until the range is
+  exhausted, so fast workers pick up the work left behind by slow ones.
+
+  The worker id passed to the task is in [0, size()) and is stable for the
+  duration of a call. It is meant to index per-worker scratch buffers owned
+  by the caller. Tasks must not throw.
+*/
+class PHThreadPool
+{
+ public:
+  //! task signature: (work item index, worker id)
+  using Task = std::function<void(std::size_t, unsigned int)>;
+
+  //! construct with given number of workers. 0 means one per hardware thread
+  explicit PHThreadPool(unsigned int nthreads = 0);
+
+  //! stops and joins all workers
+  ~PHThreadPool();
+
+  PHThreadPool(const PHThreadPool&) = delete;
+  PHThreadPool& operator=(const PHThreadPool&) = delete;
+
+  //! number of workers, including the calling thread
+  unsigned int size() const { return m_workers.size() + 1; }
+
+  //! run task on all indices in [0, n), returns once all are processed
+  /*! the calling thread participates as worker 0 */
+  void parallel_for(std::size_t n, const Task& task);
+
+ private:
+  //! worker main loop
+  void worker_loop(unsigned int id);
+
+  //! process work items until the current range is exhausted
+  void run_tasks(unsigned int id);
+
+  std::vector<std::thread> m_workers;
+
+  //! serializes concurrent calls to parallel_for
+  std::mutex m_call_mutex;
+
+  //! protects the state below
+  std::mutex m_mutex;
+  std::condition_variable m_start_cv;
+  std::condition_variable m_done_cv;
+
+  const Task* m_task = nullptr;
+  std::size_t m_ntasks = 0;
+  std::atomic<std::size_t> m_next{0};
+  unsigned int m_active = 0;
+  uint64_t m_generation = 0;
+  bool m_stop = false;
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef PHOOL_GETCLASS_H
 #define PHOOL_GETCLASS_H
 
+#include "PHCompositeNode.h"
 #include "PHDataNode.h"
 #include "PHIODataNode.h"
 #include "PHNode.h"
@@ -10,14 +11,11 @@
 
 #include <string>
 
-class PHCompositeNode;
-
 namespace findNode
 {
-  template <class T> T *getClass(PHCompositeNode *top, const std::string &name)
+  // object of type T held by a node, nullptr if none
+  template <class T> T *getObject(PHNode *FoundNode)
   {
-    PHNodeIterator iter(top);
-    PHNode *FoundNode = iter.findFirst(name);  // returns pointer to PHNode
     if (!FoundNode)
     {
       return nullptr;
@@ -55,12 +53,62 @@ namespace findNode
     return nullptr;
   }
 
+  template <class T> T *getClass(PHCompositeNode *top, const std::string &name)
+  {
+    PHNodeIterator iter(top);
+    PHNode *FoundNode = iter.findFirst(name);  // returns pointer to PHNode
+    return getObject<T>(FoundNode);
+  }
+
   template <class T> T *getClass(PHCompositeNode *top, const int packetid)
   {
     std::string name = std::to_string(packetid);
     return findNode::getClass<T>(top,name);
   }
 
+  // Handle to a node object, to be set up once (e.g. in InitRun) and
+  // used in every event instead of getClass. The node is looked up
+  // again only when the tree below top changed, the object is always
+  // taken from the node, so replacing the node content is safe.
+  // A handle caches the node, so it is not shared between threads
+  template <class T> class Handle
+  {
+   public:
+    Handle() = default;
+    Handle(PHCompositeNode *top, const std::string &name)
+      : m_Top(top)
+      , m_Name(name)
+    {
+    }
+
+    T *get()
+    {
+      if (!m_Top)
+      {
+        return nullptr;
+      }
+      const unsigned long version = m_Top->treeVersion();
+      if (m_Version != version)
+      {
+        PHNodeIterator iter(m_Top);
+        m_Node = iter.findFirst(m_Name);
+        m_Version = version;
+      }
+      return getObject<T>(m_Node);
+    }
+
+    T *operator->() { return get(); }
+    explicit operator bool() { return get() != nullptr; }
+
+    const std::string &name() const { return m_Name; }
+
+   private:
+    PHCompositeNode *m_Top = nullptr;
+    std::string m_Name;
+    PHNode *m_Node = nullptr;
+    unsigned long m_Version = 0;
+  };
+
 }  // namespace findNode
 
 #endif
@@ -34,6 +34,7 @@
 
 #include <TSystem.h>
 
+#include <algorithm>
 #include <climits>
 #include <iostream>  // for operator<<, endl, basic...
 #include <memory>    // for allocator_traits<>::val...
@@ -74,6 +75,7 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
   {
     WaveformProcessing->set_bitFlipRecovery(m_dobitfliprecovery);
   }
+  WaveformProcessing->set_analyticTemplateFit(m_analytic_templatefit);
 
   // Set functional fit parameters
   if (_processingtype == CaloWaveformProcessing::FUNCFIT)
@@ -183,13 +185,17 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
 
 int CaloTowerBuilder::process_sim()
 {
+  // fast and nyquist processing read the samples straight from the batch
+  const bool use_batch = WaveformProcessing->has_batch_processing();
   std::vector<std::vector<float>> waveforms;
+  if (use_batch)
+  {
+    m_batch.reset(m_CalowaveformContainer->size(), std::max({m_nsamples, m_nzerosuppsamples, 2}));
+  }
 
   for (int ich = 0; ich < (int) m_CalowaveformContainer->size(); ich++)
   {
     TowerInfo *towerinfo = m_CalowaveformContainer->get_tower_at_channel(ich);
-    std::vector<float> waveform;
-    waveform.reserve(m_nsamples);
     bool fillwaveform = true;
     // get key
     if (m_dotbtszs)
@@ -203,65 +209,132 @@ int CaloTowerBuilder::process_sim()
       {
         // zero suppressed
         fillwaveform = false;
-        waveform.push_back(pre);
-        waveform.push_back(post);
+        if (use_batch)
+        {
+          const int index = m_batch.add_channel(2);
+          m_batch.set_sample(index, 0, pre);
+          m_batch.set_sample(index, 1, post);
+        }
+        else
+        {
+          waveforms.push_back({static_cast<float>(pre), static_cast<float>(post)});
+        }
       }
     }
     if (fillwaveform)
     {
-      for (int samp = 0; samp < m_nsamples; samp++)
+      if (use_batch)
       {
-        waveform.push_back(towerinfo->get_waveform_value(samp));
+        const int index = m_batch.add_channel(m_nsamples);
+        for (int samp = 0; samp < m_nsamples; samp++)
+        {
+          m_batch.set_sample(index, samp, towerinfo->get_waveform_value(samp));
+        }
+      }
+      else
+      {
+        std::vector<float> waveform;
+        waveform.reserve(m_nsamples);
+        for (int samp = 0; samp < m_nsamples; samp++)
+        {
+          waveform.push_back(towerinfo->get_waveform_value(samp));
+        }
+        waveforms.push_back(std::move(waveform));
       }
     }
-    waveforms.push_back(waveform);
-    waveform.clear();
   }
 
-  std::vector<std::vector<float>> processed_waveforms = WaveformProcessing->process_waveform(waveforms);
-  int n_channels = processed_waveforms.size();
+  std::vector<std::vector<float>> processed_waveforms;
+  if (use_batch)
+  {
+    WaveformProcessing->process_waveform(m_batch);
+  }
+  else
+  {
+    processed_waveforms = WaveformProcessing->process_waveform(waveforms);
+  }
+
+  const int n_channels = use_batch ? m_batch.nchannels : processed_waveforms.size();
   for (int i = 0; i < n_channels; i++)
   {
     // this is for copying the truth info to the downstream object
     TowerInfo *towerwaveform = m_CalowaveformContainer->get_tower_at_channel(i);
     TowerInfo *towerinfo = m_CaloInfoContainer->get_tower_at_channel(i);
     towerinfo->copy_tower(towerwaveform);
-    towerinfo->set_time(processed_waveforms.at(i).at(1));
-    towerinfo->set_energy(processed_waveforms.at(i).at(0));
-    towerinfo->set_time(processed_waveforms.at(i).at(1));
-    towerinfo->set_pedestal(processed_waveforms.at(i).at(2));
-    towerinfo->set_chi2(processed_waveforms.at(i).at(3));
-    bool SZS = isSZS(processed_waveforms.at(i).at(1), processed_waveforms.at(i).at(3));
-    if (processed_waveforms.at(i).at(4) == 0)
+    float energy = 0;
+    float time = 0;
+    float pedestal = 0;
+    float chi2 = 0;
+    bool recovered = false;
+    bool fitstatus = false;
+    if (use_batch)
     {
-      towerinfo->set_isRecovered(false);
+      // fast and nyquist processing never recover nor fail
+      energy = m_batch.amplitude[i];
+      time = m_batch.time[i];
+      pedestal = m_batch.pedestal[i];
+      chi2 = m_batch.chi2[i];
     }
     else
     {
-      towerinfo->set_isRecovered(true);
+      const std::vector<float> &processed = processed_waveforms.at(i);
+      energy = processed.at(0);
+      time = processed.at(1);
+      pedestal = processed.at(2);
+      chi2 = processed.at(3);
+      recovered = (processed.at(4) != 0);
+      fitstatus = static_cast<bool>(processed.at(5));
     }
-    towerinfo->set_FitStatus(static_cast<bool>(processed_waveforms.at(i).at(5)));
-    int n_samples = waveforms.at(i).size();
+    towerinfo->set_energy(energy);
+    towerinfo->set_time(time);
+    towerinfo->set_pedestal(pedestal);
+    towerinfo->set_chi2(chi2);
+    towerinfo->set_isRecovered(recovered);
+    towerinfo->set_FitStatus(fitstatus);
+    bool SZS = isSZS(time, chi2);
+
+    const int n_samples = use_batch ? m_batch.nsamples[i] : waveforms.at(i).size();
     if (n_samples == m_nzerosuppsamples || SZS)
     {
       towerinfo->set_isZS(true);
     }
     for (int j = 0; j < n_samples; j++)
     {
-      towerinfo->set_waveform_value(j, waveforms.at(i).at(j));
-      if (std::round(waveforms.at(i).at(j)) >= m_saturation)
+      const float value = use_batch ? m_batch.sample(i, j) : waveforms[i][j];
+      towerinfo->set_waveform_value(j, value);
+      if (std::round(value) >= m_saturation)
       {
         towerinfo->set_isSaturated(true);
       }
     }
   }
-  waveforms.clear();
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::vector<float>> &waveforms)
 {
+  // fast and nyquist processing read the samples straight from the batch,
+  // which is filled here in place of the waveform vectors
+  const bool use_batch = WaveformProcessing->has_batch_processing();
+  if (use_batch)
+  {
+    m_batch.reset(std::max(m_packet_high - m_packet_low + 1, 1) * m_nchannels, std::max({m_nsamples, m_nzerosuppsamples, 2}));
+  }
+
+  // add a channel with all samples set to the same value (empty, masked or missing)
+  auto add_constant_waveform = [&](float value)
+  {
+    if (use_batch)
+    {
+      m_batch.add_channel(m_nzerosuppsamples, value);
+    }
+    else
+    {
+      waveforms.emplace_back(m_nzerosuppsamples, value);
+    }
+  };
+
   std::variant<CaloPacketContainer *, Event *> event;
   if (m_UseOfflinePacketFlag)
   {
@@ -316,13 +389,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
           {
             continue;
           }
-          std::vector<float> waveform;
-          waveform.reserve(m_nzerosuppsamples);
-          for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-          {
-            waveform.push_back(-1);
-          }
-          waveforms.push_back(waveform);
+          add_constant_waveform(-1);
         }
         return Fun4AllReturnCodes::EVENT_OK;
       }
@@ -357,20 +424,31 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
               for (int iskip = 0; iskip < 64; iskip++)
               {
                 n_pad_skip_mask++;
-                std::vector<float> waveform;
-                waveform.reserve(m_nsamples);
-
-                for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-                {
-                  waveform.push_back(0);
-                }
-                waveforms.push_back(waveform);
-                waveform.clear();
+                add_constant_waveform(0);
               }
             }
           }
         }
 
+        if (use_batch)
+        {
+          if (packet->iValue(channel, "SUPPRESSED"))
+          {
+            const int index = m_batch.add_channel(2);
+            m_batch.set_sample(index, 0, packet->iValue(channel, "PRE"));
+            m_batch.set_sample(index, 1, packet->iValue(channel, "POST"));
+          }
+          else
+          {
+            const int index = m_batch.add_channel(m_nsamples);
+            for (int samp = 0; samp < m_nsamples; samp++)
+            {
+              m_batch.set_sample(index, samp, packet->iValue(samp, channel));
+            }
+          }
+          continue;
+        }
+
         std::vector<float> waveform;
         waveform.reserve(m_nsamples);
         if (packet->iValue(channel, "SUPPRESSED"))
@@ -385,8 +463,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
             waveform.push_back(packet->iValue(samp, channel));
           }
         }
-        waveforms.push_back(waveform);
-        waveform.clear();
+        waveforms.push_back(std::move(waveform));
       }
 
       int nch_padded = nchannels;
@@ -402,15 +479,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
           {
             continue;
           }
-          std::vector<float> waveform;
-          waveform.reserve(m_nsamples);
-
-          for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-          {
-            waveform.push_back(0);
-          }
-          waveforms.push_back(waveform);
-          waveform.clear();
+          add_constant_waveform(0);
         }
       }
     }
@@ -422,14 +491,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
         {
           continue;
         }
-        std::vector<float> waveform;
-        waveform.reserve(2);
-        for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-        {
-          waveform.push_back(-1);  // push back -1 for missing packets
-        }
-        waveforms.push_back(waveform);
-        waveform.clear();
+        add_constant_waveform(-1);  // -1 for missing packets
       }
     }
     return Fun4AllReturnCodes::EVENT_OK;
@@ -480,15 +542,26 @@ int CaloTowerBuilder::process_event(PHCompositeNode *topNode)
   {
     return Fun4AllReturnCodes::ABORTEVENT;
   }
-  if (waveforms.empty())
+  // waveforms are either in the batch or in the waveform vector
+  const bool use_batch = WaveformProcessing->has_batch_processing();
+  const int n_channels = use_batch ? m_batch.nchannels : waveforms.size();
+  if (n_channels == 0)
   {
     return Fun4AllReturnCodes::EVENT_OK;
   }
-  // waveform vector is filled here, now fill our output. methods from the base class make sure
+  // waveforms are filled here, now fill our output. methods from the base class make sure
   // we only fill what the chosen container version supports
-  std::vector<std::vector<float>> processed_waveforms = WaveformProcessing->process_waveform(waveforms);
+  std::vector<std::vector<float>> processed_waveforms;
+  if (use_batch)
+  {
+    // samples are processed in place, results are read back directly from the batch
+    WaveformProcessing->process_waveform(m_batch);
+  }
+  else
+  {
+    processed_waveforms = WaveformProcessing->process_waveform(waveforms);
+  }
 
-  int n_channels = processed_waveforms.size();
   for (int i = 0; i < n_channels; i++)
   {
     int idx = i;
@@ -497,27 +570,45 @@ int CaloTowerBuilder::process_event(PHCompositeNode *topNode)
     {
       idx = cdbttree_sepd_map->GetIntValue(i, m_fieldname);
     }
-    TowerInfo *towerinfo = m_CaloInfoContainer->get_tower_at_channel(i);
-    towerinfo->set_time(processed_waveforms.at(idx).at(1));
-    towerinfo->set_energy(processed_waveforms.at(idx).at(0));
-    towerinfo->set_time(processed_waveforms.at(idx).at(1));
-    towerinfo->set_pedestal(processed_waveforms.at(idx).at(2));
-    towerinfo->set_chi2(processed_waveforms.at(idx).at(3));
-    bool SZS = isSZS(processed_waveforms.at(idx).at(1), processed_waveforms.at(idx).at(3));
-
-    if (processed_waveforms.at(idx).at(4) == 0)
+    float energy = 0;
+    float time = 0;
+    float pedestal = 0;
+    float chi2 = 0;
+    bool recovered = false;
+    bool fitstatus = false;
+    if (use_batch)
     {
-      towerinfo->set_isRecovered(false);
+      // fast and nyquist processing never recover nor fail
+      energy = m_batch.amplitude[idx];
+      time = m_batch.time[idx];
+      pedestal = m_batch.pedestal[idx];
+      chi2 = m_batch.chi2[idx];
     }
     else
     {
-      towerinfo->set_isRecovered(true);
+      const std::vector<float> &processed = processed_waveforms.at(idx);
+      energy = processed.at(0);
+      time = processed.at(1);
+      pedestal = processed.at(2);
+      chi2 = processed.at(3);
+      recovered = (processed.at(4) != 0);
+      fitstatus = static_cast<bool>(processed.at(5));
     }
-    towerinfo->set_FitStatus(static_cast<bool>(processed_waveforms.at(idx).at(5)));
-    int n_samples = waveforms.at(idx).size();
+    TowerInfo *towerinfo = m_CaloInfoContainer->get_tower_at_channel(i);
+    towerinfo->set_energy(energy);
+    towerinfo->set_time(time);
+    towerinfo->set_pedestal(pedestal);
+    towerinfo->set_chi2(chi2);
+    towerinfo->set_isRecovered(recovered);
+    towerinfo->set_FitStatus(fitstatus);
+    bool SZS = isSZS(time, chi2);
+
+    const int n_samples = use_batch ? m_batch.nsamples.at(idx) : waveforms.at(idx).size();
+    auto sample = [&](int j)
+    { return use_batch ? m_batch.sample(idx, j) : waveforms[idx][j]; };
     if (n_samples == m_nzerosuppsamples || SZS)
     {
-      if (waveforms.at(idx).at(0) == -1)
+      if (sample(0) == -1)
       {
         towerinfo->set_isNotInstr(true);
       }
@@ -529,11 +620,12 @@ int CaloTowerBuilder::process_event(PHCompositeNode *topNode)
 
     for (int j = 0; j < n_samples; j++)
     {
-      if (std::round(waveforms.at(idx).at(j)) >= m_saturation)
+      const float value = sample(j);
+      if (std::round(value) >= m_saturation)
       {
         towerinfo->set_isSaturated(true);
       }
-      towerinfo->set_waveform_value(j, waveforms.at(idx).at(j));
+      towerinfo->set_waveform_value(j, value);
     }
   }
   waveforms.clear();
@@ -94,6 +94,12 @@ public:
     m_dobitfliprecovery = dobitfliprecovery;
   }
 
+  //! use the analytic template fit rather than the ROOT GSL fitter. Off by default
+  void set_analyticTemplateFit(bool analytic = true)
+  {
+    m_analytic_templatefit = analytic;
+  }
+
   // Functional fit options: 0 = PowerLawExp, 1 = PowerLawDoubleExp
   void set_funcfit_type(int type)
   {
@@ -134,6 +140,7 @@ private:
   bool skipChannel(int ich, int pid);
   static bool isSZS(float time, float chi2);
   CaloWaveformProcessing *WaveformProcessing{nullptr};
+  CaloWaveformFitting::WaveformBatch m_batch;  // reused waveform buffer for batch processing
   TowerInfoContainer *m_CaloInfoContainer{nullptr};      //! Calo info
   TowerInfoContainer *m_CalowaveformContainer{nullptr};  // waveform from simulation
   CDBTTree *cdbttree = nullptr;
@@ -162,6 +169,7 @@ private:
   float m_timeLim_low{-3.0};
   float m_timeLim_high{4.0};
   bool m_dobitfliprecovery{false};
+  bool m_analytic_templatefit{false};
 
   int m_saturation{16383};
   std::string calibdir;
@@ -244,20 +244,33 @@ void CaloTowerCalib::LoadCalib(PHCompositeNode *topNode)
   unsigned int ntowers = _raw_towers->size();
   m_cdbInfo_vec.resize(ntowers);
 
+  // resolve the calibration fields once, outside of the channel loop
+  CDBTTree::Column<float> calibcolumn = cdbttree->GetFloatColumn(m_fieldname);
+  CDBTTree::Column<float> crosscalibcolumn;
+  if (m_doZScrosscalib)
+  {
+    crosscalibcolumn = cdbttree_ZScrosscalib->GetFloatColumn(m_fieldname_ZScrosscalib);
+  }
+  CDBTTree::Column<float> timecolumn;
+  if (m_dotimecalib)
+  {
+    timecolumn = cdbttree_time->GetFloatColumn(m_fieldname_time);
+  }
+
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
     unsigned int key = _raw_towers->encode_key(channel);
 
-    m_cdbInfo_vec[channel].calibconst = cdbttree->GetFloatValue(key, m_fieldname);
+    m_cdbInfo_vec[channel].calibconst = cdbttree->GetFloatValue(key, calibcolumn);
 
     if (m_doZScrosscalib)
     {
-      m_cdbInfo_vec[channel].crosscalibconst = cdbttree_ZScrosscalib->GetFloatValue(key, m_fieldname_ZScrosscalib);
+      m_cdbInfo_vec[channel].crosscalibconst = cdbttree_ZScrosscalib->GetFloatValue(key, crosscalibcolumn);
     }
 
     if(m_dotimecalib)
     {
-      m_cdbInfo_vec[channel].meantime = cdbttree_time->GetFloatValue(key, m_fieldname_time);
+      m_cdbInfo_vec[channel].meantime = cdbttree_time->GetFloatValue(key, timecolumn);
     }
   }
 }
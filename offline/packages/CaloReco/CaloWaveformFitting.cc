@@ -4,7 +4,6 @@
 #include <TFile.h>
 #include <TH1F.h>
 #include <TProfile.h>
-#include <TSpline.h>
 #include <TFitResult.h>
 
 #include <Fit/BinData.h>
@@ -17,19 +16,45 @@
 #include <ROOT/TThreadExecutor.hxx>
 #include <ROOT/TThreadedObject.hxx>
 
-#include <pthread.h>
+#include <ROOT/TSeq.hxx>
+
 #include <algorithm>
+#include <cassert>
+#include <cmath>
 #include <iostream>
 #include <limits>
 #include <string>
 
 static ROOT::TThreadExecutor *t = new ROOT::TThreadExecutor(1);  // NOLINT(misc-use-anonymous-namespace)
+
+namespace
+{
+  // adc value of saturated samples
+  constexpr float SATURATED_ADC = 16383;
+
+  // step of the coarse scan over time in the analytic template fit, in samples
+  constexpr double TIME_SCAN_STEP = 0.25;
+
+  // precision on time of the analytic template fit, in samples
+  constexpr double TIME_TOLERANCE = 1e-4;
+}  // namespace
+
+//! ROOT fit objects. The TF1 is bound to the owning CaloWaveformFitting
+struct CaloWaveformFitting::TemplateFitter
+{
+  std::unique_ptr<TF1> f;
+  std::unique_ptr<ROOT::Math::WrappedMultiTF1> fitFunction;
+  ROOT::Fit::Fitter fitter;
+};
+
 double CaloWaveformFitting::template_function(double *x, double *par)
 {
-  Double_t v1 = (par[0] * h_template->Interpolate(x[0] - par[1])) + par[2];
+  Double_t v1 = (par[0] * template_value(x[0] - par[1])) + par[2];
   return v1;
 }
 
+CaloWaveformFitting::CaloWaveformFitting() = default;
+
 CaloWaveformFitting::~CaloWaveformFitting()
 {
   delete h_template;
@@ -45,286 +70,355 @@ void CaloWaveformFitting::initialize_processing(const std::string &templatefile)
   fin->Close();
   delete fin;
   m_peakTimeTemp = h_template->GetBinCenter(h_template->GetMaximumBin());
+
+  // copy template for lock free, allocation free interpolation
+  const int nbins = h_template->GetNbinsX();
+  m_template_values.resize(nbins);
+  for (int i = 0; i < nbins; ++i)
+  {
+    m_template_values[i] = h_template->GetBinContent(i + 1);
+  }
+  m_template_x0 = h_template->GetBinCenter(1);
+  m_template_invdx = 1. / h_template->GetBinWidth(1);
+
   t = new ROOT::TThreadExecutor(_nthreads);
 }
 
-std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(std::vector<std::vector<float>> waveformvector)
+std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(const std::vector<std::vector<float>> &waveformvector)
 {
-  int size1 = waveformvector.size();
-  std::vector<std::vector<float>> fitresults;
-  for (int i = 0; i < size1; i++)
+  return calo_processing_templatefit(waveformvector);
+}
+
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit(const std::vector<std::vector<float>> &chnlvector)
+{
+  const unsigned int nchnls = chnlvector.size();
+  std::vector<std::vector<float>> fit_params(nchnls, std::vector<float>(NFITVALUES, 0));
+  auto func = [&](unsigned int ichnl)
   {
-    waveformvector.at(i).push_back(i);
-  }
-  fitresults = calo_processing_templatefit(waveformvector);
-  return fitresults;
+    const std::vector<float> &v = chnlvector[ichnl];
+    calo_processing_templatefit(v.data(), v.size(), fit_params[ichnl].data());
+  };
+  t->Foreach(func, ROOT::TSeqU(nchnls));
+  return fit_params;
 }
 
-std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit(std::vector<std::vector<float>> chnlvector)
+void CaloWaveformFitting::calo_processing_templatefit(const float *v, int size1, float *result)
 {
-  auto func = [&](std::vector<float> &v)
+  if (size1 == _nzerosuppresssamples)
   {
-    int size1 = v.size() - 1;
-    if (size1 == _nzerosuppresssamples)
+    result[0] = v[1] - v[0];  // returns peak sample - pedestal sample
+    result[1] = std::numeric_limits<float>::quiet_NaN();  // set time to qnan for ZS
+    result[2] = v[0];
+    // check if post-sample is 0, if so set high chi2
+    result[3] = (v[0] != 0 && v[1] == 0) ? 1000000 : std::numeric_limits<float>::quiet_NaN();
+    result[4] = 0;
+    result[5] = 0;
+    return;
+  }
+
+  float maxheight = 0;
+  int maxbin = 0;
+  for (int i = 0; i < size1; i++)
+  {
+    if (v[i] > maxheight)
     {
-      v.push_back(v.at(1) - v.at(0));                        // returns peak sample - pedestal sample
-      v.push_back(std::numeric_limits<float>::quiet_NaN());  // set time to qnan for ZS
-      v.push_back(v.at(0));
-      if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
-      {
-        v.push_back(1000000);
-      }
-      else
-      {
-        v.push_back(std::numeric_limits<float>::quiet_NaN());
-      }
-      v.push_back(0);
-      v.push_back(0);
+      maxheight = v[i];
+      maxbin = i;
     }
-    else
+  }
+  float pedestal = 1500;
+  if (maxbin > 4)
+  {
+    pedestal = 0.5 * (v[maxbin - 4] + v[maxbin - 5]);
+  }
+  else if (maxbin > 3)
+  {
+    pedestal = (v[maxbin - 4]);
+  }
+  else
+  {
+    pedestal = 0.5 * (v[size1 - 3] + v[size1 - 2]);
+  }
+
+  if ((_bdosoftwarezerosuppression && v[6] - v[0] < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
+  {
+    result[0] = v[6] - v[0];
+    result[1] = std::numeric_limits<float>::quiet_NaN();
+    result[2] = v[0];
+    // check if post-sample is 0, if so set high chi2
+    result[3] = (v[0] != 0 && v[1] == 0) ? 1000000 : std::numeric_limits<float>::quiet_NaN();
+    result[4] = 0;
+    result[5] = 0;
+    return;
+  }
+
+  // saturated samples are excluded from the fit,
+  // unless too many are saturated: need enough ndf
+  int ndata = size1;
+  if (_handleSaturation)
+  {
+    ndata = size1 - std::count(v, v + size1, SATURATED_ADC);
+  }
+  bool skip_saturated = _handleSaturation;
+  if (ndata < (size1 - 4))
+  {
+    ndata = size1;
+    skip_saturated = false;
+  }
+
+  // time parameter limits
+  double time_low = -1 * m_peakTimeTemp;
+  double time_high = size1 - m_peakTimeTemp;
+  if (m_setTimeLim)
+  {
+    time_low = m_timeLim_low;
+    time_high = m_timeLim_high;
+  }
+
+  const double params[] = {static_cast<double>(maxheight - pedestal), static_cast<double>(maxbin - m_peakTimeTemp), static_cast<double>(pedestal)};
+  const TemplateFitResult fitres = _analytic_templatefit ? fit_template_analytic(v, size1, skip_saturated, time_low, time_high) : fit_template_root(v, size1, skip_saturated, time_low, time_high, params);
+
+  // get the fit status code (0 means successful fit)
+  const int validfit = fitres.status;
+  double chi2min = fitres.chi2;
+  chi2min /= ndata - 3;  // divide by the number of dof
+
+  result[0] = fitres.amplitude;
+  result[1] = fitres.time;
+  result[2] = fitres.pedestal;
+  result[3] = chi2min;
+  result[4] = 0;
+  result[5] = validfit;
+
+  if (chi2min > _chi2threshold && (fitres.pedestal < _bfr_highpedestalthreshold || pedestal < _bfr_highpedestalthreshold) && (fitres.pedestal > _bfr_lowpedestalthreshold || pedestal > _bfr_lowpedestalthreshold) && _dobitfliprecovery)
+  {
+    std::vector<float> rv(v, v + size1);  // temporary recovered waveform
+    unsigned int bits[3] = {8192, 4096, 2048};
+    for (auto bit : bits)
     {
-      float maxheight = 0;
-      int maxbin = 0;
       for (int i = 0; i < size1; i++)
       {
-        if (v.at(i) > maxheight)
+        if (((unsigned int) rv[i] & bit) && ((unsigned int) rv[i] % bit > _bfr_lowpedestalthreshold))
         {
-          maxheight = v.at(i);
-          maxbin = i;
+          rv[i] = rv[i] - bit;
         }
       }
-      float pedestal = 1500;
-      if (maxbin > 4)
-      {
-        pedestal = 0.5 * (v.at(maxbin - 4) + v.at(maxbin - 5));
-      }
-      else if (maxbin > 3)
-      {
-        pedestal = (v.at(maxbin - 4));
-      }
-      else
+    }
+
+    maxheight = 0;
+    maxbin = 0;
+    for (int i = 0; i < size1; i++)
+    {
+      if (rv[i] > maxheight)
       {
-        pedestal = 0.5 * (v.at(size1 - 3) + v.at(size1 - 2));
+        maxheight = rv[i];
+        maxbin = i;
       }
+    }
+    if (maxbin > 4)
+    {
+      pedestal = 0.5 * (rv[maxbin - 4] + rv[maxbin - 5]);
+    }
+    else if (maxbin > 3)
+    {
+      pedestal = (rv[maxbin - 4]);
+    }
+    else
+    {
+      pedestal = 0.5 * (rv[size1 - 3] + rv[size1 - 2]);
+    }
 
-      if ((_bdosoftwarezerosuppression && v.at(6) - v.at(0) < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
+    // the recovered waveform is fitted using all samples, with the default time limits
+    const double recover_params[] = {static_cast<double>(maxheight - pedestal), 0, static_cast<double>(pedestal)};
+    const double recover_time_low = -1 * m_peakTimeTemp;
+    const double recover_time_high = size1 - m_peakTimeTemp;
+    const TemplateFitResult recover_fitres = _analytic_templatefit ? fit_template_analytic(rv.data(), size1, false, recover_time_low, recover_time_high) : fit_template_root(rv.data(), size1, false, recover_time_low, recover_time_high, recover_params);
+    double recover_chi2min = recover_fitres.chi2;
+    recover_chi2min /= size1 - 3;  // divide by the number of dof
+    if (recover_chi2min < _chi2lowthreshold && recover_fitres.pedestal < _bfr_highpedestalthreshold && recover_fitres.pedestal > _bfr_lowpedestalthreshold)
+    {
+      result[0] = recover_fitres.amplitude;
+      result[1] = recover_fitres.time;
+      result[2] = recover_fitres.pedestal;
+      result[3] = recover_chi2min;
+      result[4] = 1;
+      result[5] = recover_fitres.status;
+    }
+  }
+}
+
+CaloWaveformFitting::TemplateFitResult CaloWaveformFitting::fit_template_analytic(const float *samples, int nsamples, bool skip_saturated, double time_low, double time_high) const
+{
+  // for a given time shift, amplitude and pedestal minimizing the chi2 are obtained from the normal equations
+  //   A sum(T^2) + P sum(T) = sum(T y)
+  //   A sum(T)   + P n      = sum(y)
+  // with T the template evaluated at each sample. Only the time remains to be minimized
+  auto evaluate = [&](double time, TemplateFitResult &res)
+  {
+    double n = 0;
+    double sT = 0;
+    double sTT = 0;
+    double sy = 0;
+    double syy = 0;
+    double sTy = 0;
+    for (int i = 0; i < nsamples; ++i)
+    {
+      if (skip_saturated && samples[i] == SATURATED_ADC)
       {
-        v.push_back(v.at(6) - v.at(0));
-        v.push_back(std::numeric_limits<float>::quiet_NaN());
-        v.push_back(v.at(0));
-        if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
-        {
-          v.push_back(1000000);
-        }
-        else
-        {
-          v.push_back(std::numeric_limits<float>::quiet_NaN());
-        }
-        v.push_back(0);
-        v.push_back(0);
+        continue;
       }
-      else
-      {
-        auto *h = new TH1F(std::string("h_" + std::to_string((int) round(v.at(size1)))).c_str(), "", size1, -0.5, size1 - 0.5);
-
-        int ndata = 0;
-        for (int i = 0; i < size1; ++i)
-        {
-          if ((v.at(i) == 16383) && _handleSaturation)
-          {
-            continue;
-          }
+      const double T = template_value(i - time);
+      const double y = samples[i];
+      n += 1;
+      sT += T;
+      sTT += T * T;
+      sy += y;
+      syy += y * y;
+      sTy += T * y;
+    }
 
-          h->SetBinContent(i + 1, v.at(i));
-          h->SetBinError(i + 1, 1);
-          ndata++;
-        }
-        // if too many are saturated don't do the saturation recovery need enough ndf
-        if (ndata < (size1 - 4))
-        {
-          ndata = size1;
-          for (int i = 0; i < size1; ++i)
-          {
-            h->SetBinContent(i + 1, v.at(i));
-            h->SetBinError(i + 1, 1);
-          }
-        }
+    res.time = time;
+    res.status = 0;
+    const double det = n * sTT - sT * sT;
+    if (n < 1)
+    {
+      res.amplitude = 0;
+      res.pedestal = 0;
+      res.chi2 = 0;
+      res.status = 1;
+      return;
+    }
+    if (!(det > 0))
+    {
+      // flat template over the samples: amplitude is undetermined
+      res.amplitude = 0;
+      res.pedestal = sy / n;
+      res.chi2 = std::max(0., syy - sy * sy / n);
+      res.status = 1;
+      return;
+    }
+    const double A = (n * sTy - sT * sy) / det;
+    const double P = (sy - A * sT) / n;
+    res.amplitude = A;
+    res.pedestal = P;
+    res.chi2 = std::max(0., syy - 2 * A * sTy - 2 * P * sy + A * A * sTT + 2 * A * P * sT + n * P * P);
+  };
 
-        auto *f = new TF1(std::string("f_" + std::to_string((int) round(v.at(size1)))).c_str(), this, &CaloWaveformFitting::template_function, 0, 31, 3, "CaloWaveformFitting", "template_function");
-        ROOT::Math::WrappedMultiTF1 *fitFunction = new ROOT::Math::WrappedMultiTF1(*f, 3);
-        ROOT::Fit::BinData data(v.size() - 1, 1);
-        ROOT::Fit::FillData(data, h);
-        ROOT::Fit::Chi2Function *EPChi2 = new ROOT::Fit::Chi2Function(data, *fitFunction);
-        ROOT::Fit::Fitter *fitter = new ROOT::Fit::Fitter();
-        fitter->Config().MinimizerOptions().SetMinimizerType("GSLMultiFit");
-        fitter->Config().MinimizerOptions().SetPrintLevel(-1);
-        double params[] = {static_cast<double>(maxheight - pedestal), static_cast<double>(maxbin - m_peakTimeTemp), static_cast<double>(pedestal)};
-        // double params[] = {static_cast<double>(maxheight - pedestal), 0, static_cast<double>(pedestal)};
-        fitter->Config().SetParamsSettings(3, params);
-        fitter->Config().ParSettings(1).SetLimits(-1 * m_peakTimeTemp, size1 - m_peakTimeTemp);  // set lim on time par
-        if (m_setTimeLim)
-        {
-          fitter->Config().ParSettings(1).SetLimits(m_timeLim_low, m_timeLim_high);
-        }
-        fitter->FitFCN(*EPChi2, nullptr, data.Size(), true);
-        ROOT::Fit::FitResult fitres = fitter->Result();
-        // get the fit status code (0 means successful fit)
-        int validfit = fitres.Status();
-        /*
-        if(validfit != 0)
-        {
-          std::cout<<"invalid fit status in waveform fitting: " << validfit <<std::endl;
-          for (int i = 0; i < size1; ++i)
-        {
-          std::cout<<v.at(i) << " ";
-        }
-        std::cout<<std::endl;
-        }
-        */
-        double chi2min = fitres.MinFcnValue();
-        // chi2min /= size1 - 3;  // divide by the number of dof
-        chi2min /= ndata - 3;  // divide by the number of dof
-        if (chi2min > _chi2threshold && (f->GetParameter(2) < _bfr_highpedestalthreshold || pedestal < _bfr_highpedestalthreshold) && (f->GetParameter(2) > _bfr_lowpedestalthreshold || pedestal > _bfr_lowpedestalthreshold) && _dobitfliprecovery)
-        {
-          std::vector<float> rv;  // temporary recovered waveform
-          rv.reserve(size1);
-          for (int i = 0; i < size1; i++)
-          {
-            rv.push_back(v.at(i));
-          }
-          unsigned int bits[3] = {8192, 4096, 2048};
-          for (auto bit : bits)
-          {
-            for (int i = 0; i < size1; i++)
-            {
-              if (((unsigned int) rv.at(i) & bit) && ((unsigned int) rv.at(i) % bit > _bfr_lowpedestalthreshold))
-              {
-                rv.at(i) = rv.at(i) - bit;
-              }
-            }
-          }
-          for (int i = 0; i < size1; i++)
-          {
-            h->SetBinContent(i + 1, rv.at(i));
-            h->SetBinError(i + 1, 1);
-          }
+  // coarse scan over the allowed time range
+  TemplateFitResult best;
+  evaluate(time_low, best);
+  const int nsteps = std::max(1, static_cast<int>(std::ceil((time_high - time_low) / TIME_SCAN_STEP)));
+  const double step = (time_high - time_low) / nsteps;
+  TemplateFitResult current;
+  for (int istep = 1; istep <= nsteps; ++istep)
+  {
+    evaluate(time_low + istep * step, current);
+    if (current.chi2 < best.chi2)
+    {
+      best = current;
+    }
+  }
 
-          maxheight = 0;
-          maxbin = 0;
-          for (int i = 0; i < size1; i++)
-          {
-            if (rv.at(i) > maxheight)
-            {
-              maxheight = rv.at(i);
-              maxbin = i;
-            }
-          }
-          if (maxbin > 4)
-          {
-            pedestal = 0.5 * (rv.at(maxbin - 4) + rv.at(maxbin - 5));
-          }
-          else if (maxbin > 3)
-          {
-            pedestal = (rv.at(maxbin - 4));
-          }
-          else
-          {
-            pedestal = 0.5 * (rv.at(size1 - 3) + rv.at(size1 - 2));
-          }
+  // golden section refinement around the best scan point
+  constexpr double golden = 0.6180339887498949;
+  double a = std::max(time_low, best.time - step);
+  double b = std::min(time_high, best.time + step);
+  TemplateFitResult left;
+  TemplateFitResult right;
+  evaluate(b - golden * (b - a), left);
+  evaluate(a + golden * (b - a), right);
+  while (b - a > TIME_TOLERANCE)
+  {
+    if (left.chi2 < right.chi2)
+    {
+      b = right.time;
+      right = left;
+      evaluate(b - golden * (b - a), left);
+    }
+    else
+    {
+      a = left.time;
+      left = right;
+      evaluate(a + golden * (b - a), right);
+    }
+  }
+  const TemplateFitResult &refined = (left.chi2 < right.chi2) ? left : right;
+  if (refined.chi2 < best.chi2)
+  {
+    best = refined;
+  }
+  return best;
+}
 
-          auto *recover_f = new TF1(std::string("recover_f_" + std::to_string((int) round(v.at(size1)))).c_str(), this, &CaloWaveformFitting::template_function, 0, 31, 3, "CaloWaveformFitting", "template_function");
-          ROOT::Math::WrappedMultiTF1 *recoverFitFunction = new ROOT::Math::WrappedMultiTF1(*recover_f, 3);
-          ROOT::Fit::BinData recoverData(rv.size() - 1, 1);
-          ROOT::Fit::FillData(recoverData, h);
-          ROOT::Fit::Chi2Function *recoverEPChi2 = new ROOT::Fit::Chi2Function(recoverData, *recoverFitFunction);
-          ROOT::Fit::Fitter *recoverFitter = new ROOT::Fit::Fitter();
-          recoverFitter->Config().MinimizerOptions().SetMinimizerType("GSLMultiFit");
-          double recover_params[] = {static_cast<double>(maxheight - pedestal), 0, static_cast<double>(pedestal)};
-          recoverFitter->Config().SetParamsSettings(3, recover_params);
-          recoverFitter->Config().ParSettings(1).SetLimits(-1 * m_peakTimeTemp, size1 - m_peakTimeTemp);  // set lim on time par
-          recoverFitter->FitFCN(*recoverEPChi2, nullptr, recoverData.Size(), true);
-          ROOT::Fit::FitResult recover_fitres = recoverFitter->Result();
-          int recover_validfit = recover_fitres.Status();
-          double recover_chi2min = recover_fitres.MinFcnValue();
-          recover_chi2min /= size1 - 3;  // divide by the number of dof
-          if (recover_chi2min < _chi2lowthreshold && recover_f->GetParameter(2) < _bfr_highpedestalthreshold && recover_f->GetParameter(2) > _bfr_lowpedestalthreshold)
-          {
-            for (int i = 0; i < size1; i++)
-            {
-              v.at(i) = rv.at(i);
-            }
-            for (int i = 0; i < 3; i++)
-            {
-              v.push_back(recover_f->GetParameter(i));
-            }
-            v.push_back(recover_chi2min);
-            v.push_back(1);
-            v.push_back(recover_validfit);
-          }
-          else
-          {
-            for (int i = 0; i < 3; i++)
-            {
-              v.push_back(f->GetParameter(i));
-            }
-            v.push_back(chi2min);
-            v.push_back(0);
-            v.push_back(validfit);
-          }
-          recover_f->Delete();
-          delete recoverFitFunction;
-          delete recoverFitter;
-          delete recoverEPChi2;
-        }
-        else
-        {
-          for (int i = 0; i < 3; i++)
-          {
-            v.push_back(f->GetParameter(i));
-          }
-          v.push_back(chi2min);
-          v.push_back(0);
-          v.push_back(validfit);
-        }
-        h->Delete();
-        f->Delete();
-        delete fitFunction;
-        delete fitter;
-        delete EPChi2;
-      }
+CaloWaveformFitting::TemplateFitResult CaloWaveformFitting::fit_template_root(const float *samples, int nsamples, bool skip_saturated, double time_low, double time_high, const double *params)
+{
+  // take a fitter from the pool, or make a new one if all are in use
+  std::unique_ptr<TemplateFitter> fitter;
+  {
+    std::lock_guard<std::mutex> lock(m_fitters_mutex);
+    if (m_fitters.empty())
+    {
+      fitter = std::make_unique<TemplateFitter>();
+      fitter->f = std::make_unique<TF1>(std::string("f_template_" + std::to_string(m_nfitters++)).c_str(), this, &CaloWaveformFitting::template_function, 0, 31, 3, "CaloWaveformFitting", "template_function");
+      fitter->fitFunction = std::make_unique<ROOT::Math::WrappedMultiTF1>(*fitter->f, 3);
+      fitter->fitter.Config().MinimizerOptions().SetMinimizerType("GSLMultiFit");
+      fitter->fitter.Config().MinimizerOptions().SetPrintLevel(-1);
     }
-  };
+    else
+    {
+      fitter = std::move(m_fitters.back());
+      m_fitters.pop_back();
+    }
+  }
 
-  t->Foreach(func, chnlvector);
-  int size3 = chnlvector.size();
-  std::vector<std::vector<float>> fit_params;
-  std::vector<float> fit_params_tmp;
-  for (int i = 0; i < size3; i++)
+  ROOT::Fit::BinData data(nsamples, 1);
+  for (int i = 0; i < nsamples; ++i)
   {
-    const std::vector<float> &tv = chnlvector.at(i);
-    int size2 = tv.size();
-    for (int q = 6; q > 0; q--)
+    if (skip_saturated && samples[i] == SATURATED_ADC)
     {
-      fit_params_tmp.push_back(tv.at(size2 - q));
+      continue;
     }
-    fit_params.push_back(fit_params_tmp);
-    fit_params_tmp.clear();
+    data.Add(i, samples[i], 1);
   }
-  chnlvector.clear();
-  return fit_params;
+
+  ROOT::Fit::Chi2Function EPChi2(data, *fitter->fitFunction);
+  fitter->fitter.Config().SetParamsSettings(3, params);
+  fitter->fitter.Config().ParSettings(1).SetLimits(time_low, time_high);  // set lim on time par
+  fitter->fitter.FitFCN(EPChi2, nullptr, data.Size(), true);
+  const ROOT::Fit::FitResult &fitres = fitter->fitter.Result();
+
+  TemplateFitResult res;
+  res.amplitude = fitres.Parameter(0);
+  res.time = fitres.Parameter(1);
+  res.pedestal = fitres.Parameter(2);
+  res.chi2 = fitres.MinFcnValue();
+  res.status = fitres.Status();
+
+  std::lock_guard<std::mutex> lock(m_fitters_mutex);
+  m_fitters.push_back(std::move(fitter));
+  return res;
 }
 
 void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax)
 {
-  int n = 3;
-  double xp[3] = {x0, x1, x2};
-  double yp[3] = {y0, y1, y2};
-  TSpline3 *sp = new TSpline3("", xp, yp, n, "b2e2", 0, 0);
-  double X;
-  double Y;
-  double B;
-  double C;
-  double D;
+  // natural cubic spline through the 3 points (zero second derivative at both ends, as TSpline3 "b2e2"),
+  // computed in closed form. On each segment S(x) = Y + B dx + C dx^2 + D dx^3, dx = x - X
+  const double xp[3] = {x0, x1, x2};
+  const double yp[3] = {y0, y1, y2};
+  const double h0 = xp[1] - xp[0];
+  const double h1 = xp[2] - xp[1];
+
+  // second derivative at the middle point
+  const double M1 = 3 * ((yp[2] - yp[1]) / h1 - (yp[1] - yp[0]) / h0) / (h0 + h1);
+  const double B[2] = {(yp[1] - yp[0]) / h0 - h0 * M1 / 6, (yp[2] - yp[1]) / h1 - h1 * M1 / 3};
+  const double C[2] = {0, M1 / 2};
+  const double D[2] = {M1 / (6 * h0), -M1 / (6 * h1)};
+  auto eval = [&](int i, double x)
+  {
+    const double dx = x - xp[i];
+    return yp[i] + dx * (B[i] + dx * (C[i] + dx * D[i]));
+  };
+
   ymax = y1;
   xmax = x1;
   if (y0 > ymax)
@@ -339,17 +433,16 @@ void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float
   }
   for (int i = 0; i <= 1; i++)
   {
-    sp->GetCoeff(i, X, Y, B, C, D);
-    if (D == 0)
+    const double X = xp[i];
+    if (D[i] == 0)
     {
-      if (C < 0)
+      if (C[i] < 0)
       {
-        // TSpline is a quadratic equation
-
-        float root = (-B / (2 * C)) + X;
+        // spline is a quadratic equation
+        float root = (-B[i] / (2 * C[i])) + X;
         if (root >= xp[i] && root <= xp[i + 1])
         {
-          float yvalue = sp->Eval(root);
+          float yvalue = eval(i, root);
           if (yvalue > ymax)
           {
             ymax = yvalue;
@@ -361,20 +454,20 @@ void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float
     else
     {
       // find x when derivative = 0
-      float root = ((-2 * C + sqrt((4 * C * C) - (12 * B * D))) / (6 * D)) + X;
+      float root = ((-2 * C[i] + sqrt((4 * C[i] * C[i]) - (12 * B[i] * D[i]))) / (6 * D[i])) + X;
       if (root >= xp[i] && root <= xp[i + 1])
       {
-        float yvalue = sp->Eval(root);
+        float yvalue = eval(i, root);
         if (yvalue > ymax)
         {
           ymax = yvalue;
           xmax = root;
         }
       }
-      root = (-2 * C - sqrt((4 * C * C) - (12 * B * D))) / (6 * D) + X;
+      root = (-2 * C[i] - sqrt((4 * C[i] * C[i]) - (12 * B[i] * D[i]))) / (6 * D[i]) + X;
       if (root >= xp[i] && root <= xp[i + 1])
       {
-        float yvalue = sp->Eval(root);
+        float yvalue = eval(i, root);
         if (yvalue > ymax)
         {
           ymax = yvalue;
@@ -383,68 +476,65 @@ void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float
       }
     }
   }
-  delete sp;
   return;
 }
+
+void CaloWaveformFitting::fast_result(const float *v, int stride, int nsamples, int maxx, float &amp, float &time, float &ped, float &chi2)
+{
+  auto value = [v, stride](int is)
+  { return v[static_cast<std::size_t>(is) * stride]; };
+
+  amp = 0;
+  time = 0;
+  ped = 0;
+  chi2 = std::numeric_limits<float>::quiet_NaN();
+  if (nsamples == 2)
+  {
+    amp = value(1);
+    time = std::numeric_limits<float>::quiet_NaN();
+    ped = value(0);
+    if (value(0) != 0 && value(1) == 0)  // check if post-sample is 0, if so set high chi2
+    {
+      chi2 = 1000000;
+    }
+  }
+  else if (nsamples >= 3)
+  {
+    ped = (value(0) + value(1) + value(2)) / 3;
+    // if maxx <=5 nsample >=10 use the last two sample for pedestal(for HCal TP)
+    if (maxx <= 5 && nsamples >= 10)
+    {
+      ped = 0.5 * (value(nsamples - 2) + value(nsamples - 1));
+    }
+    if (maxx == 0 || maxx == nsamples - 1)
+    {
+      amp = value(maxx);
+      time = maxx;
+    }
+    else
+    {
+      FastMax(maxx - 1, maxx, maxx + 1, value(maxx - 1), value(maxx), value(maxx + 1), time, amp);
+    }
+  }
+  amp -= ped;
+}
+
 std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_fast(const std::vector<std::vector<float>> &chnlvector)
 {
   std::vector<std::vector<float>> fit_values;
   int nchnls = chnlvector.size();
+  fit_values.reserve(nchnls);
   for (int m = 0; m < nchnls; m++)
   {
-    const std::vector<float> &v = chnlvector.at(m);
-    int nsamples = v.size();
-
-    double maxy = v.at(0);
+    const std::vector<float> &v = chnlvector[m];
+    const int nsamples = v.size();
+    const int maxx = nsamples ? std::distance(v.begin(), std::max_element(v.begin(), v.end())) : 0;
     float amp = 0;
     float time = 0;
     float ped = 0;
-    float chi2 = std::numeric_limits<float>::quiet_NaN();
-    if (nsamples == 2)
-    {
-      amp = v.at(1);
-      time = std::numeric_limits<float>::quiet_NaN();
-      ped = v.at(0);
-      if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
-      {
-        chi2 = 1000000;
-      }
-    }
-    else if (nsamples >= 3)
-    {
-      int maxx = 0;
-      for (int i = 0; i < nsamples; i++)
-      {
-        if (i < 3)
-        {
-          ped += v.at(i);
-        }
-        if (v.at(i) > maxy)
-        {
-          maxy = v.at(i);
-          maxx = i;
-        }
-      }
-      ped /= 3;
-      // if maxx <=5 nsample >=10 use the last two sample for pedestal(for HCal TP)
-      if (maxx <= 5 && nsamples >= 10)
-      {
-        ped = 0.5 * (v.at(nsamples - 2) + v.at(nsamples - 1));
-      }
-      if (maxx == 0 || maxx == nsamples - 1)
-      {
-        amp = maxy;
-        time = maxx;
-      }
-      else
-      {
-        FastMax(maxx - 1, maxx, maxx + 1, v.at(maxx - 1), v.at(maxx), v.at(maxx + 1), time, amp);
-      }
-    }
-    amp -= ped;
-    std::vector<float> val = {amp, time, ped, chi2, 0, 0};
-    fit_values.push_back(val);
-    val.clear();
+    float chi2 = 0;
+    fast_result(v.data(), 1, nsamples, maxx, amp, time, ped, chi2);
+    fit_values.push_back({amp, time, ped, chi2, 0, 0});
   }
   return fit_values;
 }
@@ -453,9 +543,10 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_nyquist(con
 {
   std::vector<std::vector<float>> fit_values;
   int nchnls = chnlvector.size();
+  fit_values.reserve(nchnls);
   for (int m = 0; m < nchnls; m++)
   {
-    std::vector<float> v = chnlvector.at(m);
+    const std::vector<float> &v = chnlvector[m];
     int nsamples = (int) v.size();
 
     if (nsamples == 2)
@@ -469,18 +560,148 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_nyquist(con
       continue;
     }
 
-    std::vector<float> result = NyquistInterpolation(v);
+    const int maxx = std::distance(v.begin(), std::max_element(v.begin(), v.end()));
+    std::vector<float> result(NFITVALUES, 0);
+    NyquistInterpolation(v.data(), 1, nsamples, maxx, result[0], result[1], result[2], result[3]);
     fit_values.push_back(result);
   }
   return fit_values;
 }
-// mabye I can find a way to make it thread safe
-std::vector<float> CaloWaveformFitting::NyquistInterpolation(std::vector<float> &vec_signal_samples)
+
+void CaloWaveformFitting::WaveformBatch::reset(int max_channels, int max_samples)
+{
+  nchannels = 0;
+  capacity = max_channels;
+  maxsamples = max_samples;
+  samples.assign(static_cast<std::size_t>(capacity) * maxsamples, std::numeric_limits<float>::lowest());
+  resize_channels();
+}
+
+void CaloWaveformFitting::WaveformBatch::resize_channels()
+{
+  nsamples.resize(capacity);
+  amplitude.resize(capacity);
+  time.resize(capacity);
+  pedestal.resize(capacity);
+  chi2.resize(capacity);
+  maxvalue.resize(capacity);
+  maxsample.resize(capacity);
+}
+
+int CaloWaveformFitting::WaveformBatch::add_channel(int n, float value)
+{
+  if (nchannels == capacity)
+  {
+    // more channels than announced: move the samples to a larger layout
+    const int new_capacity = std::max(2 * capacity, 64);
+    std::vector<float> new_samples(static_cast<std::size_t>(new_capacity) * maxsamples, std::numeric_limits<float>::lowest());
+    for (int is = 0; is < maxsamples; ++is)
+    {
+      const auto first = samples.begin() + static_cast<std::size_t>(is) * capacity;
+      std::copy(first, first + nchannels, new_samples.begin() + static_cast<std::size_t>(is) * new_capacity);
+    }
+    samples.swap(new_samples);
+    capacity = new_capacity;
+    resize_channels();
+  }
+
+  const int ich = nchannels++;
+  n = std::min(n, maxsamples);
+  nsamples[ich] = n;
+  for (int is = 0; is < n; ++is)
+  {
+    set_sample(ich, is, value);
+  }
+  return ich;
+}
+
+void CaloWaveformFitting::WaveformBatch::find_maximum()
+{
+  // maximum sample of all channels at once. The loop over channels is branch free and
+  // contiguous in memory, so it is vectorized. Padding is lowest float, so never selected,
+  // and the strict comparison keeps the first maximum, as std::max_element
+  const float *first = samples.data();
+  std::copy(first, first + nchannels, maxvalue.begin());
+  std::fill(maxsample.begin(), maxsample.begin() + nchannels, 0);
+  for (int is = 1; is < maxsamples; ++is)
+  {
+    const float *row = first + static_cast<std::size_t>(is) * capacity;
+    float *maxv = maxvalue.data();
+    int *maxi = maxsample.data();
+    for (int ich = 0; ich < nchannels; ++ich)
+    {
+      const bool greater = row[ich] > maxv[ich];
+      maxv[ich] = greater ? row[ich] : maxv[ich];
+      maxi[ich] = greater ? is : maxi[ich];
+    }
+  }
+}
+
+void CaloWaveformFitting::calo_processing_fast(WaveformBatch &batch)
+{
+  // samples are read in place, every capacity values
+  batch.find_maximum();
+  for (int ich = 0; ich < batch.nchannels; ++ich)
+  {
+    fast_result(batch.waveform(ich), batch.capacity, batch.nsamples[ich], batch.maxsample[ich], batch.amplitude[ich], batch.time[ich], batch.pedestal[ich], batch.chi2[ich]);
+  }
+}
+
+void CaloWaveformFitting::calo_processing_nyquist(WaveformBatch &batch)
 {
-  // int N = (int) vec_signal_samples.size();
-  auto max_elem_iter = std::max_element(vec_signal_samples.begin(), vec_signal_samples.end());
-  int maxx = std::distance(vec_signal_samples.begin(), max_elem_iter);
-  float max = *max_elem_iter;
+  // samples are read in place, every capacity values
+  batch.find_maximum();
+  for (int ich = 0; ich < batch.nchannels; ++ich)
+  {
+    const int nsamples = batch.nsamples[ich];
+    if (nsamples == 2)
+    {
+      const float pre = batch.sample(ich, 0);
+      const float post = batch.sample(ich, 1);
+      batch.amplitude[ich] = post - pre;
+      batch.time[ich] = std::numeric_limits<float>::quiet_NaN();
+      batch.pedestal[ich] = pre;
+      // check if post-sample is 0, if so set high chi2
+      batch.chi2[ich] = (pre != 0 && post == 0) ? 1000000 : std::numeric_limits<float>::quiet_NaN();
+      continue;
+    }
+    NyquistInterpolation(batch.waveform(ich), batch.capacity, nsamples, batch.maxsample[ich], batch.amplitude[ich], batch.time[ich], batch.pedestal[ich], batch.chi2[ich]);
+  }
+}
+
+const std::vector<double> &CaloWaveformFitting::psinc_kernel(int N)
+{
+  auto iter = m_psinc_kernels.find(N);
+  if (iter != m_psinc_kernels.end())
+  {
+    return iter->second;
+  }
+
+  // kernel sampled at u = j / PSINC_DIVISIONS for u in [-N, N]
+  std::vector<double> kernel(2 * N * PSINC_DIVISIONS + 1);
+  for (int j = 0; j < (int) kernel.size(); ++j)
+  {
+    const double u = static_cast<double>(j - N * PSINC_DIVISIONS) / PSINC_DIVISIONS;
+    if (j % PSINC_DIVISIONS == 0)
+    {
+      // integer u, where the closed form is 0/0. Not used by psinc, which returns the sample itself
+      kernel[j] = (N % 2 == 0) ? Dkernel(u, N) : Dkernelodd(u, N);
+      continue;
+    }
+    const double piu = M_PI * u;
+    const double piuN = piu / N;
+    kernel[j] = (N % 2 == 0) ? std::sin(piu) / std::tan(piuN) / N : std::sin(piu) / std::sin(piuN) / N;
+  }
+  return m_psinc_kernels.emplace(N, std::move(kernel)).first->second;
+}
+
+void CaloWaveformFitting::NyquistInterpolation(const float *vec_signal_samples, int stride, int N, int maxx, float &amplitude, float &time, float &pedestal, float &chi2)
+{
+  // the maximum search only evaluates the interpolation at multiples of 1/512,
+  // which use the precomputed kernel
+  const std::vector<double> &kernel = psinc_kernel(N);
+
+  float max = vec_signal_samples[static_cast<std::size_t>(maxx) * stride];
 
   float maxpos = maxx;
   float steplength = 0.5;
@@ -496,7 +717,7 @@ std::vector<float> CaloWaveformFitting::NyquistInterpolation(std::vector<float>
       float yval = max;
       if (i != maxpos)
       {
-        yval = psinc(i, vec_signal_samples);
+        yval = psinc(i, vec_signal_samples, stride, N, &kernel);
       }
       if (yval > max)
       {
@@ -507,19 +728,19 @@ std::vector<float> CaloWaveformFitting::NyquistInterpolation(std::vector<float>
     steplength /= 2;
   }
 
-  float pedestal = 0;
+  pedestal = 0;
 
   if (maxpos > 5)
   {
     for (int i = 0; i < 3; i++)
     {
-      pedestal += vec_signal_samples[i];
+      pedestal += vec_signal_samples[static_cast<std::size_t>(i) * stride];
     }
     pedestal = pedestal / 3;
   }
   else if (maxpos > 4)
   {
-    pedestal = (vec_signal_samples[0] + vec_signal_samples[1]) / 2;
+    pedestal = (vec_signal_samples[0] + vec_signal_samples[stride]) / 2;
   }
   // need more consideration for what is the most effieicnt
   else
@@ -527,21 +748,21 @@ std::vector<float> CaloWaveformFitting::NyquistInterpolation(std::vector<float>
     pedestal = max;
     for (float i = maxpos - 5; i < maxpos; i += 0.1)
     {
-      float yval = psinc(i, vec_signal_samples);
+      float yval = psinc(i, vec_signal_samples, stride, N, &kernel);
       pedestal = std::min(yval, pedestal);
     }
   }
   // calculate chi2 using the tempalte
-  float chi2 = 0;
+  chi2 = 0;
   double par[3] = {max - pedestal, maxpos - m_peakTimeTemp, pedestal};
-  for (int i = 0; i < (int) vec_signal_samples.size(); i++)
+  for (int i = 0; i < N; i++)
   {
     double xval[1] = {(double) i};
-    float diff = vec_signal_samples[i] - template_function(xval, par);
+    float diff = vec_signal_samples[static_cast<std::size_t>(i) * stride] - template_function(xval, par);
     chi2 += diff * diff;
   }
-  std::vector<float> val = {max - pedestal, maxpos, pedestal, chi2, 0, 0};
-  return val;
+  amplitude = max - pedestal;
+  time = maxpos;
 }
 
 // for odd N
@@ -571,39 +792,54 @@ double CaloWaveformFitting::Dkernel(double x, int N)
   return sum;
 }
 
-float CaloWaveformFitting::stablepsinc(float time, std::vector<float> &vec_signal_samples)
+float CaloWaveformFitting::stablepsinc(float time, const float *vec_signal_samples, int stride, int N)
 {
-  int N = (int) vec_signal_samples.size();
   float sum = 0;
   if (N % 2 == 0)
   {
     for (int n = 0; n < N; n++)
     {
-      sum += vec_signal_samples[n] * Dkernel(time - n, N);
+      sum += vec_signal_samples[static_cast<std::size_t>(n) * stride] * Dkernel(time - n, N);
     }
   }
   else
   {
     for (int n = 0; n < N; n++)
     {
-      sum += vec_signal_samples[n] * Dkernelodd(time - n, N);
+      sum += vec_signal_samples[static_cast<std::size_t>(n) * stride] * Dkernelodd(time - n, N);
     }
   }
   return sum;
 }
 
-float CaloWaveformFitting::psinc(float time, std::vector<float> &vec_signal_samples)
+float CaloWaveformFitting::psinc(float time, const float *vec_signal_samples, int stride, int N, const std::vector<double> *kernel)
 {
-  int N = (int) vec_signal_samples.size();
-
   if (std::abs(std::round(time) - time) < 1e-6)
   {
     if (time < 0 || time >= N)
     {
-      return stablepsinc(time, vec_signal_samples);
+      return stablepsinc(time, vec_signal_samples, stride, N);
     }
 
-    return vec_signal_samples.at(std::round(time));
+    return vec_signal_samples[static_cast<std::size_t>(std::round(time)) * stride];
+  }
+
+  // use precomputed kernel when time falls on its grid
+  const double scaled = static_cast<double>(time) * PSINC_DIVISIONS;
+  if (kernel && scaled == std::floor(scaled) && time > -N && time < N)
+  {
+    const int offset = static_cast<int>(scaled) + N * PSINC_DIVISIONS;
+    const int last = offset - (N - 1) * PSINC_DIVISIONS;
+    if (last >= 0 && offset < (int) kernel->size())
+    {
+      const double *k = kernel->data();
+      float sum = 0;
+      for (int n = 0; n < N; n++)
+      {
+        sum += vec_signal_samples[static_cast<std::size_t>(n) * stride] * k[offset - n * PSINC_DIVISIONS];
+      }
+      return sum;
+    }
   }
 
   float sum = 0;
@@ -613,7 +849,7 @@ float CaloWaveformFitting::psinc(float time, std::vector<float> &vec_signal_samp
     {
       double piu = M_PI * (time - n);
       double piuN = piu / N;
-      sum += vec_signal_samples[n] * std::sin(piu) / (std::tan(piuN)) / N;
+      sum += vec_signal_samples[static_cast<std::size_t>(n) * stride] * std::sin(piu) / (std::tan(piuN)) / N;
     }
   }
   else
@@ -622,7 +858,7 @@ float CaloWaveformFitting::psinc(float time, std::vector<float> &vec_signal_samp
     {
       double piu = M_PI * (time - n);
       double piuN = piu / N;
-      sum += vec_signal_samples[n] * std::sin(piu) / (std::sin(piuN)) / N;
+      sum += vec_signal_samples[static_cast<std::size_t>(n) * stride] * std::sin(piu) / (std::sin(piuN)) / N;
     }
   }
 
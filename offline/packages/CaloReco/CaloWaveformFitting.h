@@ -1,6 +1,11 @@
 #ifndef CALORECO_CALOWAVEFORMFITTING_H
 #define CALORECO_CALOWAVEFORMFITTING_H
 
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -16,9 +21,78 @@ class CaloWaveformFitting
     FERMIEXP = 2,
   };
 
-  CaloWaveformFitting() = default;
+  //! number of values returned per channel: amplitude, time, pedestal, chi2, recovered flag, fit status
+  static constexpr int NFITVALUES = 6;
+
+  //! waveforms of a set of channels (e.g. all channels of a packet) in one contiguous buffer
+  /*!
+  samples are stored sample-major, samples[isample * capacity + ichannel],
+  so that per-channel operations run over all channels at once and vectorize.
+  Samples past the length of a channel (zero suppressed channels only have pre and post samples)
+  are padded with the lowest float.
+  Channels are added one at a time, and their samples written in place.
+  The buffers are reused from one event to the next.
+  */
+  class WaveformBatch
+  {
+   public:
+    //! remove all channels, and allocate for max_channels, with at most max_samples each
+    /*! more channels can be added, at the cost of a reallocation */
+    void reset(int max_channels, int max_samples);
+
+    //! add a channel with n samples, all set to value. Returns its index
+    int add_channel(int n, float value = std::numeric_limits<float>::lowest());
+
+    //! set a sample of a channel
+    void set_sample(int ich, int is, float value)
+    {
+      samples[static_cast<std::size_t>(is) * capacity + ich] = value;
+    }
+
+    //! sample of a channel
+    float sample(int ich, int is) const
+    {
+      return samples[static_cast<std::size_t>(is) * capacity + ich];
+    }
+
+    //! first sample of a channel. Next samples are every capacity values
+    const float *waveform(int ich) const
+    {
+      return samples.data() + ich;
+    }
+
+    //! find maximum sample of all channels
+    void find_maximum();
+
+    int nchannels{0};
+    int capacity{0};
+    int maxsamples{0};
+    std::vector<float> samples;
+    std::vector<int> nsamples;
+
+    //!@name processing output, one entry per channel
+    //@{
+    std::vector<float> amplitude;
+    std::vector<float> time;
+    std::vector<float> pedestal;
+    std::vector<float> chi2;
+    //@}
+
+    //! maximum sample value and position, for each channel
+    std::vector<float> maxvalue;
+    std::vector<int> maxsample;
+
+   private:
+    //! resize all per channel arrays to capacity
+    void resize_channels();
+  };
+
+  CaloWaveformFitting();
   ~CaloWaveformFitting();
 
+  CaloWaveformFitting(const CaloWaveformFitting &) = delete;
+  CaloWaveformFitting &operator=(const CaloWaveformFitting &) = delete;
+
   void set_template_file(const std::string &template_input_file)
   {
     m_template_input_file = template_input_file;
@@ -64,10 +138,30 @@ class CaloWaveformFitting
     _handleSaturation = handleSaturation;
   }
 
-  std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
-  std::vector<std::vector<float>> calo_processing_templatefit(std::vector<std::vector<float>> chnlvector);
+  //! use the analytic template fit. Off by default.
+  /*!
+  For a given time the amplitude and pedestal are linear parameters,
+  solved in closed form, so that only a 1-D minimization over time is needed.
+  When false, the full 3 parameter fit is done with the ROOT GSL fitter
+  */
+  void set_analyticTemplateFit(bool analytic = true)
+  {
+    _analytic_templatefit = analytic;
+  }
+
+  std::vector<std::vector<float>> process_waveform(const std::vector<std::vector<float>> &waveformvector);
+  std::vector<std::vector<float>> calo_processing_templatefit(const std::vector<std::vector<float>> &chnlvector);
+
+  //! template fit of a single waveform, read in place from any buffer
+  /*! writes NFITVALUES values to result. Thread safe */
+  void calo_processing_templatefit(const float *samples, int nsamples, float *result);
+
   static std::vector<std::vector<float>> calo_processing_fast(const std::vector<std::vector<float>> &chnlvector);
   std::vector<std::vector<float>> calo_processing_nyquist(const std::vector<std::vector<float>> &chnlvector);
+
+  //! batch processing, results are stored in the batch output arrays
+  static void calo_processing_fast(WaveformBatch &batch);
+  void calo_processing_nyquist(WaveformBatch &batch);
   std::vector<std::vector<float>> calo_processing_funcfit(const std::vector<std::vector<float>> &chnlvector);
 
   void initialize_processing(const std::string &templatefile);
@@ -98,18 +192,80 @@ class CaloWaveformFitting
   }
 
  private:
+  //! result of the fit of the template to one waveform
+  struct TemplateFitResult
+  {
+    double amplitude{0};
+    double time{0};
+    double pedestal{0};
+    double chi2{0};
+    int status{0};
+  };
+
+  //! ROOT fit objects, preallocated and reused across channels and events
+  struct TemplateFitter;
+
+  //! fit template using closed form amplitude and pedestal and 1-D minimization over time
+  TemplateFitResult fit_template_analytic(const float *samples, int nsamples, bool skip_saturated, double time_low, double time_high) const;
+
+  //! fit template using ROOT GSL fitter
+  TemplateFitResult fit_template_root(const float *samples, int nsamples, bool skip_saturated, double time_low, double time_high, const double *params);
+
+  //! template value at a given time, linearly interpolated between bin centers as TH1::Interpolate
+  double template_value(double x) const
+  {
+    const double u = (x - m_template_x0) * m_template_invdx;
+    if (!(u > 0))
+    {
+      return m_template_values.front();
+    }
+    const int n = m_template_values.size();
+    if (u >= n - 1)
+    {
+      return m_template_values.back();
+    }
+    const int i = static_cast<int>(u);
+    const double f = u - i;
+    return m_template_values[i] + f * (m_template_values[i + 1] - m_template_values[i]);
+  }
+
+  //! number of subdivisions per sample of the precomputed psinc kernels
+  static constexpr int PSINC_DIVISIONS = 512;
+
   static void FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax);
-  std::vector<float> NyquistInterpolation(std::vector<float> &vec_signal_samples);
+
+  //! fast processing of one waveform, with maxx the position of its maximum. Samples are every stride values
+  static void fast_result(const float *v, int stride, int nsamples, int maxx, float &amp, float &time, float &ped, float &chi2);
+
+  void NyquistInterpolation(const float *vec_signal_samples, int stride, int N, int maxx, float &amplitude, float &time, float &pedestal, float &chi2);
   static double Dkernelodd(double x, int N);
   static double Dkernel(double x, int N);
 
-  static float stablepsinc(float t, std::vector<float> &vec_signal_samples);
+  static float stablepsinc(float t, const float *vec_signal_samples, int stride, int N);
+
+  //! periodic sinc interpolation of the samples at time t. Uses the precomputed kernel when t falls on its grid
+  static float psinc(float t, const float *vec_signal_samples, int stride, int N, const std::vector<double> *kernel = nullptr);
 
-  static float psinc(float t, std::vector<float> &vec_signal_samples);
+  //! periodic sinc kernel for N samples, tabulated every 1/PSINC_DIVISIONS sample over [-N, N]
+  const std::vector<double> &psinc_kernel(int N);
   double template_function(double *x, double *par);
 
   TProfile *h_template{nullptr};
   double m_peakTimeTemp{0};
+
+  //! template bin contents and binning, copied from h_template for fast interpolation
+  std::vector<double> m_template_values;
+  double m_template_x0{0};
+  double m_template_invdx{1};
+
+  //! precomputed psinc kernels, indexed by number of samples
+  std::map<int, std::vector<double>> m_psinc_kernels;
+
+  //! pool of ROOT fitters, one per concurrently running thread
+  std::vector<std::unique_ptr<TemplateFitter>> m_fitters;
+  std::mutex m_fitters_mutex;
+  int m_nfitters{0};
+
   int _nthreads{1};
   int _nzerosuppresssamples{2};
   int _nsoftwarezerosuppression{40};
@@ -125,6 +281,7 @@ class CaloWaveformFitting
   bool m_setTimeLim{false};
   bool _dobitfliprecovery{false};
   bool _handleSaturation{true};
+  bool _analytic_templatefit{false};
 
   std::string m_template_input_file;
   std::string url_template;
@@ -51,6 +51,7 @@ void CaloWaveformProcessing::initialize_processing()
     {
       m_Fitter->set_bitFlipRecovery(_dobitfliprecovery);
     }
+    m_Fitter->set_analyticTemplateFit(_analytic_templatefit);
   }
   else if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
@@ -80,16 +81,11 @@ void CaloWaveformProcessing::initialize_processing()
   }
 }
 
-std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::vector<std::vector<float>> waveformvector)
+std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(const std::vector<std::vector<float>> &waveformvector)
 {
-  unsigned int size1 = waveformvector.size();
   std::vector<std::vector<float>> fitresults;
   if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT)
   {
-    for (unsigned int i = 0; i < size1; i++)
-    {
-      waveformvector.at(i).push_back((float) i);
-    }
     fitresults = m_Fitter->calo_processing_templatefit(waveformvector);
   }
   if (m_processingtype == CaloWaveformProcessing::ONNX)
@@ -111,6 +107,22 @@ std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::ve
   return fitresults;
 }
 
+void CaloWaveformProcessing::process_waveform(CaloWaveformFitting::WaveformBatch &batch)
+{
+  if (m_processingtype == CaloWaveformProcessing::FAST)
+  {
+    CaloWaveformFitting::calo_processing_fast(batch);
+  }
+  else if (m_processingtype == CaloWaveformProcessing::NYQUIST)
+  {
+    m_Fitter->calo_processing_nyquist(batch);
+  }
+  else
+  {
+    std::cout << "CaloWaveformProcessing::process_waveform - batch processing not available for processing type " << m_processingtype << std::endl;
+  }
+}
+
 std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector)
 {
   std::vector<std::vector<float>> fit_values;
@@ -1,6 +1,8 @@
 #ifndef CALORECO_CALOWAVEFORMPROCESSING_H
 #define CALORECO_CALOWAVEFORMPROCESSING_H
 
+#include "CaloWaveformFitting.h"
+
 #include <fun4all/SubsysReco.h>
 
 #include <array>
@@ -76,6 +78,12 @@ class CaloWaveformProcessing : public SubsysReco
     _dobitfliprecovery = dobitfliprecovery;
   }
 
+  //! use analytic template fit rather than the ROOT GSL fitter. Off by default
+  void set_analyticTemplateFit(bool analytic = true)
+  {
+    _analytic_templatefit = analytic;
+  }
+
   // Functional fit options: 0 = PowerLawExp, 1 = PowerLawDoubleExp
   void set_funcfit_type(int type)
   {
@@ -96,7 +104,16 @@ class CaloWaveformProcessing : public SubsysReco
     _doubleexp_ratio = ratio;
   }
 
-  std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
+  std::vector<std::vector<float>> process_waveform(const std::vector<std::vector<float>> &waveformvector);
+
+  //! true if the processing type can process a WaveformBatch (FAST and NYQUIST)
+  bool has_batch_processing() const
+  {
+    return m_processingtype == CaloWaveformProcessing::FAST || m_processingtype == CaloWaveformProcessing::NYQUIST;
+  }
+
+  //! process all waveforms of a batch. Results are stored in the batch
+  void process_waveform(CaloWaveformFitting::WaveformBatch &batch);
   std::vector<std::vector<float>> calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector);
 
   void initialize_processing();
@@ -115,6 +132,7 @@ class CaloWaveformProcessing : public SubsysReco
   int _nsoftwarezerosuppression{40};
   bool _bdosoftwarezerosuppression{false};
   bool _dobitfliprecovery{false};
+  bool _analytic_templatefit{false};
 
   std::string m_template_input_file;
   std::string url_template;
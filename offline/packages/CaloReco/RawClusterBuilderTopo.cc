@@ -17,16 +17,17 @@
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>  // for abs
 #include <exception>
 #include <iostream>
 #include <iterator>  // for begin, end
-#include <list>
 #include <memory>  // for allocator_traits<>::valu...
 #include <stdexcept>
 #include <utility>
@@ -198,6 +199,402 @@ std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID(int ID)
   return adjacent_towers;
 }
 
+void RawClusterBuilderTopo::build_tower_grid()
+{
+  // EMCal IDs start after the EMCal grid size, which also covers both HCal layers
+  const int n_IDs = 2 * _EMCAL_NETA * _EMCAL_NPHI;
+
+  _tower_E.assign(n_IDs, 0);
+  _tower_key.assign(n_IDs, 0);
+  _tower_status.assign(n_IDs, -2);
+  _tower_parent.assign(n_IDs, 0);
+  _root_cluster.assign(n_IDs, -1);
+  _tower_ownership.assign(n_IDs, std::pair<int, int>(-1, -1));
+
+  // the neighbors only depend on the geometry and the configuration, look them up once
+  _neighbor_offsets.assign(n_IDs + 1, 0);
+  _neighbors.clear();
+  for (int ID = 0; ID < n_IDs; ID++)
+  {
+    bool valid_ID = (ID >= _EMCAL_NETA * _EMCAL_NPHI) || (ID < 2 * _HCAL_NETA * _HCAL_NPHI);
+    if (valid_ID)
+    {
+      std::vector<int> adjacent_towers = get_adjacent_towers_by_ID(ID);
+      _neighbors.insert(_neighbors.end(), adjacent_towers.begin(), adjacent_towers.end());
+    }
+    _neighbor_offsets[ID + 1] = _neighbors.size();
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "RawClusterBuilderTopo::build_tower_grid: " << n_IDs << " tower IDs with " << _neighbors.size() << " neighbors in total" << std::endl;
+  }
+}
+
+void RawClusterBuilderTopo::build_channel_map(TowerInfoContainer *towerinfos, int ilayer)
+{
+  static const RawTowerDefs::CalorimeterId caloid[3] = {RawTowerDefs::CalorimeterId::HCALIN, RawTowerDefs::CalorimeterId::HCALOUT, RawTowerDefs::CalorimeterId::CEMC};
+
+  unsigned int n_towers = towerinfos->size();
+  _channel_ID[ilayer].resize(n_towers);
+  _channel_key[ilayer].resize(n_towers);
+  for (unsigned int channel = 0; channel < n_towers; channel++)
+  {
+    unsigned int towerinfo_key = towerinfos->encode_key(channel);
+    int ti_ieta = towerinfos->getTowerEtaBin(towerinfo_key);
+    int ti_iphi = towerinfos->getTowerPhiBin(towerinfo_key);
+    const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(caloid[ilayer], ti_ieta, ti_iphi);
+
+    int ieta = ti_ieta;
+    int iphi = ti_iphi;
+    if (ilayer < 2)
+    {
+      // the HCal bins are taken from the geometry
+      RawTowerGeom *tower_geom = _geom_containers[ilayer]->get_tower_geometry(key);
+      ieta = _geom_containers[ilayer]->get_etabin(tower_geom->get_eta());
+      iphi = _geom_containers[ilayer]->get_phibin(tower_geom->get_phi());
+    }
+    _channel_ID[ilayer][channel] = get_ID(ilayer, ieta, iphi);
+    _channel_key[ilayer][channel] = key;
+  }
+}
+
+void RawClusterBuilderTopo::fill_tower_grid(TowerInfoContainer *towerinfos, int ilayer)
+{
+  static const char *layer_name[3] = {"IHCal", "OHCal", "EMCal"};
+
+  unsigned int n_towers = towerinfos->size();
+  if (_channel_ID[ilayer].size() != n_towers)
+  {
+    build_channel_map(towerinfos, ilayer);
+  }
+
+  for (unsigned int channel = 0; channel < n_towers; channel++)
+  {
+    TowerInfo *towerInfo = towerinfos->get_tower_at_channel(channel);
+    if (_only_good_towers && (!towerInfo->get_isGood()))
+    {
+      continue;
+    }
+    float this_E = towerInfo->get_energy();
+
+    // if not using abs E, short circuit all negative towers right here
+    if (!_use_absE && this_E < 1.E-10)
+    {
+      continue;
+    }
+
+    int ID = _channel_ID[ilayer][channel];
+    _tower_status[ID] = -1;  // change status to unknown
+    _tower_E[ID] = this_E;
+    _tower_key[ID] = _channel_key[ilayer][channel];
+
+    // use fabs() here for simplicity - if we're not using abs E, negative towers are already excluded
+    if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[ilayer])
+    {
+      _seeds.emplace_back(ID, this_E);
+      if (Verbosity() > 10)
+      {
+        std::cout << "RawClusterBuilderTopo::process_event: adding " << layer_name[ilayer] << " tower at ieta / iphi = " << get_ieta_from_ID(ID) << " / " << get_iphi_from_ID(ID) << " with E = " << this_E << std::endl;
+        std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID(ID) << " / " << get_ieta_from_ID(ID) << " / " << get_iphi_from_ID(ID) << std::endl;
+      }
+    }
+  }
+}
+
+int RawClusterBuilderTopo::grow_clusters_serial()
+{
+  int cluster_index = 0;  // begin counting clusters
+
+  for (unsigned int iseed = 0; iseed < _seeds.size(); iseed++)
+  {
+    int seed_ID = _seeds[iseed].first;
+
+    if (Verbosity() > 5)
+    {
+      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << _seeds.size() - iseed - 1 << std::endl;
+    }
+
+    // if this seed was already claimed by some other seed during its growth, remove it and do nothing
+    int seed_status = get_status_from_ID(seed_ID);
+    if (seed_status > -1)
+    {
+      if (Verbosity() > 10)
+      {
+        std::cout << " --> already owned by cluster # " << seed_status << std::endl;
+      }
+      continue;  // go onto the next iteration of the loop
+    }
+
+    // this seed tower now owned by new cluster
+    set_status_by_ID(seed_ID, cluster_index);
+
+    if (_cluster_towers.size() <= static_cast<unsigned int>(cluster_index))
+    {
+      _cluster_towers.emplace_back();
+    }
+    std::vector<int> &cluster_tower_ID = _cluster_towers[cluster_index];
+    cluster_tower_ID.push_back(seed_ID);
+
+    // iteratively process growth towers, adding > 2 * sigma neighbors to the list for further checking
+    // the towers from igrow on are the ones still to be processed
+
+    if (Verbosity() > 5)
+    {
+      std::cout << " RawClusterBuilderTopo::process_event: Entering Growth stage for cluster " << cluster_index << std::endl;
+    }
+
+    for (unsigned int igrow = 0; igrow < cluster_tower_ID.size(); igrow++)
+    {
+      int grow_ID = cluster_tower_ID[igrow];
+
+      if (Verbosity() > 5)
+      {
+        std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << cluster_tower_ID.size() - igrow - 1 << " grow towers left" << std::endl;
+      }
+
+      for (int this_adjacent_tower_ID : get_adjacent_towers(grow_ID))
+      {
+        if (Verbosity() > 10)
+        {
+          std::cout << " --> --> --> checking possible adjacent tower with ID " << this_adjacent_tower_ID << " : ";
+        }
+        int test_layer = get_ilayer_from_ID(this_adjacent_tower_ID);
+
+        // if tower does not exist, continue
+        if (get_status_from_ID(this_adjacent_tower_ID) == -2)
+        {
+          if (Verbosity() > 10)
+          {
+            std::cout << "does not exist " << std::endl;
+          }
+          continue;
+        }
+
+        // if tower is owned by THIS cluster already, continue
+        if (get_status_from_ID(this_adjacent_tower_ID) == cluster_index)
+        {
+          if (Verbosity() > 10)
+          {
+            std::cout << "already owned by this cluster index " << cluster_index << std::endl;
+          }
+          continue;
+        }
+
+        // if tower has < 2*sigma energy, continue
+        if (std::fabs(get_E_from_ID(this_adjacent_tower_ID)) < _sigma_grow * _noise_LAYER[test_layer])
+        {
+          if (Verbosity() > 10)
+          {
+            std::cout << "E = " << get_E_from_ID(this_adjacent_tower_ID) << " under 2*sigma threshold " << std::endl;
+          }
+          continue;
+        }
+
+        // if tower is owned by somebody else, continue (although should this really happen?)
+        if (get_status_from_ID(this_adjacent_tower_ID) > -1)
+        {
+          if (Verbosity() > 10)
+          {
+            std::cout << "ERROR! in growth stage, encountered >2sigma tower which is already owned?!" << std::endl;
+          }
+          continue;
+        }
+
+        // tower good to be added to cluster and to list of grow towers
+        cluster_tower_ID.push_back(this_adjacent_tower_ID);
+        set_status_by_ID(this_adjacent_tower_ID, cluster_index);
+        if (Verbosity() > 10)
+        {
+          std::cout << "add this tower ( ID " << this_adjacent_tower_ID << " ) to grow list " << std::endl;
+        }
+      }
+
+      if (Verbosity() > 5)
+      {
+        std::cout << " --> after examining neighbors, grow list is now " << cluster_tower_ID.size() - igrow - 1 << ", # of towers in cluster = " << cluster_tower_ID.size() << std::endl;
+      }
+    }
+
+    add_perimeter_towers(cluster_index);
+
+    // increment cluster index for next one
+    cluster_index++;
+  }
+
+  return cluster_index;
+}
+
+int RawClusterBuilderTopo::grow_clusters_parallel()
+{
+  // label the connected components of the towers above the growth threshold
+  const int n_IDs = _tower_status.size();
+  for (int ID = 0; ID < n_IDs; ID++)
+  {
+    if (is_growth_tower(ID))
+    {
+      _tower_parent[ID] = ID;
+      _root_cluster[ID] = -1;
+    }
+  }
+  for (int ID = 0; ID < n_IDs; ID++)
+  {
+    if (!is_growth_tower(ID))
+    {
+      continue;
+    }
+    for (int this_adjacent_tower_ID : get_adjacent_towers(ID))
+    {
+      if (this_adjacent_tower_ID < ID && is_growth_tower(this_adjacent_tower_ID))
+      {
+        int root1 = find_root(ID);
+        int root2 = find_root(this_adjacent_tower_ID);
+        if (root1 != root2)
+        {
+          _tower_parent[std::max(root1, root2)] = std::min(root1, root2);
+        }
+      }
+    }
+  }
+
+  // the highest seed of each component starts a cluster, the others are absorbed by its growth
+  _cluster_seeds.clear();
+  for (const auto &seed : _seeds)
+  {
+    int root = find_root(seed.first);
+    if (_root_cluster[root] > -1)
+    {
+      continue;
+    }
+    int cluster_index = _cluster_seeds.size();
+    _root_cluster[root] = cluster_index;
+    _cluster_seeds.push_back(seed.first);
+
+    // this seed tower now owned by new cluster
+    set_status_by_ID(seed.first, cluster_index);
+    if (_cluster_towers.size() <= static_cast<unsigned int>(cluster_index))
+    {
+      _cluster_towers.emplace_back();
+    }
+    _cluster_towers[cluster_index].push_back(seed.first);
+  }
+
+  // a core only reaches the towers of its own component, so the cores can be
+  // grown independently and give the same tower lists as the serial growth
+  const int n_clusters = _cluster_seeds.size();
+  auto grow_core = [this](std::size_t cluster_index, unsigned int /*worker*/)
+  {
+    std::vector<int> &cluster_tower_ID = _cluster_towers[cluster_index];
+    for (unsigned int igrow = 0; igrow < cluster_tower_ID.size(); igrow++)
+    {
+      int grow_ID = cluster_tower_ID[igrow];
+      for (int this_adjacent_tower_ID : get_adjacent_towers(grow_ID))
+      {
+        if (get_status_from_ID(this_adjacent_tower_ID) == -1 && is_growth_tower(this_adjacent_tower_ID))
+        {
+          cluster_tower_ID.push_back(this_adjacent_tower_ID);
+          set_status_by_ID(this_adjacent_tower_ID, cluster_index);
+        }
+      }
+    }
+  };
+  if (_pool && n_clusters > 1)
+  {
+    _pool->parallel_for(n_clusters, grow_core);
+  }
+  else
+  {
+    for (int cluster_index = 0; cluster_index < n_clusters; cluster_index++)
+    {
+      grow_core(cluster_index, 0);
+    }
+  }
+
+  // the perimeter towers go to the first cluster reaching them
+  for (int cluster_index = 0; cluster_index < n_clusters; cluster_index++)
+  {
+    add_perimeter_towers(cluster_index);
+  }
+
+  return n_clusters;
+}
+
+void RawClusterBuilderTopo::add_perimeter_towers(int cluster_index)
+{
+  std::vector<int> &cluster_tower_ID = _cluster_towers[cluster_index];
+
+  // done growing cluster, now add on perimeter towers with E > 0 * sigma
+  if (Verbosity() > 5)
+  {
+    std::cout << " RawClusterBuilderTopo::process_event: Entering Perimeter stage for cluster " << cluster_index << std::endl;
+  }
+  // we'll be adding on to the cluster list, so get the # of core towers first
+  int n_core_towers = cluster_tower_ID.size();
+
+  for (int ic = 0; ic < n_core_towers; ic++)
+  {
+    int core_ID = cluster_tower_ID.at(ic);
+
+    if (Verbosity() > 5)
+    {
+      std::cout << " --> cluster " << cluster_index << ", perimeter stage, examining neighbors of ID " << core_ID << ", core cluster # " << ic << " of " << n_core_towers << " total " << std::endl;
+    }
+
+    for (int this_adjacent_tower_ID : get_adjacent_towers(core_ID))
+    {
+      if (Verbosity() > 10)
+      {
+        std::cout << " --> --> --> checking possible adjacent tower with ID " << this_adjacent_tower_ID << " : ";
+      }
+
+      int test_layer = get_ilayer_from_ID(this_adjacent_tower_ID);
+
+      // if tower does not exist, continue
+      if (get_status_from_ID(this_adjacent_tower_ID) == -2)
+      {
+        if (Verbosity() > 10)
+        {
+          std::cout << "does not exist " << std::endl;
+        }
+        continue;
+      }
+
+      // if tower is owned by somebody else (including current cluster), continue. ( allowed during perimeter fixing state )
+      if (get_status_from_ID(this_adjacent_tower_ID) > -1)
+      {
+        if (Verbosity() > 10)
+        {
+          std::cout << "already owned by other cluster index " << get_status_from_ID(this_adjacent_tower_ID) << std::endl;
+        }
+        continue;
+      }
+
+      // if tower has < 0*sigma energy, continue
+      if (std::fabs(get_E_from_ID(this_adjacent_tower_ID)) < _sigma_peri * _noise_LAYER[test_layer])
+      {
+        if (Verbosity() > 10)
+        {
+          std::cout << "E = " << get_E_from_ID(this_adjacent_tower_ID) << " under 0*sigma threshold " << std::endl;
+        }
+        continue;
+      }
+
+      // perimeter tower good to be added to cluster
+      cluster_tower_ID.push_back(this_adjacent_tower_ID);
+      set_status_by_ID(this_adjacent_tower_ID, cluster_index);
+      if (Verbosity() > 10)
+      {
+        std::cout << "add this tower ( ID " << this_adjacent_tower_ID << " ) to cluster " << std::endl;
+      }
+    }
+
+    if (Verbosity() > 5)
+    {
+      std::cout << " --> after examining perimeter neighbors, # of towers in cluster is now = " << cluster_tower_ID.size() << std::endl;
+    }
+  }
+}
+
 void RawClusterBuilderTopo::export_single_cluster(const std::vector<int> &original_towers)
 {
   if (Verbosity() > 2)
@@ -205,17 +602,16 @@ void RawClusterBuilderTopo::export_single_cluster(const std::vector<int> &origin
     std::cout << "RawClusterBuilderTopo::export_single_cluster called " << std::endl;
   }
 
-  std::map<int, std::pair<int, int> > tower_ownership;
   for (const int &original_tower : original_towers)
   {
-    tower_ownership[original_tower] = std::pair<int, int>(0, -1);  // all towers owned by cluster 0
+    _tower_ownership[original_tower] = std::pair<int, int>(0, -1);  // all towers owned by cluster 0
   }
-  export_clusters(original_towers, tower_ownership, 1, std::vector<float>(), std::vector<float>(), std::vector<float>());
+  export_clusters(original_towers, 1, std::vector<float>(), std::vector<float>(), std::vector<float>());
 
   return;
 }
 
-void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_towers, std::map<int, std::pair<int, int> > tower_ownership, unsigned int n_clusters, const std::vector<float> &pseudocluster_sumE, const std::vector<float> &pseudocluster_eta, const std::vector<float> &pseudocluster_phi)
+void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_towers, unsigned int n_clusters, const std::vector<float> &pseudocluster_sumE, const std::vector<float> &pseudocluster_eta, const std::vector<float> &pseudocluster_phi)
 {
   if (n_clusters != 1)  // if we didn't just pass down from export_single_cluster
   {
@@ -225,59 +621,41 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
     }
   }
   // build a RawCluster for output
-  std::vector<RawCluster *> clusters;
-  std::vector<float> clusters_E;
-  std::vector<float> clusters_absE;
-  std::vector<float> clusters_x;
-  std::vector<float> clusters_y;
-  std::vector<float> clusters_z;
-
+  std::vector<RawCluster *> &clusters = _export_clusters;
+  clusters.resize(n_clusters);
   for (unsigned int pc = 0; pc < n_clusters; pc++)
   {
-    clusters.push_back(new RawClusterv1());
-    clusters_E.push_back(0);
-    clusters_absE.push_back(0);
-    clusters_x.push_back(0);
-    clusters_y.push_back(0);
-    clusters_z.push_back(0);
+    clusters[pc] = new RawClusterv1();
   }
+  _export_sums.assign(n_clusters, ClusterSums());
 
   for (int original_tower : original_towers)
   {
     int this_ID = original_tower;
-    std::pair<int, int> the_pair = tower_ownership[this_ID];
+    const std::pair<int, int> &the_pair = _tower_ownership[this_ID];
 
     if (Verbosity() > 5)
     {
       std::cout << "RawClusterBuilderTopo::export_clusters -> assigning tower " << original_tower << " with ownership ( " << the_pair.first << ", " << the_pair.second << " ) " << std::endl;
     }
-    int this_ieta = get_ieta_from_ID(this_ID);
-    int this_iphi = get_iphi_from_ID(this_ID);
     int this_layer = get_ilayer_from_ID(this_ID);
     float this_E = get_E_from_ID(this_ID);
 
-    int this_key = 0;
-    if (this_layer == 2)
-    {
-      this_key = _EMTOWERMAP_KEY_ETA_PHI[this_ieta][this_iphi];
-    }
-    else
-    {
-      this_key = _TOWERMAP_KEY_LAYER_ETA_PHI[this_layer][this_ieta][this_iphi];
-    }
+    int this_key = _tower_key[this_ID];
 
     RawTowerGeom *tower_geom = _geom_containers[this_layer]->get_tower_geometry(this_key);
 
     if (the_pair.second == -1)
     {
       // assigned only to one cluster, easy
+      ClusterSums &sums1 = _export_sums[the_pair.first];
       clusters[the_pair.first]->addTower(this_key, this_E);
-      clusters_E[the_pair.first] = clusters_E[the_pair.first] + this_E;
-      clusters_absE[the_pair.first] = clusters_absE[the_pair.first] + std::fabs(this_E);
+      sums1.E += this_E;
+      sums1.absE += std::fabs(this_E);
       // calculate position mean using absolute energy as weights
-      clusters_x[the_pair.first] = clusters_x[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_x();
-      clusters_y[the_pair.first] = clusters_y[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_y();
-      clusters_z[the_pair.first] = clusters_z[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_z();
+      sums1.x += std::fabs(this_E) * tower_geom->get_center_x();
+      sums1.y += std::fabs(this_E) * tower_geom->get_center_y();
+      sums1.z += std::fabs(this_E) * tower_geom->get_center_z();
 
       if (Verbosity() > 5)
       {
@@ -296,19 +674,21 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
       {
         std::cout << " tower ID " << this_ID << " has dR1 = " << dR1 << " to pseudocluster " << the_pair.first << " , and dR2 = " << dR2 << " to pseudocluster " << the_pair.second << ", so frac1 = " << frac1 << std::endl;
       }
+      ClusterSums &sums1 = _export_sums[the_pair.first];
+      ClusterSums &sums2 = _export_sums[the_pair.second];
       clusters[the_pair.first]->addTower(this_key, this_E * frac1);
-      clusters_E[the_pair.first] = clusters_E[the_pair.first] + this_E * frac1;
-      clusters_absE[the_pair.first] = clusters_absE[the_pair.first] + std::fabs(this_E) * frac1;
-      clusters_x[the_pair.first] = clusters_x[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_x() * frac1;
-      clusters_y[the_pair.first] = clusters_y[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_y() * frac1;
-      clusters_z[the_pair.first] = clusters_z[the_pair.first] + std::fabs(this_E) * tower_geom->get_center_z() * frac1;
+      sums1.E += this_E * frac1;
+      sums1.absE += std::fabs(this_E) * frac1;
+      sums1.x += std::fabs(this_E) * tower_geom->get_center_x() * frac1;
+      sums1.y += std::fabs(this_E) * tower_geom->get_center_y() * frac1;
+      sums1.z += std::fabs(this_E) * tower_geom->get_center_z() * frac1;
 
       clusters[the_pair.second]->addTower(this_key, this_E * (1 - frac1));
-      clusters_E[the_pair.second] = clusters_E[the_pair.second] + this_E * (1 - frac1);
-      clusters_absE[the_pair.second] = clusters_absE[the_pair.second] + std::fabs(this_E) * (1 - frac1);
-      clusters_x[the_pair.second] = clusters_x[the_pair.second] + std::fabs(this_E) * tower_geom->get_center_x() * (1 - frac1);
-      clusters_y[the_pair.second] = clusters_y[the_pair.second] + std::fabs(this_E) * tower_geom->get_center_y() * (1 - frac1);
-      clusters_z[the_pair.second] = clusters_z[the_pair.second] + std::fabs(this_E) * tower_geom->get_center_z() * (1 - frac1);
+      sums2.E += this_E * (1 - frac1);
+      sums2.absE += std::fabs(this_E) * (1 - frac1);
+      sums2.x += std::fabs(this_E) * tower_geom->get_center_x() * (1 - frac1);
+      sums2.y += std::fabs(this_E) * tower_geom->get_center_y() * (1 - frac1);
+      sums2.z += std::fabs(this_E) * tower_geom->get_center_z() * (1 - frac1);
     }
   }
 
@@ -316,19 +696,20 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
 
   for (unsigned int cl = 0; cl < n_clusters; cl++)
   {
-    if (clusters_absE[cl] < _min_cluster_E)
+    if (_export_sums[cl].absE < _min_cluster_E)
     {
       if (Verbosity() > 2)
       {
-        std::cout << "RawClusterBuilderTopo::export_clusters: skipping cluster with E = " << clusters_E[cl] << " and absE = " << clusters_absE[cl] << " due to low energy " << std::endl;
+        std::cout << "RawClusterBuilderTopo::export_clusters: skipping cluster with E = " << _export_sums[cl].E << " and absE = " << _export_sums[cl].absE << " due to low energy " << std::endl;
       }
+      delete clusters[cl];
       continue;
     }
-    clusters[cl]->set_energy(clusters_E[cl]);
+    clusters[cl]->set_energy(_export_sums[cl].E);
 
-    float mean_x = clusters_x[cl] / clusters_absE[cl];
-    float mean_y = clusters_y[cl] / clusters_absE[cl];
-    float mean_z = clusters_z[cl] / clusters_absE[cl];
+    float mean_x = _export_sums[cl].x / _export_sums[cl].absE;
+    float mean_y = _export_sums[cl].y / _export_sums[cl].absE;
+    float mean_z = _export_sums[cl].z / _export_sums[cl].absE;
 
     clusters[cl]->set_r(std::sqrt((mean_y * mean_y) + (mean_x * mean_x)));
     clusters[cl]->set_phi(std::atan2(mean_y, mean_x));
@@ -338,7 +719,7 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
 
     if (Verbosity() > 1)
     {
-      std::cout << "RawClusterBuilderTopo::export_clusters: added cluster with E = " << clusters_E[cl] << ", eta = " << -1 * log(tan(std::atan2(std::sqrt((mean_y * mean_y) + (mean_x * mean_x)), mean_z) / 2.0)) << ", phi = " << std::atan2(mean_y, mean_x) << std::endl;
+      std::cout << "RawClusterBuilderTopo::export_clusters: added cluster with E = " << _export_sums[cl].E << ", eta = " << -1 * log(tan(std::atan2(std::sqrt((mean_y * mean_y) + (mean_x * mean_x)), mean_z) / 2.0)) << ", phi = " << std::atan2(mean_y, mean_x) << std::endl;
     }
   }
 
@@ -360,6 +741,8 @@ RawClusterBuilderTopo::RawClusterBuilderTopo(const std::string &name)
   _local_max_minE_LAYER[2] = 1;
 }
 
+RawClusterBuilderTopo::~RawClusterBuilderTopo() = default;
+
 int RawClusterBuilderTopo::InitRun(PHCompositeNode *topNode)
 {
   try
@@ -383,6 +766,15 @@ int RawClusterBuilderTopo::InitRun(PHCompositeNode *topNode)
     std::cout << "RawClusterBuilderTopo::InitRun: initialized with minE for local max in EMCal / IHCal / OHCal = " << _local_max_minE_LAYER[2] << " / " << _local_max_minE_LAYER[0] << " / " << _local_max_minE_LAYER[1] << std::endl;
   }
 
+  if (_nthreads != 1 && !_pool)
+  {
+    _pool = std::make_unique<PHThreadPool>(_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << "Using " << _pool->size() << " worker threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -455,10 +847,6 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // define geometry only once if it has not been yet
     _EMCAL_NETA = _geom_containers[2]->get_etabins();
     _EMCAL_NPHI = _geom_containers[2]->get_phibins();
-
-    _EMTOWERMAP_STATUS_ETA_PHI.resize(_EMCAL_NETA, std::vector<int>(_EMCAL_NPHI, -2));
-    _EMTOWERMAP_KEY_ETA_PHI.resize(_EMCAL_NETA, std::vector<int>(_EMCAL_NPHI, 0));
-    _EMTOWERMAP_E_ETA_PHI.resize(_EMCAL_NETA, std::vector<float>(_EMCAL_NPHI, 0));
   }
 
   if (_HCAL_NETA < 0)
@@ -466,389 +854,73 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // define geometry only once if it has not been yet
     _HCAL_NETA = _geom_containers[1]->get_etabins();
     _HCAL_NPHI = _geom_containers[1]->get_phibins();
+  }
 
-    _TOWERMAP_STATUS_LAYER_ETA_PHI.resize(2, std::vector<std::vector<int> >(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, -2)));
-    _TOWERMAP_KEY_LAYER_ETA_PHI.resize(2, std::vector<std::vector<int> >(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0)));
-    _TOWERMAP_E_LAYER_ETA_PHI.resize(2, std::vector<std::vector<float> >(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0)));
+  if (_tower_status.empty())
+  {
+    build_tower_grid();
   }
 
   // reset maps
   // but note -- do not reset keys!
-  for (int ieta = 0; ieta < _EMCAL_NETA; ieta++)
-  {
-    for (int iphi = 0; iphi < _EMCAL_NPHI; iphi++)
-    {
-      _EMTOWERMAP_STATUS_ETA_PHI[ieta][iphi] = -2;  // set tower does not exist
-      _EMTOWERMAP_E_ETA_PHI[ieta][iphi] = 0;        // set zero energy
-    }
-  }
-  for (int ilayer = 0; ilayer < 2; ilayer++)
+  std::fill(_tower_status.begin(), _tower_status.end(), -2);  // set tower does not exist
+  std::fill(_tower_E.begin(), _tower_E.end(), 0);             // set zero energy
+
+  for (auto &cluster_towers : _cluster_towers)
   {
-    for (int ieta = 0; ieta < _HCAL_NETA; ieta++)
-    {
-      for (int iphi = 0; iphi < _HCAL_NPHI; iphi++)
-      {
-        _TOWERMAP_STATUS_LAYER_ETA_PHI[ilayer][ieta][iphi] = -2;  // set tower does not exist
-        _TOWERMAP_E_LAYER_ETA_PHI[ilayer][ieta][iphi] = 0;        // set zero energy
-      }
-    }
+    cluster_towers.clear();
   }
 
   // setup
-  std::vector<std::pair<int, float> > list_of_seeds;
+  _seeds.clear();
 
   // translate towers to our internal representation
   if (_enable_EMCal)
   {
-    TowerInfo *towerInfo = nullptr;
-    unsigned int n_EM_towers = towerinfosEM->size();
-    for (unsigned int iEM = 0; iEM < n_EM_towers; iEM++)
-    {
-      towerInfo = towerinfosEM->get_tower_at_channel(iEM);
-      if (_only_good_towers && (!towerInfo->get_isGood()))
-      {
-        continue;
-      }
-      unsigned int towerinfo_key = towerinfosEM->encode_key(iEM);
-      int ti_ieta = towerinfosEM->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosEM->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, ti_ieta, ti_iphi);
-
-      // RawTowerGeom *tower_geom = _geom_containers[2]->get_tower_geometry(key);
-
-      // int ieta = _geom_containers[2]->get_etabin(tower_geom->get_eta());
-      // int iphi = _geom_containers[2]->get_phibin(tower_geom->get_phi());
-
-      int ieta = ti_ieta;
-      int iphi = ti_iphi;
-
-      float this_E = towerInfo->get_energy();
-
-      // if not using abs E, short circuit all negative towers right here (same for IHCal, OHCal below)
-      if (!_use_absE && this_E < 1.E-10)
-      {
-        continue;
-      }
-
-      _EMTOWERMAP_STATUS_ETA_PHI[ieta][iphi] = -1;  // change status to unknown
-      _EMTOWERMAP_E_ETA_PHI[ieta][iphi] = this_E;
-      _EMTOWERMAP_KEY_ETA_PHI[ieta][iphi] = key;
-
-      // use fabs() here for simplicity - if we're not using abs E, negative towers are already excluded
-      if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[2])
-      {
-        int ID = get_ID(2, ieta, iphi);
-        list_of_seeds.emplace_back(ID, this_E);
-        if (Verbosity() > 10)
-        {
-          std::cout << "RawClusterBuilderTopo::process_event: adding EMCal tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
-          std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID(ID) << " / " << get_ieta_from_ID(ID) << " / " << get_iphi_from_ID(ID) << std::endl;
-        };
-      }
-    }
+    fill_tower_grid(towerinfosEM, 2);
   }
 
   // translate towers to our internal representation
   if (_enable_HCal)
   {
-    TowerInfo *towerInfo = nullptr;
-    unsigned int n_IH_towers = towerinfosIH->size();
-    for (unsigned int iIH = 0; iIH < n_IH_towers; iIH++)
-    {
-      towerInfo = towerinfosIH->get_tower_at_channel(iIH);
-      if (_only_good_towers && (!towerInfo->get_isGood()))
-      {
-        continue;
-      }
-      unsigned int towerinfo_key = towerinfosIH->encode_key(iIH);
-      int ti_ieta = towerinfosIH->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosIH->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ti_ieta, ti_iphi);
-
-      RawTowerGeom *tower_geom = _geom_containers[0]->get_tower_geometry(key);
-
-      int ieta = _geom_containers[0]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[0]->get_phibin(tower_geom->get_phi());
-      float this_E = towerInfo->get_energy();
-
-      if (!_use_absE && this_E < 1.E-10)
-      {
-        continue;
-      }
-
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[0][ieta][iphi] = -1;  // change status to unknown
-      _TOWERMAP_E_LAYER_ETA_PHI[0][ieta][iphi] = this_E;
-      _TOWERMAP_KEY_LAYER_ETA_PHI[0][ieta][iphi] = key;
-
-      if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[0])
-      {
-        int ID = get_ID(0, ieta, iphi);
-        list_of_seeds.emplace_back(ID, this_E);
-        if (Verbosity() > 10)
-        {
-          std::cout << "RawClusterBuilderTopo::process_event: adding IHCal tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
-          std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID(ID) << " / " << get_ieta_from_ID(ID) << " / " << get_iphi_from_ID(ID) << std::endl;
-        };
-      }
-    }
-    unsigned int n_OH_towers = towerinfosOH->size();
-    for (unsigned int iOH = 0; iOH < n_OH_towers; iOH++)
-    {
-      towerInfo = towerinfosOH->get_tower_at_channel(iOH);
-      if (_only_good_towers && (!towerInfo->get_isGood()))
-      {
-        continue;
-      }
-      unsigned int towerinfo_key = towerinfosOH->encode_key(iOH);
-      int ti_ieta = towerinfosOH->getTowerEtaBin(towerinfo_key);
-      int ti_iphi = towerinfosOH->getTowerPhiBin(towerinfo_key);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, ti_ieta, ti_iphi);
-
-      RawTowerGeom *tower_geom = _geom_containers[1]->get_tower_geometry(key);
-
-      int ieta = _geom_containers[1]->get_etabin(tower_geom->get_eta());
-      int iphi = _geom_containers[1]->get_phibin(tower_geom->get_phi());
-      float this_E = towerInfo->get_energy();
-
-      if (!_use_absE && this_E < 1.E-10)
-      {
-        continue;
-      }
-
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[1][ieta][iphi] = -1;  // change status to unknown
-      _TOWERMAP_E_LAYER_ETA_PHI[1][ieta][iphi] = this_E;
-      _TOWERMAP_KEY_LAYER_ETA_PHI[1][ieta][iphi] = key;
-
-      if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[1])
-      {
-        int ID = get_ID(1, ieta, iphi);
-        list_of_seeds.emplace_back(ID, this_E);
-        if (Verbosity() > 10)
-        {
-          std::cout << "RawClusterBuilderTopo::process_event: adding OHCal tower at ieta / iphi = " << ieta << " / " << iphi << " with E = " << this_E << std::endl;
-          std::cout << " --> ID = " << ID << " , check ilayer / ieta / iphi = " << get_ilayer_from_ID(ID) << " / " << get_ieta_from_ID(ID) << " / " << get_iphi_from_ID(ID) << std::endl;
-        };
-      }
-    }
+    fill_tower_grid(towerinfosIH, 0);
+    fill_tower_grid(towerinfosOH, 1);
   }
 
   if (Verbosity() > 10)
   {
-    for (unsigned int n = 0; n < list_of_seeds.size(); n++)
+    for (unsigned int n = 0; n < _seeds.size(); n++)
     {
-      std::cout << "RawClusterBuilderTopo::process_event: unsorted seed element n = " << n << " , ID / E = " << list_of_seeds.at(n).first << " / " << list_of_seeds.at(n).second << std::endl;
+      std::cout << "RawClusterBuilderTopo::process_event: unsorted seed element n = " << n << " , ID / E = " << _seeds.at(n).first << " / " << _seeds.at(n).second << std::endl;
     }
   }
 
-  std::sort(list_of_seeds.begin(), list_of_seeds.end(), sort_by_pair_second);
+  std::sort(_seeds.begin(), _seeds.end(), sort_by_pair_second);
 
   if (Verbosity() > 10)
   {
-    for (unsigned int n = 0; n < list_of_seeds.size(); n++)
+    for (unsigned int n = 0; n < _seeds.size(); n++)
     {
-      std::cout << "RawClusterBuilderTopo::process_event: sorted seed element n = " << n << " , ID / E = " << list_of_seeds.at(n).first << " / " << list_of_seeds.at(n).second << std::endl;
+      std::cout << "RawClusterBuilderTopo::process_event: sorted seed element n = " << n << " , ID / E = " << _seeds.at(n).first << " / " << _seeds.at(n).second << std::endl;
     }
   }
 
   if (Verbosity() > 0)
   {
-    std::cout << "RawClusterBuilderTopo::process_event: initialized with " << list_of_seeds.size() << " seeds with E > 4*sigma " << std::endl;
+    std::cout << "RawClusterBuilderTopo::process_event: initialized with " << _seeds.size() << " seeds with E > 4*sigma " << std::endl;
   }
 
-  int cluster_index = 0;  // begin counting clusters
-
-  std::vector<std::vector<int> > all_cluster_towers;  // store final cluster tower lists here
-
-  while (!list_of_seeds.empty())
+  // if the seeds are above the growth threshold, the core of a cluster is the
+  // connected component of towers above the growth threshold around its seed,
+  // and the cores can be grown independently of each other
+  int cluster_index = 0;
+  if (_sigma_seed >= _sigma_grow && Verbosity() <= 5)
   {
-    int seed_ID = list_of_seeds.at(0).first;
-    list_of_seeds.erase(list_of_seeds.begin());
-
-    if (Verbosity() > 5)
-    {
-      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << list_of_seeds.size() << std::endl;
-    }
-
-    // if this seed was already claimed by some other seed during its growth, remove it and do nothing
-    int seed_status = get_status_from_ID(seed_ID);
-    if (seed_status > -1)
-    {
-      if (Verbosity() > 10)
-      {
-        std::cout << " --> already owned by cluster # " << seed_status << std::endl;
-      }
-      continue;  // go onto the next iteration of the loop
-    }
-
-    // this seed tower now owned by new cluster
-    set_status_by_ID(seed_ID, cluster_index);
-
-    std::vector<int> cluster_tower_ID;
-    cluster_tower_ID.push_back(seed_ID);
-
-    std::vector<int> grow_tower_ID;
-    grow_tower_ID.push_back(seed_ID);
-
-    // iteratively process growth towers, adding > 2 * sigma neighbors to the list for further checking
-
-    if (Verbosity() > 5)
-    {
-      std::cout << " RawClusterBuilderTopo::process_event: Entering Growth stage for cluster " << cluster_index << std::endl;
-    }
-
-    while (!grow_tower_ID.empty())
-    {
-      int grow_ID = grow_tower_ID.at(0);
-      grow_tower_ID.erase(grow_tower_ID.begin());
-
-      if (Verbosity() > 5)
-      {
-        std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << grow_tower_ID.size() << " grow towers left" << std::endl;
-      }
-
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(grow_ID);
-
-      for (int this_adjacent_tower_ID : adjacent_tower_IDs)
-      {
-        if (Verbosity() > 10)
-        {
-          std::cout << " --> --> --> checking possible adjacent tower with ID " << this_adjacent_tower_ID << " : ";
-        }
-        int test_layer = get_ilayer_from_ID(this_adjacent_tower_ID);
-
-        // if tower does not exist, continue
-        if (get_status_from_ID(this_adjacent_tower_ID) == -2)
-        {
-          if (Verbosity() > 10)
-          {
-            std::cout << "does not exist " << std::endl;
-          }
-          continue;
-        }
-
-        // if tower is owned by THIS cluster already, continue
-        if (get_status_from_ID(this_adjacent_tower_ID) == cluster_index)
-        {
-          if (Verbosity() > 10)
-          {
-            std::cout << "already owned by this cluster index " << cluster_index << std::endl;
-          }
-          continue;
-        }
-
-        // if tower has < 2*sigma energy, continue
-        if (std::fabs(get_E_from_ID(this_adjacent_tower_ID)) < _sigma_grow * _noise_LAYER[test_layer])
-        {
-          if (Verbosity() > 10)
-          {
-            std::cout << "E = " << get_E_from_ID(this_adjacent_tower_ID) << " under 2*sigma threshold " << std::endl;
-          }
-          continue;
-        }
-
-        // if tower is owned by somebody else, continue (although should this really happen?)
-        if (get_status_from_ID(this_adjacent_tower_ID) > -1)
-        {
-          if (Verbosity() > 10)
-          {
-            std::cout << "ERROR! in growth stage, encountered >2sigma tower which is already owned?!" << std::endl;
-          }
-          continue;
-        }
-
-        // tower good to be added to cluster and to list of grow towers
-        grow_tower_ID.push_back(this_adjacent_tower_ID);
-        cluster_tower_ID.push_back(this_adjacent_tower_ID);
-        set_status_by_ID(this_adjacent_tower_ID, cluster_index);
-        if (Verbosity() > 10)
-        {
-          std::cout << "add this tower ( ID " << this_adjacent_tower_ID << " ) to grow list " << std::endl;
-        }
-      }
-
-      if (Verbosity() > 5)
-      {
-        std::cout << " --> after examining neighbors, grow list is now " << grow_tower_ID.size() << ", # of towers in cluster = " << cluster_tower_ID.size() << std::endl;
-      }
-    }
-
-    // done growing cluster, now add on perimeter towers with E > 0 * sigma
-    if (Verbosity() > 5)
-    {
-      std::cout << " RawClusterBuilderTopo::process_event: Entering Perimeter stage for cluster " << cluster_index << std::endl;
-    }
-    // we'll be adding on to the cluster list, so get the # of core towers first
-    int n_core_towers = cluster_tower_ID.size();
-
-    for (int ic = 0; ic < n_core_towers; ic++)
-    {
-      int core_ID = cluster_tower_ID.at(ic);
-
-      if (Verbosity() > 5)
-      {
-        std::cout << " --> cluster " << cluster_index << ", perimeter stage, examining neighbors of ID " << core_ID << ", core cluster # " << ic << " of " << n_core_towers << " total " << std::endl;
-      }
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(core_ID);
-
-      for (int this_adjacent_tower_ID : adjacent_tower_IDs)
-      {
-        if (Verbosity() > 10)
-        {
-          std::cout << " --> --> --> checking possible adjacent tower with ID " << this_adjacent_tower_ID << " : ";
-        }
-
-        int test_layer = get_ilayer_from_ID(this_adjacent_tower_ID);
-
-        // if tower does not exist, continue
-        if (get_status_from_ID(this_adjacent_tower_ID) == -2)
-        {
-          if (Verbosity() > 10)
-          {
-            std::cout << "does not exist " << std::endl;
-          }
-          continue;
-        }
-
-        // if tower is owned by somebody else (including current cluster), continue. ( allowed during perimeter fixing state )
-        if (get_status_from_ID(this_adjacent_tower_ID) > -1)
-        {
-          if (Verbosity() > 10)
-          {
-            std::cout << "already owned by other cluster index " << get_status_from_ID(this_adjacent_tower_ID) << std::endl;
-          }
-          continue;
-        }
-
-        // if tower has < 0*sigma energy, continue
-        if (std::fabs(get_E_from_ID(this_adjacent_tower_ID)) < _sigma_peri * _noise_LAYER[test_layer])
-        {
-          if (Verbosity() > 10)
-          {
-            std::cout << "E = " << get_E_from_ID(this_adjacent_tower_ID) << " under 0*sigma threshold " << std::endl;
-          }
-          continue;
-        }
-
-        // perimeter tower good to be added to cluster
-        cluster_tower_ID.push_back(this_adjacent_tower_ID);
-        set_status_by_ID(this_adjacent_tower_ID, cluster_index);
-        if (Verbosity() > 10)
-        {
-          std::cout << "add this tower ( ID " << this_adjacent_tower_ID << " ) to cluster " << std::endl;
-        }
-      }
-
-      if (Verbosity() > 5)
-      {
-        std::cout << " --> after examining perimeter neighbors, # of towers in cluster is now = " << cluster_tower_ID.size() << std::endl;
-      }
-    }
-
-    // keep track of these
-    all_cluster_towers.push_back(cluster_tower_ID);
-
-    // increment cluster index for next one
-    cluster_index++;
+    cluster_index = grow_clusters_parallel();
+  }
+  else
+  {
+    cluster_index = grow_clusters_serial();
   }
 
   if (Verbosity() > 0)
@@ -860,9 +932,18 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
   // now entering cluster splitting stage
 
+  // buffers reused for all clusters
+  std::vector<std::pair<int, float> > local_maxima_ID;
+  std::vector<int> seed_list;
+  std::vector<int> neighbor_list;
+  std::vector<int> shared_list;
+  std::vector<int> new_ownerships;
+  std::vector<int> new_neighbor_list;
+  std::vector<bool> pseudocluster_adjacency;
+
   for (int cl = 0; cl < original_cluster_index; cl++)
   {
-    std::vector<int> original_towers = all_cluster_towers.at(cl);
+    const std::vector<int> &original_towers = _cluster_towers[cl];
 
     if (!_do_split)
     {
@@ -875,7 +956,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       continue;
     }
 
-    std::vector<std::pair<int, float> > local_maxima_ID;
+    local_maxima_ID.clear();
 
     // iterate through each tower, looking for maxima
     for (int tower_ID : original_towers)
@@ -896,7 +977,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       }
 
       // examine neighbors
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(tower_ID);
+      TowerRange adjacent_tower_IDs = get_adjacent_towers(tower_ID);
       int neighbors_in_cluster = 0;
 
       // check for higher neighbor
@@ -1043,14 +1124,13 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // -1 means unseen
     // -2 means seen and in the seed list now (e.g. don't add it to the seed list again)
     // -3 shared tower, ignore going forward...
-    std::map<int, std::pair<int, int> > tower_ownership;
-    for (int &original_tower : original_towers)
+    for (int original_tower : original_towers)
     {
-      tower_ownership[original_tower] = std::pair<int, int>(-1, -1);  // initialize all towers as un-seen
+      _tower_ownership[original_tower] = std::pair<int, int>(-1, -1);  // initialize all towers as un-seen
     }
-    std::vector<int> seed_list;
-    std::vector<int> neighbor_list;
-    std::vector<int> shared_list;
+    seed_list.clear();
+    neighbor_list.clear();
+    shared_list.clear();
 
     // sort maxima before populating seed list
     std::sort(local_maxima_ID.begin(), local_maxima_ID.end(), sort_by_pair_second);
@@ -1058,15 +1138,15 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // initialize neighbor list
     for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
     {
-      tower_ownership[local_maxima_ID.at(s).first] = std::pair<int, int>(s, -1);
+      _tower_ownership[local_maxima_ID.at(s).first] = std::pair<int, int>(s, -1);
       neighbor_list.push_back(local_maxima_ID.at(s).first);
     }
 
     if (Verbosity() > 100)
     {
-      for (int &original_tower : original_towers)
+      for (int original_tower : original_towers)
       {
-        std::pair<int, int> the_pair = tower_ownership[original_tower];
+        std::pair<int, int> the_pair = _tower_ownership[original_tower];
         std::cout << " Debug Pre-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
         std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
         std::cout << std::endl;
@@ -1082,7 +1162,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         std::cout << " -> starting split loop with " << seed_list.size() << " seed, " << neighbor_list.size() << " neighbor, and " << shared_list.size() << " shared towers " << std::endl;
       }
       // go through neighbor list, assigning ownership only via the seed list
-      std::vector<int> new_ownerships;
+      new_ownerships.clear();
 
       for (unsigned int n = 0; n < neighbor_list.size(); n++)
       {
@@ -1096,19 +1176,15 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         {
           if (Verbosity() > 10)
           {
-            std::cout << " -> -> -> special first pass rules, this tower already owned by pseudocluster " << tower_ownership[neighbor_ID].first << std::endl;
+            std::cout << " -> -> -> special first pass rules, this tower already owned by pseudocluster " << _tower_ownership[neighbor_ID].first << std::endl;
           }
-          new_ownerships.push_back(tower_ownership[neighbor_ID].first);
+          new_ownerships.push_back(_tower_ownership[neighbor_ID].first);
         }
         else
         {
-          std::map<int, bool> pseudocluster_adjacency;
-          for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
-          {
-            pseudocluster_adjacency[s] = false;
-          }
+          pseudocluster_adjacency.assign(local_maxima_ID.size(), false);
           // look over all towers THIS one is adjacent to, and count up...
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
+          TowerRange adjacent_tower_IDs = get_adjacent_towers(neighbor_ID);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1117,13 +1193,16 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
               continue;
             }
 
-            if (tower_ownership[this_adjacent_tower_ID].first > -1)
+            if (_tower_ownership[this_adjacent_tower_ID].first > -1)
             {
               if (Verbosity() > 20)
               {
-                std::cout << " -> -> -> adjacent tower to this one, with ID " << this_adjacent_tower_ID << " , is owned by pseudocluster " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
+                std::cout << " -> -> -> adjacent tower to this one, with ID " << this_adjacent_tower_ID << " , is owned by pseudocluster " << _tower_ownership[this_adjacent_tower_ID].first << std::endl;
+              }
+              if (_tower_ownership[this_adjacent_tower_ID].first < (int) pseudocluster_adjacency.size())
+              {
+                pseudocluster_adjacency[_tower_ownership[this_adjacent_tower_ID].first] = true;
               }
-              pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].first] = true;
             }
           }
           int n_pseudocluster_adjacent = 0;
@@ -1175,7 +1254,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         int neighbor_ID = neighbor_list.at(n);
         if (new_ownerships.at(n) > -1)
         {
-          tower_ownership[neighbor_ID] = std::pair<int, int>(new_ownerships.at(n), -1);
+          _tower_ownership[neighbor_ID] = std::pair<int, int>(new_ownerships.at(n), -1);
           seed_list.push_back(neighbor_ID);
           if (Verbosity() > 20)
           {
@@ -1184,7 +1263,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         }
         if (new_ownerships.at(n) == -3)
         {
-          tower_ownership[neighbor_ID] = std::pair<int, int>(-3, -1);
+          _tower_ownership[neighbor_ID] = std::pair<int, int>(-3, -1);
           shared_list.push_back(neighbor_ID);
           if (Verbosity() > 20)
           {
@@ -1198,13 +1277,13 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         std::cout << " producing a new neighbor list ... " << std::endl;
       }
       // populate a new neighbor list from the about-to-be-owned towers before transferring this one
-      std::list<int> new_neighbor_list;
+      new_neighbor_list.clear();
       for (unsigned int n = 0; n < neighbor_list.size(); n++)
       {
         int neighbor_ID = neighbor_list.at(n);
         if (new_ownerships.at(n) > -1)
         {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
+          TowerRange adjacent_tower_IDs = get_adjacent_towers(neighbor_ID);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1212,7 +1291,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
             {
               continue;
             }
-            if (tower_ownership[this_adjacent_tower_ID].first == -1)
+            if (_tower_ownership[this_adjacent_tower_ID].first == -1)
             {
               new_neighbor_list.push_back(this_adjacent_tower_ID);
               if (Verbosity() > 5)
@@ -1229,23 +1308,16 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         std::cout << " new neighbor list has size " << new_neighbor_list.size() << ", but after removing duplicate elements: ";
       }
 
-      new_neighbor_list.sort();
-      new_neighbor_list.unique();
+      std::sort(new_neighbor_list.begin(), new_neighbor_list.end());
+      new_neighbor_list.erase(std::unique(new_neighbor_list.begin(), new_neighbor_list.end()), new_neighbor_list.end());
 
       if (Verbosity() > 5)
       {
         std::cout << new_neighbor_list.size() << std::endl;
       }
 
-      // clear neighbor list!
-      neighbor_list.clear();
-
       // now transfer over new neighbor list
-      for (; !new_neighbor_list.empty();)
-      {
-        neighbor_list.push_back(new_neighbor_list.front());
-        new_neighbor_list.pop_front();
-      }
+      neighbor_list.swap(new_neighbor_list);
 
       first_pass = false;
 
@@ -1253,15 +1325,15 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
     if (Verbosity() > 100)
     {
-      for (int &original_tower : original_towers)
+      for (int original_tower : original_towers)
       {
-        std::pair<int, int> the_pair = tower_ownership[original_tower];
+        std::pair<int, int> the_pair = _tower_ownership[original_tower];
         std::cout << " Debug Mid-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
         std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
         std::cout << std::endl;
         if (the_pair.first == -1)
         {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(original_tower);
+          TowerRange adjacent_tower_IDs = get_adjacent_towers(original_tower);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1269,7 +1341,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
             {
               continue;
             }
-            std::cout << "    -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
+            std::cout << "    -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << _tower_ownership[this_adjacent_tower_ID].first << std::endl;
           }
         }
       }
@@ -1288,9 +1360,9 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     pseudocluster_sumE.resize(local_maxima_ID.size(), 0);
     pseudocluster_ntower.resize(local_maxima_ID.size(), 0);
 
-    for (int &original_tower : original_towers)
+    for (int original_tower : original_towers)
     {
-      std::pair<int, int> the_pair = tower_ownership[original_tower];
+      std::pair<int, int> the_pair = _tower_ownership[original_tower];
       if (the_pair.first > -1)
       {
         float this_ID = original_tower;
@@ -1320,21 +1392,19 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       std::cout << "RawClusterBuilderTopo::process_event now splitting up shared clusters (including unassigned clusters), initial shared list has size " << shared_list.size() << std::endl;
     }
     // iterate through shared cells, identifying which two they belong to
-    while (!shared_list.empty())
+    for (unsigned int ishared = 0; ishared < shared_list.size(); ishared++)
     {
-      // pick the first cell and pop off list
-      int shared_ID = shared_list.at(0);
-      shared_list.erase(shared_list.begin());
+      // pick the next cell of the list
+      int shared_ID = shared_list[ishared];
 
       if (Verbosity() > 5)
       {
-        std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() << " shared towers left " << std::endl;
+        std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() - ishared - 1 << " shared towers left " << std::endl;
       }
       // look through adjacent pseudoclusters, taking two with highest energies
-      std::vector<bool> pseudocluster_adjacency;
-      pseudocluster_adjacency.resize(local_maxima_ID.size(), false);
+      pseudocluster_adjacency.assign(local_maxima_ID.size(), false);
 
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(shared_ID);
+      TowerRange adjacent_tower_IDs = get_adjacent_towers(shared_ID);
 
       for (int this_adjacent_tower_ID : adjacent_tower_IDs)
       {
@@ -1342,19 +1412,19 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         {
           continue;
         }
-        if (tower_ownership[this_adjacent_tower_ID].first > -1)
+        if (_tower_ownership[this_adjacent_tower_ID].first > -1)
         {
-          pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].first] = true;
+          pseudocluster_adjacency[_tower_ownership[this_adjacent_tower_ID].first] = true;
         }
-        if (tower_ownership[this_adjacent_tower_ID].second > -1)
+        if (_tower_ownership[this_adjacent_tower_ID].second > -1)
         {  // can inherit adjacency from shared cluster
-          pseudocluster_adjacency[tower_ownership[this_adjacent_tower_ID].second] = true;
+          pseudocluster_adjacency[_tower_ownership[this_adjacent_tower_ID].second] = true;
         }
         // at the same time, add unowned towers to the list for later examination
-        if (tower_ownership[this_adjacent_tower_ID].first == -1)
+        if (_tower_ownership[this_adjacent_tower_ID].first == -1)
         {
           shared_list.push_back(this_adjacent_tower_ID);
-          tower_ownership[this_adjacent_tower_ID] = std::pair<int, int>(-3, -1);
+          _tower_ownership[this_adjacent_tower_ID] = std::pair<int, int>(-3, -1);
           if (Verbosity() > 10)
           {
             std::cout << " -> while looking at neighbors, have added un-examined tower " << this_adjacent_tower_ID << " to shared list " << std::endl;
@@ -1396,20 +1466,20 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         std::cout << " -> highest pseudoclusters its adjacent to are " << highest_pseudocluster_index << " ( E = " << highest_pseudocluster_E << " ) and " << second_highest_pseudocluster_index << " ( E = " << second_highest_pseudocluster_E << " ) " << std::endl;
       }
       // assign these clusters as owners
-      tower_ownership[shared_ID] = std::pair<int, int>(highest_pseudocluster_index, second_highest_pseudocluster_index);
+      _tower_ownership[shared_ID] = std::pair<int, int>(highest_pseudocluster_index, second_highest_pseudocluster_index);
     }
 
     if (Verbosity() > 100)
     {
-      for (int &original_tower : original_towers)
+      for (int original_tower : original_towers)
       {
-        std::pair<int, int> the_pair = tower_ownership[original_tower];
+        std::pair<int, int> the_pair = _tower_ownership[original_tower];
         std::cout << " Debug Post-Split: tower_ownership[ " << original_tower << " ] = ( " << the_pair.first << ", " << the_pair.second << " ) ";
         std::cout << " , layer / ieta / iphi = " << get_ilayer_from_ID(original_tower) << " / " << get_ieta_from_ID(original_tower) << " / " << get_iphi_from_ID(original_tower);
         std::cout << std::endl;
         if (the_pair.first == -1)
         {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(original_tower);
+          TowerRange adjacent_tower_IDs = get_adjacent_towers(original_tower);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1417,14 +1487,14 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
             {
               continue;
             }
-            std::cout << " -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << tower_ownership[this_adjacent_tower_ID].first << std::endl;
+            std::cout << " -> adjacent to add tower " << this_adjacent_tower_ID << " , which has status " << _tower_ownership[this_adjacent_tower_ID].first << std::endl;
           }
         }
       }
     }
 
     // call helper function
-    export_clusters(original_towers, tower_ownership, local_maxima_ID.size(), pseudocluster_sumE, pseudocluster_eta, pseudocluster_phi);
+    export_clusters(original_towers, local_maxima_ID.size(), pseudocluster_sumE, pseudocluster_eta, pseudocluster_phi);
   }
 
   if (Verbosity() > 1)
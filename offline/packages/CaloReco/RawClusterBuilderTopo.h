@@ -9,20 +9,24 @@
 
 #include <fun4all/SubsysReco.h>
 
-#include <map>
+#include <cmath>
+#include <memory>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
 
 class PHCompositeNode;
+class PHThreadPool;
+class RawCluster;
 class RawClusterContainer;
 class RawTowerGeomContainer;
+class TowerInfoContainer;
 
 class RawClusterBuilderTopo : public SubsysReco
 {
  public:
   explicit RawClusterBuilderTopo(const std::string &name = "RawClusterBuilderTopo");
-  ~RawClusterBuilderTopo() override {}
+  ~RawClusterBuilderTopo() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -103,6 +107,12 @@ class RawClusterBuilderTopo : public SubsysReco
     _inputnodeprefix = inputPrefix;
   }
 
+  //! number of threads for the seed growth, 0 means one per hardware thread
+  void set_nthreads(unsigned int n)
+  {
+    _nthreads = n;
+  }
+
  private:
   void CreateNodes(PHCompositeNode *topNode);
 
@@ -126,13 +136,62 @@ class RawClusterBuilderTopo : public SubsysReco
 
   std::vector<int> get_adjacent_towers_by_ID(int ID);
 
+  // range of tower IDs in the precomputed neighbor table
+  struct TowerRange
+  {
+    const int *first;
+    const int *last;
+    const int *begin() const { return first; }
+    const int *end() const { return last; }
+  };
+
+  TowerRange get_adjacent_towers(int ID) const
+  {
+    return TowerRange{_neighbors.data() + _neighbor_offsets[ID], _neighbors.data() + _neighbor_offsets[ID + 1]};
+  }
+
+  // allocate the flat tower grid and fill the neighbor table, once the geometry is known
+  void build_tower_grid();
+
+  // cache the tower ID and key of every channel of a calorimeter
+  void build_channel_map(TowerInfoContainer *towerinfos, int ilayer);
+
+  // copy the towers of one calorimeter to the grid and collect the seeds
+  void fill_tower_grid(TowerInfoContainer *towerinfos, int ilayer);
+
+  // grow the clusters from the seeds one after the other, returns the number of clusters
+  int grow_clusters_serial();
+
+  // grow the cluster cores in parallel from the connected components of the
+  // towers above the growth threshold, returns the number of clusters
+  int grow_clusters_parallel();
+
+  // add the perimeter towers to a cluster
+  void add_perimeter_towers(int cluster_index);
+
+  int find_root(int ID)
+  {
+    while (_tower_parent[ID] != ID)
+    {
+      _tower_parent[ID] = _tower_parent[_tower_parent[ID]];
+      ID = _tower_parent[ID];
+    }
+    return ID;
+  }
+
+  bool is_growth_tower(int ID) const
+  {
+    return _tower_status[ID] != -2 && std::fabs(_tower_E[ID]) >= _sigma_grow * _noise_LAYER[get_ilayer_from_ID(ID)];
+  }
+
   static float calculate_dR(float, float, float, float);
 
   void export_single_cluster(const std::vector<int> &);
 
-  void export_clusters(const std::vector<int> &, std::map<int, std::pair<int, int> >, unsigned int, const std::vector<float> &, const std::vector<float> &, const std::vector<float> &);
+  // the tower ownership is taken from _tower_ownership
+  void export_clusters(const std::vector<int> &, unsigned int, const std::vector<float> &, const std::vector<float> &, const std::vector<float> &);
 
-  int get_ID(int ilayer, int ieta, int iphi)
+  int get_ID(int ilayer, int ieta, int iphi) const
   {
     if (ilayer < 2)
     {
@@ -141,7 +200,7 @@ class RawClusterBuilderTopo : public SubsysReco
     return _EMCAL_NPHI * _EMCAL_NETA + ieta * _EMCAL_NPHI + iphi;
   }
 
-  int get_ilayer_from_ID(int ID)
+  int get_ilayer_from_ID(int ID) const
   {
     if (ID < _EMCAL_NPHI * _EMCAL_NETA)
     {
@@ -153,7 +212,7 @@ class RawClusterBuilderTopo : public SubsysReco
     }
   }
 
-  int get_ieta_from_ID(int ID)
+  int get_ieta_from_ID(int ID) const
   {
     if (ID < _EMCAL_NPHI * _EMCAL_NETA)
     {
@@ -165,7 +224,7 @@ class RawClusterBuilderTopo : public SubsysReco
     }
   }
 
-  int get_iphi_from_ID(int ID)
+  int get_iphi_from_ID(int ID) const
   {
     if (ID < _EMCAL_NPHI * _EMCAL_NETA)
     {
@@ -177,34 +236,19 @@ class RawClusterBuilderTopo : public SubsysReco
     }
   }
 
-  int get_status_from_ID(int ID)
+  int get_status_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      return _TOWERMAP_STATUS_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
-    }
-    return _EMTOWERMAP_STATUS_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
+    return _tower_status[ID];
   }
 
-  float get_E_from_ID(int ID)
+  float get_E_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      return _TOWERMAP_E_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
-    }
-    return _EMTOWERMAP_E_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
+    return _tower_E[ID];
   }
 
   void set_status_by_ID(int ID, int status)
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)] = status;
-    }
-    else
-    {
-      _EMTOWERMAP_STATUS_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)] = status;
-    }
+    _tower_status[ID] = status;
   }
 
   RawClusterContainer *_clusters {nullptr};
@@ -236,13 +280,43 @@ class RawClusterBuilderTopo : public SubsysReco
   bool _do_split {true};
   bool _only_good_towers {true};
 
-  std::vector<std::vector<std::vector<float> > > _TOWERMAP_E_LAYER_ETA_PHI;
-  std::vector<std::vector<std::vector<int> > > _TOWERMAP_KEY_LAYER_ETA_PHI;
-  std::vector<std::vector<std::vector<int> > > _TOWERMAP_STATUS_LAYER_ETA_PHI;
-
-  std::vector<std::vector<float> > _EMTOWERMAP_E_ETA_PHI;
-  std::vector<std::vector<int> > _EMTOWERMAP_KEY_ETA_PHI;
-  std::vector<std::vector<int> > _EMTOWERMAP_STATUS_ETA_PHI;
+  // flat tower grid of all three calorimeters, indexed by tower ID (see get_ID)
+  // status is -2 for towers which do not exist, -1 for unowned towers and
+  // the cluster index otherwise
+  std::vector<float> _tower_E;
+  std::vector<int> _tower_key;
+  std::vector<int> _tower_status;
+
+  // neighbors of tower ID are _neighbors[_neighbor_offsets[ID]] to _neighbors[_neighbor_offsets[ID + 1]]
+  std::vector<int> _neighbor_offsets;
+  std::vector<int> _neighbors;
+
+  // tower ID and key of every TowerInfo channel, per layer
+  std::vector<int> _channel_ID[3];
+  std::vector<int> _channel_key[3];
+
+  // per event buffers, kept to reuse their memory
+  std::vector<std::pair<int, float> > _seeds;
+  std::vector<std::vector<int> > _cluster_towers;
+  std::vector<int> _cluster_seeds;
+  std::vector<int> _tower_parent;
+  std::vector<int> _root_cluster;
+  // pseudocluster ownership of the towers of the cluster being split
+  std::vector<std::pair<int, int> > _tower_ownership;
+
+  struct ClusterSums
+  {
+    float E{0};
+    float absE{0};
+    float x{0};
+    float y{0};
+    float z{0};
+  };
+  std::vector<RawCluster *> _export_clusters;
+  std::vector<ClusterSums> _export_sums;
+
+  unsigned int _nthreads{1};
+  std::unique_ptr<PHThreadPool> _pool;
 
   std::string _inputnodeprefix;
   std::string ClusterNodeName {"TOPOCLUSTER_HCAL"};
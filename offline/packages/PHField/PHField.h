@@ -3,6 +3,8 @@
 
 // units of this class. To convert internal value to Geant4/CLHEP units for fast access
 
+#include <cstddef>
+
 //! \brief transient object for field storage and access
 class PHField
 {
@@ -30,6 +32,21 @@ class PHField
       double *Bfield) const
   { return GetFieldValue( Point, Bfield ); }
 
+  //! access field values for several points at once
+  /* thread safe. By default, loops over the un-cached accessor */
+  //! @param[in]  Points  n space time coordinates, stored consecutively as x, y, z, t
+  //! @param[out] Bfields n field values, stored consecutively as Bx, By, Bz
+  virtual void GetFieldValues(
+      const double *Points,
+      double *Bfields,
+      std::size_t n) const
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      GetFieldValue_nocache(Points + 4 * i, Bfields + 3 * i);
+    }
+  }
+
   //! verbosity
   void Verbosity(const int i) { m_Verbosity = i; }
 
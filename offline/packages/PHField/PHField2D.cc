@@ -9,6 +9,7 @@
 #include <Geant4/G4SystemOfUnits.hh>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
@@ -18,10 +19,6 @@
 
 PHField2D::PHField2D(const std::string &filename, const int verb, const float magfield_rescale)
   : PHField(verb)
-  , r_index0_cache(0)
-  , r_index1_cache(0)
-  , z_index0_cache(0)
-  , z_index1_cache(0)
 {
   if (Verbosity() > 0)
   {
@@ -148,15 +145,11 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
   // initialize maps
   nz = z_set.size();
   nr = r_set.size();
-  r_map_.resize(nr, 0);
-  z_map_.resize(nz, 0);
+  z_map_ = PHFieldGridAxis(std::vector<float>(z_set.begin(), z_set.end()));
+  r_map_ = PHFieldGridAxis(std::vector<float>(r_set.begin(), r_set.end()));
 
-  std::copy(z_set.begin(), z_set.end(), z_map_.begin());
-  std::copy(r_set.begin(), r_set.end(), r_map_.begin());
-
-  // initialize the field map vectors to the correct sizes
-  BFieldR_.resize(nz, std::vector<float>(nr, 0));
-  BFieldZ_.resize(nz, std::vector<float>(nr, 0));
+  // initialize the field map to the correct size
+  BField_.assign(static_cast<std::size_t>(nz) * nr * NCOMPONENTS, 0);
 
   // all of this assumes that  z_prev < z , i.e. the table is ordered (as of right now)
   unsigned int ir = 0;
@@ -190,8 +183,9 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
       std::cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_map_[iz - 1] << std::endl;
     }
 
-    BFieldR_[iz][ir] = Br * magfield_rescale;
-    BFieldZ_[iz][ir] = Bz * magfield_rescale;
+    float *bfield = &BField_[index(iz, ir)];
+    bfield[0] = Bz * magfield_rescale;
+    bfield[1] = Br * magfield_rescale;
 
     // you can change this to check table values for correctness
     // print_map prints the values in the root table, and the
@@ -203,8 +197,8 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
       std::cout << " B("
                 << r_map_[ir] << ", "
                 << z_map_[iz] << "):  ("
-                << BFieldR_[iz][ir] << ", "
-                << BFieldZ_[iz][ir] << ")" << std::endl;
+                << bfield[1] << ", "
+                << bfield[0] << ")" << std::endl;
     }
 
   }  // end loop over root field map file
@@ -217,7 +211,7 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
   }
   if (Verbosity() > 0)
   {
-    std::cout << "  Mag field r max boundary: " << r_map_.back() / cm << " cm" << std::endl;
+    std::cout << "  Mag field r max boundary: " << r_map_.values().back() / cm << " cm" << std::endl;
   }
 
   if (Verbosity() > 0)
@@ -227,6 +221,12 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
 }
 
 void PHField2D::GetFieldValue(const double point[4], double *Bfield) const
+{
+  // the lookup does not depend on previous calls, both accessors are identical
+  GetFieldValue_nocache(point, Bfield);
+}
+
+void PHField2D::GetFieldValue_nocache(const double point[4], double *Bfield) const
 {
   if (Verbosity() > 2)
   {
@@ -250,7 +250,7 @@ void PHField2D::GetFieldValue(const double point[4], double *Bfield) const
     double cylpoint[4] = {z, r, phi, 0};
 
     // take <z,r,phi> location and return a vector of <Bz, Br, Bphi>
-    GetFieldCyl(cylpoint, BFieldCyl);
+    GetFieldCyl_nocache(cylpoint, BFieldCyl);
 
     // X direction of B-field ( Bx = Br*cos(phi) - Bphi*sin(phi)
     Bfield[0] = cos(phi) * BFieldCyl[1] - sin(phi) * BFieldCyl[2];  // unit vector transformations
@@ -282,188 +282,122 @@ void PHField2D::GetFieldValue(const double point[4], double *Bfield) const
   return;
 }
 
-void PHField2D::GetFieldValue_nocache(const double point[4], double *Bfield) const
+void PHField2D::find_cell(const double point[4], cell &c) const
 {
-  if (Verbosity() > 2)
-  {
-    std::cout << "\nPHField2D::GetFieldValue" << std::endl;
-  }
-  double x = point[0];
-  double y = point[1];
-  double z = point[2];
-  double r = sqrt(x * x + y * y);
-  double phi;
-  phi = atan2(y, x);
-  if (phi < 0)
+  c = cell();
+
+  const double x = point[0];
+  const double y = point[1];
+  const double r_point = std::sqrt(x * x + y * y);
+  if (r_point > 0)
   {
-    phi += 2 * M_PI;  // normalize phi to be over the range [0,2*pi]
+    c.cosphi = x / r_point;
+    c.sinphi = y / r_point;
   }
 
-  // Check that the point is within the defined z region (check r in a second)
-  if ((z >= minz_) && (z <= maxz_))
+  // same selection and rounding as GetFieldValue_nocache and GetFieldCyl_nocache
+  if (!(point[2] >= minz_ && point[2] <= maxz_))
   {
-    double BFieldCyl[3];
-    double cylpoint[4] = {z, r, phi, 0};
-
-    // take <z,r,phi> location and return a vector of <Bz, Br, Bphi>
-    GetFieldCyl_nocache(cylpoint, BFieldCyl);
-
-    // X direction of B-field ( Bx = Br*cos(phi) - Bphi*sin(phi)
-    Bfield[0] = cos(phi) * BFieldCyl[1] - sin(phi) * BFieldCyl[2];  // unit vector transformations
-
-    // Y direction of B-field ( By = Br*sin(phi) + Bphi*cos(phi)
-    Bfield[1] = sin(phi) * BFieldCyl[1] + cos(phi) * BFieldCyl[2];
-
-    // Z direction of B-field
-    Bfield[2] = BFieldCyl[0];
+    return;
   }
-  else  // x,y,z is outside of z range of the field map
+
+  const float z = point[2];
+  const float r = r_point;
+  if (z < z_map_[0] || z > z_map_[z_map_.size() - 1])
   {
-    Bfield[0] = 0.0;
-    Bfield[1] = 0.0;
-    Bfield[2] = 0.0;
-    if (Verbosity() > 2)
-    {
-      std::cout << "!!!!!!!!!! Field point not in defined region (outside of z bounds)" << std::endl;
-    }
+    return;
   }
 
-  if (Verbosity() > 2)
+  const int r_index0 = r_map_.lower_index(r);
+  const int z_index0 = z_map_.lower_index(z);
+  if (r_index0 < 0 || r_index0 + 1 >= r_map_.size() || z_index0 < 0 || z_index0 + 1 >= z_map_.size())
   {
-    std::cout << "END PHField2D::GetFieldValue\n"
-              << "  --->  {Bx, By, Bz} : "
-              << "< " << Bfield[0] << ", " << Bfield[1] << ", " << Bfield[2] << " >" << std::endl;
+    return;
   }
 
-  return;
-}
+  c.offset = index(z_index0, r_index0);
 
-void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
-{
-  float z = CylPoint[0];
-  float r = CylPoint[1];
+  double zweight = z - z_map_[z_index0];
+  double zspacing = z_map_[z_index0 + 1] - z_map_[z_index0];
+  c.zweight = zweight / zspacing;
 
-  BfieldCyl[0] = 0.0;
-  BfieldCyl[1] = 0.0;
-  BfieldCyl[2] = 0.0;
+  double rweight = r - r_map_[r_index0];
+  double rspacing = r_map_[r_index0 + 1] - r_map_[r_index0];
+  c.rweight = rweight / rspacing;
 
-  if (Verbosity() > 2)
-  {
-    std::cout << "GetFieldCyl@ <z,r>: {" << z << "," << r << "}" << std::endl;
-  }
+  c.inside = true;
+}
 
-  if (z < z_map_[0] || z > z_map_[z_map_.size() - 1])
+void PHField2D::GetFieldValues(const double *points, double *Bfields, std::size_t n) const
+{
+  // diagnostic printouts are only available in the single point accessor
+  if (Verbosity() > 2)
   {
-    if (Verbosity() > 2)
+    for (std::size_t i = 0; i < n; ++i)
     {
-      std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
+      PHField2D::GetFieldValue_nocache(points + 4 * i, Bfields + 3 * i);
     }
     return;
   }
 
-  // since GEANT4 looks up the field ~95% of the time in the same voxel
-  // between subsequent calls, we can save on the expense of the upper_bound
-  // lookup (~10-15% of central event run time) with some caching between calls
-  unsigned int r_index0 = r_index0_cache;
-  unsigned int r_index1 = r_index1_cache;
+  // points are processed by blocks: the grid cells of all points in the block are found first,
+  // then all points are interpolated in a single loop over the flat grid.
+  // The rotation to cartesian coordinates uses x/r and y/r rather than cos(phi) and sin(phi),
+  // so that results agree with GetFieldValue up to rounding
+  constexpr std::size_t block_size = 64;
+  std::array<cell, block_size> cells;
+
+  const std::ptrdiff_t z_step = static_cast<std::ptrdiff_t>(r_map_.size()) * NCOMPONENTS;
+  const float *field = BField_.data();
 
-  if (!((r > r_map_[r_index0]) && (r < r_map_[r_index1])))
+  for (std::size_t first = 0; first < n; first += block_size)
   {
-    // if miss cached r values, search through the lookup table
-    std::vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
-    r_index0 = distance(r_map_.begin(), riter) - 1;
-    if (r_index0 >= r_map_.size())
+    const std::size_t count = std::min(block_size, n - first);
+    for (std::size_t i = 0; i < count; ++i)
     {
-      if (Verbosity() > 2)
-      {
-        std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
-      }
-      return;
+      find_cell(points + 4 * (first + i), cells[i]);
     }
 
-    r_index1 = r_index0 + 1;
-    if (r_index1 >= r_map_.size())
+    for (std::size_t i = 0; i < count; ++i)
     {
-      if (Verbosity() > 2)
+      const cell &c = cells[i];
+      double *Bfield = Bfields + 3 * (first + i);
+      if (!c.inside)
       {
-        std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
+        Bfield[0] = 0.0;
+        Bfield[1] = 0.0;
+        Bfield[2] = 0.0;
+        continue;
       }
-      return;
-    }
-
-    // update cache
-    r_index0_cache = r_index0;
-    r_index1_cache = r_index1;
-  }
 
-  unsigned int z_index0 = z_index0_cache;
-  unsigned int z_index1 = z_index1_cache;
+      const float *B00 = field + c.offset;
+      const float *B01 = B00 + NCOMPONENTS;
+      const float *B10 = B00 + z_step;
+      const float *B11 = B10 + NCOMPONENTS;
 
-  if (!((z > z_map_[z_index0]) && (z < z_map_[z_index1])))
-  {
-    // if miss cached z values, search through the lookup table
-    std::vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
-    z_index0 = distance(z_map_.begin(), ziter) - 1;
-    z_index1 = z_index0 + 1;
-    if (z_index1 >= z_map_.size())
-    {
-      if (Verbosity() > 2)
+      double BfieldCyl[NCOMPONENTS];
+      for (int j = 0; j < NCOMPONENTS; ++j)
       {
-        std::cout << "!!!! Point not in defined region (z too large in specific r-plane)" << std::endl;
+        BfieldCyl[j] =
+            (1 - c.zweight) * ((1 - c.rweight) * B00[j] +
+                               c.rweight * B01[j]) +
+            c.zweight * ((1 - c.rweight) * B10[j] +
+                         c.rweight * B11[j]);
       }
-      return;
-    }
-
-    // update cache
-    z_index0_cache = z_index0;
-    z_index1_cache = z_index1;
-  }
-
-  double Br000 = BFieldR_[z_index0][r_index0];
-  double Br010 = BFieldR_[z_index0][r_index1];
-  double Br100 = BFieldR_[z_index1][r_index0];
-  double Br110 = BFieldR_[z_index1][r_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0];
-  double Bz100 = BFieldZ_[z_index1][r_index0];
-  double Bz010 = BFieldZ_[z_index0][r_index1];
-  double Bz110 = BFieldZ_[z_index1][r_index1];
 
-  double zweight = z - z_map_[z_index0];
-  double zspacing = z_map_[z_index1] - z_map_[z_index0];
-  zweight /= zspacing;
-
-  double rweight = r - r_map_[r_index0];
-  double rspacing = r_map_[r_index1] - r_map_[r_index0];
-  rweight /= rspacing;
-
-  // Z direction of B-field
-  BfieldCyl[0] =
-      (1 - zweight) * ((1 - rweight) * Bz000 +
-                       rweight * Bz010) +
-      zweight * ((1 - rweight) * Bz100 +
-                 rweight * Bz110);
-
-  // R direction of B-field
-  BfieldCyl[1] =
-      (1 - zweight) * ((1 - rweight) * Br000 +
-                       rweight * Br010) +
-      zweight * ((1 - rweight) * Br100 +
-                 rweight * Br110);
-
-  // PHI Direction of B-field
-  BfieldCyl[2] = 0;
-
-  if (Verbosity() > 2)
-  {
-    std::cout << "End GFCyl Call: <bz,br,bphi> : {"
-              << BfieldCyl[0] / gauss << "," << BfieldCyl[1] / gauss << "," << BfieldCyl[2] / gauss << "}"
-              << std::endl;
+      // (Bz, Br) to (Bx, By, Bz). There is no azimuthal component
+      Bfield[0] = c.cosphi * BfieldCyl[1];
+      Bfield[1] = c.sinphi * BfieldCyl[1];
+      Bfield[2] = BfieldCyl[0];
+    }
   }
-
-  return;
 }
 
+void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
+{
+  // the lookup does not depend on previous calls, both accessors are identical
+  GetFieldCyl_nocache(CylPoint, BfieldCyl);
+}
 
 void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl) const
 {
@@ -488,14 +422,10 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
     return;
   }
 
-  // since GEANT4 looks up the field ~95% of the time in the same voxel
-  // between subsequent calls, we can save on the expense of the upper_bound
-  // lookup (~10-15% of central event run time) with some caching between calls
-
-  // if miss cached r values, search through the lookup table
-  std::vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
-  const unsigned int r_index0 = distance(r_map_.begin(), riter) - 1;
-  if (r_index0 >= r_map_.size())
+  // grid cells are found by direct index calculation for uniform grids,
+  // which makes caching the previous cell unnecessary
+  const unsigned int r_index0 = r_map_.lower_index(r);
+  if (r_index0 >= (unsigned int) r_map_.size())
   {
     if (Verbosity() > 2)
     {
@@ -505,7 +435,7 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
   }
 
   const unsigned int r_index1 = r_index0 + 1;
-  if (r_index1 >= r_map_.size())
+  if (r_index1 >= (unsigned int) r_map_.size())
   {
     if (Verbosity() > 2)
     {
@@ -514,11 +444,9 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
     return;
   }
 
-  // if miss cached z values, search through the lookup table
-  std::vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
-  const unsigned int z_index0 = distance(z_map_.begin(), ziter) - 1;
+  const unsigned int z_index0 = z_map_.lower_index(z);
   const unsigned int z_index1 = z_index0 + 1;
-  if (z_index1 >= z_map_.size())
+  if (z_index1 >= (unsigned int) z_map_.size())
   {
     if (Verbosity() > 2)
     {
@@ -527,15 +455,11 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
     return;
   }
 
-  double Br000 = BFieldR_[z_index0][r_index0];
-  double Br010 = BFieldR_[z_index0][r_index1];
-  double Br100 = BFieldR_[z_index1][r_index0];
-  double Br110 = BFieldR_[z_index1][r_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0];
-  double Bz100 = BFieldZ_[z_index1][r_index0];
-  double Bz010 = BFieldZ_[z_index0][r_index1];
-  double Bz110 = BFieldZ_[z_index1][r_index1];
+  // each corner holds (Bz, Br)
+  const float *B00 = &BField_[index(z_index0, r_index0)];
+  const float *B01 = &BField_[index(z_index0, r_index1)];
+  const float *B10 = &BField_[index(z_index1, r_index0)];
+  const float *B11 = &BField_[index(z_index1, r_index1)];
 
   double zweight = z - z_map_[z_index0];
   double zspacing = z_map_[z_index1] - z_map_[z_index0];
@@ -545,19 +469,15 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
   double rspacing = r_map_[r_index1] - r_map_[r_index0];
   rweight /= rspacing;
 
-  // Z direction of B-field
-  BfieldCyl[0] =
-      (1 - zweight) * ((1 - rweight) * Bz000 +
-                       rweight * Bz010) +
-      zweight * ((1 - rweight) * Bz100 +
-                 rweight * Bz110);
-
-  // R direction of B-field
-  BfieldCyl[1] =
-      (1 - zweight) * ((1 - rweight) * Br000 +
-                       rweight * Br010) +
-      zweight * ((1 - rweight) * Br100 +
-                 rweight * Br110);
+  // Z and R direction of B-field
+  for (int i = 0; i < NCOMPONENTS; ++i)
+  {
+    BfieldCyl[i] =
+        (1 - zweight) * ((1 - rweight) * B00[i] +
+                         rweight * B01[i]) +
+        zweight * ((1 - rweight) * B10[i] +
+                   rweight * B11[i]);
+  }
 
   // PHI Direction of B-field
   BfieldCyl[2] = 0;
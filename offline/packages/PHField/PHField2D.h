@@ -3,7 +3,9 @@
 #define PHFIELD_PHFIELD2D_H
 
 #include "PHField.h"
+#include "PHFieldGridAxis.h"
 
+#include <cstddef>
 #include <map>
 #include <string>
 #include <tuple>
@@ -25,37 +27,56 @@ class PHField2D : public PHField
   //! access field value
   void GetFieldValue_nocache(const double Point[4], double *Bfield) const override;
 
+  //! access field values for several points at once
+  void GetFieldValues(const double *Points, double *Bfields, std::size_t n) const override;
+
   void GetFieldCyl(const double CylPoint[4], double *Bfield) const;
 
   void GetFieldCyl_nocache(const double CylPoint[4], double *Bfield) const;
 
   protected:
-  // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector<std::vector<float> > BFieldZ_;
-  std::vector<std::vector<float> > BFieldR_;
-  std::vector<std::vector<float> > BFieldPHI_;
+  //! number of field components stored per grid point
+  static constexpr int NCOMPONENTS = 2;
+
+  //! index of the first field component (Bz) of a grid point in BField_
+  std::size_t index(int iz, int ir) const
+  {
+    return (static_cast<std::size_t>(iz) * r_map_.size() + ir) * NCOMPONENTS;
+  }
+
+  // field values on the <z,r> grid, r running fastest
+  // components are interleaved as (Bz, Br)
+  std::vector<float> BField_;
 
   // maps indices to values z_map[i] = z_value that corresponds to ith index
-  std::vector<float> z_map_;    // < i >
-  std::vector<float> r_map_;    // < j >
-  std::vector<float> phi_map_;  // < k >
+  PHFieldGridAxis z_map_;    // < i >
+  PHFieldGridAxis r_map_;    // < j >
 
   float maxz_, minz_;  // boundaries of magnetic field map cyl
   double magfield_unit;
 
  private:
+  //! grid cell and interpolation weights of a point, used by GetFieldValues
+  struct cell
+  {
+    //! first component of the lower corner in BField_
+    std::size_t offset = 0;
+
+    double zweight = 0;
+    double rweight = 0;
+
+    //! cos and sin of the point azimuth, to rotate the field to cartesian coordinates
+    double cosphi = 1;
+    double sinphi = 0;
+
+    //! false if the point is outside of the map, in which case the field is zero
+    bool inside = false;
+  };
+
+  //! find grid cell and interpolation weights of a point, same selection as GetFieldValue
+  void find_cell(const double point[4], cell &) const;
+
   void print_map(std::map<trio, trio>::iterator &it) const;
-  // mutable allows to change internal data even in const methods
-  // I don't like this too much but these are cached values to speed up
-  // the field lookup by a lot
-  // I want them to be data members so we can run 2 fieldmaps in parallel
-  // and still have caching. Putting those as static variables into
-  // the implementation will prevent this
-
-  mutable unsigned int r_index0_cache;
-  mutable unsigned int r_index1_cache;
-  mutable unsigned int z_index0_cache;
-  mutable unsigned int z_index1_cache;
 };
 
 #endif
@@ -1,4 +1,5 @@
 #include "PHField3DCartesian.h"
+#include "PHFieldMapFile.h"
 
 #include <phool/phool.h>
 
@@ -11,37 +12,92 @@
 
 #include <boost/stacktrace.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <iterator>
 #include <set>
+#include <stdexcept>
 #include <utility>
 
-PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
-  : filename(fname)
+namespace
 {
-  std::cout << "PHField3DCartesian::PHField3DCartesian" << std::endl;
-
-  for (int i = 0; i < 2; i++) // NOLINT (modernize-loop-convert)
+  // find cell i such that axis[i] <= value <= axis[i+1] and the fractional position of value inside the cell.
+  // value is assumed to be inside the axis range
+  void find_cell(const PHFieldGridAxis &axis, double value, std::size_t &index, double &fraction)
   {
-    for (int j = 0; j < 2; j++)
+    const int n = axis.size();
+    if (n < 2)
     {
-      for (int k = 0; k < 2; k++)
-      {
-        for (int l = 0; l < 3; l++)
-        {
-          bf[i][j][k][l] = {std::numeric_limits<double>::quiet_NaN()};
-        }
-      }
+      index = 0;
+      fraction = 0;
+      return;
     }
+
+    const int i = std::clamp(axis.lower_index(value), 0, n - 2);
+    index = i;
+    fraction = (value - axis[i]) / (axis[i + 1] - axis[i]);
+  }
+
+  // position of a coordinate value in its (sorted) axis
+  std::size_t axis_index(const PHFieldGridAxis &axis, float value)
+  {
+    return std::distance(axis.values().begin(), std::lower_bound(axis.values().begin(), axis.values().end(), value));
   }
+}  // namespace
+
+PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
+  : filename(fname)
+  , rescale(magfield_rescale)
+{
+  std::cout << "PHField3DCartesian::PHField3DCartesian" << std::endl;
+
   std::cout << "\n================ Begin Construct Mag Field =====================" << std::endl;
   std::cout << "\n-----------------------------------------------------------"
             << "\n      Magnetic field Module - Verbosity:"
             << "\n-----------------------------------------------------------";
 
+  if (PHFieldMapFile::is_binary_map(filename))
+  {
+    read_binary(innerradius, outerradius, size_z);
+  }
+  else
+  {
+    read_root(innerradius, outerradius, size_z);
+  }
+
+  xmin = xvals.values().front();
+  xmax = xvals.values().back();
+
+  ymin = yvals.values().front();
+  ymax = yvals.values().back();
+  if (ymin != xmin || ymax != xmax)
+  {
+    std::cout << "PHField3DCartesian: Compiler bug!!!!!!!! Do not use inlining!!!!!!" << std::endl;
+    std::cout << "exiting now - recompile with -fno-inline" << std::endl;
+    exit(1);
+  }
+
+  zmin = zvals.values().front();
+  zmax = zvals.values().back();
+
+  xstepsize = (xmax - xmin) / (xvals.size() - 1);
+  ystepsize = (ymax - ymin) / (yvals.size() - 1);
+  zstepsize = (zmax - zmin) / (zvals.size() - 1);
+
+  std::cout << " ---> " << xvals.size() << " x " << yvals.size() << " x " << zvals.size() << " grid points" << std::endl;
+  std::cout << "\n================= End Construct Mag Field ======================\n"
+            << std::endl;
+}
+
+//_____________________________________________________________
+PHField3DCartesian::~PHField3DCartesian() = default;
+
+//_____________________________________________________________
+void PHField3DCartesian::read_root(const float innerradius, const float outerradius, const float size_z)
+{
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -76,56 +132,130 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
   field_map->SetBranchAddress("bx", &ROOT_BX);
   field_map->SetBranchAddress("by", &ROOT_BY);
   field_map->SetBranchAddress("bz", &ROOT_BZ);
+
+  // first pass: store accepted entries and collect the grid coordinates along each axis
+  struct entry
+  {
+    float x;
+    float y;
+    float z;
+    float bx;
+    float by;
+    float bz;
+  };
+  std::vector<entry> entries;
+  entries.reserve(field_map->GetEntries());
+
+  std::set<float> xset;
+  std::set<float> yset;
+  std::set<float> zset;
   for (int i = 0; i < field_map->GetEntries(); i++)
   {
     field_map->GetEntry(i);
-    trio coord_key(ROOT_X * cm, ROOT_Y * cm, ROOT_Z * cm);
-    trio field_val(ROOT_BX * tesla * magfield_rescale, ROOT_BY * tesla * magfield_rescale, ROOT_BZ * tesla * magfield_rescale);
-    xvals.insert(ROOT_X * cm);
-    yvals.insert(ROOT_Y * cm);
-    zvals.insert(ROOT_Z * cm);
-    if ((std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) >= innerradius &&
-         std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) <= outerradius) ||
-        std::abs(ROOT_Z * cm) > size_z)
+    xset.insert(ROOT_X * cm);
+    yset.insert(ROOT_Y * cm);
+    zset.insert(ROOT_Z * cm);
+    if (accept(ROOT_X * cm, ROOT_Y * cm, ROOT_Z * cm, innerradius, outerradius, size_z))
     {
-      fieldmap[coord_key] = field_val;
+      entries.push_back({static_cast<float>(ROOT_X * cm), static_cast<float>(ROOT_Y * cm), static_cast<float>(ROOT_Z * cm),
+                         static_cast<float>(ROOT_BX * tesla), static_cast<float>(ROOT_BY * tesla), static_cast<float>(ROOT_BZ * tesla)});
     }
   }
-  xmin = *(xvals.begin());
-  xmax = *(xvals.rbegin());
-
-  ymin = *(yvals.begin());
-  ymax = *(yvals.rbegin());
-  if (ymin != xmin || ymax != xmax)
+  xvals = PHFieldGridAxis(std::vector<float>(xset.begin(), xset.end()));
+  yvals = PHFieldGridAxis(std::vector<float>(yset.begin(), yset.end()));
+  zvals = PHFieldGridAxis(std::vector<float>(zset.begin(), zset.end()));
+
+  // second pass: fill the dense field arrays. Grid points without an entry remain NaN
+  const std::size_t npoints = xvals.size() * yvals.size() * zvals.size();
+  bxvals.assign(npoints, std::numeric_limits<float>::quiet_NaN());
+  byvals.assign(npoints, std::numeric_limits<float>::quiet_NaN());
+  bzvals.assign(npoints, std::numeric_limits<float>::quiet_NaN());
+  for (const auto &e : entries)
   {
-    std::cout << "PHField3DCartesian: Compiler bug!!!!!!!! Do not use inlining!!!!!!" << std::endl;
-    std::cout << "exiting now - recompile with -fno-inline" << std::endl;
-    exit(1);
+    const std::size_t i = index(axis_index(xvals, e.x), axis_index(yvals, e.y), axis_index(zvals, e.z));
+    bxvals[i] = e.bx;
+    byvals[i] = e.by;
+    bzvals[i] = e.bz;
   }
-
-  zmin = *(zvals.begin());
-  zmax = *(zvals.rbegin());
-
-  xstepsize = (xmax - xmin) / (xvals.size() - 1);
-  ystepsize = (ymax - ymin) / (yvals.size() - 1);
-  zstepsize = (zmax - zmin) / (zvals.size() - 1);
+  bx = bxvals.data();
+  by = byvals.data();
+  bz = bzvals.data();
 
   delete field_map;
   delete rootinput;
-  std::cout << "\n================= End Construct Mag Field ======================\n"
-            << std::endl;
 }
 
-PHField3DCartesian::~PHField3DCartesian()
+//_____________________________________________________________
+void PHField3DCartesian::read_binary(const float innerradius, const float outerradius, const float size_z)
 {
-  if (Verbosity() > 0)
+  std::cout << "\n ---> "
+               "Mapping the field grid from "
+            << filename << " ... " << std::endl;
+
+  try
   {
-    std::cout << "PHField3DCartesian: cache hits: " << cache_hits
-              << " cache misses: " << cache_misses
-              << std::endl;
+    mapfile = std::make_unique<PHFieldMapFile>(filename);
+  }
+  catch (const std::runtime_error &e)
+  {
+    std::cout << PHWHERE << " " << e.what() << " exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+
+  xvals = PHFieldGridAxis(std::vector<float>(mapfile->x(), mapfile->x() + mapfile->nx()));
+  yvals = PHFieldGridAxis(std::vector<float>(mapfile->y(), mapfile->y() + mapfile->ny()));
+  zvals = PHFieldGridAxis(std::vector<float>(mapfile->z(), mapfile->z() + mapfile->nz()));
+
+  // use the mapped field values directly, unless the radius cuts remove some of the points
+  bx = mapfile->bx();
+  by = mapfile->by();
+  bz = mapfile->bz();
+
+  bool copied = false;
+  for (int ix = 0; ix < xvals.size(); ++ix)
+  {
+    for (int iy = 0; iy < yvals.size(); ++iy)
+    {
+      for (int iz = 0; iz < zvals.size(); ++iz)
+      {
+        const std::size_t i = index(ix, iy, iz);
+        if (std::isnan(bx[i]) || accept(xvals[ix], yvals[iy], zvals[iz], innerradius, outerradius, size_z))
+        {
+          continue;
+        }
+
+        if (!copied)
+        {
+          const std::size_t npoints = xvals.size() * yvals.size() * zvals.size();
+          bxvals.assign(bx, bx + npoints);
+          byvals.assign(by, by + npoints);
+          bzvals.assign(bz, bz + npoints);
+          bx = bxvals.data();
+          by = byvals.data();
+          bz = bzvals.data();
+          copied = true;
+        }
+        bxvals[i] = std::numeric_limits<float>::quiet_NaN();
+        byvals[i] = std::numeric_limits<float>::quiet_NaN();
+        bzvals[i] = std::numeric_limits<float>::quiet_NaN();
+      }
+    }
+  }
+
+  // the mapping is no longer needed once the values are copied
+  if (copied)
+  {
+    mapfile.reset();
   }
 }
 
+//_____________________________________________________________
+bool PHField3DCartesian::write_binary(const std::string &fname) const
+{
+  return PHFieldMapFile::write_cartesian(fname, xvals.values(), yvals.values(), zvals.values(), bx, by, bz);
+}
+
 void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) const
 {
 
@@ -169,158 +299,7 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
   ysav = y;
   zsav = z;
 
-  if (point[0] < xmin || point[0] > xmax ||
-      point[1] < ymin || point[1] > ymax ||
-      point[2] < zmin || point[2] > zmax)
-  {
-    return;
-  }
-
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    xkey[1] = *it;
-  }
-
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
-  {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    zkey[1] = *it;
-  }
-
-  if (xkey_save != xkey[0] ||
-      ykey_save != ykey[0] ||
-      zkey_save != zkey[0])
-  {
-    cache_misses++;
-    xkey_save = xkey[0];
-    ykey_save = ykey[0];
-    zkey_save = zkey[0];
-
-    std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-    trio key;
-    for (int i = 0; i < 2; i++)
-    {
-      for (int j = 0; j < 2; j++)
-      {
-        for (int k = 0; k < 2; k++)
-        {
-          key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-          magval = fieldmap.find(key);
-          if (magval == fieldmap.end())
-          {
-            std::cout << PHWHERE << " could not locate key in " << filename
-                      << " value: x: " << xkey[i] / cm
-                      << ", y: " << ykey[j] / cm
-                      << ", z: " << zkey[k] / cm << std::endl;
-            return;
-          }
-          bf[i][j][k][0] = std::get<0>(magval->second);
-          bf[i][j][k][1] = std::get<1>(magval->second);
-          bf[i][j][k][2] = std::get<2>(magval->second);
-          if (Verbosity() > 0)
-          {
-            const double x_loc = std::get<0>(magval->first);
-            const double y_loc = std::get<1>(magval->first);
-            const double z_loc = std::get<2>(magval->first);
-
-            std::cout << "read x/y/z: " << x_loc / cm << "/"
-              << y_loc / cm << "/"
-              << z_loc / cm << " bx/by/bz: "
-              << bf[i][j][k][0] / tesla << "/"
-              << bf[i][j][k][1] / tesla << "/"
-              << bf[i][j][k][2] / tesla << std::endl;
-          }
-        }
-      }
-    }
-  }
-  else
-  {
-    cache_hits++;
-  }
-
-  // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
-  // normalize distance to step size
-  double fractionx = xinblock / xstepsize;
-  double fractiony = yinblock / ystepsize;
-  double fractionz = zinblock / zstepsize;
-  if (Verbosity() > 0)
-  {
-    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
-    std::cout << "x/y/z inblock: " << xinblock / cm << "/" << yinblock / cm << "/" << zinblock / cm << std::endl;
-    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
-  }
-
-  // linear extrapolation in cube:
-
-  // Vxyz =
-  // V000 * x * y * z +
-  // V100 * (1 - x) * y * z +
-  // V010 * x * (1 - y) * z +
-  // V001 * x y * (1 - z) +
-  // V101 * (1 - x) * y * (1 - z) +
-  // V011 * x * (1 - y) * (1 - z) +
-  // V110 * (1 - x) * (1 - y) * z +
-  // V111 * (1 - x) * (1 - y) * (1 - z)
-
-  for (int i = 0; i < 3; i++)
-  {
-    Bfield[i] = bf[0][0][0][i] * fractionx * fractiony * fractionz +
-                bf[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
-                bf[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
-                bf[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
-                bf[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
-                bf[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
-                bf[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
-                bf[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
-  }
-
-  return;
+  interpolate(x, y, z, Bfield);
 }
 
 //_____________________________________________________________
@@ -337,145 +316,85 @@ void PHField3DCartesian::GetFieldValue_nocache(const double point[4], double *Bf
   if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(z))
   { return; }
 
-  if (point[0] < xmin || point[0] > xmax ||
-      point[1] < ymin || point[1] > ymax ||
-      point[2] < zmin || point[2] > zmax)
-  { return; }
+  interpolate(x, y, z, Bfield);
+}
 
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
+//_____________________________________________________________
+void PHField3DCartesian::GetFieldValues(const double *points, double *Bfields, std::size_t n) const
+{
+  for (std::size_t i = 0; i < n; ++i)
   {
-    --it;
-    xkey[1] = *it;
+    GetFieldValue_nocache(points + 4 * i, Bfields + 3 * i);
   }
+}
 
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
-  {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
-  }
-  else
+//_____________________________________________________________
+void PHField3DCartesian::interpolate(double x, double y, double z, double *Bfield) const
+{
+  Bfield[0] = 0.0;
+  Bfield[1] = 0.0;
+  Bfield[2] = 0.0;
+
+  if (x < xmin || x > xmax ||
+      y < ymin || y > ymax ||
+      z < zmin || z > zmax)
+  { return; }
+
+  // lower corner of the cell containing the point, and normalized position inside the cell
+  std::size_t ix = 0;
+  std::size_t iy = 0;
+  std::size_t iz = 0;
+  double fractionx = 0;
+  double fractiony = 0;
+  double fractionz = 0;
+  find_cell(xvals, x, ix, fractionx);
+  find_cell(yvals, y, iy, fractiony);
+  find_cell(zvals, z, iz, fractionz);
+
+  // number of grid points to the upper corner along each axis (0 for single point axis)
+  const std::size_t nx = (xvals.size() > 1) ? 1 : 0;
+  const std::size_t ny = (yvals.size() > 1) ? 1 : 0;
+  const std::size_t nz = (zvals.size() > 1) ? 1 : 0;
+
+  if (Verbosity() > 0)
   {
-    --it;
-    zkey[1] = *it;
+    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
+    std::cout << "x/y/z cell: " << ix << "/" << iy << "/" << iz << std::endl;
+    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
   }
 
-  // local xyz and field
-  double bf_loc[2][2][2][3]{};
-
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-  trio key;
-  for (int i = 0; i < 2; i++)
+  // linear interpolation in cube:
+  // each corner is weighted by the product, along each axis, of
+  // fraction for the upper point and (1 - fraction) for the lower point
+  double bfield_loc[3] = {0, 0, 0};
+  for (std::size_t i = 0; i < 2; ++i)
   {
-    for (int j = 0; j < 2; j++)
+    const double wx = i ? fractionx : 1. - fractionx;
+    for (std::size_t j = 0; j < 2; ++j)
     {
-      for (int k = 0; k < 2; k++)
+      const double wy = j ? fractiony : 1. - fractiony;
+      for (std::size_t k = 0; k < 2; ++k)
       {
-        key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-        magval = fieldmap.find(key);
-        if (magval == fieldmap.end())
+        const double wz = k ? fractionz : 1. - fractionz;
+        const std::size_t index_loc = index(ix + i * nx, iy + j * ny, iz + k * nz);
+        if (std::isnan(bx[index_loc]))
         {
           std::cout << PHWHERE << " could not locate key in " << filename
-            << " value: x: " << xkey[i] / cm
-            << ", y: " << ykey[j] / cm
-            << ", z: " << zkey[k] / cm << std::endl;
+                    << " value: x: " << xvals[ix + i * nx] / cm
+                    << ", y: " << yvals[iy + j * ny] / cm
+                    << ", z: " << zvals[iz + k * nz] / cm << std::endl;
           return;
         }
 
-        bf_loc[i][j][k][0] = std::get<0>(magval->second);
-        bf_loc[i][j][k][1] = std::get<1>(magval->second);
-        bf_loc[i][j][k][2] = std::get<2>(magval->second);
-        if (Verbosity() > 0)
-        {
-
-          const double x_loc = std::get<0>(magval->first);
-          const double y_loc = std::get<1>(magval->first);
-          const double z_loc = std::get<2>(magval->first);
-
-          std::cout << "read x/y/z: " << x_loc / cm << "/"
-            << y_loc / cm << "/"
-            << z_loc / cm << " bx/by/bz: "
-            << bf_loc[i][j][k][0] / tesla << "/"
-            << bf_loc[i][j][k][1] / tesla << "/"
-            << bf_loc[i][j][k][2] / tesla << std::endl;
-        }
+        const double weight = wx * wy * wz;
+        bfield_loc[0] += weight * bx[index_loc];
+        bfield_loc[1] += weight * by[index_loc];
+        bfield_loc[2] += weight * bz[index_loc];
       }
     }
   }
 
-  // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
-  // normalize distance to step size
-  double fractionx = xinblock / xstepsize;
-  double fractiony = yinblock / ystepsize;
-  double fractionz = zinblock / zstepsize;
-  if (Verbosity() > 0)
-  {
-    std::cout << "x/y/z stepsize: " << xstepsize / cm << "/" << ystepsize / cm << "/" << zstepsize / cm << std::endl;
-    std::cout << "x/y/z inblock: " << xinblock / cm << "/" << yinblock / cm << "/" << zinblock / cm << std::endl;
-    std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
-  }
-
-  // linear extrapolation in cube:
-
-  // Vxyz =
-  // V000 * x * y * z +
-  // V100 * (1 - x) * y * z +
-  // V010 * x * (1 - y) * z +
-  // V001 * x y * (1 - z) +
-  // V101 * (1 - x) * y * (1 - z) +
-  // V011 * x * (1 - y) * (1 - z) +
-  // V110 * (1 - x) * (1 - y) * z +
-  // V111 * (1 - x) * (1 - y) * (1 - z)
-
-  for (int i = 0; i < 3; i++)
-  {
-    Bfield[i] = bf_loc[0][0][0][i] * fractionx * fractiony * fractionz +
-                bf_loc[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
-                bf_loc[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
-                bf_loc[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
-                bf_loc[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
-                bf_loc[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
-                bf_loc[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
-                bf_loc[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
-  }
-
-  return;
+  Bfield[0] = bfield_loc[0] * rescale;
+  Bfield[1] = bfield_loc[1] * rescale;
+  Bfield[2] = bfield_loc[2] * rescale;
 }
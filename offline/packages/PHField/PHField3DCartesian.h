@@ -2,18 +2,23 @@
 #define PHFIELD_PHFIELD3DCARTESIAN_H
 
 #include "PHField.h"
+#include "PHFieldGridAxis.h"
 
+#include <cmath>
+#include <cstddef>
 #include <limits>
-#include <map>
-#include <set>
+#include <memory>
 #include <string>
-#include <tuple>
+#include <vector>
+
+class PHFieldMapFile;
 
 class PHField3DCartesian : public PHField
 {
  public:
 
   //! constructor
+  /*! fname is either a ROOT file containing the "fieldmap" ntuple, or a binary map (see PHFieldMapFile) */
   explicit PHField3DCartesian(const std::string &fname, const float magfield_rescale = 1.0, const float innerradius = 0, const float outerradius = 1.e10, const float size_z = 1.e10);
 
   //! destructor
@@ -25,10 +30,40 @@ class PHField3DCartesian : public PHField
   //! @param[out] Bfield  field value. In the case of magnetic field, the order is Bx, By, Bz in in Geant4/CLHEP units
   void GetFieldValue(const double Point[4], double *Bfield) const override;
 
+  //! access field value. The lookup does not use any cache, so that this is identical to GetFieldValue, minus diagnostics
   void GetFieldValue_nocache(const double Point[4], double *Bfield) const override;
 
+  //! access field values for several points at once
+  void GetFieldValues(const double *Points, double *Bfields, std::size_t n) const override;
+
+  //! write the loaded grid to a binary map. Returns false on failure
+  /*! field values are written before rescaling */
+  bool write_binary(const std::string &fname) const;
+
   private:
+
+  //! load grid from ROOT ntuple
+  void read_root(const float innerradius, const float outerradius, const float size_z);
+
+  //! map grid from binary file
+  void read_binary(const float innerradius, const float outerradius, const float size_z);
+
+  //! true if a grid point passes the radius cuts
+  static bool accept(double x, double y, double z, const float innerradius, const float outerradius, const float size_z)
+  {
+    const double r = std::sqrt(x * x + y * y);
+    return (r >= innerradius && r <= outerradius) || std::abs(z) > size_z;
+  }
+
+  //! trilinear interpolation of the field at a given point, assumed finite
+  void interpolate(double x, double y, double z, double *Bfield) const;
+
+  //! index of a grid point in the field arrays
+  std::size_t index(std::size_t ix, std::size_t iy, std::size_t iz) const
+  { return (ix * yvals.size() + iy) * zvals.size() + iz; }
+
   std::string filename;
+  double rescale {1};
   double xmin {1000000};
   double xmax {-1000000};
   double ymin {1000000};
@@ -39,20 +74,27 @@ class PHField3DCartesian : public PHField
   double ystepsize {std::numeric_limits<double>::quiet_NaN()};
   double zstepsize {std::numeric_limits<double>::quiet_NaN()};
 
-  // these are updated in a const method
-  // to cache previous values
-  mutable double bf[2][2][2][3]{};
-  mutable double xkey_save {std::numeric_limits<double>::quiet_NaN()};
-  mutable double ykey_save {std::numeric_limits<double>::quiet_NaN()};
-  mutable double zkey_save {std::numeric_limits<double>::quiet_NaN()};
-  mutable int cache_hits {0};
-  mutable int cache_misses {0};
-
-  typedef std::tuple<float, float, float> trio;
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> > fieldmap;
-  std::set<float> xvals;
-  std::set<float> yvals;
-  std::set<float> zvals;
+  //! grid point coordinates along each axis, sorted
+  PHFieldGridAxis xvals;
+  PHFieldGridAxis yvals;
+  PHFieldGridAxis zvals;
+
+  //! field components at each grid point, z running fastest, before rescaling
+  /*!
+  points that are not in the map (e.g. removed by the radius cuts) are set to NaN.
+  They point either to the owned arrays below, or directly into the mapped binary file
+  */
+  const float *bx {nullptr};
+  const float *by {nullptr};
+  const float *bz {nullptr};
+
+  //! owned field arrays, used when reading from ROOT or when the cuts remove points from a binary map
+  std::vector<float> bxvals;
+  std::vector<float> byvals;
+  std::vector<float> bzvals;
+
+  //! binary map, kept open for as long as the field arrays point into it
+  std::unique_ptr<PHFieldMapFile> mapfile;
 };
 
 #endif
@@ -7,6 +7,7 @@
 #include <Geant4/G4SystemOfUnits.hh>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstdlib>
@@ -134,18 +135,12 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
   nz = z_set.size();
   nr = r_set.size();
   nphi = phi_set.size();
-  r_map_.resize(nr, 0);
-  z_map_.resize(nz, 0);
-  phi_map_.resize(nphi, 0);
+  z_map_ = PHFieldGridAxis(std::vector<float>(z_set.begin(), z_set.end()));
+  r_map_ = PHFieldGridAxis(std::vector<float>(r_set.begin(), r_set.end()));
+  phi_map_ = PHFieldGridAxis(std::vector<float>(phi_set.begin(), phi_set.end()));
 
-  std::copy(z_set.begin(), z_set.end(), z_map_.begin());
-  std::copy(phi_set.begin(), phi_set.end(), phi_map_.begin());
-  std::copy(r_set.begin(), r_set.end(), r_map_.begin());
-
-  // initialize the field map vectors to the correct sizes
-  BFieldR_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldPHI_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldZ_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
+  // initialize the field map to the correct size
+  BField_.assign(static_cast<std::size_t>(nz) * nr * nphi * NCOMPONENTS, 0);
 
   // all of this assumes that  z_prev < z , i.e. the table is ordered (as of right now)
   unsigned int ir = 0;
@@ -188,9 +183,10 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
       std::cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_map_[iz - 1] << std::endl;
     }
 
-    BFieldR_[iz][ir][iphi] = Br * magfield_rescale;
-    BFieldPHI_[iz][ir][iphi] = Bphi * magfield_rescale;
-    BFieldZ_[iz][ir][iphi] = Bz * magfield_rescale;
+    float *bfield = &BField_[index(iz, ir, iphi)];
+    bfield[0] = Bz * magfield_rescale;
+    bfield[1] = Br * magfield_rescale;
+    bfield[2] = Bphi * magfield_rescale;
 
     // you can change this to check table values for correctness
     // print_map prints the values in the root table, and the
@@ -203,9 +199,9 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
                 << r_map_[ir] << ", "
                 << phi_map_[iphi] << ", "
                 << z_map_[iz] << "):  ("
-                << BFieldR_[iz][ir][iphi] << ", "
-                << BFieldPHI_[iz][ir][iphi] << ", "
-                << BFieldZ_[iz][ir][iphi] << ")" << std::endl;
+                << bfield[1] << ", "
+                << bfield[2] << ", "
+                << bfield[0] << ")" << std::endl;
     }
 
   }  // end loop over root field map file
@@ -215,6 +211,10 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
   std::cout << "\n ---> ... read file successfully "
             << "\n ---> Z Boundaries ~ zlow, zhigh: "
             << minz_ / cm << "," << maxz_ / cm << " cm " << std::endl;
+  if (!(z_map_.is_uniform() && r_map_.is_uniform() && phi_map_.is_uniform()))
+  {
+    std::cout << " ---> grid is not uniform, using binary search for field lookup" << std::endl;
+  }
 
   std::cout << "\n================= End Construct Mag Field ======================\n"
             << std::endl;
@@ -325,28 +325,17 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
     return;
   }
 
-  std::vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
-  int z_index0 = distance(z_map_.begin(), ziter) - 1;
-  int z_index1 = z_index0 + 1;
+  const int z_index0 = z_map_.lower_index(z);
+  const int z_index1 = z_index0 + 1;
 
   assert(z_index0 >= 0);
   assert(z_index1 >= 0);
-  assert(z_index0 < (int) z_map_.size());
-  assert(z_index1 < (int) z_map_.size());
+  assert(z_index0 < z_map_.size());
+  assert(z_index1 < z_map_.size());
 
-  std::vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
-  int r_index0 = distance(r_map_.begin(), riter) - 1;
-  if (r_index0 >= (int) r_map_.size())
-  {
-    if (Verbosity() > 2)
-    {
-      std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
-    }
-    return;
-  }
-
-  int r_index1 = r_index0 + 1;
-  if (r_index1 >= (int) r_map_.size())
+  const int r_index0 = r_map_.lower_index(r);
+  const int r_index1 = r_index0 + 1;
+  if (r_index1 >= r_map_.size())
   {
     if (Verbosity() > 2)
     {
@@ -358,44 +347,26 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   assert(r_index0 >= 0);
   assert(r_index1 >= 0);
 
-  std::vector<float>::const_iterator phiiter = upper_bound(phi_map_.begin(), phi_map_.end(), phi);
-  int phi_index0 = distance(phi_map_.begin(), phiiter) - 1;
+  const int phi_index0 = phi_map_.lower_index(phi);
   int phi_index1 = phi_index0 + 1;
-  if (phi_index1 >= (int) phi_map_.size())
+  if (phi_index1 >= phi_map_.size())
   {
     phi_index1 = 0;
   }
 
   assert(phi_index0 >= 0);
-  assert(phi_index0 < (int) phi_map_.size());
+  assert(phi_index0 < phi_map_.size());
   assert(phi_index1 >= 0);
 
-  double Br000 = BFieldR_[z_index0][r_index0][phi_index0];
-  double Br001 = BFieldR_[z_index0][r_index0][phi_index1];
-  double Br010 = BFieldR_[z_index0][r_index1][phi_index0];
-  double Br011 = BFieldR_[z_index0][r_index1][phi_index1];
-  double Br100 = BFieldR_[z_index1][r_index0][phi_index0];
-  double Br101 = BFieldR_[z_index1][r_index0][phi_index1];
-  double Br110 = BFieldR_[z_index1][r_index1][phi_index0];
-  double Br111 = BFieldR_[z_index1][r_index1][phi_index1];
-
-  double Bphi000 = BFieldPHI_[z_index0][r_index0][phi_index0];
-  double Bphi001 = BFieldPHI_[z_index0][r_index0][phi_index1];
-  double Bphi010 = BFieldPHI_[z_index0][r_index1][phi_index0];
-  double Bphi011 = BFieldPHI_[z_index0][r_index1][phi_index1];
-  double Bphi100 = BFieldPHI_[z_index1][r_index0][phi_index0];
-  double Bphi101 = BFieldPHI_[z_index1][r_index0][phi_index1];
-  double Bphi110 = BFieldPHI_[z_index1][r_index1][phi_index0];
-  double Bphi111 = BFieldPHI_[z_index1][r_index1][phi_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0][phi_index0];
-  double Bz001 = BFieldZ_[z_index0][r_index0][phi_index1];
-  double Bz100 = BFieldZ_[z_index1][r_index0][phi_index0];
-  double Bz101 = BFieldZ_[z_index1][r_index0][phi_index1];
-  double Bz010 = BFieldZ_[z_index0][r_index1][phi_index0];
-  double Bz110 = BFieldZ_[z_index1][r_index1][phi_index0];
-  double Bz011 = BFieldZ_[z_index0][r_index1][phi_index1];
-  double Bz111 = BFieldZ_[z_index1][r_index1][phi_index1];
+  // each corner holds (Bz, Br, Bphi)
+  const float *B000 = &BField_[index(z_index0, r_index0, phi_index0)];
+  const float *B001 = &BField_[index(z_index0, r_index0, phi_index1)];
+  const float *B010 = &BField_[index(z_index0, r_index1, phi_index0)];
+  const float *B011 = &BField_[index(z_index0, r_index1, phi_index1)];
+  const float *B100 = &BField_[index(z_index1, r_index0, phi_index0)];
+  const float *B101 = &BField_[index(z_index1, r_index0, phi_index1)];
+  const float *B110 = &BField_[index(z_index1, r_index1, phi_index0)];
+  const float *B111 = &BField_[index(z_index1, r_index1, phi_index1)];
 
   double zweight = z - z_map_[z_index0];
   double zspacing = z_map_[z_index1] - z_map_[z_index0];
@@ -413,37 +384,15 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   }
   phiweight /= phispacing;
 
-  // Z direction of B-field
-  BfieldCyl[0] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Bz000 + phiweight * Bz001) +
-                       rweight * ((1 - phiweight) * Bz010 + phiweight * Bz011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Bz100 + phiweight * Bz101) +
-                 rweight * ((1 - phiweight) * Bz110 + phiweight * Bz111));
-
-  // R direction of B-field
-  BfieldCyl[1] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Br000 + phiweight * Br001) +
-                       rweight * ((1 - phiweight) * Br010 + phiweight * Br011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Br100 + phiweight * Br101) +
-                 rweight * ((1 - phiweight) * Br110 + phiweight * Br111));
-
-  // PHI Direction of B-field
-  BfieldCyl[2] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Bphi000 + phiweight * Bphi001) +
-                       rweight * ((1 - phiweight) * Bphi010 + phiweight * Bphi011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Bphi100 + phiweight * Bphi101) +
-                 rweight * ((1 - phiweight) * Bphi110 + phiweight * Bphi111));
-
-  //     std::cout << "wr: " << rweight << " wz: " << zweight << " wphi: " << phiweight << std::endl;
-  //     std::cout << "Bz000: " << Bz000 << std::endl
-  //          << "Bz001: " << Bz001 << std::endl
-  //          << "Bz010: " << Bz010 << std::endl
-  //          << "Bz011: " << Bz011 << std::endl
-  //          << "Bz100: " << Bz100 << std::endl
-  //          << "Bz101: " << Bz101 << std::endl
-  //          << "Bz110: " << Bz110 << std::endl
-  //          << "Bz111: " << Bz111 << std::endl
-  //          << "Bz:    " << BfieldCyl[0] << std::endl << std::endl;
+  // Z, R and PHI direction of B-field
+  for (int i = 0; i < NCOMPONENTS; ++i)
+  {
+    BfieldCyl[i] =
+        (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * B000[i] + phiweight * B001[i]) +
+                         rweight * ((1 - phiweight) * B010[i] + phiweight * B011[i])) +
+        zweight * ((1 - rweight) * ((1 - phiweight) * B100[i] + phiweight * B101[i]) +
+                   rweight * ((1 - phiweight) * B110[i] + phiweight * B111[i]));
+  }
 
   if (Verbosity() > 2)
   {
@@ -455,31 +404,150 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   return;
 }
 
-// a binary search algorithm that puts the location that "key" would be, into index...
-// it returns true if key was found, and false if not.
-bool PHField3DCylindrical::bin_search(const std::vector<float> &vec, unsigned start, unsigned end, const float &key, unsigned &index) const
+void PHField3DCylindrical::find_cell(const double point[4], cell &c) const
 {
-  // Termination condition: start index greater than end index
-  if (start > end)
+  c = cell();
+
+  const double x = point[0];
+  const double y = point[1];
+  const double r_point = std::sqrt(x * x + y * y);
+  if (r_point > 0)
+  {
+    c.cosphi = x / r_point;
+    c.sinphi = y / r_point;
+  }
+
+  // same selection and rounding as GetFieldValue and GetFieldCyl
+  if (!(point[2] >= minz_ && point[2] <= maxz_))
+  {
+    return;
+  }
+
+  double phi_point = std::atan2(y, x == 0 ? 0.00000000001 : x);
+  if (phi_point < 0)
+  {
+    phi_point += 2 * M_PI;
+  }
+
+  const float z = point[2];
+  float r = r_point;
+  const float phi = phi_point;
+
+  if (z <= z_map_[0] || z >= z_map_[z_map_.size() - 1])
+  {
+    return;
+  }
+  r = std::max(r, r_map_[0]);
+
+  const int z_index0 = z_map_.lower_index(z);
+  const int r_index0 = r_map_.lower_index(r);
+  if (r_index0 + 1 >= r_map_.size())
+  {
+    return;
+  }
+
+  // points below the first phi value interpolate between the last and first grid values
+  int phi_index0 = phi_map_.lower_index(phi);
+  if (phi_index0 < 0)
   {
-    index = start;
-    return false;
+    phi_index0 = phi_map_.size() - 1;
   }
+  const int phi_index1 = (phi_index0 + 1 < phi_map_.size()) ? phi_index0 + 1 : 0;
 
-  // Find the middle element of the vector and use that for splitting
-  // the array into two pieces.
-  unsigned middle = start + ((end - start) / 2);
+  c.offset = index(z_index0, r_index0, phi_index0);
+  c.phi_step = static_cast<std::ptrdiff_t>(phi_index1 - phi_index0) * NCOMPONENTS;
 
-  if (vec[middle] == key)
+  double zweight = z - z_map_[z_index0];
+  double zspacing = z_map_[z_index0 + 1] - z_map_[z_index0];
+  c.zweight = zweight / zspacing;
+
+  double rweight = r - r_map_[r_index0];
+  double rspacing = r_map_[r_index0 + 1] - r_map_[r_index0];
+  c.rweight = rweight / rspacing;
+
+  double phiweight = phi - phi_map_[phi_index0];
+  if (phiweight < 0)
+  {
+    phiweight += 2 * M_PI;
+  }
+  double phispacing = phi_map_[phi_index1] - phi_map_[phi_index0];
+  if (phi_index1 == 0)
+  {
+    phispacing += 2 * M_PI;
+  }
+  c.phiweight = phiweight / phispacing;
+
+  c.inside = true;
+}
+
+void PHField3DCylindrical::GetFieldValues(const double *points, double *Bfields, std::size_t n) const
+{
+  // diagnostic printouts are only available in the single point accessor
+  if (Verbosity() > 2)
   {
-    index = middle;
-    return true;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      PHField3DCylindrical::GetFieldValue(points + 4 * i, Bfields + 3 * i);
+    }
+    return;
   }
-  if (vec[middle] > key)
+
+  // points are processed by blocks: the grid cells of all points in the block are found first,
+  // then all points are interpolated in a single loop over the flat grid.
+  // The rotation to cartesian coordinates uses x/r and y/r rather than cos(phi) and sin(phi),
+  // so that results agree with GetFieldValue up to rounding
+  constexpr std::size_t block_size = 64;
+  std::array<cell, block_size> cells;
+
+  const std::ptrdiff_t r_step = static_cast<std::ptrdiff_t>(phi_map_.size()) * NCOMPONENTS;
+  const std::ptrdiff_t z_step = r_step * r_map_.size();
+  const float *field = BField_.data();
+
+  for (std::size_t first = 0; first < n; first += block_size)
   {
-    return bin_search(vec, start, middle - 1, key, index);
+    const std::size_t count = std::min(block_size, n - first);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      find_cell(points + 4 * (first + i), cells[i]);
+    }
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const cell &c = cells[i];
+      double *Bfield = Bfields + 3 * (first + i);
+      if (!c.inside)
+      {
+        Bfield[0] = 0.0;
+        Bfield[1] = 0.0;
+        Bfield[2] = 0.0;
+        continue;
+      }
+
+      const float *B000 = field + c.offset;
+      const float *B001 = B000 + c.phi_step;
+      const float *B010 = B000 + r_step;
+      const float *B011 = B010 + c.phi_step;
+      const float *B100 = B000 + z_step;
+      const float *B101 = B100 + c.phi_step;
+      const float *B110 = B100 + r_step;
+      const float *B111 = B110 + c.phi_step;
+
+      double BfieldCyl[NCOMPONENTS];
+      for (int j = 0; j < NCOMPONENTS; ++j)
+      {
+        BfieldCyl[j] =
+            (1 - c.zweight) * ((1 - c.rweight) * ((1 - c.phiweight) * B000[j] + c.phiweight * B001[j]) +
+                               c.rweight * ((1 - c.phiweight) * B010[j] + c.phiweight * B011[j])) +
+            c.zweight * ((1 - c.rweight) * ((1 - c.phiweight) * B100[j] + c.phiweight * B101[j]) +
+                         c.rweight * ((1 - c.phiweight) * B110[j] + c.phiweight * B111[j]));
+      }
+
+      // (Bz, Br, Bphi) to (Bx, By, Bz)
+      Bfield[0] = c.cosphi * BfieldCyl[1] - c.sinphi * BfieldCyl[2];
+      Bfield[1] = c.sinphi * BfieldCyl[1] + c.cosphi * BfieldCyl[2];
+      Bfield[2] = BfieldCyl[0];
+    }
   }
-  return bin_search(vec, middle + 1, end, key, index);
 }
 
 // debug function to print key/value pairs in map
@@ -21,7 +21,9 @@
 #define PHFIELD_PHFIELD3DCYLINDRICAL_H
 
 #include "PHField.h"
+#include "PHFieldGridAxis.h"
 
+#include <cstddef>
 #include <map>
 #include <string>
 #include <tuple>
@@ -35,23 +37,55 @@ class PHField3DCylindrical : public PHField
   PHField3DCylindrical(const std::string& filename, int verb = 0, const float magfield_rescale = 1.0);
   ~PHField3DCylindrical() override {}
   void GetFieldValue(const double Point[4], double* Bfield) const override;
+  void GetFieldValues(const double* Points, double* Bfields, std::size_t n) const override;
   void GetFieldCyl(const double CylPoint[4], double* Bfield) const;
 
  protected:
-  // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector<std::vector<std::vector<float> > > BFieldZ_;
-  std::vector<std::vector<std::vector<float> > > BFieldR_;
-  std::vector<std::vector<std::vector<float> > > BFieldPHI_;
+  //! number of field components stored per grid point
+  static constexpr int NCOMPONENTS = 3;
+
+  //! index of the first field component (Bz) of a grid point in BField_
+  std::size_t index(int iz, int ir, int iphi) const
+  {
+    return ((static_cast<std::size_t>(iz) * r_map_.size() + ir) * phi_map_.size() + iphi) * NCOMPONENTS;
+  }
+
+  // field values on the <z,r,phi> grid, phi running fastest
+  // components are interleaved as (Bz, Br, Bphi) so that one grid point is a single cache access
+  std::vector<float> BField_;
 
   // maps indices to values z_map[i] = z_value that corresponds to ith index
-  std::vector<float> z_map_;    // < i >
-  std::vector<float> r_map_;    // < j >
-  std::vector<float> phi_map_;  // < k >
+  PHFieldGridAxis z_map_;    // < i >
+  PHFieldGridAxis r_map_;    // < j >
+  PHFieldGridAxis phi_map_;  // < k >
 
   float maxz_, minz_;  // boundaries of magnetic field map cyl
 
  private:
-  bool bin_search(const std::vector<float>& vec, unsigned start, unsigned end, const float& key, unsigned& index) const;
+  //! grid cell and interpolation weights of a point, used by GetFieldValues
+  struct cell
+  {
+    //! first component of the lower corner in BField_
+    std::size_t offset = 0;
+
+    //! offset from lower to upper corner along phi, negative when wrapping around 2pi
+    std::ptrdiff_t phi_step = 0;
+
+    double zweight = 0;
+    double rweight = 0;
+    double phiweight = 0;
+
+    //! cos and sin of the point azimuth, to rotate the field to cartesian coordinates
+    double cosphi = 1;
+    double sinphi = 0;
+
+    //! false if the point is outside of the map, in which case the field is zero
+    bool inside = false;
+  };
+
+  //! find grid cell and interpolation weights of a point, same selection as GetFieldValue
+  void find_cell(const double point[4], cell&) const;
+
   void print_map(std::map<trio, trio>::iterator& it) const;
 };
 
@@ -0,0 +1,101 @@
+#ifndef PHFIELD_PHFIELDGRIDAXIS_H
+#define PHFIELD_PHFIELDGRIDAXIS_H
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <vector>
+
+//! one axis of a field map grid
+/*!
+  stores the sorted grid point coordinates along the axis.
+  When the points are equally spaced, which is the case for all sPHENIX maps,
+  the cell containing a given coordinate is obtained by direct index calculation
+  rather than a binary search
+*/
+class PHFieldGridAxis
+{
+ public:
+  PHFieldGridAxis() = default;
+
+  //! construct from sorted, unique values
+  explicit PHFieldGridAxis(const std::vector<float>& values)
+    : m_values(values)
+  {
+    const int n = m_values.size();
+    if (n < 2)
+    {
+      return;
+    }
+
+    m_min = m_values.front();
+    const double step = (m_values.back() - m_values.front()) / (n - 1);
+    if (!(step > 0))
+    {
+      return;
+    }
+
+    m_uniform = true;
+    for (int i = 0; i < n; ++i)
+    {
+      if (std::abs(m_values[i] - (m_min + i * step)) > 1e-3 * step)
+      {
+        m_uniform = false;
+        break;
+      }
+    }
+    m_inv_step = 1. / step;
+  }
+
+  //! grid point coordinates
+  const std::vector<float>& values() const { return m_values; }
+
+  //! number of grid points
+  int size() const { return m_values.size(); }
+
+  //! coordinate of a given grid point
+  float operator[](int i) const { return m_values[i]; }
+
+  //! true if grid points are equally spaced
+  bool is_uniform() const { return m_uniform; }
+
+  //! index of the last grid point at or below x
+  /*! same as std::upper_bound(...) - 1: returns -1 if x is below the first point, size()-1 if x is above the last */
+  int lower_index(double x) const
+  {
+    const int n = m_values.size();
+    if (!m_uniform)
+    {
+      return std::distance(m_values.begin(), std::upper_bound(m_values.begin(), m_values.end(), x)) - 1;
+    }
+
+    if (!(x >= m_values.front()))
+    {
+      return -1;
+    }
+    if (x >= m_values.back())
+    {
+      return n - 1;
+    }
+
+    // direct calculation, corrected for rounding
+    int i = std::min(static_cast<int>((x - m_min) * m_inv_step), n - 2);
+    while (i > 0 && m_values[i] > x)
+    {
+      --i;
+    }
+    while (i < n - 2 && m_values[i + 1] <= x)
+    {
+      ++i;
+    }
+    return i;
+  }
+
+ private:
+  std::vector<float> m_values;
+  double m_min = 0;
+  double m_inv_step = 0;
+  bool m_uniform = false;
+};
+
+#endif
@@ -0,0 +1,173 @@
+#include "PHFieldMapFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+  constexpr std::array<char, 8> MAGIC = {'P', 'H', 'F', 'M', 'A', 'P', '\0', '\0'};
+
+  struct Header
+  {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t layout;
+    uint32_t nx;
+    uint32_t ny;
+    uint32_t nz;
+    uint32_t reserved;
+  };
+
+  static_assert(sizeof(Header) == 32, "unexpected binary field map header size");
+}  // namespace
+
+//_____________________________________________________________________________
+PHFieldMapFile::PHFieldMapFile(const std::string& filename)
+{
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    throw std::runtime_error("PHFieldMapFile - cannot open " + filename);
+  }
+
+  struct stat status
+  {
+  };
+  if (fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(Header)))
+  {
+    close(fd);
+    throw std::runtime_error("PHFieldMapFile - invalid file " + filename);
+  }
+  m_size = status.st_size;
+
+  // read-only shared mapping: pages are shared between all processes using the same file
+  m_data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (m_data == MAP_FAILED)
+  {
+    m_data = nullptr;
+    throw std::runtime_error("PHFieldMapFile - cannot map " + filename);
+  }
+
+  Header header{};
+  std::memcpy(&header, m_data, sizeof(Header));
+  if (header.magic != MAGIC)
+  {
+    munmap(m_data, m_size);
+    throw std::runtime_error("PHFieldMapFile - not a binary field map: " + filename);
+  }
+  if (header.version != VERSION)
+  {
+    munmap(m_data, m_size);
+    throw std::runtime_error("PHFieldMapFile - unsupported version " + std::to_string(header.version) + " in " + filename);
+  }
+  if (header.layout != kCartesian)
+  {
+    munmap(m_data, m_size);
+    throw std::runtime_error("PHFieldMapFile - unsupported layout " + std::to_string(header.layout) + " in " + filename);
+  }
+
+  m_layout = header.layout;
+  m_nx = header.nx;
+  m_ny = header.ny;
+  m_nz = header.nz;
+
+  // check the grid dimensions against the file length before computing any offset.
+  // The dimensions come from the file and their product may overflow, so it is compared
+  // to the number of values actually present in the file rather than the other way around
+  const std::size_t payload = m_size - sizeof(Header);
+  const std::size_t nvalues = payload / sizeof(float);
+  const std::size_t naxis = m_nx + m_ny + m_nz;
+  if (payload % sizeof(float) != 0 ||
+      m_nx == 0 || m_ny == 0 || m_nz == 0 ||
+      naxis > nvalues || (nvalues - naxis) % 3 != 0)
+  {
+    munmap(m_data, m_size);
+    throw std::runtime_error("PHFieldMapFile - inconsistent size in " + filename);
+  }
+
+  const std::size_t npoints = (nvalues - naxis) / 3;
+  if (npoints / m_nx / m_ny != m_nz || npoints % m_nx != 0 || (npoints / m_nx) % m_ny != 0)
+  {
+    munmap(m_data, m_size);
+    throw std::runtime_error("PHFieldMapFile - inconsistent size in " + filename);
+  }
+
+  const auto* values = reinterpret_cast<const float*>(static_cast<const char*>(m_data) + sizeof(Header));
+  m_x = values;
+  m_y = m_x + m_nx;
+  m_z = m_y + m_ny;
+  m_bx = m_z + m_nz;
+  m_by = m_bx + npoints;
+  m_bz = m_by + npoints;
+}
+
+//_____________________________________________________________________________
+PHFieldMapFile::~PHFieldMapFile()
+{
+  if (m_data)
+  {
+    munmap(m_data, m_size);
+  }
+}
+
+//_____________________________________________________________________________
+bool PHFieldMapFile::is_binary_map(const std::string& filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  std::array<char, 8> magic{};
+  return in.read(magic.data(), magic.size()) && magic == MAGIC;
+}
+
+//_____________________________________________________________________________
+bool PHFieldMapFile::write_cartesian(
+    const std::string& filename,
+    const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z,
+    const float* bx, const float* by, const float* bz)
+{
+  Header header{};
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.layout = kCartesian;
+  header.nx = x.size();
+  header.ny = y.size();
+  header.nz = z.size();
+
+  const std::size_t npoints = x.size() * y.size() * z.size();
+
+  // write to a temporary file first, so that readers never see a partial map
+  const std::string tmpname = filename + ".tmp";
+  {
+    std::ofstream out(tmpname, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    out.write(reinterpret_cast<const char*>(x.data()), sizeof(float) * x.size());
+    out.write(reinterpret_cast<const char*>(y.data()), sizeof(float) * y.size());
+    out.write(reinterpret_cast<const char*>(z.data()), sizeof(float) * z.size());
+    out.write(reinterpret_cast<const char*>(bx), sizeof(float) * npoints);
+    out.write(reinterpret_cast<const char*>(by), sizeof(float) * npoints);
+    out.write(reinterpret_cast<const char*>(bz), sizeof(float) * npoints);
+    out.close();
+    if (!out)
+    {
+      // do not leave a partial file behind
+      std::remove(tmpname.c_str());
+      return false;
+    }
+  }
+
+  if (std::rename(tmpname.c_str(), filename.c_str()) != 0)
+  {
+    std::remove(tmpname.c_str());
+    return false;
+  }
+
+  return true;
+}
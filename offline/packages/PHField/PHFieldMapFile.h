@@ -0,0 +1,87 @@
+#ifndef PHFIELD_PHFIELDMAPFILE_H
+#define PHFIELD_PHFIELDMAPFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//! read-only, memory mapped binary field map
+/*!
+  The binary format is a precomputed, flat copy of the in-memory grid,
+  so that a map can be used directly from the page cache without parsing:
+  all processes on a node reading the same file share the same physical pages.
+
+  Layout (native endianness, all fields 4 bytes):
+  - header: magic "PHFMAP\0\0" (8 bytes), version, layout, nx, ny, nz, reserved (32 bytes total)
+  - grid point coordinates along each axis: float x[nx], y[ny], z[nz]
+  - field components, z running fastest: float bx[nx*ny*nz], by[...], bz[...]
+
+  Coordinates and field values are stored in Geant4/CLHEP units, before rescaling.
+  Grid points without field value are stored as NaN.
+  Only the cartesian layout (the one used by PHField3DCartesian) is defined so far.
+*/
+class PHFieldMapFile
+{
+ public:
+  //! supported grid layouts
+  enum Layout : uint32_t
+  {
+    kCartesian = 1
+  };
+
+  //! current format version
+  static constexpr uint32_t VERSION = 1;
+
+  //! open and map file. Throws std::runtime_error if the file cannot be mapped or is not a valid map
+  explicit PHFieldMapFile(const std::string& filename);
+
+  //! unmap file
+  ~PHFieldMapFile();
+
+  PHFieldMapFile(const PHFieldMapFile&) = delete;
+  PHFieldMapFile& operator=(const PHFieldMapFile&) = delete;
+
+  //! true if the file starts with the binary field map signature
+  static bool is_binary_map(const std::string& filename);
+
+  //! write a cartesian map. Returns false on failure
+  static bool write_cartesian(
+      const std::string& filename,
+      const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z,
+      const float* bx, const float* by, const float* bz);
+
+  //!@name accessors
+  //@{
+  uint32_t layout() const { return m_layout; }
+  std::size_t nx() const { return m_nx; }
+  std::size_t ny() const { return m_ny; }
+  std::size_t nz() const { return m_nz; }
+  const float* x() const { return m_x; }
+  const float* y() const { return m_y; }
+  const float* z() const { return m_z; }
+  const float* bx() const { return m_bx; }
+  const float* by() const { return m_by; }
+  const float* bz() const { return m_bz; }
+  //@}
+
+ private:
+  //! mapped region
+  void* m_data = nullptr;
+  std::size_t m_size = 0;
+
+  uint32_t m_layout = 0;
+  std::size_t m_nx = 0;
+  std::size_t m_ny = 0;
+  std::size_t m_nz = 0;
+
+  //! pointers into the mapped region
+  const float* m_x = nullptr;
+  const float* m_y = nullptr;
+  const float* m_z = nullptr;
+  const float* m_bx = nullptr;
+  const float* m_by = nullptr;
+  const float* m_bz = nullptr;
+};
+
+#endif
@@ -204,3 +204,17 @@ PHFieldUtility::GetFieldConfigNode(const PHFieldConfig *default_config, PHCompos
 
   return field;
 }
+
+//_____________________________________________________________________________
+bool PHFieldUtility::ConvertFieldMap(const std::string &root_filename, const std::string &binary_filename)
+{
+  // no cuts and no rescaling, these are applied when the binary map is loaded
+  const PHField3DCartesian field(root_filename);
+  if (!field.write_binary(binary_filename))
+  {
+    std::cout << PHWHERE << " could not write " << binary_filename << std::endl;
+    return false;
+  }
+  std::cout << "PHFieldUtility::ConvertFieldMap - converted " << root_filename << " to " << binary_filename << std::endl;
+  return true;
+}
@@ -33,6 +33,12 @@ class PHFieldUtility
   static PHField *
   BuildFieldMap(const PHFieldConfig *field_config, float inner_radius = 0., float outer_radius = 1.e10, float size_z = 1.e10, const int verbosity = 0);
 
+  //! Convert a 3D cartesian ROOT field map to the memory mapped binary format (see PHFieldMapFile)
+  //! the binary map can then be used in place of the ROOT file in any PHFieldConfig
+  //! \return true on success
+  static bool
+  ConvertFieldMap(const std::string &root_filename, const std::string &binary_filename);
+
   //! DST node name for RunTime field map object
   static std::string
   GetDSTFieldMapNodeName()
@@ -158,11 +158,19 @@ float FastJetAlgo::calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents
   return bge.rho();
 }
 
-std::vector<fastjet::PseudoJet>
-FastJetAlgo::jets_to_pseudojets(std::vector<Jet*>& particles) const
+void FastJetAlgo::jets_to_particles(std::vector<Jet*>& jets)
 {
-  std::vector<fastjet::PseudoJet> pseudojets;
-  for (unsigned int ipart = 0; ipart < particles.size(); ++ipart)
+  m_particles.clear();
+  for (auto* jet : jets)
+  {
+    m_particles.add(jet);
+  }
+}
+
+void FastJetAlgo::select_pseudojets(const JetParticles& particles)
+{
+  m_pseudojets.clear();
+  for (const auto& particle : particles.pseudojets())
   {
     // fastjet performs strangely with exactly (px,py,pz,E) =
     // (0,0,0,0) inputs, such as placeholder towers or those with
@@ -170,34 +178,29 @@ FastJetAlgo::jets_to_pseudojets(std::vector<Jet*>& particles) const
 
     // Ignore particles with negative/small energies
 
-    if (particles[ipart]->get_e() < m_opt.constituent_min_E)
+    if (particle.e() < m_opt.constituent_min_E)
     {
       continue;
     }
-    if (!std::isfinite(particles[ipart]->get_px()) ||
-        !std::isfinite(particles[ipart]->get_py()) ||
-        !std::isfinite(particles[ipart]->get_pz()) ||
-        !std::isfinite(particles[ipart]->get_e()))
+    if (!std::isfinite(particle.px()) ||
+        !std::isfinite(particle.py()) ||
+        !std::isfinite(particle.pz()) ||
+        !std::isfinite(particle.e()))
     {
       std::cout << PHWHERE << " invalid particle kinematics:"
-                << " px: " << particles[ipart]->get_px()
-                << " py: " << particles[ipart]->get_py()
-                << " pz: " << particles[ipart]->get_pz()
-                << " e: " << particles[ipart]->get_e() << std::endl;
+                << " px: " << particle.px()
+                << " py: " << particle.py()
+                << " pz: " << particle.pz()
+                << " e: " << particle.e() << std::endl;
       gSystem->Exit(1);
     }
-    fastjet::PseudoJet pseudojet(particles[ipart]->get_px(),
-                                 particles[ipart]->get_py(),
-                                 particles[ipart]->get_pz(),
-                                 particles[ipart]->get_e());
-    if (m_opt.use_constituent_min_pt && pseudojet.perp() < m_opt.constituent_min_pt)
+    if (m_opt.use_constituent_min_pt && particle.perp() < m_opt.constituent_min_pt)
     {
       continue;
     }
-    pseudojet.set_user_index(ipart);
-    pseudojets.push_back(pseudojet);
+    // the user index is the particle index
+    m_pseudojets.push_back(particle);
   }
-  return pseudojets;
 }
 
 void FastJetAlgo::first_call_init(JetContainer* jetcont)
@@ -251,6 +254,13 @@ void FastJetAlgo::first_call_init(JetContainer* jetcont)
 }
 
 void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont)
+{
+  // translate input jets to the particle buffer
+  jets_to_particles(particles);
+  cluster_and_fill_particles(m_particles, jetcont);
+}
+
+void FastJetAlgo::cluster_and_fill_particles(const JetParticles& particles, JetContainer* jetcont)
 {
   if (m_first_cluster_call)
   {
@@ -267,8 +277,9 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
     std::cout << "   Verbosity>8 #input particles: " << particles.size() << std::endl;
   }
 
-  // translate input jets to input fastjets
-  auto pseudojets = jets_to_pseudojets(particles);
+  // select the input fastjets
+  select_pseudojets(particles);
+  std::vector<fastjet::PseudoJet>& pseudojets = m_pseudojets;
 
   // if using constituent subtraction, oberve maximum eta and subtract the constituents
   if (m_opt.cs_calc_constsub)
@@ -389,7 +400,10 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
         //        ++n_clustered;
         if (m_opt.save_jet_components)
         {
-          jet->insert_comp(particles[comp.user_index()]->get_comp_vec(), true);
+          for (const auto* c = particles.begin_comp(comp.user_index()); c != particles.end_comp(comp.user_index()); ++c)
+          {
+            jet->insert_comp(c->first, c->second, true);
+          }
         }
       }  // end loop over all constituents
     }
@@ -400,7 +414,10 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
       {
         for (auto& comp : constituents)
         {
-          jet->insert_comp(particles[comp.user_index()]->get_comp_vec(), true);
+          for (const auto* c = particles.begin_comp(comp.user_index()); c != particles.end_comp(comp.user_index()); ++c)
+          {
+            jet->insert_comp(c->first, c->second, true);
+          }
         }
       }
     }
@@ -413,11 +430,12 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
   delete (m_opt.calc_area ? m_cluseqarea : m_cluseq);  // if (m_cluseq) delete m_cluseq;
 }
 
-std::vector<Jet*> FastJetAlgo::get_jets(std::vector<Jet*> particles)
+std::vector<Jet*> FastJetAlgo::get_jets(std::vector<Jet*>& particles)
 {
   // translate to fastjet
-  auto pseudojets = jets_to_pseudojets(particles);
-  auto fastjets = cluster_jets(pseudojets);
+  jets_to_particles(particles);
+  select_pseudojets(m_particles);
+  auto fastjets = cluster_jets(m_pseudojets);
 
   fastjet::contrib::SoftDrop sd(m_opt.SD_beta, m_opt.SD_zcut);
   if (m_opt.verbosity > 5)
@@ -4,6 +4,7 @@
 #include "FastJetOptions.h"
 #include "Jet.h"
 #include "JetAlgo.h"
+#include "JetParticles.h"
 
 #include <fastjet/JetDefinition.hh>
 #include <fastjet/PseudoJet.hh>
@@ -46,9 +47,12 @@ class FastJetAlgo : public JetAlgo
   void set_SoftDrop_zcut(float zcut) { m_opt.SD_zcut = zcut; }
   //--end-legacy-code-interface-------------------------------------------
 
-  std::vector<Jet*> get_jets(std::vector<Jet*> particles) override;
+  std::vector<Jet*> get_jets(std::vector<Jet*>& particles) override;
   void cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont) override;
 
+  bool use_particles() const override { return true; }
+  void cluster_and_fill_particles(const JetParticles& particles, JetContainer* jetcont) override;
+
  private:
   FastJetOptions m_opt{};
   bool m_first_cluster_call{true};
@@ -60,7 +64,8 @@ class FastJetAlgo : public JetAlgo
   Jet::PROPERTY m_area_index{Jet::PROPERTY::no_property};
 
   // Internal processes
-  std::vector<fastjet::PseudoJet> jets_to_pseudojets(std::vector<Jet*>& particles) const;
+  void jets_to_particles(std::vector<Jet*>& jets);
+  void select_pseudojets(const JetParticles& particles);
   std::vector<fastjet::PseudoJet> cluster_jets(std::vector<fastjet::PseudoJet>& pseudojets);
   std::vector<fastjet::PseudoJet> cluster_area_jets(std::vector<fastjet::PseudoJet>& pseudojets);
   float calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents) const;
@@ -75,6 +80,10 @@ class FastJetAlgo : public JetAlgo
 
   fastjet::ClusterSequence* m_cluseq{nullptr};
   fastjet::ClusterSequence* m_cluseqarea{nullptr};
+
+  // buffers reused from event to event
+  JetParticles m_particles;
+  std::vector<fastjet::PseudoJet> m_pseudojets;
 };
 
 #endif
@@ -6,6 +6,7 @@
 #include <limits>
 
 class JetContainer;
+class JetParticles;
 class JetAlgo
 {
  public:
@@ -20,7 +21,7 @@ class JetAlgo
   virtual float get_par() { return std::numeric_limits<float>::quiet_NaN(); }
 
   // old version -- get jets to fill into JetMap
-  virtual std::vector<Jet*> get_jets(std::vector<Jet*> /* particles*/)  // ? Why isn't this passed as a reference?
+  virtual std::vector<Jet*> get_jets(std::vector<Jet*>& /* particles*/)
   {
     return std::vector<Jet*>();
   }
@@ -30,6 +31,15 @@ class JetAlgo
   {
   }
 
+  // true if the algorithm clusters the flat particle buffer, which
+  // does not carry the Jet properties of the inputs
+  virtual bool use_particles() const { return false; }
+
+  // same as cluster_and_fill, from the particles shared by all algorithms of the event
+  virtual void cluster_and_fill_particles(const JetParticles& /* particles*/, JetContainer* /*clones*/)
+  {
+  }
+
   virtual std::map<Jet::PROPERTY, unsigned int>& property_indices();
 
  protected:
@@ -2,6 +2,7 @@
 #define JETBASE_JETINPUT_H
 
 #include "Jet.h"
+#include "JetParticles.h"
 
 #include <iostream>
 #include <vector>
@@ -24,6 +25,21 @@ class JetInput
   {
     return std::vector<Jet*>();
   }
+
+  //! append the input particles to a buffer owned by the caller
+  /*!
+    The default converts the Jets of get_input. Inputs with many particles
+    fill the buffer directly, without a Jet per particle.
+  */
+  virtual void fill_input(PHCompositeNode* topNode, JetParticles& particles)
+  {
+    for (auto* jet : get_input(topNode))
+    {
+      particles.add(jet);
+      delete jet;
+    }
+  }
+
   virtual int Verbosity() const { return m_Verbosity; }
   virtual void Verbosity(int i) { m_Verbosity = i; }
 
@@ -0,0 +1,69 @@
+#ifndef JETBASE_JETPARTICLES_H
+#define JETBASE_JETPARTICLES_H
+
+#include "Jet.h"
+
+#include <fastjet/PseudoJet.hh>
+
+#include <vector>
+
+//! input particles of one event for the jet algorithms
+/*!
+  The particles are kept as pseudojets next to a flat list of their
+  components, the user index of each pseudojet is its position in the list.
+  The buffers are cleared but not released from one event to the next, so
+  filling the input does not allocate a Jet per tower or track, and the same
+  pseudojets are handed to all jet algorithms of the event.
+*/
+class JetParticles
+{
+ public:
+  JetParticles() = default;
+
+  //! remove all particles, keeping the memory
+  void clear()
+  {
+    m_pseudojets.clear();
+    m_comps.clear();
+    m_comp_offsets.assign(1, 0);
+  }
+
+  //! add a particle made of a single component
+  void add(const double px, const double py, const double pz, const double e, const Jet::SRC src, const unsigned int id)
+  {
+    m_pseudojets.emplace_back(px, py, pz, e);
+    m_pseudojets.back().set_user_index(m_pseudojets.size() - 1);
+    m_comps.emplace_back(src, id);
+    m_comp_offsets.push_back(m_comps.size());
+  }
+
+  //! add a particle from a Jet, with all its components
+  void add(Jet *jet)
+  {
+    m_pseudojets.emplace_back(jet->get_px(), jet->get_py(), jet->get_pz(), jet->get_e());
+    m_pseudojets.back().set_user_index(m_pseudojets.size() - 1);
+    for (const auto &comp : jet->get_comp_vec())
+    {
+      m_comps.push_back(comp);
+    }
+    m_comp_offsets.push_back(m_comps.size());
+  }
+
+  unsigned int size() const { return m_pseudojets.size(); }
+  bool empty() const { return m_pseudojets.empty(); }
+
+  //! pseudojets of all particles, user index is the particle index
+  const std::vector<fastjet::PseudoJet> &pseudojets() const { return m_pseudojets; }
+
+  //! components of a particle
+  const Jet::TYPE_comp *begin_comp(const unsigned int particle) const { return m_comps.data() + m_comp_offsets[particle]; }
+  const Jet::TYPE_comp *end_comp(const unsigned int particle) const { return m_comps.data() + m_comp_offsets[particle + 1]; }
+
+ private:
+  std::vector<fastjet::PseudoJet> m_pseudojets;
+  std::vector<Jet::TYPE_comp> m_comps;
+  //! components of particle i are m_comps[m_comp_offsets[i]] to m_comps[m_comp_offsets[i+1]]
+  std::vector<unsigned int> m_comp_offsets{0};
+};
+
+#endif
@@ -79,6 +79,24 @@ int JetReco::InitRun(PHCompositeNode *topNode)
     std::cout << "===========================================================================" << std::endl;
   }
 
+  // the input is only converted to Jets if they are used
+  use_particles = false;
+  use_inputjets = use_jetmap;
+  if (use_jetcon)
+  {
+    for (auto &_algo : _algos)
+    {
+      if (_algo->use_particles())
+      {
+        use_particles = true;
+      }
+      else
+      {
+        use_inputjets = true;
+      }
+    }
+  }
+
   return CreateNodes(topNode);
 }
 
@@ -95,13 +113,24 @@ int JetReco::process_event(PHCompositeNode *topNode)
   //------------------------------------------------------------------
 
   std::vector<Jet *> inputs;  // owns memory
-  for (auto &_input : _inputs)
+  if (use_inputjets)
   {
-    std::vector<Jet *> parts = _input->get_input(topNode);
-    for (auto &part : parts)
+    for (auto &_input : _inputs)
     {
-      inputs.push_back(part);
-      inputs.back()->set_id(inputs.size() - 1);  // unique ids ensured
+      std::vector<Jet *> parts = _input->get_input(topNode);
+      for (auto &part : parts)
+      {
+        inputs.push_back(part);
+        inputs.back()->set_id(inputs.size() - 1);  // unique ids ensured
+      }
+    }
+  }
+  _particles.clear();
+  if (use_particles)
+  {
+    for (auto &_input : _inputs)
+    {
+      _input->fill_input(topNode, _particles);
     }
   }
 
@@ -292,7 +321,15 @@ void JetReco::FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<J
     exit(-1);
   }
   jetconn->Reset();
-  _algos[ipos]->cluster_and_fill(inputs, jetconn);  // fills the jet container with clustered jets
+  // fills the jet container with clustered jets
+  if (use_particles && _algos[ipos]->use_particles())
+  {
+    _algos[ipos]->cluster_and_fill_particles(_particles, jetconn);
+  }
+  else
+  {
+    _algos[ipos]->cluster_and_fill(inputs, jetconn);
+  }
   for (auto &_input : _inputs)
   {
     jetconn->insert_src(_input->get_src());
@@ -7,6 +7,8 @@
 /// \author Mike McCumber
 //===========================================================
 
+#include "JetParticles.h"
+
 // PHENIX includes
 #include <fun4all/SubsysReco.h>
 
@@ -69,6 +71,10 @@ class JetReco : public SubsysReco
   std::string _inputnode;
   std::vector<std::string> _outputs;
 
+  // input particles shared by the algorithms clustering them directly,
+  // reused from event to event
+  JetParticles _particles;
+
   // transition functions, while moving from JetMap to JetContainer.
   // May be removed after transition is made, depending on state of
   // functions
@@ -82,6 +88,8 @@ class JetReco : public SubsysReco
   TRANSITION which_fill;  // fill both container and map
   bool use_jetcon;
   bool use_jetmap;
+  bool use_particles{false};  // some algorithm clusters the particles
+  bool use_inputjets{true};   // some algorithm or the JetMap needs the input Jets
 };
 
 #endif  // JETBASE_JETRECO_H
@@ -65,13 +65,151 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     std::cout << "TowerJetInput::process_event -- entered" << std::endl;
   }
   float vtxz = 0;  // default to 0
+  RawTowerContainer *towers = nullptr;
+  TowerInfoContainer *towerinfos = nullptr;
+  RawTowerGeomContainer *geom = nullptr;
+  RawTowerGeomContainer *EMCal_geom = nullptr;
+  if (!get_vertex_z(topNode, vtxz) || !get_nodes(topNode, towers, towerinfos, geom, EMCal_geom))
+  {
+    return std::vector<Jet *>();
+  }
+
+  std::vector<Jet *> pseudojets;
+  if (m_use_towerinfo)
+  {
+    if (!towerinfos)
+    {
+      return std::vector<Jet *>();
+    }
+    update_tower_geometry(towerinfos, geom, EMCal_geom);
+
+    unsigned int nchannels = towerinfos->size();
+    for (unsigned int channel = 0; channel < nchannels; channel++)
+    {
+      TowerInfo *tower = towerinfos->get_tower_at_channel(channel);
+      assert(tower);
+
+      double px;
+      double py;
+      double pz;
+      if (!get_tower_momentum(tower, channel, vtxz, px, py, pz))
+      {
+        continue;
+      }
+      double e = tower->get_energy();
+
+      Jet *jet = new Jetv2();
+      jet->set_px(px);
+      jet->set_py(py);
+      jet->set_pz(pz);
+      jet->set_e(e);
+      jet->insert_comp(m_input, channel);
+      float tower_t = 17.6*tower->get_time(); // 17.6 ns/sample and get_time() returns t in samples
+      if(jet->size_properties() < Jet::PROPERTY::prop_t+1)
+	{
+	  jet->resize_properties(Jet::PROPERTY::prop_t + 1);
+	}
+      if(e > m_timing_e_threshold)
+	{
+	  jet->set_property(Jet::PROPERTY::prop_t, tower_t);
+	}
+      else
+	{
+	  jet->set_property(Jet::PROPERTY::prop_t, std::numeric_limits<float>::quiet_NaN());
+	}
+      pseudojets.push_back(jet);
+    }
+  }
+  else
+  {
+    RawTowerContainer::ConstRange begin_end = towers->getTowers();
+    RawTowerContainer::ConstIterator rtiter;
+    for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
+    {
+      RawTower *tower = rtiter->second;
+
+      RawTowerGeom *tower_geom = geom->get_tower_geometry(tower->get_key());
+      assert(tower_geom);
+
+      double r = tower_geom->get_center_radius();
+      if (m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input == Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS)
+      {
+        const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
+        RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
+        assert(EMCal_tower_geom);
+        r = EMCal_tower_geom->get_center_radius();
+      }
+      double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
+      double towereta = tower_geom->get_eta();
+      double z0 = sinh(towereta) * r;
+      double z = z0 - vtxz;
+      double eta = asinh(z / r);  // eta after shift from vertex
+      double pt = tower->get_energy() / cosh(eta);
+      double px = pt * cos(phi);
+      double py = pt * sin(phi);
+      double pz = pt * sinh(eta);
+
+      Jet *jet = new Jetv2();
+      jet->set_px(px);
+      jet->set_py(py);
+      jet->set_pz(pz);
+      jet->set_e(tower->get_energy());
+      jet->insert_comp(m_input, tower->get_id());
+      pseudojets.push_back(jet);
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "TowerJetInput::process_event -- exited" << std::endl;
+  }
+  return pseudojets;
+}
+
+void TowerJetInput::fill_input(PHCompositeNode *topNode, JetParticles &particles)
+{
+  float vtxz = 0;  // default to 0
+  RawTowerContainer *towers = nullptr;
+  TowerInfoContainer *towerinfos = nullptr;
+  RawTowerGeomContainer *geom = nullptr;
+  RawTowerGeomContainer *EMCal_geom = nullptr;
+  if (!get_vertex_z(topNode, vtxz) || !get_nodes(topNode, towers, towerinfos, geom, EMCal_geom))
+  {
+    return;
+  }
+  if (!m_use_towerinfo)
+  {
+    // the RawTowerContainer inputs still go through the Jets
+    JetInput::fill_input(topNode, particles);
+    return;
+  }
+  update_tower_geometry(towerinfos, geom, EMCal_geom);
+
+  unsigned int nchannels = towerinfos->size();
+  for (unsigned int channel = 0; channel < nchannels; channel++)
+  {
+    TowerInfo *tower = towerinfos->get_tower_at_channel(channel);
+    assert(tower);
+
+    double px;
+    double py;
+    double pz;
+    if (!get_tower_momentum(tower, channel, vtxz, px, py, pz))
+    {
+      continue;
+    }
+    particles.add(px, py, pz, tower->get_energy(), m_input, channel);
+  }
+}
+
+bool TowerJetInput::get_vertex_z(PHCompositeNode *topNode, float &vtxz)
+{
   GlobalVertexMap *vertexmap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
   if (!vertexmap)
   {
     std::cout << "TowerJetInput::get_input - Fatal Error - GlobalVertexMap node is missing. Please turn on the do_global flag in the main macro in order to reconstruct the global vertex." << std::endl;
     assert(vertexmap);  // force quit
 
-    return std::vector<Jet *>();
+    return false;
   }
   if (vertexmap->empty())
   {
@@ -128,7 +266,12 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     }
     vtxz = 0;
   }
+  return true;
+}
 
+bool TowerJetInput::get_nodes(PHCompositeNode *topNode, RawTowerContainer *&towers, TowerInfoContainer *&towerinfos,
+                              RawTowerGeomContainer *&geom, RawTowerGeomContainer *&EMCal_geom)
+{
   m_use_towerinfo = false;
 
   /* std::string name =(m_input == Jet::CEMC_TOWER ? "CEMC_TOWER" */
@@ -154,10 +297,6 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
   /*                        : "NO NAME"); */
   /* std::cout << " TowerJetInput (" << name << ")" << std::endl; */
 
-  RawTowerContainer *towers = nullptr;
-  TowerInfoContainer *towerinfos = nullptr;
-  RawTowerGeomContainer *geom = nullptr;
-  RawTowerGeomContainer *EMCal_geom = nullptr;
 
   
   if (m_input == Jet::CEMC_TOWER)
@@ -166,7 +305,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO)
@@ -178,7 +317,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_EMBED)
@@ -190,7 +329,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_SIM)
@@ -202,7 +341,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::CEMC;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::EEMC_TOWER)
@@ -211,7 +350,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_EEMC");
     if ((!towers && !towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER)
@@ -220,7 +359,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO)
@@ -232,7 +371,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_EMBED)
@@ -244,7 +383,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_SIM)
@@ -256,7 +395,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALIN;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER)
@@ -265,7 +404,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO)
@@ -277,7 +416,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_EMBED)
@@ -289,7 +428,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_SIM)
@@ -301,7 +440,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geocaloid = RawTowerDefs::CalorimeterId::HCALOUT;
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
 
@@ -311,7 +450,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FEMC");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::FHCAL_TOWER)
@@ -320,7 +459,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_FHCAL");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_RETOWER)
@@ -329,7 +468,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_RETOWER)
@@ -341,7 +480,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_SUB1)
@@ -350,7 +489,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWERINFO_SUB1)
@@ -362,7 +501,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER_SUB1)
@@ -371,7 +510,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWERINFO_SUB1)
@@ -383,7 +522,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER_SUB1)
@@ -392,7 +531,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWERINFO_SUB1)
@@ -404,7 +543,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towerinfos) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::CEMC_TOWER_SUB1CS)
@@ -413,7 +552,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALIN_TOWER_SUB1CS)
@@ -422,7 +561,7 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALIN");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else if (m_input == Jet::HCALOUT_TOWER_SUB1CS)
@@ -431,12 +570,12 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_HCALOUT");
     if ((!towers) || !geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
   else
   {
-    return std::vector<Jet *>();
+    return false;
   }
 
   // for those cases we need to use the EMCal R and IHCal eta phi to calculate the vertex correction
@@ -445,124 +584,76 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
     EMCal_geom = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
     if (!EMCal_geom)
     {
-      return std::vector<Jet *>();
+      return false;
     }
   }
+  return true;
+}
 
-  // first grab the event vertex or bail
-
-
-  std::vector<Jet *> pseudojets;
-  if (m_use_towerinfo)
+void TowerJetInput::update_tower_geometry(TowerInfoContainer *towerinfos, RawTowerGeomContainer *geom, RawTowerGeomContainer *EMCal_geom)
+{
+  unsigned int nchannels = towerinfos->size();
+  if (geom == m_cached_geom && EMCal_geom == m_cached_EMCal_geom && nchannels == m_tower_geometry.size())
   {
-    if (!towerinfos)
-    {
-      return std::vector<Jet *>();
-    }
-
-    unsigned int nchannels = towerinfos->size();
-    for (unsigned int channel = 0; channel < nchannels; channel++)
-    {
-      TowerInfo *tower = towerinfos->get_tower_at_channel(channel);
-      assert(tower);
-
-      unsigned int calokey = towerinfos->encode_key(channel);
-      int ieta = towerinfos->getTowerEtaBin(calokey);
-      int iphi = towerinfos->getTowerPhiBin(calokey);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
-      // skip masked towers
-      if (!tower->get_isGood())
-      {
-        continue;
-      }
-      if (std::isnan(tower->get_energy()))
-      {
-        continue;
-      }
-      RawTowerGeom *tower_geom = geom->get_tower_geometry(key);
-      assert(tower_geom);
-      double r = tower_geom->get_center_radius();
-      if (m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input == Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS)
-      {
-        const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
-        RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
-        assert(EMCal_tower_geom);
-        r = EMCal_tower_geom->get_center_radius();
-      }
-      double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
-      double towereta = tower_geom->get_eta();
-      double z0 = sinh(towereta) * r;
-      double z = z0 - vtxz;
-      double eta = asinh(z / r);  // eta after shift from vertex
-      double pt = tower->get_energy() / cosh(eta);
-      double e = tower->get_energy();
-      double px = pt * cos(phi);
-      double py = pt * sin(phi);
-      double pz = pt * sinh(eta);
-
-      Jet *jet = new Jetv2();
-      jet->set_px(px);
-      jet->set_py(py);
-      jet->set_pz(pz);
-      jet->set_e(e);
-      jet->insert_comp(m_input, channel);
-      float tower_t = 17.6*tower->get_time(); // 17.6 ns/sample and get_time() returns t in samples
-      if(jet->size_properties() < Jet::PROPERTY::prop_t+1)
-	{
-	  jet->resize_properties(Jet::PROPERTY::prop_t + 1);
-	}
-      if(e > m_timing_e_threshold)
-	{
-	  jet->set_property(Jet::PROPERTY::prop_t, tower_t);
-	}
-      else
-	{
-	  jet->set_property(Jet::PROPERTY::prop_t, std::numeric_limits<float>::quiet_NaN());
-	}
-      pseudojets.push_back(jet);
-    }
+    return;
   }
-  else
-  {
-    RawTowerContainer::ConstRange begin_end = towers->getTowers();
-    RawTowerContainer::ConstIterator rtiter;
-    for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
-    {
-      RawTower *tower = rtiter->second;
+  m_cached_geom = geom;
+  m_cached_EMCal_geom = EMCal_geom;
+  m_tower_geometry.assign(nchannels, TowerGeometry());
 
-      RawTowerGeom *tower_geom = geom->get_tower_geometry(tower->get_key());
-      assert(tower_geom);
+  // for the retowered EMCal we use the EMCal R and IHCal eta phi
+  double EMCal_r = 0;
+  if (EMCal_geom)
+  {
+    const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
+    RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
+    assert(EMCal_tower_geom);
+    EMCal_r = EMCal_tower_geom->get_center_radius();
+  }
 
-      double r = tower_geom->get_center_radius();
-      if (m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input == Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS)
-      {
-        const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
-        RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key);
-        assert(EMCal_tower_geom);
-        r = EMCal_tower_geom->get_center_radius();
-      }
-      double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
-      double towereta = tower_geom->get_eta();
-      double z0 = sinh(towereta) * r;
-      double z = z0 - vtxz;
-      double eta = asinh(z / r);  // eta after shift from vertex
-      double pt = tower->get_energy() / cosh(eta);
-      double px = pt * cos(phi);
-      double py = pt * sin(phi);
-      double pz = pt * sinh(eta);
+  for (unsigned int channel = 0; channel < nchannels; channel++)
+  {
+    unsigned int calokey = towerinfos->encode_key(channel);
+    int ieta = towerinfos->getTowerEtaBin(calokey);
+    int iphi = towerinfos->getTowerPhiBin(calokey);
+    const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
+    RawTowerGeom *tower_geom = geom->get_tower_geometry(key);
+    if (!tower_geom)
+    {
+      // only an error if the tower is used
+      continue;
+    }
+    TowerGeometry &towergeom = m_tower_geometry[channel];
+    towergeom.valid = true;
+    towergeom.r = (EMCal_geom ? EMCal_r : tower_geom->get_center_radius());
+    towergeom.z0 = sinh(tower_geom->get_eta()) * towergeom.r;
+    double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
+    towergeom.cosphi = cos(phi);
+    towergeom.sinphi = sin(phi);
+  }
+}
 
-      Jet *jet = new Jetv2();
-      jet->set_px(px);
-      jet->set_py(py);
-      jet->set_pz(pz);
-      jet->set_e(tower->get_energy());
-      jet->insert_comp(m_input, tower->get_id());
-      pseudojets.push_back(jet);
-    }
+bool TowerJetInput::get_tower_momentum(TowerInfo *tower, unsigned int channel, float vtxz, double &px, double &py, double &pz) const
+{
+  // skip masked towers
+  if (!tower->get_isGood())
+  {
+    return false;
   }
-  if (Verbosity() > 0)
+  if (std::isnan(tower->get_energy()))
   {
-    std::cout << "TowerJetInput::process_event -- exited" << std::endl;
+    return false;
   }
-  return pseudojets;
+  const TowerGeometry &towergeom = m_tower_geometry[channel];
+  assert(towergeom.valid);
+
+  // eta after shift from vertex: sinh(eta) = z/r, so the unit vector
+  // of the tower is (r cos(phi), r sin(phi), z) / sqrt(r^2 + z^2)
+  double z = towergeom.z0 - vtxz;
+  double norm = tower->get_energy() / std::sqrt(towergeom.r * towergeom.r + z * z);
+  double pt = norm * towergeom.r;
+  px = pt * towergeom.cosphi;
+  py = pt * towergeom.sinphi;
+  pz = norm * z;
+  return true;
 }
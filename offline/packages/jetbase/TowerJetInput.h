@@ -13,6 +13,10 @@
 // forward declarations
 class PHCompositeNode;
 class GlobalVertex;
+class RawTowerContainer;
+class RawTowerGeomContainer;
+class TowerInfo;
+class TowerInfoContainer;
 class TowerJetInput : public JetInput
 {
  public:
@@ -24,6 +28,7 @@ class TowerJetInput : public JetInput
   Jet::SRC get_src() override { return m_input; }
 
   std::vector<Jet*> get_input(PHCompositeNode* topNode) override;
+  void fill_input(PHCompositeNode* topNode, JetParticles& particles) override;
 
   void reset_GlobalVertexType()
   {
@@ -59,6 +64,27 @@ class TowerJetInput : public JetInput
   void set_timing_e_threshold(float new_threshold) { m_timing_e_threshold = new_threshold; }
 
  private:
+  //! tower geometry of a towerinfo channel
+  struct TowerGeometry
+  {
+    bool valid{false};
+    double r{0};
+    //! z of the tower center for a vertex at 0
+    double z0{0};
+    double cosphi{0};
+    double sinphi{0};
+  };
+
+  bool get_vertex_z(PHCompositeNode* topNode, float& vtxz);
+  bool get_nodes(PHCompositeNode* topNode, RawTowerContainer*& towers, TowerInfoContainer*& towerinfos,
+                 RawTowerGeomContainer*& geom, RawTowerGeomContainer*& EMCal_geom);
+
+  //! cache the geometry of all channels, redone only if the geometry nodes change
+  void update_tower_geometry(TowerInfoContainer* towerinfos, RawTowerGeomContainer* geom, RawTowerGeomContainer* EMCal_geom);
+
+  //! momentum of a tower from the cached geometry, false if the tower is skipped
+  bool get_tower_momentum(TowerInfo* tower, unsigned int channel, float vtxz, double& px, double& py, double& pz) const;
+
   Jet::SRC m_input;
   RawTowerDefs::CalorimeterId geocaloid{RawTowerDefs::CalorimeterId::NONE};
   bool m_use_towerinfo {false};
@@ -67,6 +93,10 @@ class TowerJetInput : public JetInput
   bool m_use_vertextype {false};
   std::vector<GlobalVertex::VTXTYPE> m_vertex_type{GlobalVertex::UNDEFINED};
   float m_timing_e_threshold{0.1};
+
+  std::vector<TowerGeometry> m_tower_geometry;
+  RawTowerGeomContainer* m_cached_geom{nullptr};
+  RawTowerGeomContainer* m_cached_EMCal_geom{nullptr};
 };
 
 #endif
@@ -808,6 +808,8 @@ int MbdCalib::Download_Shapes(const std::string& dbase_location)
     }
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    const CDBTTree::Column<float> shape_val = cdbttree->GetFloatColumn("shape_val");
+    const CDBTTree::Column<float> sherr_val = cdbttree->GetFloatColumn("sherr_val");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
@@ -828,10 +830,10 @@ int MbdCalib::Download_Shapes(const std::string& dbase_location)
       {
         int chtemp = (1000 * ipt) + ifeech;
 
-        float val = cdbttree->GetFloatValue(chtemp, "shape_val");
+        float val = cdbttree->GetFloatValue(chtemp, shape_val);
         _shape_y[ifeech].push_back(val);
 
-        val = cdbttree->GetFloatValue(chtemp, "sherr_val");
+        val = cdbttree->GetFloatValue(chtemp, sherr_val);
         _sherr_yerr[ifeech].push_back(val);
       }
 
@@ -997,6 +999,7 @@ int MbdCalib::Download_TimeCorr(const std::string& dbase_location)
     }
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    const CDBTTree::Column<float> tcorr_val = cdbttree->GetFloatColumn("tcorr_val");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
@@ -1013,7 +1016,7 @@ int MbdCalib::Download_TimeCorr(const std::string& dbase_location)
       {
         int chtemp = (1000*ipt) + ifeech; // in cdbtree, entry has id = 1000*datapoint + ifeech
 
-        float val = cdbttree->GetFloatValue(chtemp, "tcorr_val");
+        float val = cdbttree->GetFloatValue(chtemp, tcorr_val);
         _tcorr_y[ifeech].push_back( val );
       }
 
@@ -1156,6 +1159,7 @@ int MbdCalib::Download_SlewCorr(const std::string& dbase_location)
     }
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    const CDBTTree::Column<float> scorr_val = cdbttree->GetFloatColumn("scorr_val");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
@@ -1172,7 +1176,7 @@ int MbdCalib::Download_SlewCorr(const std::string& dbase_location)
       {
         int chtemp = (1000*ipt) + ifeech; // in cdbtree, entry has id = 1000*datapoint + ifeech
 
-        float val = cdbttree->GetFloatValue(chtemp, "scorr_val");
+        float val = cdbttree->GetFloatValue(chtemp, scorr_val);
         _scorr_y[ifeech].push_back( val );
       }
 
@@ -1328,6 +1332,7 @@ int MbdCalib::Download_TimeRMS(const std::string& dbase_location)
     }
     CDBTTree* cdbttree = new CDBTTree(dbase_location);
     cdbttree->LoadCalibrations();
+    const CDBTTree::Column<float> trms_val = cdbttree->GetFloatColumn("trms_val");
 
     for (int ifeech = 0; ifeech < MbdDefs::MBD_N_FEECH; ifeech++)
     {
@@ -1344,7 +1349,7 @@ int MbdCalib::Download_TimeRMS(const std::string& dbase_location)
       {
         int chtemp = (1000*ipt) + ifeech; // in cdbtree, entry has id = 1000*datapoint + ifeech
 
-        float val = cdbttree->GetFloatValue(chtemp, "trms_val");
+        float val = cdbttree->GetFloatValue(chtemp, trms_val);
         _trms_y[ifeech].push_back( val );
       }
 
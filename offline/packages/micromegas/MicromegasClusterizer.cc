@@ -41,6 +41,7 @@
 #include <cstdint>                                 // for uint16_t
 #include <iterator>                                 // for distance
 #include <map>                                      // for _Rb_tree_const_it...
+#include <memory>
 #include <utility>                                  // for pair, make_pair
 #include <vector>
 
@@ -408,7 +409,7 @@ int MicromegasClusterizer::process_event(PHCompositeNode *topNode)
         }
       }
 
-      trkrClusterContainer->addClusterSpecifyKey( ckey, cluster.release() );
+      trkrClusterContainer->addCluster( ckey, std::move(cluster) );
 
       // increment counter
       ++m_clustercounts[hitsetkey];
@@ -12,6 +12,7 @@
 #include <trackbase/ClusHitsVerbosev1.h>
 #include <trackbase/TpcDefs.h>
 #include <trackbase/TrkrClusterContainerv4.h>
+#include <trackbase/TrkrClusterContainerv5.h>
 #include <trackbase/TrkrClusterHitAssocv3.h>
 #include <trackbase/TrkrClusterv3.h>
 #include <trackbase/TrkrClusterv4.h>
@@ -43,6 +44,7 @@
 #include <phool/PHNode.h>        // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -63,8 +65,6 @@
 #include <utility>  // for pair
 #include <vector>
 #include <unordered_set>
-// Terra incognita....
-#include <pthread.h>
 
 namespace
 {
@@ -139,21 +139,74 @@ namespace
     vec_dVerbose zvec_ClusHitsVerbose;    // only fill if fillClusHitsVerbose
   };
 
-  pthread_mutex_t mythreadlock;
+  // dense (phi, t) adc array for one hitset, stored contiguously with t running fastest
+  // adcval[iphi][it] returns the adc in a given cell
+  struct adc_grid
+  {
+    unsigned short phibins = 0;
+    unsigned short tbins = 0;
+    std::vector<unsigned short> values;
+
+    // resize to requested dimensions and zero all cells. Capacity is kept
+    void reset(unsigned short nphi, unsigned short nt)
+    {
+      phibins = nphi;
+      tbins = nt;
+      values.assign(static_cast<size_t>(nphi) * nt, 0);
+    }
+
+    unsigned short *operator[](int iphi) { return values.data() + static_cast<size_t>(iphi) * tbins; }
+    const unsigned short *operator[](int iphi) const { return values.data() + static_cast<size_t>(iphi) * tbins; }
+  };
+
+  // scratch buffers, reused for all hitsets processed by a given worker
+  struct scratch_buffers
+  {
+    adc_grid adcval;
+    std::vector<ihit> seeds;
+    std::vector<ihit> ihit_list;
+  };
 
-  void remove_hit(double adc, int phibin, int tbin, int edge, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
+  // collect all cells above threshold, in (phi, t) order
+  void find_seeds(const adc_grid &adcval, unsigned short threshold, std::vector<ihit> &seeds)
   {
-    using hit_iterator = std::multimap<unsigned short, ihit>::iterator;
-    std::pair<hit_iterator, hit_iterator> iterpair = all_hit_map.equal_range(adc);
-    hit_iterator it = iterpair.first;
-    for (; it != iterpair.second; ++it)
+    // cells are tested by blocks. The block test has no branch and is vectorized by the compiler,
+    // so that the mostly empty regions of the grid are skipped quickly
+    constexpr int block_size = 16;
+    const int tbins = adcval.tbins;
+    for (int iphi = 0; iphi < adcval.phibins; ++iphi)
     {
-      if (it->second.iphi == phibin && it->second.it == tbin)
+      const unsigned short *row = adcval[iphi];
+      for (int it0 = 0; it0 < tbins; it0 += block_size)
       {
-        all_hit_map.erase(it);
-        break;
+        const int it1 = std::min(it0 + block_size, tbins);
+        if (it1 - it0 == block_size)
+        {
+          bool any = false;
+          for (int it = it0; it < it1; ++it)
+          {
+            any |= (row[it] > threshold);
+          }
+          if (!any)
+          {
+            continue;
+          }
+        }
+
+        for (int it = it0; it < it1; ++it)
+        {
+          if (row[it] > threshold)
+          {
+            seeds.push_back({static_cast<unsigned short>(iphi), static_cast<unsigned short>(it), row[it], 0});
+          }
+        }
       }
     }
+  }
+
+  void remove_hit(int phibin, int tbin, int edge, adc_grid &adcval)
+  {
+    // hits are flagged as used directly in the adc array
     if (edge)
     {
       adcval[phibin][tbin] = USHRT_MAX;
@@ -164,19 +217,18 @@ namespace
     }
   }
 
-  void remove_hits(std::vector<ihit> &ihit_list, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
+  void remove_hits(std::vector<ihit> &ihit_list, adc_grid &adcval)
   {
     for (auto &iter : ihit_list)
     {
-      unsigned short adc = iter.adc;
       unsigned short phibin = iter.iphi;
       unsigned short tbin = iter.it;
       unsigned short edge = iter.edge;
-      remove_hit(adc, phibin, tbin, edge, all_hit_map, adcval);
+      remove_hit(phibin, tbin, edge, adcval);
     }
   }
 
-  void find_t_range(int phibin, int tbin, const thread_data &my_data, const std::vector<std::vector<unsigned short>> &adcval, int &tdown, int &tup, int &touch, int &edge)
+  void find_t_range(int phibin, int tbin, const thread_data &my_data, const adc_grid &adcval, int &tdown, int &tup, int &touch, int &edge)
   {
     const int FitRangeT = (int) my_data.maxHalfSizeT;
     const int NTBinsMax = (int) my_data.tbins;
@@ -271,7 +323,7 @@ namespace
     return;
   }
 
-  void find_phi_range(int phibin, int tbin, const thread_data &my_data, const std::vector<std::vector<unsigned short>> &adcval, int &phidown, int &phiup, int &touch, int &edge)
+  void find_phi_range(int phibin, int tbin, const thread_data &my_data, const adc_grid &adcval, int &phidown, int &phiup, int &touch, int &edge)
   {
     int FitRangePHI = (int) my_data.maxHalfSizePhi;
     int NPhiBinsMax = (int) my_data.phibins;
@@ -369,7 +421,7 @@ namespace
     return;
   }
 
-  int is_hit_isolated(int iphi, int it, int NPhiBinsMax, int NTBinsMax, const std::vector<std::vector<unsigned short>> &adcval)
+  int is_hit_isolated(int iphi, int it, int NPhiBinsMax, int NTBinsMax, const adc_grid &adcval)
   {
     // check isolated hits
     // const int NPhiBinsMax = (int) my_data.phibins;
@@ -426,7 +478,7 @@ namespace
     return isiso;
   }
 
-  void get_cluster(int phibin, int tbin, const thread_data &my_data, const std::vector<std::vector<unsigned short>> &adcval, std::vector<ihit> &ihit_list, int &touch, int &edge)
+  void get_cluster(int phibin, int tbin, const thread_data &my_data, const adc_grid &adcval, std::vector<ihit> &ihit_list, int &touch, int &edge)
   {
     // search along phi at the peak in t
     //    const int NPhiBinsMax = (int) my_data.phibins;
@@ -817,7 +869,7 @@ namespace
     //      std::cout << "done calc" << std::endl;
   }
 
-  void ProcessSectorData(thread_data *my_data)
+  void ProcessSectorData(thread_data *my_data, scratch_buffers &scratch)
   {
     const auto &pedestal = my_data->pedestal;
     const auto &phibins = my_data->phibins;
@@ -827,10 +879,16 @@ namespace
     const auto &maxz = my_data->tGeometry->get_max_driftlength() + my_data->tGeometry->get_CM_halfwidth();
     const auto &layer = my_data->layer;
     //    int nhits = 0;
-    // for convenience, create a 2D vector to store adc values in and initialize to zero
-    std::vector<std::vector<unsigned short>> adcval(phibins, std::vector<unsigned short>(tbins, 0));
-    std::multimap<unsigned short, ihit> all_hit_map;
-    std::vector<ihit> hit_vect;
+    // for convenience, use a dense 2D array to store adc values in and initialize to zero
+    // buffers are owned by the worker and keep their capacity from one hitset to the next
+    auto &adcval = scratch.adcval;
+    adcval.reset(phibins, tbins);
+    auto &seeds = scratch.seeds;
+    seeds.clear();
+    auto &ihit_list = scratch.ihit_list;
+
+    // only cells above that threshold are used as cluster seeds
+    unsigned short seed_threshold = 0;
 
     int tbinmax = tbins;
     int tbinmin = 0;
@@ -884,6 +942,9 @@ namespace
 
     if (my_data->hitset != nullptr)
     {
+      // adc values are integers, so that adc > threshold is unchanged by rounding the threshold down
+      seed_threshold = std::clamp(std::floor(my_data->seed_threshold), 0., (double) USHRT_MAX);
+
       TrkrHitSet *hitset = my_data->hitset;
       TrkrHitSet::ConstRange hitrangei = hitset->getHits();
 
@@ -927,27 +988,16 @@ namespace
         {
           adc = (unsigned short) fadc;
         }
-        if (adc > 0)
+        if (adc > my_data->edge_threshold)
         {
-          if (adc > (my_data->seed_threshold))
-          {
-            ihit thisHit;
-
-            thisHit.iphi = phibin;
-            thisHit.it = tbin;
-            thisHit.adc = adc;
-            thisHit.edge = 0;
-            all_hit_map.insert(std::make_pair(adc, thisHit));
-          }
-          if (adc > my_data->edge_threshold)
-          {
-            adcval[phibin][tbin] = adc;
-          }
+          adcval[phibin][tbin] = adc;
         }
       }
     }
     else if (my_data->rawhitset != nullptr)
     {
+      seed_threshold = 5;
+
       RawHitSet *hitset = my_data->rawhitset;
       /*
 	std::cout << "Layer: " << my_data->layer
@@ -981,15 +1031,6 @@ namespace
           {
             if (nt == 0)
             {
-              if (val > 5)
-              {
-                ihit thisHit;
-                thisHit.iphi = nphi;
-                thisHit.it = pindex;
-                thisHit.adc = val;
-                thisHit.edge = 0;
-                all_hit_map.insert(std::make_pair(val, thisHit));
-              }
               adcval[nphi][pindex++] = val;
             }
             else
@@ -1000,15 +1041,6 @@ namespace
               }
               else
               {
-                if (val > 5)
-                {
-                  ihit thisHit;
-                  thisHit.iphi = nphi;
-                  thisHit.it = pindex;
-                  thisHit.adc = val;
-                  thisHit.edge = 0;
-                  all_hit_map.insert(std::make_pair(val, thisHit));
-                }
                 adcval[nphi][pindex++] = val;
               }
             }
@@ -1016,54 +1048,40 @@ namespace
         }
       }
     }
-    /*
-    if (my_data->do_singles)
-    {
-      for (auto ahit : all_hit_map)
-      {
-        ihit hiHit = ahit.second;
-        int iphi = hiHit.iphi;
-        int it = hiHit.it;
-        unsigned short edge = hiHit.edge;
-        double adc = hiHit.adc;
-        if (it > 0 && it < tbins)
-        {
-          if (adcval[iphi][it - 1] == 0 &&
-              adcval[iphi][it + 1] == 0)
-          {
-            remove_hit(adc, iphi, it, edge, all_hit_map, adcval);
-          }
-        }
-      }
-    }
-    */
     // std::cout << "done filling " << std::endl;
-    while (!all_hit_map.empty())
+    find_seeds(adcval, seed_threshold, seeds);
+
+    // sort seeds by increasing adc, then process from the back (highest adc first).
+    // stable sort so that among equal adc values the last seed in (phi, t) order comes first
+    std::stable_sort(seeds.begin(), seeds.end(), [](const ihit &lhs, const ihit &rhs)
+                     { return lhs.adc < rhs.adc; });
+
+    for (auto seed_iter = seeds.rbegin(); seed_iter != seeds.rend(); ++seed_iter)
     {
-      // std::cout << "all hit map size: " << all_hit_map.size() << std::endl;
-      auto iter = all_hit_map.rbegin();
-      if (iter == all_hit_map.rend())
-      {
-        break;
-      }
-      ihit hiHit = iter->second;
+      const ihit &hiHit = *seed_iter;
       int iphi = hiHit.iphi;
       int it = hiHit.it;
       unsigned short edge = hiHit.edge;
-      double adc = hiHit.adc;
+
+      // skip seeds already used in a previous cluster
+      if (adcval[iphi][it] != hiHit.adc)
+      {
+        continue;
+      }
+
       if (my_data->do_singles)
       {
         if (is_hit_isolated(iphi, it, (int) my_data->phibins, (int) my_data->tbins, adcval))
         {
-          remove_hit(adc, iphi, it, edge, all_hit_map, adcval);
+          remove_hit(iphi, it, edge, adcval);
           continue;
         }
       }
 
-      // put all hits in the all_hit_map (sorted by adc)
+      // seeds are sorted by adc
       // start with highest adc hit
       //  -> cluster around it and get vector of hits
-      std::vector<ihit> ihit_list;
+      ihit_list.clear();
       int ntouch = 0;
       int nedge = 0;
       get_cluster(iphi, it, *my_data, adcval, ihit_list, ntouch, nedge);
@@ -1109,16 +1127,16 @@ namespace
       }
       if (ihit_list.size() <= 1)
       {
-        remove_hits(ihit_list, all_hit_map, adcval);
+        remove_hits(ihit_list, adcval);
         ihit_list.clear();
-        remove_hit(adc, iphi, it, edge, all_hit_map, adcval);
+        remove_hit(iphi, it, edge, adcval);
       }
       // -> calculate cluster parameters
       // -> add hits to truth association
-      // remove hits from all_hit_map
-      // repeat untill all_hit_map empty
+      // flag hits as used in the adc array
+      // repeat until all seeds are used
       calc_cluster_parameter(iphi, it, ihit_list, *my_data, ntouch, nedge);
-      remove_hits(ihit_list, all_hit_map, adcval);
+      remove_hits(ihit_list, adcval);
       ihit_list.clear();
     }
     /*    if( my_data->rawhitset!=nullptr){
@@ -1132,23 +1150,21 @@ namespace
                 << std::endl;
     }
     */
-    // pthread_exit(nullptr);
-  }
-
-  void *ProcessSector(void *threadarg)
-  {
-    auto *my_data = static_cast<thread_data *>(threadarg);
-    ProcessSectorData(my_data);
-    pthread_exit(nullptr);
   }
 }  // namespace
 
+struct TpcClusterizer::scratch_data : public scratch_buffers
+{
+};
+
 TpcClusterizer::TpcClusterizer(const std::string &name)
   : SubsysReco(name)
   , m_training(nullptr)
 {
 }
 
+TpcClusterizer::~TpcClusterizer() = default;
+
 bool TpcClusterizer::is_in_sector_boundary(int phibin, int sector, PHG4TpcGeom *layergeom) const
 {
   bool reject_it = false;
@@ -1205,7 +1221,14 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
       dstNode->addNode(DetNode);
     }
 
-    trkrclusters = new TrkrClusterContainerv4;
+    if (m_cluster_columns)
+    {
+      trkrclusters = new TrkrClusterContainerv5;
+    }
+    else
+    {
+      trkrclusters = new TrkrClusterContainerv4;
+    }
     PHIODataNode<PHObject> *TrkrClusterContainerNode =
         new PHIODataNode<PHObject>(trkrclusters, "TRKR_CLUSTER", "PHObject");
     DetNode->addNode(TrkrClusterContainerNode);
@@ -1319,6 +1342,19 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
     makeChannelMask(m_hotChannelMap, m_hotChannelMapName, "TotalHotChannels");
   }
 
+  // worker threads are created once and reused for all events
+  if (!m_pool)
+  {
+    m_pool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << "Using " << m_pool->size() << " worker threads" << std::endl;
+    }
+  }
+
+  // one set of scratch buffers per worker
+  m_scratch.resize(m_pool->size());
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -1441,28 +1477,9 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       rawhitsetrange = m_rawhits->getHitSets(TrkrDefs::TrkrId::tpcId);
       num_hitsets = std::distance(rawhitsetrange.first, rawhitsetrange.second);
     }
-  // create structure to store given thread and associated data
-  struct thread_pair_t
-  {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  // create vector of thread pairs and reserve the right size upfront to avoid reallocation
-  std::vector<thread_pair_t> threads;
-  threads.reserve(num_hitsets);
-
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
-  {
-    std::cout << std::endl
-              << " mutex init failed" << std::endl;
-    return 1;
-  }
-//  int count = 0;
+  // one entry per hitset. Reserve the right size upfront to avoid reallocation
+  std::vector<thread_data> sectors;
+  sectors.reserve(num_hitsets);
 
   if (!do_read_raw)
   {
@@ -1470,47 +1487,46 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
          hitsetitr != hitsetrange.second;
          ++hitsetitr)
     {
-      // if(count>0)continue;
       TrkrHitSet *hitset = hitsetitr->second;
       unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
       int side = TpcDefs::getSide(hitsetitr->first);
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
+      // instanciate new thread data, at the end of the vector
+      thread_data &data = sectors.emplace_back();
       if (mClusHitsVerbose)
       {
-        thread_pair.data.fillClusHitsVerbose = true;
+        data.fillClusHitsVerbose = true;
       };
 
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = hitset;
-      thread_pair.data.rawhitset = nullptr;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.seed_threshold = seed_threshold;
-      thread_pair.data.edge_threshold = edge_threshold;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.do_singles = do_singles;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.verbosity = Verbosity();
-      thread_pair.data.do_split = do_split;
-      thread_pair.data.FixedWindow = do_fixed_window;
-      thread_pair.data.min_err_squared = min_err_squared;
-      thread_pair.data.min_clus_size = min_clus_size;
-      thread_pair.data.min_adc_sum = min_adc_sum;
+      data.layergeom = layergeom;
+      data.hitset = hitset;
+      data.rawhitset = nullptr;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.seed_threshold = seed_threshold;
+      data.edge_threshold = edge_threshold;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.do_singles = do_singles;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.verbosity = Verbosity();
+      data.do_split = do_split;
+      data.FixedWindow = do_fixed_window;
+      data.min_err_squared = min_err_squared;
+      data.min_clus_size = min_clus_size;
+      data.min_adc_sum = min_adc_sum;
 
       // --- pass dead/hot map info ---
-      thread_pair.data.deadMap  = &m_deadChannelMap;
-      thread_pair.data.hotMap   = &m_hotChannelMap;
-      thread_pair.data.maskDead = m_maskDeadChannels;
-      thread_pair.data.maskHot  = m_maskHotChannels;
+      data.deadMap  = &m_deadChannelMap;
+      data.hotMap   = &m_hotChannelMap;
+      data.maskDead = m_maskDeadChannels;
+      data.maskHot  = m_maskHotChannels;
 
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -1530,73 +1546,17 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
 
       m_tdriftmax = layergeom->get_max_driftlength() / m_tGeometry->get_drift_velocity(); 
       //  std::cout << "     m_tdriftmax " << m_tdriftmax << " drift velocity reco " << m_tGeometry->get_drift_velocity() << std::endl;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
-
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
-
-      thread_pair.data.radius = layergeom->get_radius();
-      thread_pair.data.drift_velocity = m_tGeometry->get_drift_velocity();
-      thread_pair.data.pads_per_sector = 0;
-      thread_pair.data.phistep = 0;
-      int rc;
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto *cluster = data.cluster_vector[index];
+      data.m_tdriftmax = m_tdriftmax;
 
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
 
-          if (mClusHitsVerbose)
-          {
-            for (const auto &hit : data.phivec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addPhiHit(hit.first, hit.second);
-            }
-            for (const auto &hit : data.zvec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addZHit(hit.first, hit.second);
-            }
-            mClusHitsVerbose->push_hits(ckey);
-          }
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
-//      count++;
+      data.radius = layergeom->get_radius();
+      data.drift_velocity = m_tGeometry->get_drift_velocity();
+      data.pads_per_sector = 0;
+      data.phistep = 0;
     }
   }
   else
@@ -1605,38 +1565,34 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
          hitsetitr != rawhitsetrange.second;
          ++hitsetitr)
     {
-      //	if(count>0)continue;
-      //    const auto hitsetid = hitsetitr->first;
-      //	std::cout << " starting thread # " << count << std::endl;
-
       RawHitSet *hitset = hitsetitr->second;
       unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
       int side = TpcDefs::getSide(hitsetitr->first);
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
-
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = nullptr;
-      thread_pair.data.rawhitset = hitset;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.verbosity = Verbosity();
+      // instanciate new thread data, at the end of the vector
+      thread_data &data = sectors.emplace_back();
+
+      data.layergeom = layergeom;
+      data.hitset = nullptr;
+      data.rawhitset = hitset;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.verbosity = Verbosity();
 
       // --- pass dead/hot map info ---
-      thread_pair.data.deadMap  = &m_deadChannelMap;
-      thread_pair.data.hotMap   = &m_hotChannelMap;
-      thread_pair.data.maskDead = m_maskDeadChannels;
-      thread_pair.data.maskHot  = m_maskHotChannels;
+      data.deadMap  = &m_deadChannelMap;
+      data.hotMap   = &m_hotChannelMap;
+      data.maskDead = m_maskDeadChannels;
+      data.maskHot  = m_maskHotChannels;
 
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -1648,148 +1604,79 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
 
       m_tdriftmax = layergeom->get_max_driftlength() / m_tGeometry->get_drift_velocity(); 
       //      std::cout << "     m_tdriftmax " << m_tdriftmax << " drift velocity reco " << m_tGeometry->get_drift_velocity() << std::endl;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
+      data.m_tdriftmax = m_tdriftmax;
 
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
-      
-      /*
-      PHG4TpcGeom *testlayergeom = geom_container->GetLayerCellGeom(32);
-      for( double iphi = 1408; iphi < 1408+ 128;iphi+=0.1){
-        double clusiphi = iphi;
-        double clusphi = testlayergeom->get_phi(clusiphi);
-        double radius = layergeom->get_radius();
-        double clusx = radius * cos(clusphi);
-        double clusy = radius * sin(clusphi);
-        double clusz  = -37.524;
-
-        TrkrDefs::hitsetkey tpcHitSetKey = TpcDefs::genHitSetKey( 32,11, 0 );
-        Acts::Vector3 global(clusx, clusy, clusz);
-        TrkrDefs::subsurfkey subsurfkey = 0;
-
-        Surface surface = m_tGeometry->get_tpc_surface_from_coords(
-                                                                   tpcHitSetKey,
-                                                                   global,
-                                                                   subsurfkey);
-        std::cout << " iphi: " << iphi << " clusphi: " << clusphi << " surfkey " << subsurfkey << std::endl;
-        //	std::cout << "surfkey" << subsurfkey << std::endl;
-      }
-      continue;
-      */
-      int rc = 0;
-      //      if(layer==32)
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-      //      else
-      // continue;
-
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto *cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
-//      count++;
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
     }
   }
 
-  pthread_attr_destroy(&attr);
-//  count = 0;
-  // wait for completion of all threads
-  if (!do_sequential)
+  // process hitsets, either in the calling thread or on the worker pool
+  if (do_sequential || !m_pool)
   {
-    for (const auto &thread_pair : threads)
+    for (auto &data : sectors)
     {
-      int rc2 = pthread_join(thread_pair.thread, nullptr);
-      if (rc2)
-      {
-        std::cout << "Error:unable to join," << rc2 << std::endl;
-      }
+      ProcessSectorData(&data, m_scratch.front());
+    }
+  }
+  else
+  {
+    m_pool->parallel_for(sectors.size(), [this, &sectors](std::size_t index, unsigned int worker)
+                         { ProcessSectorData(&sectors[index], m_scratch[worker]); });
+  }
 
-      // get the hitsetkey from thread data
-      const auto &data(thread_pair.data);
-      const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
+  // copy output to the node tree, in hitset order
+  for (const auto &data : sectors)
+  {
+    // get the hitsetkey from thread data
+    const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
 
-      // copy clusters to map
-      for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy clusters to map
+    for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // get cluster
-        auto *cluster = data.cluster_vector[index];
+      // get cluster
+      auto *cluster = data.cluster_vector[index];
 
-        // insert in map
-        // std::cout << "X: " << cluster->getLocalX() << "Y: " << cluster->getLocalY() << std::endl;
-        m_clusterlist->addClusterSpecifyKey(ckey, cluster);
+      // insert in map
+      // std::cout << "X: " << cluster->getLocalX() << "Y: " << cluster->getLocalY() << std::endl;
+      m_clusterlist->addCluster(ckey, std::unique_ptr<TrkrCluster>(cluster));
 
-        if (mClusHitsVerbose)
+      if (mClusHitsVerbose && data.fillClusHitsVerbose)
+      {
+        for (const auto &hit : data.phivec_ClusHitsVerbose[index])
         {
-          for (const auto &hit : data.phivec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addPhiHit(hit.first, (double) hit.second);
-          }
-          for (const auto &hit : data.zvec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addZHit(hit.first, (double) hit.second);
-          }
-          mClusHitsVerbose->push_hits(ckey);
+          mClusHitsVerbose->addPhiHit(hit.first, (double) hit.second);
         }
+        for (const auto &hit : data.zvec_ClusHitsVerbose[index])
+        {
+          mClusHitsVerbose->addZHit(hit.first, (double) hit.second);
+        }
+        mClusHitsVerbose->push_hits(ckey);
       }
+    }
 
-      // copy hit associations to map
-      for (const auto &[index, hkey] : thread_pair.data.association_vector)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy hit associations to map
+    for (const auto &[index, hkey] : data.association_vector)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // add to association table
-        m_clusterhitassoc->addAssoc(ckey, hkey);
-      }
+      // add to association table
+      m_clusterhitassoc->addAssoc(ckey, hkey);
+    }
 
-      for (auto *v_hit : thread_pair.data.v_hits)
+    for (auto *v_hit : data.v_hits)
+    {
+      if (_store_hits)
       {
-        if (_store_hits)
-        {
-          m_training->v_hits.emplace_back(*v_hit);
-        }
-        delete v_hit;
+        m_training->v_hits.emplace_back(*v_hit);
       }
+      delete v_hit;
     }
   }
 
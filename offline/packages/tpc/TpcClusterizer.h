@@ -7,13 +7,16 @@
 #include <trackbase/TrkrDefs.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 typedef std::map<TrkrDefs::hitsetkey, std::unordered_set<TrkrDefs::hitkey>> hitMaskTpcSet;
 
 class ClusHitsVerbosev1;
 class PHCompositeNode;
+class PHThreadPool;
 class TrkrHitSet;
 class TrkrHitSetContainer;
 class TrkrClusterContainer;
@@ -30,7 +33,7 @@ public:
   typedef std::pair<unsigned short, iphiz> ihit;
 
   TpcClusterizer(const std::string &name = "TpcClusterizer");
-  ~TpcClusterizer() override = default;
+  ~TpcClusterizer() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -42,6 +45,8 @@ public:
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_do_wedge_emulation(bool do_wedge) { do_wedge_emulation = do_wedge; }
   void set_do_sequential(bool do_seq) { do_sequential = do_seq; }
+  //! number of worker threads used to process hitsets. 0 means one per hardware thread
+  void set_nthreads(unsigned int n) { m_nthreads = n; }
   void set_do_split(bool split) { do_split = split; }
   void set_fixed_window(int fixed) { do_fixed_window = fixed; }
   void set_pedestal(double val) { pedestal = val; }
@@ -56,6 +61,8 @@ public:
   void set_max_cluster_half_size_z(unsigned short size) { MaxClusterHalfSizeT = size; }
   void set_reject_event(bool reject) { m_rejectEvent = reject; }
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; }
+  // store the clusters in a column oriented TrkrClusterContainerv5, if this module creates the cluster node
+  void set_cluster_columns(bool columns) { m_cluster_columns = columns; }
   void set_nzbins(int val){NZBinsSide = val; is_reco = true;}
   void set_rawdata_reco()
   {
@@ -103,6 +110,7 @@ public:
   TrkrClusterHitAssoc *m_clusterhitassoc = nullptr;
   ActsGeometry *m_tGeometry = nullptr;
   bool m_rejectEvent = true;
+  bool m_cluster_columns = false;
   bool _store_hits = false;
   bool _use_nn = false;
   bool do_hit_assoc = true;
@@ -129,6 +137,14 @@ public:
 
   TrainingHitsContainer *m_training;
 
+  //! worker pool, created at InitRun and reused across events
+  unsigned int m_nthreads = 0;
+  std::unique_ptr<PHThreadPool> m_pool;
+
+  //! scratch buffers of each worker, indexed by the worker id passed by the pool
+  struct scratch_data;
+  std::vector<scratch_data> m_scratch;
+
   hitMaskTpcSet m_deadChannelMap;
   hitMaskTpcSet m_hotChannelMap; 
 
@@ -8,8 +8,9 @@
 #include "TpcDistortionCorrectionContainer.h"
 
 #include <TH1.h>
-#include <cmath>
 
+#include <array>
+#include <cmath>
 #include <iostream>
 
 namespace
@@ -82,8 +83,36 @@ Acts::Vector3 TpcDistortionCorrection::get_corrected_position(const Acts::Vector
   dr=0;
   dz=0;
   
-  //get the corrections from the histograms
-  if (dcc->m_dimensions == 3)
+  //get the corrections from the resampled grid if available, from the histograms otherwise
+  const auto& grid = dcc->m_grid[index];
+  if (grid.valid() && grid.dimension() == dcc->m_dimensions)
+  {
+    if (grid.in_range(phi, r, z))
+    {
+      std::array<double, 3> corrections{};
+      grid.interpolate(phi, r, z, corrections);
+
+      double zterm = 1.0;
+      if (dcc->m_dimensions == 2 && dcc->m_interpolate_z)
+      {
+        zterm = (1. - std::abs(z) / 102.605);
+      }
+
+      if (grid.has(TpcDistortionCorrectionGrid::PHI) && (mask & COORD_PHI))
+      {
+        dphi = corrections[TpcDistortionCorrectionGrid::PHI] * zterm / divisor;
+      }
+      if (grid.has(TpcDistortionCorrectionGrid::R) && (mask & COORD_R))
+      {
+        dr = corrections[TpcDistortionCorrectionGrid::R] * zterm;
+      }
+      if (grid.has(TpcDistortionCorrectionGrid::Z) && (mask & COORD_Z))
+      {
+        dz = corrections[TpcDistortionCorrectionGrid::Z] * zterm;
+      }
+    }
+  }
+  else if (dcc->m_dimensions == 3)
   {
     if (dcc->m_hDPint[index] && (mask & COORD_PHI) && check_boundaries(dcc->m_hDPint[index], phi, r, z))
     {
@@ -138,3 +167,12 @@ if(dcc->m_use_scalefactor)
 
   return {x_new, y_new, z_new};
 }
+
+//________________________________________________________
+void TpcDistortionCorrection::get_corrected_positions(std::vector<Acts::Vector3>& positions, const TpcDistortionCorrectionContainer* dcc, unsigned int mask) const
+{
+  for (auto& position : positions)
+  {
+    position = get_corrected_position(position, dcc, mask);
+  }
+}
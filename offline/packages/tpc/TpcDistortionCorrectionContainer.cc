@@ -35,6 +35,29 @@ void TpcDistortionCorrectionContainer::load_histograms( const std::string& sourc
     m_hDZint[j] = dynamic_cast<TH1*>(distortion_tfile->Get((std::string("hIntDistortionZ")+extension[j]).c_str()));
     assert(m_hDZint[j]);
   }
+
+  build_grids();
+}
+
+//_______________________________________________________________
+void TpcDistortionCorrectionContainer::build_grids()
+{
+  for (int j = 0; j < 2; ++j)
+  {
+    if (!m_grid[j].build(m_hDPint[j], m_hDRint[j], m_hDZint[j]))
+    {
+      std::cout << "TpcDistortionCorrectionContainer::build_grids - histograms for side " << j << " cannot be resampled, using histogram interpolation" << std::endl;
+    }
+  }
+}
+
+//_______________________________________________________________
+void TpcDistortionCorrectionContainer::clear_grids()
+{
+  for (auto& grid : m_grid)
+  {
+    grid.clear();
+  }
 }
 
 //_______________________________________________________________
@@ -7,6 +7,8 @@
  * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
  */
 
+#include "TpcDistortionCorrectionGrid.h"
+
 #include <array>
 #include <string>
 
@@ -24,6 +26,16 @@ class TpcDistortionCorrectionContainer
   //! save histograms to out file
   void save_histograms( const std::string& /*destination*/ ) const;
 
+  //! resample the correction histograms into flat grids, used by TpcDistortionCorrection in place of the histograms
+  /**
+   * called by load_histograms. It must be called again if the histograms are modified or replaced afterwards,
+   * or the grids removed with clear_grids, otherwise corrections are taken from the outdated grids
+   */
+  void build_grids();
+
+  //! remove the grids, corrections are then interpolated directly from the histograms
+  void clear_grids();
+
   //! flag to tell us whether to read z data or just 2d data
   int m_dimensions = 3;
 
@@ -48,6 +60,9 @@ class TpcDistortionCorrectionContainer
    */
   std::array<TH1*, 2> m_hentries = {{nullptr, nullptr}};
   //@}
+
+  //! (dphi, dr, dz) corrections resampled from the histograms, for each side
+  std::array<TpcDistortionCorrectionGrid, 2> m_grid;
 };
 
 #endif
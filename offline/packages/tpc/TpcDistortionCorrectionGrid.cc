@@ -0,0 +1,129 @@
+/*!
+ * \file TpcDistortionCorrectionGrid.cc
+ * \brief distortion correction histograms of one TPC side, resampled into a flat grid for fast interpolation
+ */
+
+#include "TpcDistortionCorrectionGrid.h"
+
+#include <TAxis.h>
+#include <TH1.h>
+
+namespace
+{
+  // true if axis has uniform binning
+  bool is_uniform(const TAxis* axis)
+  {
+    return !axis->IsVariableBinSize();
+  }
+
+  // true if both axes have the same binning
+  bool same_binning(const TAxis* first, const TAxis* second)
+  {
+    return first->GetNbins() == second->GetNbins() && first->GetXmin() == second->GetXmin() && first->GetXmax() == second->GetXmax();
+  }
+}  // namespace
+
+//________________________________________________________
+bool TpcDistortionCorrectionGrid::build(const TH1* hDP, const TH1* hDR, const TH1* hDZ)
+{
+  clear();
+
+  const std::array<const TH1*, 3> histograms = {{hDP, hDR, hDZ}};
+
+  // find reference histogram and check binning compatibility
+  const TH1* reference = nullptr;
+  for (const auto* h : histograms)
+  {
+    if (!h)
+    {
+      continue;
+    }
+
+    if (!reference)
+    {
+      reference = h;
+      if (h->GetDimension() != 2 && h->GetDimension() != 3)
+      {
+        return false;
+      }
+    }
+    else if (h->GetDimension() != reference->GetDimension())
+    {
+      return false;
+    }
+
+    const std::array<const TAxis*, 3> axes = {{h->GetXaxis(), h->GetYaxis(), h->GetZaxis()}};
+    const std::array<const TAxis*, 3> reference_axes = {{reference->GetXaxis(), reference->GetYaxis(), reference->GetZaxis()}};
+    for (int i = 0; i < h->GetDimension(); ++i)
+    {
+      if (!is_uniform(axes[i]) || !same_binning(axes[i], reference_axes[i]))
+      {
+        return false;
+      }
+    }
+  }
+
+  if (!reference)
+  {
+    return false;
+  }
+
+  // copy axes
+  const int dimension = reference->GetDimension();
+  const std::array<const TAxis*, 3> reference_axes = {{reference->GetXaxis(), reference->GetYaxis(), reference->GetZaxis()}};
+  for (int i = 0; i < dimension; ++i)
+  {
+    auto& axis = m_axis[i];
+    axis.nbins = reference_axes[i]->GetNbins();
+    axis.min = reference_axes[i]->GetXmin();
+    axis.max = reference_axes[i]->GetXmax();
+    axis.width = (axis.max - axis.min) / axis.nbins;
+  }
+
+  // need at least two bins on each axis for interpolation
+  if (m_axis[0].nbins < 2 || m_axis[1].nbins < 2 || (dimension == 3 && m_axis[2].nbins < 2))
+  {
+    m_axis = {};
+    return false;
+  }
+
+  // copy bin contents, underflow and overflow bins are never used
+  const int nx = m_axis[0].nbins;
+  const int ny = m_axis[1].nbins;
+  const int nz = dimension == 3 ? m_axis[2].nbins : 1;
+  m_values.assign(static_cast<std::size_t>(3) * nx * ny * nz, 0);
+  for (int i = 0; i < 3; ++i)
+  {
+    const auto* h = histograms[i];
+    if (!h)
+    {
+      continue;
+    }
+    m_has[i] = true;
+
+    std::size_t index = i;
+    for (int iz = 1; iz <= nz; ++iz)
+    {
+      for (int iy = 1; iy <= ny; ++iy)
+      {
+        for (int ix = 1; ix <= nx; ++ix)
+        {
+          m_values[index] = dimension == 3 ? h->GetBinContent(ix, iy, iz) : h->GetBinContent(ix, iy);
+          index += 3;
+        }
+      }
+    }
+  }
+
+  m_dimension = dimension;
+  return true;
+}
+
+//________________________________________________________
+void TpcDistortionCorrectionGrid::clear()
+{
+  m_dimension = 0;
+  m_axis = {};
+  m_has = {{false, false, false}};
+  m_values.clear();
+}
@@ -0,0 +1,172 @@
+#ifndef TPC_TPCDISTORTIONCORRECTIONGRID_H
+#define TPC_TPCDISTORTIONCORRECTIONGRID_H
+
+/*!
+ * \file TpcDistortionCorrectionGrid.h
+ * \brief distortion correction histograms of one TPC side, resampled into a flat grid for fast interpolation
+ */
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class TH1;
+
+/*!
+ * the (dphi, dr, dz) corrections of all bins are stored next to each other in
+ * a contiguous float array, so that the three corrections of a point are
+ * obtained from a single lookup of the surrounding bins. The interpolation is
+ * the same as TH3::Interpolate and TH2::Interpolate on the source histograms,
+ * and is only done away from the first and last bin of each axis, as checked
+ * by TpcDistortionCorrection.
+ *
+ * The grid can only be built if all histograms share the same, uniform binning.
+ * It has to be rebuilt when the histograms are modified.
+ */
+class TpcDistortionCorrectionGrid
+{
+ public:
+  //! index of each correction
+  enum Coordinate
+  {
+    PHI = 0,
+    R = 1,
+    Z = 2
+  };
+
+  //! constructor
+  TpcDistortionCorrectionGrid() = default;
+
+  //! resample histograms (phi, r[, z]) into the grid. Missing histograms are allowed. Returns false if the histograms cannot be resampled
+  bool build(const TH1* /*hDP*/, const TH1* /*hDR*/, const TH1* /*hDZ*/);
+
+  //! remove grid
+  void clear();
+
+  //! true if grid was built
+  bool valid() const
+  {
+    return m_dimension > 0;
+  }
+
+  //! grid dimension, 2 or 3, or 0 if not built
+  int dimension() const
+  {
+    return m_dimension;
+  }
+
+  //! true if the correction for a given coordinate was present in the source histograms
+  bool has(Coordinate coord) const
+  {
+    return m_has[coord];
+  }
+
+  //! true if the point is away from the first and last bins of all axes, where interpolation is valid
+  bool in_range(double phi, double r, double z) const
+  {
+    return m_axis[0].in_range(phi) && m_axis[1].in_range(r) && (m_dimension < 3 || m_axis[2].in_range(z));
+  }
+
+  //! interpolate all three corrections at a given point. The point must be in range
+  void interpolate(double phi, double r, double z, std::array<double, 3>& corrections) const
+  {
+    double xd = 0;
+    double yd = 0;
+    double zd = 0;
+    const int ix = m_axis[0].lower_bin(phi, xd);
+    const int iy = m_axis[1].lower_bin(r, yd);
+    if (m_dimension == 3)
+    {
+      const int iz = m_axis[2].lower_bin(z, zd);
+      const std::size_t stride_y = 3 * m_axis[0].nbins;
+      const std::size_t stride_z = stride_y * m_axis[1].nbins;
+      const float* v000 = &m_values[iz * stride_z + iy * stride_y + 3 * ix];
+      const float* v100 = v000 + 3;
+      const float* v010 = v000 + stride_y;
+      const float* v110 = v010 + 3;
+      for (int i = 0; i < 3; ++i)
+      {
+        // same order of operations as TH3::Interpolate
+        const double i1 = v000[i] * (1 - zd) + v000[i + stride_z] * zd;
+        const double i2 = v010[i] * (1 - zd) + v010[i + stride_z] * zd;
+        const double j1 = v100[i] * (1 - zd) + v100[i + stride_z] * zd;
+        const double j2 = v110[i] * (1 - zd) + v110[i + stride_z] * zd;
+        const double w1 = i1 * (1 - yd) + i2 * yd;
+        const double w2 = j1 * (1 - yd) + j2 * yd;
+        corrections[i] = w1 * (1 - xd) + w2 * xd;
+      }
+    }
+    else
+    {
+      const std::size_t stride_y = 3 * m_axis[0].nbins;
+      const float* v00 = &m_values[iy * stride_y + 3 * ix];
+      const float* v10 = v00 + 3;
+      const float* v01 = v00 + stride_y;
+      const float* v11 = v01 + 3;
+      for (int i = 0; i < 3; ++i)
+      {
+        corrections[i] = (v00[i] * (1 - yd) + v01[i] * yd) * (1 - xd) + (v10[i] * (1 - yd) + v11[i] * yd) * xd;
+      }
+    }
+  }
+
+ private:
+  //! uniform axis
+  struct Axis
+  {
+    int nbins = 0;
+    double min = 0;
+    double max = 0;
+    double width = 1;
+
+    //! same as TAxis::FindBin
+    int find_bin(double value) const
+    {
+      if (value < min)
+      {
+        return 0;
+      }
+      if (!(value < max))
+      {
+        return nbins + 1;
+      }
+      return 1 + int(nbins * (value - min) / (max - min));
+    }
+
+    //! same check as in TpcDistortionCorrection: not in the first and last bin
+    bool in_range(double value) const
+    {
+      const int bin = find_bin(value);
+      return bin >= 2 && bin < nbins;
+    }
+
+    //! zero based index of the bin whose center is just below value, and fraction of the way to the next bin center
+    int lower_bin(double value, double& fraction) const
+    {
+      int bin = find_bin(value);
+      if (value < center(bin))
+      {
+        --bin;
+      }
+      fraction = (value - center(bin)) / (center(bin + 1) - center(bin));
+      return bin - 1;
+    }
+
+    //! same as TAxis::GetBinCenter for uniform binning
+    double center(int bin) const
+    {
+      return min + (bin - 0.5) * width;
+    }
+  };
+
+  int m_dimension = 0;
+
+  std::array<Axis, 3> m_axis = {};
+
+  std::array<bool, 3> m_has = {{false, false, false}};
+
+  //! (dphi, dr, dz) for all bins, phi bins first, then r bins, then z bins
+  std::vector<float> m_values;
+};
+
+#endif
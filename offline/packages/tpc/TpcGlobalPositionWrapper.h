@@ -10,6 +10,8 @@
 
 #include <trackbase/TrkrDefs.h>
 
+#include <vector>
+
 
 class ActsGeometry;
 class PHCompositeNode;
@@ -51,6 +53,13 @@ class TpcGlobalPositionWrapper
   //! apply all loaded distortion corrections to a given position
   Acts::Vector3 applyDistortionCorrections( Acts::Vector3 /*source*/ ) const;
 
+  //! apply all loaded distortion corrections to many positions, in place
+  /**
+   * each correction is applied to all positions before moving to the next,
+   * so that only one correction grid is accessed at a time
+   */
+  void applyDistortionCorrections( std::vector<Acts::Vector3>& /*positions*/ ) const;
+
   //! get distortion corrected global position from cluster
   /**
    * first converts cluster position local coordinate to global coordinates
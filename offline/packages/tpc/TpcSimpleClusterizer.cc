@@ -38,6 +38,7 @@
 #include <cmath>  // for sqrt, cos, sin
 #include <iostream>
 #include <map>  // for _Rb_tree_cons...
+#include <memory>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
@@ -606,7 +607,7 @@ int TpcSimpleClusterizer::process_event(PHCompositeNode *topNode)
       auto *cluster = data.cluster_vector[index];
 
       // insert in map
-      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
+      m_clusterlist->addCluster(ckey, std::unique_ptr<TrkrCluster>(cluster));
     }
 
     // copy hit associations to map
@@ -0,0 +1,162 @@
+#ifndef TRACKBASE_PIXELCLUSTERFINDER_H
+#define TRACKBASE_PIXELCLUSTERFINDER_H
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+//! connected component clustering of the hits of one silicon sensor
+/*!
+  Hits are given as (first, second) bin pairs, e.g. (column, row). Two hits
+  are neighbours if their first bins differ by at most max_first and their
+  second bins by at most max_second. The hits are sorted by (first, second)
+  once, each hit only looks up its neighbours in the current and preceding
+  max_first bins of first, and neighbours are merged with a union-find. This
+  replaces the pairwise adjacency test of all hits and the boost graph.
+
+  The clusters are numbered in the order of their first hit in the input, and
+  the hits of each cluster are listed in input order, the same numbering as
+  boost::connected_components on the full adjacency graph. The output is kept
+  in flat arrays which are reused from one sensor to the next.
+*/
+class PixelClusterFinder
+{
+ public:
+  //! set the neighbour distance in each direction
+  void set_max_distance(const int max_first, const int max_second)
+  {
+    m_max_first = max_first;
+    m_max_second = max_second;
+  }
+
+  //! remove all hits
+  void clear()
+  {
+    m_hits.clear();
+  }
+
+  //! add a hit, its index is the number of hits added before
+  void add_hit(const int first, const int second)
+  {
+    m_hits.push_back({first, second, static_cast<unsigned int>(m_hits.size())});
+  }
+
+  //! find the clusters of the hits added since the last clear
+  void find_clusters()
+  {
+    const unsigned int nhits = m_hits.size();
+    m_parent.resize(nhits);
+    std::iota(m_parent.begin(), m_parent.end(), 0U);
+
+    m_sorted = m_hits;
+    std::sort(m_sorted.begin(), m_sorted.end());
+
+    for (unsigned int i = 0; i < nhits; ++i)
+    {
+      const Hit &hit = m_sorted[i];
+      for (int dfirst = 0; dfirst <= m_max_first; ++dfirst)
+      {
+        // hits with a lower first bin, or the same first bin and a lower second bin
+        const Hit low{hit.first - dfirst, hit.second - m_max_second, 0};
+        auto iter = std::lower_bound(m_sorted.begin(), m_sorted.begin() + i, low);
+        for (; iter != m_sorted.begin() + i && iter->first == low.first; ++iter)
+        {
+          if (iter->second > hit.second + m_max_second)
+          {
+            break;
+          }
+          unite(iter->index, hit.index);
+        }
+      }
+    }
+
+    // number the clusters by their first hit and list their hits in input order
+    m_cluster_id.assign(nhits, -1);
+    m_hit_cluster.resize(nhits);
+    m_cluster_size.clear();
+    for (unsigned int i = 0; i < nhits; ++i)
+    {
+      const unsigned int root = find(i);
+      if (m_cluster_id[root] < 0)
+      {
+        m_cluster_id[root] = m_cluster_size.size();
+        m_cluster_size.push_back(0);
+      }
+      m_hit_cluster[i] = m_cluster_id[root];
+      ++m_cluster_size[m_hit_cluster[i]];
+    }
+
+    m_offsets.resize(m_cluster_size.size() + 1);
+    m_offsets[0] = 0;
+    for (unsigned int c = 0; c < m_cluster_size.size(); ++c)
+    {
+      m_offsets[c + 1] = m_offsets[c] + m_cluster_size[c];
+    }
+    m_cluster_hits.resize(nhits);
+    m_fill.assign(m_offsets.begin(), m_offsets.end() - 1);
+    for (unsigned int i = 0; i < nhits; ++i)
+    {
+      m_cluster_hits[m_fill[m_hit_cluster[i]]++] = i;
+    }
+  }
+
+  //! number of clusters found
+  unsigned int nclusters() const { return m_cluster_size.size(); }
+
+  //! cluster of a given hit
+  int cluster(const unsigned int hit) const { return m_hit_cluster[hit]; }
+
+  //! hit indices of a cluster, in input order
+  const unsigned int *begin(const unsigned int cluster) const { return m_cluster_hits.data() + m_offsets[cluster]; }
+  const unsigned int *end(const unsigned int cluster) const { return m_cluster_hits.data() + m_offsets[cluster + 1]; }
+
+ private:
+  struct Hit
+  {
+    int first{0};
+    int second{0};
+    unsigned int index{0};
+
+    bool operator<(const Hit &other) const
+    {
+      return first < other.first || (first == other.first && second < other.second);
+    }
+  };
+
+  unsigned int find(unsigned int i)
+  {
+    while (m_parent[i] != i)
+    {
+      // path halving
+      m_parent[i] = m_parent[m_parent[i]];
+      i = m_parent[i];
+    }
+    return i;
+  }
+
+  void unite(const unsigned int a, const unsigned int b)
+  {
+    const unsigned int ra = find(a);
+    const unsigned int rb = find(b);
+    if (ra != rb)
+    {
+      // keep the lowest index as root
+      m_parent[std::max(ra, rb)] = std::min(ra, rb);
+    }
+  }
+
+  int m_max_first{1};
+  int m_max_second{1};
+
+  std::vector<Hit> m_hits;
+  std::vector<Hit> m_sorted;
+  std::vector<unsigned int> m_parent;
+  std::vector<int> m_cluster_id;
+  std::vector<int> m_hit_cluster;
+  std::vector<unsigned int> m_cluster_size;
+  std::vector<unsigned int> m_offsets;
+  std::vector<unsigned int> m_cluster_hits;
+  std::vector<unsigned int> m_fill;
+};
+
+#endif
@@ -4,12 +4,19 @@
  * @date June 2018
  */
 #include "TrkrClusterContainer.h"
+#include "TrkrCluster.h"
 
 namespace
 {
   TrkrClusterContainer::Map dummy_map;
 }
 
+//__________________________________________________________
+void TrkrClusterContainer::addCluster(const TrkrDefs::cluskey key, std::unique_ptr<TrkrCluster> cluster)
+{
+  addClusterSpecifyKey(key, cluster.release());
+}
+
 //__________________________________________________________
 TrkrClusterContainer::ConstRange TrkrClusterContainer::getClusters() const
 {
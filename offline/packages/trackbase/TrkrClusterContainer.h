@@ -14,6 +14,7 @@
 
 #include <iostream>  // for cout, ostream
 #include <map>
+#include <memory>
 #include <utility>  // for pair
 
 class TrkrCluster;
@@ -45,6 +46,10 @@ class TrkrClusterContainer : public PHObject
   //! add a cluster with specific key
   virtual void addClusterSpecifyKey(const TrkrDefs::cluskey, TrkrCluster*) {}
 
+  //! add a cluster with specific key, taking ownership
+  /*! column oriented containers copy the cluster fields and delete the cluster. Defaults to addClusterSpecifyKey */
+  virtual void addCluster(const TrkrDefs::cluskey, std::unique_ptr<TrkrCluster>);
+
   //! remove cluster
   virtual void removeCluster(TrkrDefs::cluskey) {}
 
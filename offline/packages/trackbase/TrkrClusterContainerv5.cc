@@ -0,0 +1,397 @@
+/**
+ * @file trackbase/TrkrClusterContainerv5.cc
+ * @brief Implementation of TrkrClusterContainerv5
+ */
+#include "TrkrClusterContainerv5.h"
+#include "TrkrCluster.h"
+#include "TrkrClusterv5.h"
+#include "TrkrDefs.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace
+{
+  TrkrClusterContainer::Map dummy_map;
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::Columns::resize(unsigned int size)
+{
+  localx.resize(size, NAN);
+  localy.resize(size, NAN);
+  phierr.resize(size, 0);
+  zerr.resize(size, 0);
+  subsurfkey.resize(size, TrkrDefs::SUBSURFKEYMAX);
+  adc.resize(size, 0);
+  maxadc.resize(size, 0);
+  phisize.resize(size, 0);
+  zsize.resize(size, 0);
+  overlap.resize(size, 0);
+  edge.resize(size, 0);
+  valid.resize(size, 0);
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::Columns::set(unsigned int index, const TrkrCluster& cluster)
+{
+  // same fields as TrkrClusterv5::CopyFrom
+  localx[index] = cluster.getLocalX();
+  localy[index] = cluster.getLocalY();
+  phierr[index] = cluster.getRPhiError();
+  zerr[index] = cluster.getZError();
+  subsurfkey[index] = cluster.getSubSurfKey();
+  adc[index] = cluster.getAdc();
+  maxadc[index] = cluster.getMaxAdc();
+  phisize[index] = cluster.getPhiSize();
+  zsize[index] = cluster.getZSize();
+  overlap[index] = cluster.getOverlap();
+  edge[index] = cluster.getEdge();
+  valid[index] = 1;
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::ClusterRef::identify(std::ostream& os) const
+{
+  os << "---TrkrClusterContainerv5::ClusterRef---------" << std::endl;
+
+  os << " (rphi,z) =  (" << getLocalX();
+  os << ", " << getLocalY() << ") cm ";
+
+  os << " valid = " << isValid() << std::endl;
+
+  os << std::endl;
+  os << "-----------------------------------------------" << std::endl;
+}
+
+//_________________________________________________________________
+int TrkrClusterContainerv5::ClusterRef::isValid() const
+{
+  // same as TrkrClusterv5::isValid
+  if (std::isnan(getLocalX()) || std::isnan(getLocalY()))
+  {
+    return 0;
+  }
+  if (getAdc() == 0xFFFF)
+  {
+    return 0;
+  }
+  return 1;
+}
+
+//_________________________________________________________________
+PHObject* TrkrClusterContainerv5::ClusterRef::CloneMe() const
+{
+  auto cluster = new TrkrClusterv5;
+  cluster->CopyFrom(*this);
+  return cluster;
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::Reset()
+{
+  // clear the columns
+  /* using swap ensures that the memory is properly de-allocated */
+  {
+    std::vector<TrkrDefs::hitsetkey> empty;
+    m_hitsetkeys.swap(empty);
+  }
+
+  {
+    Columns::List empty;
+    m_columns.swap(empty);
+  }
+
+  // also clear transient clusters and temporary map
+  m_refs.clear();
+  m_refs_complete = false;
+
+  {
+    Map empty;
+    m_tmpmap.swap(empty);
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::identify(std::ostream& os) const
+{
+  os << "-----TrkrClusterContainerv5-----" << std::endl;
+  os << "Number of clusters: " << size() << std::endl;
+
+  for (size_t i = 0; i < m_hitsetkeys.size(); ++i)
+  {
+    const auto& hitsetkey = m_hitsetkeys[i];
+    const auto& columns = m_columns[i];
+    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+    os << "layer: " << layer << " hitsetkey: " << hitsetkey << std::endl;
+
+    for (unsigned int index = 0; index < columns.size(); ++index)
+    {
+      if (columns.has(index))
+      {
+        os << " index: " << index
+           << " (rphi,z) = (" << columns.localx[index] << ", " << columns.localy[index] << ") cm"
+           << " adc: " << columns.adc[index] << std::endl;
+      }
+    }
+  }
+
+  os << "------------------------------" << std::endl;
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::removeCluster(TrkrDefs::cluskey key)
+{
+  // find relevant columns if any and invalidate corresponding cluster
+  auto columns = find_columns(TrkrDefs::getHitSetKeyFromClusKey(key));
+  if (columns)
+  {
+    // cluster index in columns
+    const auto index = TrkrDefs::getClusIndex(key);
+    if (index < columns->size())
+    {
+      columns->valid[index] = 0;
+    }
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::removeClusters(TrkrDefs::hitsetkey hitsetkey)
+{
+  // find matching columns
+  const auto iter = std::lower_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), hitsetkey);
+
+  // do nothing if not found
+  if (iter == m_hitsetkeys.end() || *iter != hitsetkey)
+  {
+    return;
+  }
+
+  // remove columns and hitset key
+  const auto position = iter - m_hitsetkeys.begin();
+  m_columns.erase(m_columns.begin() + position);
+  m_hitsetkeys.erase(iter);
+
+  // remove the transient clusters of this hitset, and update the others since the columns moved
+  if (m_refs_complete)
+  {
+    m_refs.erase(m_refs.begin() + position);
+    update_refs();
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::addClusterSpecifyKey(const TrkrDefs::cluskey key, TrkrCluster* /*newclus*/)
+{
+  // the caller would keep a pointer to a cluster that is not the stored one,
+  // and changes made through it would be lost
+  std::cout << "TrkrClusterContainerv5::addClusterSpecifyKey: not supported, use addCluster. key: " << key << " exiting now" << std::endl;
+  exit(1);
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::addCluster(const TrkrDefs::cluskey key, std::unique_ptr<TrkrCluster> cluster)
+{
+  addCluster(key, *cluster);
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::addCluster(TrkrDefs::cluskey key, const TrkrCluster& cluster)
+{
+  // get hitsetkey from cluster
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+
+  // find relevant columns or create them if not found
+  auto iter = std::lower_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), hitsetkey);
+  const auto position = iter - m_hitsetkeys.begin();
+  if (iter == m_hitsetkeys.end() || *iter != hitsetkey)
+  {
+    m_hitsetkeys.insert(iter, hitsetkey);
+    m_columns.insert(m_columns.begin() + position, Columns());
+
+    // the columns moved, update the transient clusters
+    if (m_refs_complete)
+    {
+      m_refs.insert(m_refs.begin() + position, std::vector<ClusterRef>());
+      update_refs();
+    }
+  }
+  auto& columns = m_columns[position];
+
+  // get cluster index in columns
+  const auto index = TrkrDefs::getClusIndex(key);
+
+  if (columns.has(index))
+  {
+    std::cout << "TrkrClusterContainerv5::AddClusterSpecifyKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+
+  // resize columns if needed, the missing indices are left invalid
+  if (index >= columns.size())
+  {
+    columns.resize(index + 1);
+  }
+
+  // copy the cluster
+  columns.set(index, cluster);
+
+  // keep the transient clusters complete once they have been created
+  if (m_refs_complete)
+  {
+    fill_refs(position);
+  }
+}
+
+//_________________________________________________________________
+TrkrClusterContainerv5::ConstRange
+TrkrClusterContainerv5::getClusters() const
+{
+  std::cout << "deprecated function in TrkrClusterContainerv5, user getClusters(TrkrDefs:hitsetkey)"
+            << std::endl;
+  return std::make_pair(dummy_map.begin(), dummy_map.begin());
+}
+
+//_________________________________________________________________
+TrkrClusterContainerv5::ConstRange
+TrkrClusterContainerv5::getClusters(TrkrDefs::hitsetkey hitsetkey)
+{
+  // clear temporary map
+  {
+    Map empty;
+    m_tmpmap.swap(empty);
+  }
+
+  // find relevant columns
+  const auto columns = find_columns(hitsetkey);
+  if (columns)
+  {
+    for (unsigned int index = 0; index < columns->size(); ++index)
+    {
+      if (columns->has(index))
+      {
+        // generate cluster key from hitset and index
+        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+
+        // insert in map
+        m_tmpmap.insert(m_tmpmap.end(), std::make_pair(ckey, findCluster(ckey)));
+      }
+    }
+  }
+
+  // return temporary map range
+  return std::make_pair(m_tmpmap.cbegin(), m_tmpmap.cend());
+}
+
+//_________________________________________________________________
+TrkrCluster* TrkrClusterContainerv5::findCluster(TrkrDefs::cluskey key) const
+{
+  const int position = find_position(TrkrDefs::getHitSetKeyFromClusKey(key));
+  const auto index = TrkrDefs::getClusIndex(key);
+  if (position < 0 || !m_columns[position].has(index))
+  {
+    return nullptr;
+  }
+
+  // the transient clusters are created once for all hitsets, at first access.
+  // Past that point this is a plain lookup, which is safe from several threads
+  if (!m_refs_complete.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(m_refs_mutex);
+    if (!m_refs_complete.load(std::memory_order_relaxed))
+    {
+      make_refs();
+      m_refs_complete.store(true, std::memory_order_release);
+    }
+  }
+
+  // check the transient clusters against the columns, which may have been changed without them
+  if (static_cast<size_t>(position) >= m_refs.size() || index >= m_refs[position].size())
+  {
+    return nullptr;
+  }
+
+  return &m_refs[position][index];
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::make_refs() const
+{
+  m_refs.clear();
+  m_refs.resize(m_columns.size());
+  for (unsigned int position = 0; position < m_columns.size(); ++position)
+  {
+    fill_refs(position);
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::fill_refs(unsigned int position) const
+{
+  // one transient cluster per index, including missing or removed clusters,
+  // so that the cluster index is also the index in the vector
+  auto* columns = const_cast<Columns*>(&m_columns[position]);
+  auto& refs = m_refs[position];
+  refs.reserve(columns->size());
+  for (unsigned int index = refs.size(); index < columns->size(); ++index)
+  {
+    refs.emplace_back(columns, index);
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::update_refs() const
+{
+  for (unsigned int position = 0; position < m_refs.size(); ++position)
+  {
+    auto* columns = const_cast<Columns*>(&m_columns[position]);
+    for (auto& ref : m_refs[position])
+    {
+      ref.m_columns = columns;
+    }
+  }
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys() const
+{
+  return m_hitsetkeys;
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys(const TrkrDefs::TrkrId trackerid) const
+{
+  /* copy the logic from TrkrHitSetContainerv1::getHitSets */
+  const TrkrDefs::hitsetkey keylo = TrkrDefs::getHitSetKeyLo(trackerid);
+  const TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid);
+
+  // get relevant range in the sorted keys
+  const auto begin = std::lower_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), keylo);
+  const auto end = std::upper_bound(begin, m_hitsetkeys.end(), keyhi);
+  return HitSetKeyList(begin, end);
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys(const TrkrDefs::TrkrId trackerid, const uint8_t layer) const
+{
+  /* copy the logic from TrkrHitSetContainerv1::getHitSets */
+  const TrkrDefs::hitsetkey keylo = TrkrDefs::getHitSetKeyLo(trackerid, layer);
+  const TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid, layer);
+
+  // get relevant range in the sorted keys
+  const auto begin = std::lower_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), keylo);
+  const auto end = std::upper_bound(begin, m_hitsetkeys.end(), keyhi);
+  return HitSetKeyList(begin, end);
+}
+
+//_________________________________________________________________
+unsigned int TrkrClusterContainerv5::size() const
+{
+  unsigned int size = 0;
+  for (const auto& columns : m_columns)
+  {
+    size += std::accumulate(columns.valid.begin(), columns.valid.end(), 0U);
+  }
+  return size;
+}
@@ -0,0 +1,248 @@
+#ifndef TRACKBASE_TRKRCLUSTERCONTAINERV5_H
+#define TRACKBASE_TRKRCLUSTERCONTAINERV5_H
+
+/**
+ * @file trackbase/TrkrClusterContainerv5.h
+ * @brief Column oriented cluster container
+ */
+
+#include "TrkrCluster.h"
+#include "TrkrClusterContainer.h"
+#include "TrkrDefs.h"
+
+#include <phool/PHObject.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Column oriented cluster container
+ *
+ * The clusters of each hitset are stored as one array per cluster field
+ * (same fields as TrkrClusterv5), indexed by the cluster index of the cluster key.
+ * The hitsets are kept in a vector sorted by hitset key. There is no
+ * allocation per cluster, and the arrays are written to the output as such.
+ *
+ * Loops over many clusters should use getColumns, or the non virtual accessors
+ * taking a cluster key. findCluster and getClusters return transient
+ * TrkrCluster objects which read and write the columns, for compatibility with
+ * the TrkrClusterContainer interface. These are stored in one vector per hitset,
+ * indexed as the columns, and remain valid until clusters are added to or removed
+ * from the same hitset, or the container is reset.
+ *
+ * The transient clusters of all hitsets are created at the first call to findCluster,
+ * under a lock, so that findCluster can be called from several threads at once.
+ * Clusters must not be added or removed meanwhile.
+ *
+ * Clusters are added with addCluster. addClusterSpecifyKey is not supported,
+ * since the container keeps no cluster object.
+ */
+class TrkrClusterContainerv5 : public TrkrClusterContainer
+{
+ public:
+  //! clusters of one hitset
+  /*! do not modify and commit: this will break reading past DSTs */
+  class Columns
+  {
+   public:
+    using List = std::vector<Columns>;
+
+    //! number of cluster indices, including missing or removed clusters
+    unsigned int size() const { return valid.size(); }
+
+    //! true if there is a cluster at a given index
+    bool has(const unsigned int index) const { return index < valid.size() && valid[index]; }
+
+    //! resize all columns
+    void resize(unsigned int);
+
+    //! copy cluster fields at a given index
+    void set(unsigned int /*index*/, const TrkrCluster&);
+
+    //!@name cluster fields
+    //@{
+    std::vector<float> localx;
+    std::vector<float> localy;
+    std::vector<float> phierr;
+    std::vector<float> zerr;
+    std::vector<TrkrDefs::subsurfkey> subsurfkey;
+    std::vector<unsigned short> adc;
+    std::vector<unsigned short> maxadc;
+    std::vector<char> phisize;
+    std::vector<char> zsize;
+    std::vector<char> overlap;
+    std::vector<char> edge;
+    //@}
+
+    //! 1 if there is a cluster at a given index, 0 otherwise
+    std::vector<unsigned char> valid;
+  };
+
+  //! transient cluster, reading and writing the columns of a container
+  class ClusterRef : public TrkrCluster
+  {
+   public:
+    ClusterRef(Columns* columns, unsigned int index)
+      : m_columns(columns)
+      , m_index(index)
+    {
+    }
+
+    void identify(std::ostream& os = std::cout) const override;
+    int isValid() const override;
+
+    //! returns a TrkrClusterv5 copy
+    PHObject* CloneMe() const override;
+
+    float getPosition(int coor) const override { return coor == 0 ? getLocalX() : getLocalY(); }
+    void setPosition(int coor, float xi) override { (coor == 0 ? m_columns->localx : m_columns->localy)[m_index] = xi; }
+    float getLocalX() const override { return m_columns->localx[m_index]; }
+    void setLocalX(float loc0) override { m_columns->localx[m_index] = loc0; }
+    float getLocalY() const override { return m_columns->localy[m_index]; }
+    void setLocalY(float loc1) override { m_columns->localy[m_index] = loc1; }
+
+    TrkrDefs::subsurfkey getSubSurfKey() const override { return m_columns->subsurfkey[m_index]; }
+    void setSubSurfKey(TrkrDefs::subsurfkey id) override { m_columns->subsurfkey[m_index] = id; }
+
+    unsigned int getAdc() const override { return m_columns->adc[m_index]; }
+    void setAdc(unsigned int adc) override { m_columns->adc[m_index] = adc; }
+    unsigned int getMaxAdc() const override { return m_columns->maxadc[m_index]; }
+    void setMaxAdc(uint16_t maxadc) override { m_columns->maxadc[m_index] = maxadc; }
+
+    float getRPhiError() const override { return m_columns->phierr[m_index]; }
+    float getZError() const override { return m_columns->zerr[m_index]; }
+
+    char getSize() const override { return m_columns->phisize[m_index] * m_columns->zsize[m_index]; }
+    float getPhiSize() const override { return (float) m_columns->phisize[m_index]; }
+    float getZSize() const override { return (float) m_columns->zsize[m_index]; }
+
+    char getOverlap() const override { return m_columns->overlap[m_index]; }
+    void setOverlap(char overlap) override { m_columns->overlap[m_index] = overlap; }
+    char getEdge() const override { return m_columns->edge[m_index]; }
+    void setEdge(char edge) override { m_columns->edge[m_index] = edge; }
+
+   private:
+    friend class TrkrClusterContainerv5;
+
+    //! columns of the cluster hitset. Updated by the container when hitsets are added or removed
+    Columns* m_columns = nullptr;
+    unsigned int m_index = 0;
+  };
+
+  TrkrClusterContainerv5() = default;
+
+  /**
+   * remove all stored clusters
+   * effectively leaving the container empty
+   */
+  void Reset() override;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  //! not supported, since no cluster object is kept. Use addCluster
+  void addClusterSpecifyKey(const TrkrDefs::cluskey, TrkrCluster*) override;
+
+  //! copy the cluster fields into the columns, and delete the cluster
+  void addCluster(const TrkrDefs::cluskey, std::unique_ptr<TrkrCluster>) override;
+
+  //! copy the cluster fields into the columns. The container does not take ownership of the cluster
+  void addCluster(TrkrDefs::cluskey, const TrkrCluster&);
+
+  //! remove cluster matching a given cluster key
+  void removeCluster(TrkrDefs::cluskey) override;
+
+  //! remove all the clusters matching a given key
+  void removeClusters(TrkrDefs::hitsetkey) override;
+
+  ConstRange getClusters() const override;  // deprecated
+
+  ConstRange getClusters(TrkrDefs::hitsetkey) override;
+
+  TrkrCluster* findCluster(TrkrDefs::cluskey) const override;
+
+  HitSetKeyList getHitSetKeys() const override;
+
+  HitSetKeyList getHitSetKeys(const TrkrDefs::TrkrId) const override;
+
+  HitSetKeyList getHitSetKeys(const TrkrDefs::TrkrId, const uint8_t /* layer */) const override;
+
+  unsigned int size(void) const override;
+
+  //! columns of a given hitset, nullptr if not found. The pointer is invalidated when clusters are added or removed
+  const Columns* getColumns(TrkrDefs::hitsetkey hitsetkey) const
+  {
+    return const_cast<TrkrClusterContainerv5*>(this)->find_columns(hitsetkey);
+  }
+
+  //!@name non virtual access to the fields of a single cluster. The cluster must exist
+  //@{
+  float getLocalX(TrkrDefs::cluskey key) const { return column(key).localx[TrkrDefs::getClusIndex(key)]; }
+  float getLocalY(TrkrDefs::cluskey key) const { return column(key).localy[TrkrDefs::getClusIndex(key)]; }
+  float getRPhiError(TrkrDefs::cluskey key) const { return column(key).phierr[TrkrDefs::getClusIndex(key)]; }
+  float getZError(TrkrDefs::cluskey key) const { return column(key).zerr[TrkrDefs::getClusIndex(key)]; }
+  TrkrDefs::subsurfkey getSubSurfKey(TrkrDefs::cluskey key) const { return column(key).subsurfkey[TrkrDefs::getClusIndex(key)]; }
+  unsigned int getAdc(TrkrDefs::cluskey key) const { return column(key).adc[TrkrDefs::getClusIndex(key)]; }
+  //@}
+
+  //! true if there is a cluster matching a given key
+  bool hasCluster(TrkrDefs::cluskey key) const
+  {
+    const auto columns = getColumns(TrkrDefs::getHitSetKeyFromClusKey(key));
+    return columns && columns->has(TrkrDefs::getClusIndex(key));
+  }
+
+ private:
+  //! position of a given hitset in m_hitsetkeys, or -1 if not found
+  int find_position(TrkrDefs::hitsetkey hitsetkey) const
+  {
+    const auto iter = std::lower_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), hitsetkey);
+    return (iter != m_hitsetkeys.end() && *iter == hitsetkey) ? iter - m_hitsetkeys.begin() : -1;
+  }
+
+  //! columns of a given hitset, nullptr if not found
+  Columns* find_columns(TrkrDefs::hitsetkey hitsetkey)
+  {
+    const int position = find_position(hitsetkey);
+    return position < 0 ? nullptr : &m_columns[position];
+  }
+
+  //! columns of the hitset of a given cluster, which must exist
+  const Columns& column(TrkrDefs::cluskey key) const
+  {
+    return *getColumns(TrkrDefs::getHitSetKeyFromClusKey(key));
+  }
+
+  //! create the transient clusters of all hitsets
+  void make_refs() const;
+
+  //! create the missing transient clusters of the hitset at a given position
+  void fill_refs(unsigned int /*position*/) const;
+
+  //! point the transient clusters to their columns, after hitsets are added or removed
+  void update_refs() const;
+
+  //! hitset keys, sorted
+  std::vector<TrkrDefs::hitsetkey> m_hitsetkeys;
+
+  //! clusters of each hitset, same order as m_hitsetkeys
+  Columns::List m_columns;
+
+  //! transient clusters returned by findCluster and getClusters, same order and indices as m_columns
+  mutable std::vector<std::vector<ClusterRef>> m_refs;  //! transient
+
+  //! true when m_refs holds all clusters. Set by the first findCluster, cleared by Reset and when reading
+  mutable std::atomic<bool> m_refs_complete{false};  //! transient
+
+  //! protects the creation of the transient clusters
+  mutable std::mutex m_refs_mutex;  //! transient
+
+  //! temporary map returned by getClusters
+  Map m_tmpmap;  //! transient. The temporary map does not get written to the output
+
+  ClassDefOverride(TrkrClusterContainerv5, 1)
+};
+
+#endif  // TRACKBASE_TRKRCLUSTERCONTAINERV5_H
@@ -0,0 +1,9 @@
+#ifdef __CINT__
+
+#pragma link C++ class TrkrClusterContainerv5 + ;
+#pragma link C++ class TrkrClusterContainerv5::Columns + ;
+
+// the transient clusters point to the columns, which are replaced when reading
+#pragma read sourceClass="TrkrClusterContainerv5" targetClass="TrkrClusterContainerv5" version="[1-]" source="" target="m_refs_complete" code="{ m_refs_complete = false; }"
+
+#endif /* __CINT__ */
@@ -0,0 +1,154 @@
+/**
+ * @file trackbase/TrkrHitSetContainerv3.cc
+ * @brief Implementation for TrkrHitSetContainerv3
+ */
+#include "TrkrHitSetContainerv3.h"
+
+#include "TrkrDefs.h"
+#include "TrkrHitSetv2.h"
+
+#include <cstdlib>
+
+TrkrHitSetContainerv3::~TrkrHitSetContainerv3()
+{
+  for (auto&& [key, hitset] : m_hitmap)
+  {
+    delete hitset;
+  }
+
+  for (auto&& hitset : m_pool)
+  {
+    delete hitset;
+  }
+}
+
+void TrkrHitSetContainerv3::release(TrkrHitSet* hitset)
+{
+  if (dynamic_cast<TrkrHitSetv2*>(hitset))
+  {
+    hitset->Reset();
+    m_pool.push_back(hitset);
+  }
+  else
+  {
+    delete hitset;
+  }
+}
+
+void TrkrHitSetContainerv3::Reset()
+{
+  for (auto&& [key, hitset] : m_hitmap)
+  {
+    release(hitset);
+  }
+
+  m_hitmap.clear();
+}
+
+void TrkrHitSetContainerv3::identify(std::ostream& os) const
+{
+  os << "Number of hits: " << size() << std::endl;
+  for (const auto& pair : m_hitmap)
+  {
+    int layer = TrkrDefs::getLayer(pair.first);
+    os << "hitsetkey " << pair.first << " layer " << layer << std::endl;
+    pair.second->identify();
+  }
+  return;
+}
+
+TrkrHitSetContainerv3::ConstIterator
+TrkrHitSetContainerv3::addHitSet(TrkrHitSet* newhit)
+{
+  return addHitSetSpecifyKey(newhit->getHitSetKey(), newhit);
+}
+
+TrkrHitSetContainerv3::ConstIterator
+TrkrHitSetContainerv3::addHitSetSpecifyKey(const TrkrDefs::hitsetkey key, TrkrHitSet* newhit)
+{
+  const auto ret = m_hitmap.insert(std::make_pair(key, newhit));
+  if (!ret.second)
+  {
+    std::cout << "TrkrHitSetContainerv3::AddHitSpecifyKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+  else
+  {
+    return ret.first;
+  }
+}
+
+void TrkrHitSetContainerv3::removeHitSet(TrkrDefs::hitsetkey key)
+{
+  auto iter = m_hitmap.find(key);
+  if (iter != m_hitmap.end())
+  {
+    release(iter->second);
+    m_hitmap.erase(iter);
+  }
+}
+
+void TrkrHitSetContainerv3::removeHitSet(TrkrHitSet* hitset)
+{
+  removeHitSet(hitset->getHitSetKey());
+}
+
+TrkrHitSetContainerv3::ConstRange
+TrkrHitSetContainerv3::getHitSets(const TrkrDefs::TrkrId trackerid) const
+{
+  const TrkrDefs::hitsetkey keylo = TrkrDefs::getHitSetKeyLo(trackerid);
+  const TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid);
+  return std::make_pair(m_hitmap.lower_bound(keylo), m_hitmap.upper_bound(keyhi));
+}
+
+TrkrHitSetContainerv3::ConstRange
+TrkrHitSetContainerv3::getHitSets(const TrkrDefs::TrkrId trackerid, const uint8_t layer) const
+{
+  const TrkrDefs::hitsetkey keylo = TrkrDefs::getHitSetKeyLo(trackerid, layer);
+  const TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid, layer);
+  return std::make_pair(m_hitmap.lower_bound(keylo), m_hitmap.upper_bound(keyhi));
+}
+
+TrkrHitSetContainerv3::ConstRange
+TrkrHitSetContainerv3::getHitSets() const
+{
+  return std::make_pair(m_hitmap.cbegin(), m_hitmap.cend());
+}
+
+TrkrHitSetContainerv3::Iterator
+TrkrHitSetContainerv3::findOrAddHitSet(TrkrDefs::hitsetkey key)
+{
+  auto it = m_hitmap.lower_bound(key);
+  if (it == m_hitmap.end() || (key < it->first))
+  {
+    // reuse a hitset from the pool if any
+    TrkrHitSet* hitset = nullptr;
+    if (m_pool.empty())
+    {
+      hitset = new TrkrHitSetv2;
+    }
+    else
+    {
+      hitset = m_pool.back();
+      m_pool.pop_back();
+    }
+
+    it = m_hitmap.insert(it, std::make_pair(key, hitset));
+    it->second->setHitSetKey(key);
+  }
+  return it;
+}
+
+TrkrHitSet*
+TrkrHitSetContainerv3::findHitSet(TrkrDefs::hitsetkey key)
+{
+  auto it = m_hitmap.find(key);
+  if (it != m_hitmap.end())
+  {
+    return it->second;
+  }
+  else
+  {
+    return nullptr;
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef TRACKBASE_TRKRHITSETCONTAINERV3_H
+#define TRACKBASE_TRKRHITSETCONTAINERV3_H
+/**
+ * @file trackbase/TrkrHitSetContainerv3.h
+ * @brief Container for TrkrHitSetv2 objects, reused from one event to the next
+ */
+
+#include "TrkrDefs.h"
+#include "TrkrHitSetContainer.h"
+
+#include <iostream>  // for cout, ostream
+#include <map>
+#include <utility>  // for pair
+#include <vector>
+
+class TrkrHitSet;
+
+/**
+ * Container for TrkrHitSet objects
+ *
+ * Same as TrkrHitSetContainerv1, except that findOrAddHitSet creates TrkrHitSetv2
+ * objects, and that these are kept in a pool when removed or when the container is reset,
+ * rather than deleted. The next events reuse them together with the memory of their hits.
+ * Hitsets of other types are deleted as in TrkrHitSetContainerv1.
+ */
+class TrkrHitSetContainerv3 : public TrkrHitSetContainer
+{
+ public:
+  TrkrHitSetContainerv3() = default;
+
+  ~TrkrHitSetContainerv3() override;
+
+  //! remove all hitsets, moving them to the pool
+  void Reset() override;
+
+  void identify(std::ostream& = std::cout) const override;
+
+  ConstIterator addHitSet(TrkrHitSet*) override;
+
+  ConstIterator addHitSetSpecifyKey(const TrkrDefs::hitsetkey, TrkrHitSet*) override;
+
+  void removeHitSet(TrkrDefs::hitsetkey) override;
+
+  void removeHitSet(TrkrHitSet*) override;
+
+  Iterator findOrAddHitSet(TrkrDefs::hitsetkey key) override;
+
+  ConstRange getHitSets(const TrkrDefs::TrkrId trackerid) const override;
+
+  ConstRange getHitSets(const TrkrDefs::TrkrId trackerid, const uint8_t layer) const override;
+
+  ConstRange getHitSets() const override;
+
+  TrkrHitSet* findHitSet(TrkrDefs::hitsetkey key) override;
+
+  unsigned int size() const override
+  {
+    return m_hitmap.size();
+  }
+
+ private:
+  //! reset and move hitset to the pool if it is a TrkrHitSetv2, delete it otherwise
+  void release(TrkrHitSet*);
+
+  Map m_hitmap;
+
+  //! hitsets available for reuse
+  std::vector<TrkrHitSet*> m_pool;  //! transient
+
+  ClassDefOverride(TrkrHitSetContainerv3, 1)
+};
+
+#endif  // TRACKBASE_TRKRHITSETCONTAINERV3_H
@@ -0,0 +1,196 @@
+/**
+ * @file trackbase/TrkrHitSetv2.cc
+ * @brief Implementation of TrkrHitSetv2
+ */
+#include "TrkrHitSetv2.h"
+#include "TrkrHit.h"
+#include "TrkrHitv2.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <tuple>
+
+namespace
+{
+  // sum of two adc values, saturating at USHRT_MAX
+  inline unsigned short add_adc(const unsigned int first, const unsigned int second)
+  {
+    return std::min<unsigned int>(first + second, USHRT_MAX);
+  }
+}  // namespace
+
+PHObject* TrkrHitSetv2::HitRef::CloneMe() const
+{
+  auto hit = new TrkrHitv2;
+  hit->setAdc(getAdc());
+  return hit;
+}
+
+void TrkrHitSetv2::Reset()
+{
+  m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  // clear, but keep the capacity of the hit vectors
+  m_hits.clear();
+  m_pending.clear();
+  m_owned.clear();
+  m_refs.clear();
+  m_map.clear();
+  m_map_complete = false;
+}
+
+void TrkrHitSetv2::identify(std::ostream& os) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(m_hitSetKey);
+  const unsigned int trkrid = TrkrDefs::getTrkrId(m_hitSetKey);
+  os
+      << "TrkrHitSetv2: "
+      << "       hitsetkey " << getHitSetKey()
+      << " TrkrId " << trkrid
+      << " layer " << layer
+      << " nhits: " << size()
+      << std::endl;
+
+  for (const auto& hit : hits())
+  {
+    os << " hitkey " << hit.key << " adc " << hit.adc << std::endl;
+  }
+}
+
+void TrkrHitSetv2::merge()
+{
+  // sort the pending adc and merge with the existing hits, summing the adc of identical keys
+  std::sort(m_pending.begin(), m_pending.end());
+  m_merged.clear();
+  m_merged.reserve(m_hits.size() + m_pending.size());
+  auto hit = m_hits.begin();
+  for (auto pending = m_pending.begin(); pending != m_pending.end(); ++pending)
+  {
+    for (; hit != m_hits.end() && hit->key < pending->key; ++hit)
+    {
+      m_merged.push_back(*hit);
+    }
+    if (hit != m_hits.end() && hit->key == pending->key)
+    {
+      m_merged.push_back(*hit);
+      ++hit;
+    }
+    else if (m_merged.empty() || m_merged.back().key != pending->key)
+    {
+      m_merged.push_back({pending->key, 0});
+      add_to_map(pending->key);
+    }
+    m_merged.back().adc = add_adc(m_merged.back().adc, pending->adc);
+  }
+  m_merged.insert(m_merged.end(), hit, m_hits.end());
+
+  m_hits.swap(m_merged);
+  m_pending.clear();
+}
+
+TrkrHitSetv2::HitList::iterator TrkrHitSetv2::find(TrkrDefs::hitkey key)
+{
+  merge_pending();
+  const auto iter = std::lower_bound(m_hits.begin(), m_hits.end(), Hit{key, 0});
+  return (iter != m_hits.end() && iter->key == key) ? iter : m_hits.end();
+}
+
+void TrkrHitSetv2::setAdc(TrkrDefs::hitkey key, unsigned int adc)
+{
+  merge_pending();
+  const auto iter = std::lower_bound(m_hits.begin(), m_hits.end(), Hit{key, 0});
+  const auto value = static_cast<unsigned short>(adc > USHRT_MAX ? USHRT_MAX : adc);
+  if (iter != m_hits.end() && iter->key == key)
+  {
+    iter->adc = value;
+  }
+  else
+  {
+    m_hits.insert(iter, {key, value});
+    add_to_map(key);
+  }
+}
+
+unsigned int TrkrHitSetv2::getAdc(TrkrDefs::hitkey key) const
+{
+  const auto iter = const_cast<TrkrHitSetv2*>(this)->find(key);
+  return iter == m_hits.end() ? 0 : iter->adc;
+}
+
+bool TrkrHitSetv2::hasHit(TrkrDefs::hitkey key) const
+{
+  // find may merge the pending hits, so it must be called before taking the end of the hits
+  const auto iter = const_cast<TrkrHitSetv2*>(this)->find(key);
+  return iter != m_hits.end();
+}
+
+void TrkrHitSetv2::removeHit(TrkrDefs::hitkey key)
+{
+  const auto iter = find(key);
+  if (iter != m_hits.end())
+  {
+    m_hits.erase(iter);
+    m_map.erase(key);
+    m_refs.erase(key);
+    m_owned.erase(key);
+  }
+  else
+  {
+    identify();
+    std::cout << "TrkrHitSetv2::removeHit: deleting a nonexist key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+}
+
+TrkrHitSetv2::ConstIterator
+TrkrHitSetv2::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
+{
+  if (hasHit(key))
+  {
+    std::cout << "TrkrHitSetv2::AddHitSpecificKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+
+  // copy the adc, and keep the hit, as TrkrHitSetv1 would
+  setAdc(key, hit->getAdc());
+  m_owned[key].reset(hit);
+
+  // the returned hit reads and writes the packed hit
+  return m_map.emplace(key, get_ref(key)).first;
+}
+
+TrkrHit*
+TrkrHitSetv2::get_ref(TrkrDefs::hitkey key) const
+{
+  auto iter = m_refs.lower_bound(key);
+  if (iter == m_refs.end() || iter->first != key)
+  {
+    iter = m_refs.emplace_hint(iter, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(const_cast<TrkrHitSetv2*>(this), key));
+  }
+  return &iter->second;
+}
+
+TrkrHit*
+TrkrHitSetv2::getHit(const TrkrDefs::hitkey key) const
+{
+  return hasHit(key) ? get_ref(key) : nullptr;
+}
+
+TrkrHitSetv2::ConstRange
+TrkrHitSetv2::getHits() const
+{
+  merge_pending();
+
+  // the map is built once, then kept up to date when hits are added or removed
+  if (!m_map_complete)
+  {
+    for (const auto& hit : m_hits)
+    {
+      m_map.emplace_hint(m_map.end(), hit.key, get_ref(hit.key));
+    }
+    m_map_complete = true;
+  }
+  return std::make_pair(m_map.cbegin(), m_map.cend());
+}
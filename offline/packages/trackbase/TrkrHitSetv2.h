@@ -0,0 +1,209 @@
+#ifndef TRACKBASE_TRKRHITSETV2_H
+#define TRACKBASE_TRKRHITSETV2_H
+
+/**
+ * @file trackbase/TrkrHitSetv2.h
+ * @brief Container for storing hits as packed (hitkey, adc) pairs
+ */
+#include "TrkrDefs.h"
+#include "TrkrHit.h"
+#include "TrkrHitSet.h"
+
+#include <climits>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <utility>  // for pair
+#include <vector>
+
+/**
+ * @brief Container for storing hits as packed (hitkey, adc) pairs
+ *
+ * The hits are stored in a single vector sorted by hit key, without one
+ * TrkrHit object per hit. Reset keeps the memory, so that a hitset reused
+ * from one event to the next (see TrkrHitSetContainerv3) does not allocate.
+ *
+ * Hits should be filled with addEnergy or addAdc, which append to a buffer
+ * merged into the sorted hits on the next read, and read with hits().
+ *
+ * The TrkrHit interface is kept for compatibility, with these restrictions:
+ * - the adc of hits passed to addHitSpecificKey is copied right away. The hits are owned
+ *   by the hitset and deleted when removed or when the hitset is reset, as with TrkrHitSetv1,
+ *   but later changes made to them are not seen. Use the returned hit, or getHit, instead;
+ * - getHit and getHits return transient TrkrHit objects reading and writing
+ *   the packed hits, which remain valid until the hit is removed or the hitset reset.
+ *   The map returned by getHits is built on first call, and kept up to date afterwards.
+ */
+class TrkrHitSetv2 : public TrkrHitSet
+{
+ public:
+  //! packed hit
+  /*! do not modify and commit: this will break reading past DSTs */
+  class Hit
+  {
+   public:
+    TrkrDefs::hitkey key = 0;
+    unsigned short adc = 0;
+
+    bool operator<(const Hit& other) const { return key < other.key; }
+  };
+  using HitList = std::vector<Hit>;
+
+  //! transient hit, reading and writing the adc of a packed hit
+  class HitRef : public TrkrHit
+  {
+   public:
+    HitRef(TrkrHitSetv2* hitset, TrkrDefs::hitkey key)
+      : m_hitset(hitset)
+      , m_key(key)
+    {
+    }
+
+    void identify(std::ostream& os = std::cout) const override
+    {
+      os << "TrkrHitSetv2::HitRef with adc = " << getAdc() << std::endl;
+    }
+
+    //! returns a TrkrHitv2 copy
+    PHObject* CloneMe() const override;
+
+    using PHObject::CopyFrom;
+    void CopyFrom(const TrkrHit& source) override { setAdc(source.getAdc()); }
+    void CopyFrom(TrkrHit* source) override { CopyFrom(*source); }
+
+    void addEnergy(const double edep) override { m_hitset->addEnergy(m_key, edep); }
+    double getEnergy() const override { return ((double) getAdc()) / TrkrDefs::EdepScaleFactor; }
+    void setAdc(const unsigned int adc) override { m_hitset->setAdc(m_key, adc); }
+    unsigned int getAdc() const override { return m_hitset->getAdc(m_key); }
+
+   private:
+    TrkrHitSetv2* m_hitset = nullptr;
+    TrkrDefs::hitkey m_key = 0;
+  };
+
+  TrkrHitSetv2() = default;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  //! remove all hits, keeping the memory
+  void Reset() override;
+
+  //! for TClonesArray based containers
+  void Clear(Option_t* /*option*/ = "") override { Reset(); }
+
+  void setHitSetKey(const TrkrDefs::hitsetkey key) override
+  {
+    m_hitSetKey = key;
+  }
+
+  TrkrDefs::hitsetkey getHitSetKey() const override
+  {
+    return m_hitSetKey;
+  }
+
+  //!@name packed hit interface
+  //@{
+
+  //! add energy to a hit, creating it if needed. Same conversion to adc as TrkrHitv2::addEnergy
+  void addEnergy(const TrkrDefs::hitkey key, const double edep)
+  {
+    const double ein = edep * TrkrDefs::EdepScaleFactor;
+    m_pending.push_back({key, static_cast<unsigned short>(ein >= USHRT_MAX ? USHRT_MAX : (ein > 0 ? ein : 0))});
+  }
+
+  //! add adc to a hit, creating it if needed. The adc saturates at USHRT_MAX
+  void addAdc(const TrkrDefs::hitkey key, const unsigned int adc)
+  {
+    m_pending.push_back({key, static_cast<unsigned short>(adc > USHRT_MAX ? USHRT_MAX : adc)});
+  }
+
+  //! set the adc of a hit, creating it if needed
+  void setAdc(TrkrDefs::hitkey, unsigned int adc);
+
+  //! adc of a hit, 0 if not found
+  unsigned int getAdc(TrkrDefs::hitkey) const;
+
+  //! true if there is a hit with this key
+  bool hasHit(TrkrDefs::hitkey) const;
+
+  //! all hits, sorted by key
+  const HitList& hits() const
+  {
+    merge_pending();
+    return m_hits;
+  }
+
+  //! reserve memory for a number of hits
+  void reserve(size_t n) { m_hits.reserve(n); }
+
+  //@}
+
+  ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*) override;
+
+  void removeHit(TrkrDefs::hitkey) override;
+
+  TrkrHit* getHit(const TrkrDefs::hitkey) const override;
+
+  ConstRange getHits() const override;
+
+  unsigned int size() const override
+  {
+    return hits().size();
+  }
+
+ private:
+  //! merge the pending hits into the sorted hits
+  void merge_pending() const
+  {
+    if (!m_pending.empty())
+    {
+      // merging does not change the content of the hitset as seen from outside
+      const_cast<TrkrHitSetv2*>(this)->merge();
+    }
+  }
+
+  void merge();
+
+  //! transient hit of a given key, created if needed
+  TrkrHit* get_ref(TrkrDefs::hitkey) const;
+
+  //! add a new hit to the map returned by getHits, once it has been built
+  void add_to_map(TrkrDefs::hitkey key)
+  {
+    if (m_map_complete)
+    {
+      m_map.emplace(key, get_ref(key));
+    }
+  }
+
+  //! position of a hit in the sorted hits, end if not found
+  HitList::iterator find(TrkrDefs::hitkey);
+
+  /// unique key for this object
+  TrkrDefs::hitsetkey m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  /// hits, sorted by key
+  HitList m_hits;
+
+  /// adc added since the last merge, one entry per call
+  HitList m_pending;  //! transient
+
+  /// hits passed to addHitSpecificKey, kept until removed or reset
+  std::map<TrkrDefs::hitkey, std::unique_ptr<TrkrHit>> m_owned;  //! transient
+
+  /// merge buffer
+  HitList m_merged;  //! transient
+
+  /// transient hits returned by getHit and getHits
+  mutable std::map<TrkrDefs::hitkey, HitRef> m_refs;  //! transient
+
+  /// map returned by getHits
+  mutable Map m_map;  //! transient
+
+  /// true when m_map holds all hits. Set by the first getHits, cleared by Reset
+  mutable bool m_map_complete = false;  //! transient
+
+  ClassDefOverride(TrkrHitSetv2, 1);
+};
+
+#endif  // TRACKBASE_TRKRHITSETV2_H
@@ -0,0 +1,6 @@
+#ifdef __CINT__
+
+#pragma link C++ class TrkrHitSetv2 + ;
+#pragma link C++ class TrkrHitSetv2::Hit + ;
+
+#endif
@@ -30,6 +30,7 @@
 #include <bitset>
 #include <cassert>
 #include <iostream>
+#include <memory>
 #include <numeric>
 #include <utility>  //for pair
 
@@ -333,9 +334,9 @@ void DSTClusterPruning::fill_clusters()
         }
         if (!m_cluster_map->findCluster(cluster_key))
         {
-          m_cluster = new TrkrClusterv5();
-          m_cluster->CopyFrom(cluster);
-          m_cluster_map->addClusterSpecifyKey(cluster_key, m_cluster);
+          auto newcluster = std::make_unique<TrkrClusterv5>();
+          newcluster->CopyFrom(cluster);
+          m_cluster_map->addCluster(cluster_key, std::move(newcluster));
         }
       }
     }
@@ -355,9 +356,9 @@ void DSTClusterPruning::fill_clusters()
         }
         if (!m_cluster_map->findCluster(cluster_key))
         {
-          m_cluster = new TrkrClusterv5();
-          m_cluster->CopyFrom(cluster);
-          m_cluster_map->addClusterSpecifyKey(cluster_key, m_cluster);
+          auto newcluster = std::make_unique<TrkrClusterv5>();
+          newcluster->CopyFrom(cluster);
+          m_cluster_map->addCluster(cluster_key, std::move(newcluster));
 
           // m_reduced_cluster_map->addClusterSpecifyKey(cluster_key, cluster);
         }
@@ -31,6 +31,7 @@
 #include <TH2.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 class alignmentTransformationContainer;
 class ActsGeometry;
@@ -41,6 +42,8 @@ class TrackSeedContainer;
 class TrkrClusterContainer;
 class SvtxAlignmentStateMap;
 class PHG4TpcGeomContainer;
+class PHThreadPool;
+class SvtxTrack_v4;
 
 using SourceLink = ActsSourceLink;
 using FitResult = ActsTrackFittingAlgorithm::TrackFitterResult;
@@ -55,7 +58,7 @@ class PHActsTrkFitter : public SubsysReco
   PHActsTrkFitter(const std::string& name = "PHActsTrkFitter");
 
   /// Destructor
-  ~PHActsTrkFitter() override = default;
+  ~PHActsTrkFitter() override;
 
   /// End, write and close files
   int End(PHCompositeNode* topNode) override;
@@ -155,7 +158,32 @@ class PHActsTrkFitter : public SubsysReco
   void setTrkrClusterContainerName(const std::string& name) { m_clusterContainerName = name; }
   void setDirectNavigation(bool flag) { m_directNavigation = flag; }
   void setClusterEdgeRejection(int edge ) { m_cluster_edge_rejection = edge; }
+
+  /// Number of threads used to fit the seeds. 0 means one per hardware thread.
+  /// The tracks are inserted in seed order, so the output does not depend on the
+  /// number of threads. The fits are done on the calling thread when the evaluator,
+  /// the alignment states, the outlier finder, the time analysis or transient
+  /// transforms (no cluster mover) are used, or when Verbosity() is not 0
+  void set_nthreads(unsigned int n) { m_nthreads = n; }
+
  private:
+  /// fit result of one seed
+  struct FitOutput
+  {
+    /// fitted track, null if the fit failed
+    std::unique_ptr<SvtxTrack_v4> track;
+
+    /// true if the track goes to the silicon-MM track map
+    bool directed = false;
+
+    /// track id, set before the fit on the calling thread.
+    /// Tracks fitted on the worker pool get their id when inserted
+    unsigned int id = 0;
+
+    /// number of fits that returned an error
+    int nBadFits = 0;
+  };
+
   /// Get all the nodes
   int getNodes(PHCompositeNode* topNode);
 
@@ -164,6 +192,15 @@ class PHActsTrkFitter : public SubsysReco
 
   void loopTracks(Acts::Logging::Level logLevel);
 
+  /// true if the seeds can be fitted on the worker pool
+  bool use_pool() const;
+
+  /// fit one seed, trying the crossing variations if needed
+  void fitSeed(TrackSeed* track, FitOutput& output);
+
+  /// insert fitted track in the relevant track map
+  void insertTrack(FitOutput& output);
+
   /// Convert the acts track fit result to an svtx track
   void updateSvtxTrack(
       const std::vector<Acts::TrackIndexType>& tips,
@@ -307,6 +344,15 @@ class PHActsTrkFitter : public SubsysReco
 
   std::vector<const Acts::Surface*> m_materialSurfaces = {};
 
+  /// seeds of the current event
+  std::vector<TrackSeed*> m_seeds;
+
+  /// fit results of the current event, one per seed
+  std::vector<FitOutput> m_fitOutputs;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_pool;
+
 };
 
 #endif
@@ -12,6 +12,7 @@
 // sPHENIX includes
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>  // for PHTimer
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
@@ -28,6 +29,7 @@
 #include <trackbase/TrackFitUtils.h>
 #include <trackbase/TrkrCluster.h>  // for TrkrCluster
 #include <trackbase/TrkrClusterContainer.h>
+#include <trackbase/TrkrClusterContainerv5.h>
 #include <trackbase/TrkrClusterHitAssoc.h>
 #include <trackbase/TrkrClusterIterationMapv1.h>
 #include <trackbase/TrkrDefs.h>  // for getLayer, clu...
@@ -193,6 +195,8 @@ PHCASeeding::PHCASeeding(
 {
 }
 
+PHCASeeding::~PHCASeeding() = default;
+
 int PHCASeeding::InitializeGeometry(PHCompositeNode* topNode)
 {
   // geometry
@@ -244,54 +248,82 @@ std::pair<PHCASeeding::PositionMap, PHCASeeding::keyListPerLayer> PHCASeeding::F
   PositionMap cachedPositions;
   cachedPositions.reserve(_cluster_map->size());  // avoid resizing mid-execution
 
-  for (const auto& hitsetkey : _cluster_map->getHitSetKeys(TrkrDefs::TrkrId::tpcId))
+  // add one cluster, unless it was used in a previous iteration
+  auto add_cluster = [&](TrkrDefs::cluskey ckey, TrkrCluster* cluster, unsigned int layer)
   {
-    auto range = _cluster_map->getClusters(hitsetkey);
-    for (auto clusIter = range.first; clusIter != range.second; ++clusIter)
+    if (_iteration_map != nullptr && _n_iteration > 0)
     {
-      TrkrDefs::cluskey ckey = clusIter->first;
-      TrkrCluster* cluster = clusIter->second;
-      unsigned int layer = TrkrDefs::getLayer(ckey);
-
-      if(cluster->getZSize()==1&&_reject_zsize1==true){
-	continue;
+      if (_iteration_map->getIteration(ckey) > 0)
+      {
+        return;  // skip hits used in a previous iteration
       }
-      if (layer < _start_layer || layer >= _end_layer)
+    }
+
+    // get global position, convert to Acts::Vector3 and store in map
+    const Acts::Vector3 globalpos_d = getGlobalPosition(ckey, cluster);
+    const Acts::Vector3 globalpos = {globalpos_d.x(), globalpos_d.y(), globalpos_d.z()};
+    cachedPositions.insert(std::make_pair(ckey, globalpos));
+
+    ckeys[layer - _FIRST_LAYER_TPC].push_back(ckey);
+    fill_tuple(_tupclus_all, 0, ckey, cachedPositions.at(ckey));
+  };
+
+  // column oriented containers are read directly, without building the temporary cluster map
+  const auto* cluster_columns = dynamic_cast<const TrkrClusterContainerv5*>(_cluster_map);
+
+  for (const auto& hitsetkey : _cluster_map->getHitSetKeys(TrkrDefs::TrkrId::tpcId))
+  {
+    // all clusters of a hitset are in the same layer
+    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+    if (layer < _start_layer || layer >= _end_layer)
+    {
+      if (Verbosity() > 2)
       {
-        if (Verbosity() > 2)
-        {
-          std::cout << "layer: " << layer << std::endl;
-        }
-        continue;
+        std::cout << "layer: " << layer << std::endl;
       }
-      if (_iteration_map != nullptr && _n_iteration > 0)
+      continue;
+    }
+
+    if (cluster_columns)
+    {
+      const auto* columns = cluster_columns->getColumns(hitsetkey);
+      for (unsigned int index = 0; index < columns->size(); ++index)
       {
-        if (_iteration_map->getIteration(ckey) > 0)
+        if (!columns->has(index) || (columns->zsize[index] == 1 && _reject_zsize1))
         {
-          continue;  // skip hits used in a previous iteration
+          continue;
         }
+        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+        add_cluster(ckey, cluster_columns->findCluster(ckey), layer);
       }
+      continue;
+    }
 
-      // get global position, convert to Acts::Vector3 and store in map
-      const Acts::Vector3 globalpos_d = getGlobalPosition(ckey, cluster);
-      const Acts::Vector3 globalpos = {globalpos_d.x(), globalpos_d.y(), globalpos_d.z()};
-      cachedPositions.insert(std::make_pair(ckey, globalpos));
+    auto range = _cluster_map->getClusters(hitsetkey);
+    for (auto clusIter = range.first; clusIter != range.second; ++clusIter)
+    {
+      TrkrDefs::cluskey ckey = clusIter->first;
+      TrkrCluster* cluster = clusIter->second;
 
-      ckeys[layer - _FIRST_LAYER_TPC].push_back(ckey);
-      fill_tuple(_tupclus_all, 0, ckey, cachedPositions.at(ckey));
+      if(cluster->getZSize()==1&&_reject_zsize1==true){
+	continue;
+      }
+      add_cluster(ckey, cluster, layer);
     }
   }
   return std::make_pair(cachedPositions, ckeys);
 }
 
-std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer)
+std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer) const
 {
   // Fill _rtree with the clusters in ckeys; remove duplicates, and return a vector of the coordKeys
   // Note that layer is only used for a cout statement
-  int n_dupli = 0;
-  std::vector<coordKey> coords;
-  _rtree.clear();
-  /* _rtree.reserve(ckeys.size()); */
+  // The tree is bulk loaded with the packing algorithm, which is faster than inserting
+  // the clusters one at a time and gives a better balanced tree to query
+  std::vector<pointKey> values;
+  std::vector<std::array<double, 2>> positions;
+  values.reserve(ckeys.size());
+  positions.reserve(ckeys.size());
   for (const auto& ckey : ckeys)
   {
     const auto& globalpos_d = globalPositions.at(ckey);
@@ -302,25 +334,62 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
       /* int layer = TrkrDefs::getLayer(ckey); */
       std::cout << "Found cluster " << ckey << " in layer " << layer << std::endl;
     }
+    values.emplace_back(point(clus_phi, clus_z), ckey);
+    positions.push_back({clus_phi, clus_z});
+  }
+  _rtree = bgi::rtree<pointKey, bgi::quadratic<16>>(values.begin(), values.end());
+
+  // a cluster is a duplicate if it is on top of an earlier cluster which is not a duplicate itself,
+  // the same clusters as removed when filling the tree one cluster at a time
+  int n_dupli = 0;
+  std::vector<bool> duplicate(ckeys.size(), false);
+  std::vector<coordKey> coords;
+  coords.reserve(ckeys.size());
+  for (unsigned int i = 0; i < ckeys.size(); ++i)
+  {
+    const double clus_phi = positions[i][0];
+    const double clus_z = positions[i][1];
     std::vector<pointKey> testduplicate;
     QueryTree(_rtree, clus_phi - 0.00001, clus_z - 0.00001, clus_phi + 0.00001, clus_z + 0.00001, testduplicate);
-    if (!testduplicate.empty())
+    // the query always returns the cluster itself
+    if (testduplicate.size() > 1)
+    {
+      for (const auto& other : testduplicate)
+      {
+        const auto iter = std::find(ckeys.begin(), ckeys.begin() + i, other.second);
+        if (iter != ckeys.begin() + i && !duplicate[iter - ckeys.begin()])
+        {
+          duplicate[i] = true;
+          break;
+        }
+      }
+    }
+    if (duplicate[i])
     {
       ++n_dupli;
       continue;
     }
-    coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckey});
-    t_fill->restart();
-    _rtree.insert(std::make_pair(point(clus_phi, globalpos_d.z()), ckey));
-    t_fill->stop();
+    coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckeys[i]});
   }
-  if (Verbosity() > 5)
+
+  if (n_dupli > 0)
   {
-    std::cout << "nhits in layer(" << layer << "): " << coords.size() << std::endl;
+    // rebuild the tree without the duplicates
+    std::vector<pointKey> unique_values;
+    unique_values.reserve(coords.size());
+    for (unsigned int i = 0; i < values.size(); ++i)
+    {
+      if (!duplicate[i])
+      {
+        unique_values.push_back(values[i]);
+      }
+    }
+    _rtree = bgi::rtree<pointKey, bgi::quadratic<16>>(unique_values.begin(), unique_values.end());
   }
-  if (Verbosity() > 3)
+
+  if (Verbosity() > 5)
   {
-    std::cout << "fill time: " << t_fill->get_accumulated_time() / 1000. << " sec" << std::endl;
+    std::cout << "nhits in layer(" << layer << "): " << coords.size() << std::endl;
   }
   if (Verbosity() > 3)
   {
@@ -399,216 +468,108 @@ int PHCASeeding::FindSeedsWithMerger(const PHCASeeding::PositionMap& globalPosit
   return seeds.size();
 }
 
+bool PHCASeeding::use_pool() const
+{
+#if defined(_PHCASEEDING_CLUSTERLOG_TUPOUT_)
+  // the tuples cannot be filled from several threads
+  return false;
+#else
+  return m_pool && Verbosity() <= 3;
+#endif
+}
+
 std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::CreateBiLinks(const PHCASeeding::PositionMap& globalPositions, const PHCASeeding::keyListPerLayer& ckeys)
 {
   keyLinks startLinks;        // bilinks at start of chains
   keyLinkPerLayer bodyLinks;  //  bilinks to build chains
-                              //
-  double cluster_find_time = 0;
-  double rtree_query_time = 0;
-  double transform_time = 0;
-  double compute_best_angle_time = 0;
-  double set_insert_time = 0;
-
-  // there are three coord_array (only the current layer is used at a time,
-  // but it is filled the same time as the _rtrees, which are used two at
-  // a time -- the prior padplane row and the next padplain row
-  std::array<std::vector<coordKey>, 3> coord_arr;
-  std::array<std::unordered_set<keyLink>, 2> previous_downlinks_arr;
-  std::array<std::unordered_set<TrkrDefs::cluskey>, 2> bottom_of_bilink_arr;
 
   // iterate from outer to inner layers
   const int inner_index = _start_layer - _FIRST_LAYER_TPC + 1;
   const int outer_index = _end_layer - _FIRST_LAYER_TPC - 2;
-
-  // fill the current and prior row coord and ttrees for the first iteration
-  int _index_above = (outer_index + 1) % 3;
-  int _index_current = (outer_index) % 3;
-  coord_arr[_index_above] = FillTree(_rtrees[_index_above], ckeys[outer_index + 1], globalPositions, outer_index + 1);
-  coord_arr[_index_current] = FillTree(_rtrees[_index_current], ckeys[outer_index], globalPositions, outer_index);
-
-  for (int layer_index = outer_index; layer_index >= inner_index; --layer_index)
+  if (outer_index < inner_index)
   {
-    // these lines of code will rotates through all three _rtree's in the array,
-    // where the old lower becomes the new middle, the old middle the new upper,
-    // and the old upper drops out and that _rtree is filled with the new lower
-    const unsigned int LAYER = layer_index + _FIRST_LAYER_TPC;
-    int index_above = (layer_index + 1) % 3;
-    int index_current = (layer_index) % 3;
-    int index_below = (layer_index - 1) % 3;
-
-    coord_arr[index_below] = FillTree(_rtrees[index_below], ckeys[layer_index - 1], globalPositions, layer_index - 1);
+    return std::make_pair(startLinks, bodyLinks);
+  }
 
-    // NO DUPLICATES FOUND IN COORD_ARR
+  // run a task for all layers in [first, last], on the worker pool if available.
+  // Each task only writes to the containers of its own layer
+  auto for_each_layer = [this](const int first, const int last, const auto& task)
+  {
+    if (use_pool())
+    {
+      m_pool->parallel_for(last - first + 1, [&task, first](std::size_t index, unsigned int /*worker*/)
+      {
+        task(first + index);
+      });
+    }
+    else
+    {
+      for (int layer_index = first; layer_index <= last; ++layer_index)
+      {
+        task(layer_index);
+      }
+    }
+  };
 
-    auto& _rtree_above = _rtrees[index_above];
-    const std::vector<coordKey>& coord = coord_arr[index_current];
-    auto& _rtree_below = _rtrees[index_below];
+  // fill the trees of all layers once, including the layers just below and above the range
+  t_fill->restart();
+  for_each_layer(inner_index - 1, outer_index + 1, [&](const int layer_index)
+  {
+    _coords[layer_index] = FillTree(_rtrees[layer_index], ckeys[layer_index], globalPositions, layer_index);
+  });
+  t_fill->stop();
+  if (Verbosity() > 3)
+  {
+    std::cout << "fill time: " << t_fill->get_accumulated_time() / 1000. << " sec" << std::endl;
+  }
 
-    auto& curr_downlinks = previous_downlinks_arr[layer_index % 2];
-    auto& last_downlinks = previous_downlinks_arr[(layer_index + 1) % 2];
+  // the links of each layer only depend on the trees of the layers below and above
+  for_each_layer(inner_index, outer_index, [&](const int layer_index)
+  {
+    FindLinks(layer_index, globalPositions);
+  });
+
+  // Any link to an above node which matches a link from that node to a "below node"
+  // becomes a "bilink". Check if this bilink links to a prior bilink or not.
+  // This is done in order from the outer to the inner layers, so that the links come
+  // out in the same order for any number of threads.
+  // There are no bilinks in the outermost layer, as links are not formed from the layer above it
+  std::array<std::unordered_set<TrkrDefs::cluskey>, 2> bottom_of_bilink_arr;
+  for (int layer_index = outer_index - 1; layer_index >= inner_index; --layer_index)
+  {
+    const auto& last_downlinks = _downlinks[layer_index + 1];
 
     auto& curr_bottom_of_bilink = bottom_of_bilink_arr[layer_index % 2];
     auto& last_bottom_of_bilink = bottom_of_bilink_arr[(layer_index + 1) % 2];
-
-    curr_downlinks.clear();
     curr_bottom_of_bilink.clear();
 
-    // For all the clusters in coord, find nearest neighbors in the
-    // above and below layers and make links
-    // Any link to an above node which matches the same clusters
-    // on the previous iteration (to a "below node") becomes a "bilink"
-    // Check if this bilink links to a prior bilink or not
-
-    std::vector<keyLink> aboveLinks;
-    for (const auto& StartCluster : coord)
+    for (const auto& uplink : _uplinks[layer_index])
     {
-      double StartPhi = StartCluster.first[0];
-      const auto& globalpos = globalPositions.at(StartCluster.second);
-      double StartX = globalpos(0);
-      double StartY = globalpos(1);
-      double StartZ = globalpos(2);
-      t_seed->stop();
-      cluster_find_time += t_seed->elapsed();
-      t_seed->restart();
-      LogDebug(" starting cluster:" << std::endl);
-      LogDebug(" z: " << StartZ << std::endl);
-      LogDebug(" phi: " << StartPhi << std::endl);
-
-      std::vector<pointKey> ClustersAbove;
-      std::vector<pointKey> ClustersBelow;
-
-      QueryTree(_rtree_below,
-                StartPhi - dphi_per_layer[LAYER],
-                StartZ - dZ_per_layer[LAYER],
-                StartPhi + dphi_per_layer[LAYER],
-                StartZ + dZ_per_layer[LAYER],
-                ClustersBelow);
-
-      FillTupWinLink(_rtree_below, StartCluster, globalPositions);
-
-      QueryTree(_rtree_above,
-                StartPhi - dphi_per_layer[LAYER + 1],
-                StartZ - dZ_per_layer[LAYER + 1],
-                StartPhi + dphi_per_layer[LAYER + 1],
-                StartZ + dZ_per_layer[LAYER + 1],
-                ClustersAbove);
-
-      t_seed->stop();
-      rtree_query_time += t_seed->elapsed();
-      t_seed->restart();
-      LogDebug(" entries in below layer: " << ClustersBelow.size() << std::endl);
-      LogDebug(" entries in above layer: " << ClustersAbove.size() << std::endl);
-      std::vector<std::array<double, 3>> delta_below;
-      std::vector<std::array<double, 3>> delta_above;
-      delta_below.clear();
-      delta_above.clear();
-      delta_below.resize(ClustersBelow.size());
-      delta_above.resize(ClustersAbove.size());
-      // calculate (delta_z_, delta_phi) vector for each neighboring cluster
-
-      std::transform(ClustersBelow.begin(), ClustersBelow.end(), delta_below.begin(),
-                     [&](pointKey BelowCandidate)
-                     {
-          const auto& belowpos = globalPositions.at(BelowCandidate.second);
-          return std::array<double,3>{belowpos(0)-StartX,
-          belowpos(1)-StartY,
-          belowpos(2)-StartZ}; });
-
-      std::transform(ClustersAbove.begin(), ClustersAbove.end(), delta_above.begin(),
-                     [&](pointKey AboveCandidate)
-                     {
-          const auto& abovepos = globalPositions.at(AboveCandidate.second);
-          return std::array<double,3>{abovepos(0)-StartX,
-          abovepos(1)-StartY,
-          abovepos(2)-StartZ}; });
-      t_seed->stop();
-      transform_time += t_seed->elapsed();
-      t_seed->restart();
-
-      // find the three clusters closest to a straight line
-      // (by maximizing the cos of the angle between the (delta_z_,delta_phi) vectors)
-      // double minSumLengths = 1e9;
-      std::unordered_set<TrkrDefs::cluskey> bestAboveClusters;
-      for (size_t iAbove = 0; iAbove < delta_above.size(); ++iAbove)
+      if (last_downlinks.find(uplink) != last_downlinks.end())
       {
-        for (size_t iBelow = 0; iBelow < delta_below.size(); ++iBelow)
+        // this is a bilink
+        const auto& key_top = uplink.first;
+        const auto& key_bot = uplink.second;
+        curr_bottom_of_bilink.insert(key_bot);
+        fill_tuple(_tupclus_bilinks, 0, key_top, globalPositions.at(key_top));
+        fill_tuple(_tupclus_bilinks, 1, key_bot, globalPositions.at(key_bot));
+
+        if (last_bottom_of_bilink.find(key_top) == last_bottom_of_bilink.end())
         {
-          // test for straightness of line just by taking the cos(angle) between the two vectors
-          // use the sq as it is much faster than sqrt
-          const auto& A = delta_below[iBelow];
-          const auto& B = delta_above[iAbove];
-          // calculate normalized dot product between two vectors
-          const double A_len_sq = (A[0] * A[0] + A[1] * A[1] + A[2] * A[2]);
-          const double B_len_sq = (B[0] * B[0] + B[1] * B[1] + B[2] * B[2]);
-          const double dot_prod = (A[0] * B[0] + A[1] * B[1] + A[2] * B[2]);
-          const double cos_angle_sq = dot_prod * dot_prod / A_len_sq / B_len_sq;  // also same as cos(angle), where angle is between two vectors
-          FillTupWinCosAngle(ClustersAbove[iAbove].second, StartCluster.second, ClustersBelow[iBelow].second, globalPositions, cos_angle_sq, (dot_prod < 0.));
-
-          constexpr double maxCosPlaneAngle = -0.95;
-          constexpr double maxCosPlaneAngle_sq = maxCosPlaneAngle * maxCosPlaneAngle;
-          if ((dot_prod < 0.) && (cos_angle_sq > maxCosPlaneAngle_sq))
-          {
-            // maxCosPlaneAngle = cos(angle);
-            // minSumLengths = belowLength+aboveLength;
-            curr_downlinks.insert({StartCluster.second, ClustersBelow[iBelow].second});
-            bestAboveClusters.insert(ClustersAbove[iAbove].second);
-
-            // fill the tuples for plotting
-            fill_tuple(_tupclus_links, 0, StartCluster.second, globalPositions.at(StartCluster.second));
-            fill_tuple(_tupclus_links, -1, ClustersBelow[iBelow].second, globalPositions.at(ClustersBelow[iBelow].second));
-            fill_tuple(_tupclus_links, 1, ClustersAbove[iAbove].second, globalPositions.at(ClustersAbove[iAbove].second));
-          }
+          startLinks.push_back(std::make_pair(key_top, key_bot));
         }
-      }
-      // NOTE:
-      // There was some old commented-out code here for allowing layers to be skipped. This
-      // may be useful in the future. This chunk of code has been moved towards the
-      // end fo the file under the title: "---OLD CODE 0: SKIP_LAYERS---"
-      t_seed->stop();
-      compute_best_angle_time += t_seed->elapsed();
-      t_seed->restart();
-
-      for (auto cluster : bestAboveClusters)
-      {
-        keyLink uplink = std::make_pair(cluster, StartCluster.second);
-
-        if (last_downlinks.find(uplink) != last_downlinks.end())
+        else
         {
-          // this is a bilink
-          const auto& key_top = uplink.first;
-          const auto& key_bot = uplink.second;
-          curr_bottom_of_bilink.insert(key_bot);
-          fill_tuple(_tupclus_bilinks, 0, key_top, globalPositions.at(key_top));
-          fill_tuple(_tupclus_bilinks, 1, key_bot, globalPositions.at(key_bot));
-
-          if (last_bottom_of_bilink.find(key_top) == last_bottom_of_bilink.end())
-          {
-            startLinks.push_back(std::make_pair(key_top, key_bot));
-          }
-          else
-          {
-            bodyLinks[layer_index + 1].push_back(std::make_pair(key_top, key_bot));
-          }
+          bodyLinks[layer_index + 1].push_back(std::make_pair(key_top, key_bot));
         }
-      }  // end loop over all up-links
-    }    // end loop over start clusters
-
-    t_seed->stop();
-    set_insert_time += t_seed->elapsed();
-    t_seed->restart();
-    LogDebug(" max collinearity: " << maxCosPlaneAngle << std::endl);
-  }  // end loop over layers (to make links)
+      }
+    }  // end loop over all up-links
+  }    // end loop over layers (to match links)
 
   t_seed->stop();
   if (Verbosity() > 0)
   {
     std::cout << "triplet forming time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
-    std::cout << "starting cluster setup: " << cluster_find_time / 1000 << " s" << std::endl;
-    std::cout << "RTree query: " << rtree_query_time / 1000 << " s" << std::endl;
-    std::cout << "Transform: " << transform_time / 1000 << " s" << std::endl;
-    std::cout << "Compute best triplet: " << compute_best_angle_time / 1000 << " s" << std::endl;
-    std::cout << "Set insert: " << set_insert_time / 1000 << " s" << std::endl;
   }
   t_seed->restart();
 
@@ -617,6 +578,124 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   return std::make_pair(startLinks, bodyLinks);
 }
 
+void PHCASeeding::FindLinks(const int layer_index, const PHCASeeding::PositionMap& globalPositions)
+{
+  // For all the clusters in the layer, find nearest neighbors in the
+  // above and below layers and make links if the three clusters are
+  // on a straight line
+  const unsigned int LAYER = layer_index + _FIRST_LAYER_TPC;
+  const auto& _rtree_above = _rtrees[layer_index + 1];
+  const auto& _rtree_below = _rtrees[layer_index - 1];
+
+  auto& curr_downlinks = _downlinks[layer_index];
+  auto& curr_uplinks = _uplinks[layer_index];
+  curr_downlinks.clear();
+  curr_uplinks.clear();
+
+  std::vector<pointKey> ClustersAbove;
+  std::vector<pointKey> ClustersBelow;
+  std::vector<std::array<double, 3>> delta_below;
+  std::vector<std::array<double, 3>> delta_above;
+  keyList bestAboveClusters;
+  for (const auto& StartCluster : _coords[layer_index])
+  {
+    double StartPhi = StartCluster.first[0];
+    const auto& globalpos = globalPositions.at(StartCluster.second);
+    double StartX = globalpos(0);
+    double StartY = globalpos(1);
+    double StartZ = globalpos(2);
+    LogDebug(" starting cluster:" << std::endl);
+    LogDebug(" z: " << StartZ << std::endl);
+    LogDebug(" phi: " << StartPhi << std::endl);
+
+    ClustersAbove.clear();
+    ClustersBelow.clear();
+
+    QueryTree(_rtree_below,
+              StartPhi - dphi_per_layer[LAYER],
+              StartZ - dZ_per_layer[LAYER],
+              StartPhi + dphi_per_layer[LAYER],
+              StartZ + dZ_per_layer[LAYER],
+              ClustersBelow);
+
+    FillTupWinLink(_rtree_below, StartCluster, globalPositions);
+
+    QueryTree(_rtree_above,
+              StartPhi - dphi_per_layer[LAYER + 1],
+              StartZ - dZ_per_layer[LAYER + 1],
+              StartPhi + dphi_per_layer[LAYER + 1],
+              StartZ + dZ_per_layer[LAYER + 1],
+              ClustersAbove);
+
+    LogDebug(" entries in below layer: " << ClustersBelow.size() << std::endl);
+    LogDebug(" entries in above layer: " << ClustersAbove.size() << std::endl);
+    delta_below.resize(ClustersBelow.size());
+    delta_above.resize(ClustersAbove.size());
+    // calculate (delta_z_, delta_phi) vector for each neighboring cluster
+
+    std::transform(ClustersBelow.begin(), ClustersBelow.end(), delta_below.begin(),
+                   [&](const pointKey& BelowCandidate)
+                   {
+        const auto& belowpos = globalPositions.at(BelowCandidate.second);
+        return std::array<double,3>{belowpos(0)-StartX,
+        belowpos(1)-StartY,
+        belowpos(2)-StartZ}; });
+
+    std::transform(ClustersAbove.begin(), ClustersAbove.end(), delta_above.begin(),
+                   [&](const pointKey& AboveCandidate)
+                   {
+        const auto& abovepos = globalPositions.at(AboveCandidate.second);
+        return std::array<double,3>{abovepos(0)-StartX,
+        abovepos(1)-StartY,
+        abovepos(2)-StartZ}; });
+
+    // find the three clusters closest to a straight line
+    // (by maximizing the cos of the angle between the (delta_z_,delta_phi) vectors)
+    bestAboveClusters.clear();
+    for (size_t iAbove = 0; iAbove < delta_above.size(); ++iAbove)
+    {
+      for (size_t iBelow = 0; iBelow < delta_below.size(); ++iBelow)
+      {
+        // test for straightness of line just by taking the cos(angle) between the two vectors
+        // use the sq as it is much faster than sqrt
+        const auto& A = delta_below[iBelow];
+        const auto& B = delta_above[iAbove];
+        // calculate normalized dot product between two vectors
+        const double A_len_sq = (A[0] * A[0] + A[1] * A[1] + A[2] * A[2]);
+        const double B_len_sq = (B[0] * B[0] + B[1] * B[1] + B[2] * B[2]);
+        const double dot_prod = (A[0] * B[0] + A[1] * B[1] + A[2] * B[2]);
+        const double cos_angle_sq = dot_prod * dot_prod / A_len_sq / B_len_sq;  // also same as cos(angle), where angle is between two vectors
+        FillTupWinCosAngle(ClustersAbove[iAbove].second, StartCluster.second, ClustersBelow[iBelow].second, globalPositions, cos_angle_sq, (dot_prod < 0.));
+
+        constexpr double maxCosPlaneAngle = -0.95;
+        constexpr double maxCosPlaneAngle_sq = maxCosPlaneAngle * maxCosPlaneAngle;
+        if ((dot_prod < 0.) && (cos_angle_sq > maxCosPlaneAngle_sq))
+        {
+          curr_downlinks.insert({StartCluster.second, ClustersBelow[iBelow].second});
+          bestAboveClusters.push_back(ClustersAbove[iAbove].second);
+
+          // fill the tuples for plotting
+          fill_tuple(_tupclus_links, 0, StartCluster.second, globalPositions.at(StartCluster.second));
+          fill_tuple(_tupclus_links, -1, ClustersBelow[iBelow].second, globalPositions.at(ClustersBelow[iBelow].second));
+          fill_tuple(_tupclus_links, 1, ClustersAbove[iAbove].second, globalPositions.at(ClustersAbove[iAbove].second));
+        }
+      }
+    }
+    // NOTE:
+    // There was some old commented-out code here for allowing layers to be skipped. This
+    // may be useful in the future. This chunk of code has been moved towards the
+    // end fo the file under the title: "---OLD CODE 0: SKIP_LAYERS---"
+
+    // each above cluster is linked once, in key order
+    std::sort(bestAboveClusters.begin(), bestAboveClusters.end());
+    bestAboveClusters.erase(std::unique(bestAboveClusters.begin(), bestAboveClusters.end()), bestAboveClusters.end());
+    for (const auto& cluster : bestAboveClusters)
+    {
+      curr_uplinks.emplace_back(cluster, StartCluster.second);
+    }
+  }  // end loop over start clusters
+}
+
 double PHCASeeding::getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b, TrkrDefs::cluskey c, const PHCASeeding::PositionMap& globalPositions) const
 {
   // Menger curvature = 1/R for circumcircle of triangle formed by most recent three clusters
@@ -965,6 +1044,15 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
     return ret;
   }
 
+  if (m_nthreads != 1 && !m_pool)
+  {
+    m_pool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << "Using " << m_pool->size() << " worker threads" << std::endl;
+    }
+  }
+
   // timing
   t_fill = std::make_unique<PHTimer>("t_fill");
   t_fill->stop();
@@ -1166,7 +1254,7 @@ void PHCASeeding::process_tupout_count()
   _search_windows->Fill(_neighbor_z_width, _neighbor_phi_width, _start_layer, _end_layer, _clusadd_delta_dzdr_window, _clusadd_delta_dphidr2_window);
 }
 
-void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree_below, const PHCASeeding::coordKey& StartCluster, const PHCASeeding::PositionMap& globalPositions) const
+void PHCASeeding::FillTupWinLink(const bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree_below, const PHCASeeding::coordKey& StartCluster, const PHCASeeding::PositionMap& globalPositions) const
 {
   double StartPhi = StartCluster.first[0];
   const auto& P0 = globalPositions.at(StartCluster.second);
@@ -1254,7 +1342,7 @@ void PHCASeeding::write_tuples(){};
 void PHCASeeding::fill_tuple(TNtuple* /**/, float /**/, TrkrDefs::cluskey /**/, const Acts::Vector3& /**/) const {};
 void PHCASeeding::fill_tuple_with_seed(TNtuple* /**/, const PHCASeeding::keyList& /**/, const PHCASeeding::PositionMap& /**/) const {};
 void PHCASeeding::process_tupout_count(){};
-void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& /**/, const PHCASeeding::coordKey& /**/, const PHCASeeding::PositionMap& /**/) const {};
+void PHCASeeding::FillTupWinLink(const bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& /**/, const PHCASeeding::coordKey& /**/, const PHCASeeding::PositionMap& /**/) const {};
 void PHCASeeding::FillTupWinCosAngle(const TrkrDefs::cluskey /**/, const TrkrDefs::cluskey /**/, const TrkrDefs::cluskey /**/, const PHCASeeding::PositionMap& /**/, double /**/, bool /**/) const {};
 void PHCASeeding::FillTupWinGrowSeed(const PHCASeeding::keyList& /**/, const PHCASeeding::keyLink& /**/, const PHCASeeding::PositionMap& /**/) const {};
 #endif  // defined _PHCASEEDING_CLUSTERLOG_TUPOUT_
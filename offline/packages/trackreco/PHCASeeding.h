@@ -49,6 +49,7 @@
 
 class ActsGeometry;
 class PHCompositeNode;
+class PHThreadPool;
 class PHTimer;
 class SvtxTrack_v3;
 class TpcDistortionCorrectionContainer;
@@ -98,7 +99,7 @@ class PHCASeeding : public PHTrackSeeding
       /* float cosTheta_limit = -0.8 */
   );
 
-  ~PHCASeeding() override = default;
+  ~PHCASeeding() override;
 
   void SetSplitSeeds(bool opt = true) { _split_seeds = opt; }
   void SetLayerRange(unsigned int layer_low, unsigned int layer_up)
@@ -156,6 +157,10 @@ class PHCASeeding : public PHTrackSeeding
   void setNitrogenFraction(double frac) { N2_frac = frac; };
   void setIsobutaneFraction(double frac) { isobutane_frac = frac; };
 
+  // number of threads used to fill the layer trees and find the links of each layer. 0 means one per hardware thread.
+  // The layers are processed on the calling thread if Verbosity() > 3 or when saving the clustering tuples
+  void set_nthreads(unsigned int n) { m_nthreads = n; }
+
  protected:
   int Setup(PHCompositeNode* topNode) override;
   int Process(PHCompositeNode* topNode) override;
@@ -190,7 +195,7 @@ class PHCASeeding : public PHTrackSeeding
   void fill_tuple(TNtuple*, float, TrkrDefs::cluskey, const Acts::Vector3&) const;
   void fill_tuple_with_seed(TNtuple*, const keyList&, const PositionMap&) const;
   void process_tupout_count();
-  void FillTupWinLink(bgi::rtree<pointKey, bgi::quadratic<16>>&, const coordKey&, const PositionMap&) const;
+  void FillTupWinLink(const bgi::rtree<pointKey, bgi::quadratic<16>>&, const coordKey&, const PositionMap&) const;
   void FillTupWinCosAngle(const TrkrDefs::cluskey, const TrkrDefs::cluskey, const TrkrDefs::cluskey, const PositionMap&, double cos_angle, bool isneg) const;
   void FillTupWinGrowSeed(const keyList& seed, const keyLink& link, const PositionMap& globalPositions) const;
   void fill_split_chains(const keyList& chain, const keyList& keylinks, const PositionMap& globalPositions, int& nchains) const;
@@ -212,6 +217,17 @@ class PHCASeeding : public PHTrackSeeding
   };
   std::pair<std::vector<keyLink>::iterator, std::vector<keyLink>::iterator> FindBilinks(const TrkrDefs::cluskey& key);
 
+  // hasher to keep links in an unordered set
+  class keyLinkHash
+  {
+   public:
+    size_t operator()(const keyLink& link) const
+    {
+      std::hash<TrkrDefs::cluskey> hasher;
+      return hasher(link.first) * 31 + hasher(link.second);
+    }
+  };
+
   /// tpc distortion correction utility class
   TpcDistortionCorrection m_distortionCorrection;
 
@@ -224,7 +240,9 @@ class PHCASeeding : public PHTrackSeeding
   std::pair<PositionMap, keyListPerLayer> FillGlobalPositions();
   std::pair<keyLinks, keyLinkPerLayer> CreateBiLinks(const PositionMap& globalPositions, const keyListPerLayer& ckeys);
   PHCASeeding::keyLists FollowBiLinks(const keyLinks& trackSeedPairs, const keyLinkPerLayer& bilinks, const PositionMap& globalPositions) const;
-  std::vector<coordKey> FillTree(bgi::rtree<pointKey, bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer);
+  std::vector<coordKey> FillTree(bgi::rtree<pointKey, bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer) const;
+  void FindLinks(int layer_index, const PositionMap&);
+  bool use_pool() const;
   int FindSeedsWithMerger(const PositionMap&, const keyListPerLayer&);
 
   void QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>>& rtree, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
@@ -272,8 +290,16 @@ class PHCASeeding : public PHTrackSeeding
   std::unique_ptr<PHTimer> t_fill;
   std::unique_ptr<PHTimer> t_makebilinks;
   std::unique_ptr<PHTimer> t_makeseeds;
-  /* std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees; */
-  std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, 3> _rtrees;  // need three layers at a time
+  std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees;  // one per layer, filled once per event
+  std::array<std::vector<coordKey>, _NLAYERS_TPC> _coords;                   // clusters in each tree, without duplicates
+
+  // links of the clusters of each layer to the layer below, as (current, below)
+  std::array<std::unordered_set<keyLink, keyLinkHash>, _NLAYERS_TPC> _downlinks;
+  // links of the clusters of each layer to the layer above, as (above, current). These are bilinks if also found in the _downlinks of the layer above
+  keyLinkPerLayer _uplinks;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_pool;
 
   double Ne_frac = 0.00;
   double Ar_frac = 0.75;
@@ -0,0 +1,92 @@
+// Tell emacs that this is a C++ source
+// -*- C++ -*-.
+#ifndef G4TPC_PHG4TPCCOUNTERRNG_H
+#define G4TPC_PHG4TPCCOUNTERRNG_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+//! counter based random numbers for the electron drift
+/*!
+  Philox4x32-10 (Salmon et al., SC'11): the random numbers are a pure function
+  of a key (seed, event) and a counter (index, stream, g4hit key). There is no
+  state to carry from one draw to the next, so the numbers drawn for a g4hit
+  do not depend on which g4hits were processed before, in which order or on
+  which thread.
+*/
+class PHG4TpcCounterRng
+{
+ public:
+  using Block = std::array<uint32_t, 4>;
+
+  PHG4TpcCounterRng(const uint32_t seed, const uint32_t event)
+    : m_key{seed, event}
+  {
+  }
+
+  //! four random words for a given counter
+  Block operator()(const uint32_t index, const uint32_t stream, const uint64_t key) const
+  {
+    Block ctr{index, stream, static_cast<uint32_t>(key), static_cast<uint32_t>(key >> 32U)};
+    uint32_t k0 = m_key[0];
+    uint32_t k1 = m_key[1];
+    for (int round = 0; round < 10; ++round)
+    {
+      const uint64_t p0 = uint64_t{0xD2511F53} * ctr[0];
+      const uint64_t p1 = uint64_t{0xCD9E8D57} * ctr[2];
+      ctr = {static_cast<uint32_t>(p1 >> 32U) ^ ctr[1] ^ k0, static_cast<uint32_t>(p1),
+             static_cast<uint32_t>(p0 >> 32U) ^ ctr[3] ^ k1, static_cast<uint32_t>(p0)};
+      k0 += 0x9E3779B9;
+      k1 += 0xBB67AE85;
+    }
+    return ctr;
+  }
+
+  //! uniform double in the open interval (0,1) from two random words
+  static double uniform(const uint32_t hi, const uint32_t lo)
+  {
+    const uint64_t bits = ((uint64_t{hi} << 32U) | lo) >> 11U;
+    return (static_cast<double>(bits) + 0.5) * 0x1p-53;
+  }
+
+  //! sequence of random words of one (stream, key) counter, usable with the std:: distributions
+  class Sequence
+  {
+   public:
+    using result_type = uint32_t;
+
+    Sequence(const PHG4TpcCounterRng &rng, const uint32_t stream, const uint64_t key)
+      : m_rng(rng)
+      , m_stream(stream)
+      , m_key(key)
+    {
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()()
+    {
+      if (m_used == m_block.size())
+      {
+        m_block = m_rng(m_index++, m_stream, m_key);
+        m_used = 0;
+      }
+      return m_block[m_used++];
+    }
+
+   private:
+    const PHG4TpcCounterRng &m_rng;
+    uint32_t m_stream{0};
+    uint64_t m_key{0};
+    uint32_t m_index{0};
+    Block m_block{};
+    unsigned int m_used{4};
+  };
+
+ private:
+  std::array<uint32_t, 2> m_key;
+};
+
+#endif
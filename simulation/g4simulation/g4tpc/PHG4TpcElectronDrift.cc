@@ -2,6 +2,7 @@
 // it uses the same MapToPadPlane as the old containers version
 
 #include "PHG4TpcElectronDrift.h"
+#include "PHG4TpcCounterRng.h"
 #include "PHG4TpcDistortion.h"
 #include "PHG4TpcPadPlane.h"  // for PHG4TpcPadPlane
 #include "TpcClusterBuilder.h"
@@ -15,6 +16,8 @@
 #include <trackbase/TrkrHit.h>  // for TrkrHit
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainerv1.h>
+#include <trackbase/TrkrHitSetContainerv3.h>
+#include <trackbase/TrkrHitSetv2.h>
 #include <trackbase/TrkrHitTruthAssoc.h>  // for TrkrHitTruthA...
 #include <trackbase/TrkrHitTruthAssocv1.h>
 #include <trackbase/TrkrHitv2.h>
@@ -47,6 +50,7 @@
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
 #include <phool/PHRandomSeed.h>
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -59,13 +63,16 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_alloc
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>    // for sqrt, abs, NAN
+#include <cstdint>
 #include <cstdlib>  // for exit
 #include <format>
 #include <iostream>
 #include <map>      // for _Rb_tree_cons...
+#include <random>
 #include <utility>  // for pair
 
 namespace
@@ -80,14 +87,16 @@ namespace
 PHG4TpcElectronDrift::PHG4TpcElectronDrift(const std::string &name)
   : SubsysReco(name)
   , PHParameterInterface(name)
-  , temp_hitsetcontainer(new TrkrHitSetContainerv1)
-  , single_hitsetcontainer(new TrkrHitSetContainerv1)
+  , temp_hitsetcontainer(new TrkrHitSetContainerv3)
+  , single_hitsetcontainer(new TrkrHitSetContainerv3)
 {
   InitializeParameters();
   RandomGenerator.reset(gsl_rng_alloc(gsl_rng_mt19937));
   set_seed(PHRandomSeed());
 }
 
+PHG4TpcElectronDrift::~PHG4TpcElectronDrift() = default;
+
 //_____________________________________________________________
 int PHG4TpcElectronDrift::Init(PHCompositeNode *topNode)
 {
@@ -352,6 +361,21 @@ int PHG4TpcElectronDrift::InitRun(PHCompositeNode *topNode)
 
   padplane->InitRun(topNode);
 
+  // worker threads are created once and reused for all events
+  if (m_threaded_drift)
+  {
+    m_batch_drift = true;
+    if (!m_pool)
+    {
+      m_pool = std::make_unique<PHThreadPool>(m_nthreads);
+      m_worker_batch.resize(m_pool->size());
+      if (Verbosity() > 0)
+      {
+        std::cout << PHWHERE << "Using " << m_pool->size() << " worker threads" << std::endl;
+      }
+    }
+  }
+
   // print all layers radii
   if (Verbosity())
   {
@@ -414,6 +438,9 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
   static constexpr unsigned int print_layer = 18;
 
+  // random numbers of the batch mode only depend on seed, event and g4hit
+  const PHG4TpcCounterRng counter_rng(m_seed, event_num);
+
   // tells m_distortionMap which event to look at
   if (m_distortionMap)
   {
@@ -431,6 +458,20 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
       findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
 
   PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits();
+
+  // QA histograms and ntuples are not thread safe, they are filled by the single threaded drift only
+  const bool threaded_drift = m_pool && !do_ElectronDriftQAHistos && Verbosity() == 0;
+  std::vector<PHG4HitContainer::ConstIterator> g4hits_to_drift;
+  std::size_t drift_block_begin = 0;
+  if (threaded_drift)
+  {
+    m_drift_block.clear();
+    g4hits_to_drift.reserve(g4hit->size());
+    for (auto hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+    {
+      g4hits_to_drift.push_back(hiter);
+    }
+  }
   unsigned int count_g4hits = 0;
   //  int count_electrons = 0;
 
@@ -515,7 +556,28 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
     // drifted electrons, then copy to the node tree later
 
     double eion = hiter->second->get_eion();
-    unsigned int n_electrons = gsl_ran_poisson(RandomGenerator.get(), eion * electrons_per_gev);
+    unsigned int n_electrons = 0;
+    const DriftedG4Hit *drifted_g4hit = nullptr;
+    if (threaded_drift)
+    {
+      // drift the next block of g4hits once this one is used up
+      const std::size_t index = count_g4hits - 1;
+      if (index >= drift_block_begin + m_drift_block.size())
+      {
+        drift_block(counter_rng, layergeom->get_drift_velocity_sim(), g4hits_to_drift, index);
+        drift_block_begin = index;
+      }
+      drifted_g4hit = &m_drift_block[index - drift_block_begin];
+      n_electrons = drifted_g4hit->n_electrons;
+    }
+    else if (m_batch_drift)
+    {
+      n_electrons = draw_n_electrons(counter_rng, hiter);
+    }
+    else
+    {
+      n_electrons = gsl_ran_poisson(RandomGenerator.get(), eion * electrons_per_gev);
+    }
     //    count_electrons += n_electrons;
 
     if (Verbosity() > 100)
@@ -548,156 +610,128 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
     int notReachingReadout = 0;
     //    int notInAcceptance = 0;
-    for (unsigned int i = 0; i < n_electrons; i++)
+    if (drifted_g4hit)
     {
-      // We choose the electron starting position at random from a flat
-      // distribution along the path length the parameter t is the fraction of
-      // the distance along the path betwen entry and exit points, it has
-      // values between 0 and 1
-      const double f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
-
-      const double x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
-      const double y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
-      const double z_start = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
-      const double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
-
-      unsigned int side = 0;
-      if (z_start > 0)
-      {
-        side = 1;
-      }
-
-      const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
-      const double rantrans =
-          gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
-          gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
-
-      const double t_path = (tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
-      const double t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
-      const double rantime =
-          gsl_ran_gaussian(RandomGenerator.get(), t_sigma) +
-	gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / layergeom->get_drift_velocity_sim();
-      double t_final = t_start + t_path + rantime;
-
-      if (t_final < min_time || t_final > max_time)
-      {
-        continue;
-      }
-
-      double z_final;
-      if (z_start < 0)
-      {
-        z_final = -tpc_length / 2. + t_final * layergeom->get_drift_velocity_sim();
-      }
-      else
+      notReachingReadout = drifted_g4hit->not_reaching_readout;
+      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                              temp_hitsetcontainer.get(), hittruthassoc, drifted_g4hit->electrons,
+                              hiter, ntpad, nthit);
+    }
+    else if (m_batch_drift)
+    {
+      notReachingReadout = drift_electrons_batch(counter_rng, layergeom->get_drift_velocity_sim(), hiter, n_electrons, ihit, m_batch, m_drifted);
+      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                              temp_hitsetcontainer.get(), hittruthassoc, m_drifted,
+                              hiter, ntpad, nthit);
+    }
+    else
+    {
+      for (unsigned int i = 0; i < n_electrons; i++)
       {
-        z_final = tpc_length / 2. - t_final * layergeom->get_drift_velocity_sim();
-      }
-
-      const double radstart = std::sqrt(square(x_start) + square(y_start));
-      const double phistart = std::atan2(y_start, x_start);
-      const double ranphi = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
+        // We choose the electron starting position at random from a flat
+        // distribution along the path length the parameter t is the fraction of
+        // the distance along the path betwen entry and exit points, it has
+        // values between 0 and 1
+        const double f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
+
+        const double x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
+        const double y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
+        const double z_start = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
+        const double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
+
+        unsigned int side = 0;
+        if (z_start > 0)
+        {
+          side = 1;
+        }
 
-      double x_final = x_start + rantrans * std::cos(ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
-      double y_final = y_start + rantrans * std::sin(ranphi);
+        const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
+        const double rantrans =
+            gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
+            gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
 
-      double rad_final = sqrt(square(x_final) + square(y_final));
-      double phi_final = atan2(y_final, x_final);
+        const double t_path = (tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
+        const double t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
+        const double rantime =
+            gsl_ran_gaussian(RandomGenerator.get(), t_sigma) +
+            gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / layergeom->get_drift_velocity_sim();
+        double t_final = t_start + t_path + rantime;
 
-      if (do_ElectronDriftQAHistos)
-      {
-        z_startmap->Fill(z_start, radstart);                   // map of starting location in Z vs. R
-        deltaphinodist->Fill(phistart, rantrans / rad_final);  // delta phi no distortion, just diffusion+smear
-        deltarnodist->Fill(radstart, rantrans);                // delta r no distortion, just diffusion+smear
-      }
-
-      if (m_distortionMap)
-      {
-        // zhangcanyu
-        const double reaches = m_distortionMap->get_reaches_readout(radstart, phistart, z_start);
-        if (reaches < thresholdforreachesreadout)
+        if (t_final < min_time || t_final > max_time)
         {
-          notReachingReadout++;
           continue;
         }
 
-        const double r_distortion = m_distortionMap->get_r_distortion(radstart, phistart, z_start);
-        const double phi_distortion = m_distortionMap->get_rphi_distortion(radstart, phistart, z_start) / radstart;
-        const double z_distortion = m_distortionMap->get_z_distortion(radstart, phistart, z_start);
-
-        rad_final += r_distortion;
-        phi_final += phi_distortion;
-        z_final += z_distortion;
+        double z_final;
         if (z_start < 0)
         {
-          t_final = (z_final + tpc_length / 2.0) / layergeom->get_drift_velocity_sim();
+          z_final = -tpc_length / 2. + t_final * layergeom->get_drift_velocity_sim();
         }
         else
         {
-          t_final = (tpc_length / 2.0 - z_final) / layergeom->get_drift_velocity_sim();
+          z_final = tpc_length / 2. - t_final * layergeom->get_drift_velocity_sim();
         }
 
-        x_final = rad_final * std::cos(phi_final);
-        y_final = rad_final * std::sin(phi_final);
+        const double radstart = std::sqrt(square(x_start) + square(y_start));
+        const double phistart = std::atan2(y_start, x_start);
+        const double ranphi = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
 
-        //	if(i < 1)
-        //{std::cout << " electron " << i << " r_distortion " << r_distortion << " phi_distortion " << phi_distortion << " rad_final " << rad_final << " phi_final " << phi_final << " r*dphi distortion " << rad_final * phi_distortion << " z_distortion " << z_distortion << std::endl;}
+        double x_final = x_start + rantrans * std::cos(ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
+        double y_final = y_start + rantrans * std::sin(ranphi);
+
+        double rad_final = sqrt(square(x_final) + square(y_final));
+        double phi_final = atan2(y_final, x_final);
 
         if (do_ElectronDriftQAHistos)
         {
-          const double phi_final_nodiff = phistart + phi_distortion;
-          const double rad_final_nodiff = radstart + r_distortion;
-          deltarnodiff->Fill(radstart, rad_final_nodiff - radstart);    // delta r no diffusion, just distortion
-          deltaphinodiff->Fill(phistart, phi_final_nodiff - phistart);  // delta phi no diffusion, just distortion
-          deltaphivsRnodiff->Fill(radstart, phi_final_nodiff - phistart);
-          deltaRphinodiff->Fill(radstart, rad_final_nodiff * phi_final_nodiff - radstart * phistart);
-
-          // Fill Diagnostic plots, written into ElectronDriftQA.root
-          hitmapstart->Fill(x_start, y_start);  // G4Hit starting positions
-          hitmapend->Fill(x_final, y_final);    // INcludes diffusion and distortion
-          hitmapstart_z->Fill(z_start, radstart);
-          hitmapend_z->Fill(z_final, rad_final);
-          deltar->Fill(radstart, rad_final - radstart);    // total delta r
-          deltaphi->Fill(phistart, phi_final - phistart);  // total delta phi
-          deltaz->Fill(z_start, z_distortion);             // map of distortion in Z (time)
+          z_startmap->Fill(z_start, radstart);                   // map of starting location in Z vs. R
+          deltaphinodist->Fill(phistart, rantrans / rad_final);  // delta phi no distortion, just diffusion+smear
+          deltarnodist->Fill(radstart, rantrans);                // delta r no distortion, just diffusion+smear
         }
-      }
 
-      // remove electrons outside of our acceptance. Careful though, electrons from just inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
-      if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
-      {
-        //        notInAcceptance++;
-        continue;
-      }
+        if (m_distortionMap && !distort_electron(radstart, phistart, x_start, y_start, z_start, layergeom->get_drift_velocity_sim(),
+                                                 rad_final, phi_final, x_final, y_final, z_final, t_final))
+        {
+          notReachingReadout++;
+          continue;
+        }
 
-      if (Verbosity() > 1000)
-      //      if(i < 1)
-      {
-        std::cout << "electron " << i << " g4hitid " << hiter->first << " f " << f << std::endl;
-        std::cout << "radstart " << radstart << " x_start: " << x_start
-                  << ", y_start: " << y_start
-                  << ",z_start: " << z_start
-                  << " t_start " << t_start
-                  << " t_path " << t_path
-                  << " t_sigma " << t_sigma
-                  << " rantime " << rantime
-                  << std::endl;
-
-        std::cout << "       rad_final " << rad_final << " x_final " << x_final
-                  << " y_final " << y_final
-                  << " z_final " << z_final << " t_final " << t_final
-                  << " zdiff " << z_final - z_start << std::endl;
-      }
+        // remove electrons outside of our acceptance. Careful though, electrons from just inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
+        if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
+        {
+          //        notInAcceptance++;
+          continue;
+        }
 
-      if (Verbosity() > 0)
-      {
-        assert(nt);
-        nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
-      }
-      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
-                              temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
-                              side, hiter, ntpad, nthit);
-    }  // end loop over electrons for this g4hit
+        if (Verbosity() > 1000)
+        //      if(i < 1)
+        {
+          std::cout << "electron " << i << " g4hitid " << hiter->first << " f " << f << std::endl;
+          std::cout << "radstart " << radstart << " x_start: " << x_start
+                    << ", y_start: " << y_start
+                    << ",z_start: " << z_start
+                    << " t_start " << t_start
+                    << " t_path " << t_path
+                    << " t_sigma " << t_sigma
+                    << " rantime " << rantime
+                    << std::endl;
+
+          std::cout << "       rad_final " << rad_final << " x_final " << x_final
+                    << " y_final " << y_final
+                    << " z_final " << z_final << " t_final " << t_final
+                    << " zdiff " << z_final - z_start << std::endl;
+        }
+
+        if (Verbosity() > 0)
+        {
+          assert(nt);
+          nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
+        }
+        padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                                temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
+                                side, hiter, ntpad, nthit);
+      }  // end loop over electrons for this g4hit
+    }
 
     if (do_ElectronDriftQAHistos)
     {
@@ -720,12 +754,11 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
         std::cout << " hitsetkey " << node_hitsetkey << " layer " << layer << " sector " << sector << " side " << side << std::endl;
       }
       // get all of the hits from the single hitset
-      TrkrHitSet::ConstRange single_hit_range = single_hitset_iter->second->getHits();
-      for (TrkrHitSet::ConstIterator single_hit_iter = single_hit_range.first;
-           single_hit_iter != single_hit_range.second;
-           ++single_hit_iter)
+      // it is a TrkrHitSetv2, since hitsets are created by TrkrHitSetContainerv3::findOrAddHitSet
+      const auto *single_hitset = static_cast<const TrkrHitSetv2 *>(single_hitset_iter->second);
+      for (const auto &single_hit : single_hitset->hits())
       {
-        TrkrDefs::hitkey single_hitkey = single_hit_iter->first;
+        TrkrDefs::hitkey single_hitkey = single_hit.key;
 
         // Add the hit-g4hit association
         // no need to check for duplicates, since the hit is new
@@ -764,21 +797,19 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
         // find or add this hitset on the node tree
         TrkrHitSetContainer::Iterator node_hitsetit = hitsetcontainer->findOrAddHitSet(node_hitsetkey);
 
-        // get all of the hits from the temporary hitset
-        TrkrHitSet::ConstRange temp_hit_range = temp_hitset_iter->second->getHits();
-        for (TrkrHitSet::ConstIterator temp_hit_iter = temp_hit_range.first;
-             temp_hit_iter != temp_hit_range.second;
-             ++temp_hit_iter)
+        // get all of the hits from the temporary hitset, a TrkrHitSetv2 as for the single hitsets
+        const auto *temp_hitset = static_cast<const TrkrHitSetv2 *>(temp_hitset_iter->second);
+        for (const auto &temp_hit : temp_hitset->hits())
         {
-          TrkrDefs::hitkey temp_hitkey = temp_hit_iter->first;
-          TrkrHit *temp_tpchit = temp_hit_iter->second;
+          TrkrDefs::hitkey temp_hitkey = temp_hit.key;
+          const double temp_energy = ((double) temp_hit.adc) / TrkrDefs::EdepScaleFactor;
           if (Verbosity() > 10 && layer == print_layer)
           {
             std::cout << "      temp_hitkey " << temp_hitkey << " layer " << layer << " pad " << TpcDefs::getPad(temp_hitkey)
                       << " z bin " << TpcDefs::getTBin(temp_hitkey)
-                      << "  energy " << temp_tpchit->getEnergy() << " eg4hit " << eg4hit << std::endl;
+                      << "  energy " << temp_energy << " eg4hit " << eg4hit << std::endl;
 
-            eg4hit += temp_tpchit->getEnergy();
+            eg4hit += temp_energy;
             //            ecollectedhits += temp_tpchit->getEnergy();
             //            ncollectedhits++;
           }
@@ -793,7 +824,7 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
           }
 
           // Either way, add the energy to it
-          node_hit->addEnergy(temp_tpchit->getEnergy());
+          node_hit->addEnergy(temp_energy);
 
         }  // end loop over temp hits
 
@@ -925,8 +956,208 @@ int PHG4TpcElectronDrift::End(PHCompositeNode * /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+bool PHG4TpcElectronDrift::distort_electron(const double radstart, const double phistart, const double x_start, const double y_start, const double z_start,
+                                            const double drift_velocity, double &rad_final, double &phi_final, double &x_final, double &y_final, double &z_final, double &t_final) const
+{
+  // zhangcanyu
+  const double reaches = m_distortionMap->get_reaches_readout(radstart, phistart, z_start);
+  if (reaches < thresholdforreachesreadout)
+  {
+    return false;
+  }
+
+  const double r_distortion = m_distortionMap->get_r_distortion(radstart, phistart, z_start);
+  const double phi_distortion = m_distortionMap->get_rphi_distortion(radstart, phistart, z_start) / radstart;
+  const double z_distortion = m_distortionMap->get_z_distortion(radstart, phistart, z_start);
+
+  rad_final += r_distortion;
+  phi_final += phi_distortion;
+  z_final += z_distortion;
+  if (z_start < 0)
+  {
+    t_final = (z_final + tpc_length / 2.0) / drift_velocity;
+  }
+  else
+  {
+    t_final = (tpc_length / 2.0 - z_final) / drift_velocity;
+  }
+
+  x_final = rad_final * std::cos(phi_final);
+  y_final = rad_final * std::sin(phi_final);
+
+  //{std::cout << " electron " << i << " r_distortion " << r_distortion << " phi_distortion " << phi_distortion << " rad_final " << rad_final << " phi_final " << phi_final << " r*dphi distortion " << rad_final * phi_distortion << " z_distortion " << z_distortion << std::endl;}
+
+  if (do_ElectronDriftQAHistos)
+  {
+    const double phi_final_nodiff = phistart + phi_distortion;
+    const double rad_final_nodiff = radstart + r_distortion;
+    deltarnodiff->Fill(radstart, rad_final_nodiff - radstart);    // delta r no diffusion, just distortion
+    deltaphinodiff->Fill(phistart, phi_final_nodiff - phistart);  // delta phi no diffusion, just distortion
+    deltaphivsRnodiff->Fill(radstart, phi_final_nodiff - phistart);
+    deltaRphinodiff->Fill(radstart, rad_final_nodiff * phi_final_nodiff - radstart * phistart);
+
+    // Fill Diagnostic plots, written into ElectronDriftQA.root
+    hitmapstart->Fill(x_start, y_start);  // G4Hit starting positions
+    hitmapend->Fill(x_final, y_final);    // INcludes diffusion and distortion
+    hitmapstart_z->Fill(z_start, radstart);
+    hitmapend_z->Fill(z_final, rad_final);
+    deltar->Fill(radstart, rad_final - radstart);    // total delta r
+    deltaphi->Fill(phistart, phi_final - phistart);  // total delta phi
+    deltaz->Fill(z_start, z_distortion);             // map of distortion in Z (time)
+  }
+  return true;
+}
+
+unsigned int PHG4TpcElectronDrift::draw_n_electrons(const PHG4TpcCounterRng &rng, PHG4HitContainer::ConstIterator hiter) const
+{
+  const double eion = hiter->second->get_eion();
+  if (eion <= 0)
+  {
+    return 0;
+  }
+  std::poisson_distribution<unsigned int> poisson(eion * electrons_per_gev);
+  PHG4TpcCounterRng::Sequence sequence(rng, 0, hiter->first);
+  return poisson(sequence);
+}
+
+void PHG4TpcElectronDrift::drift_block(const PHG4TpcCounterRng &rng, const double drift_velocity, const std::vector<PHG4HitContainer::ConstIterator> &g4hits, const std::size_t first)
+{
+  m_drift_block.resize(std::min(m_drift_block_size, g4hits.size() - first));
+  m_pool->parallel_for(m_drift_block.size(), [&](std::size_t index, unsigned int worker)
+                       {
+    auto &drifted = m_drift_block[index];
+    const auto hiter = g4hits[first + index];
+    drifted.electrons.clear();
+    drifted.n_electrons = 0;
+    drifted.not_reaching_readout = 0;
+
+    // same selection as in process_event
+    if (std::fmax(hiter->second->get_t(0), hiter->second->get_t(1)) > max_time)
+    {
+      return;
+    }
+    drifted.n_electrons = draw_n_electrons(rng, hiter);
+    if (drifted.n_electrons > 0)
+    {
+      drifted.not_reaching_readout = drift_electrons_batch(rng, drift_velocity, hiter, drifted.n_electrons, first + index, m_worker_batch[worker], drifted.electrons);
+    } });
+}
+
+int PHG4TpcElectronDrift::drift_electrons_batch(const PHG4TpcCounterRng &rng, const double drift_velocity, PHG4HitContainer::ConstIterator hiter, const unsigned int n_electrons, const double ihit,
+                                                ElectronBatch &batch, PHG4TpcPadPlane::DriftedElectrons &drifted) const
+{
+  const PHG4Hit *g4hit = hiter->second;
+  const uint64_t g4hitkey = hiter->first;
+
+  batch.resize(n_electrons);
+
+  // draw the random numbers of every electron from its own counter:
+  // stream 1 holds the position along the path and the diffusion direction,
+  // streams 2 and 3 the four gaussians of the transverse and longitudinal diffusion
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    const auto flat = rng(i, 1, g4hitkey);
+    batch.f[i] = PHG4TpcCounterRng::uniform(flat[0], flat[1]);
+    batch.ranphi[i] = -M_PI + 2 * M_PI * PHG4TpcCounterRng::uniform(flat[2], flat[3]);
+    for (unsigned int stream = 2; stream < 4; ++stream)
+    {
+      // Box-Muller
+      const auto words = rng(i, stream, g4hitkey);
+      const double radius = std::sqrt(-2. * std::log(PHG4TpcCounterRng::uniform(words[0], words[1])));
+      const double angle = 2 * M_PI * PHG4TpcCounterRng::uniform(words[2], words[3]);
+      batch.gaus[2 * (stream - 2)][i] = radius * std::cos(angle);
+      batch.gaus[2 * (stream - 2) + 1][i] = radius * std::sin(angle);
+    }
+  }
+
+  // start position and diffusion, no branches so the compiler can vectorize it
+  const double x0 = g4hit->get_x(0);
+  const double y0 = g4hit->get_y(0);
+  const double z0 = g4hit->get_z(0);
+  const double t0 = g4hit->get_t(0);
+  const double dx = g4hit->get_x(1) - x0;
+  const double dy = g4hit->get_y(1) - y0;
+  const double dz = g4hit->get_z(1) - z0;
+  const double dt = g4hit->get_t(1) - t0;
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    const double f = batch.f[i];
+    batch.x_start[i] = x0 + f * dx;
+    batch.y_start[i] = y0 + f * dy;
+    batch.z_start[i] = z0 + f * dz;
+    batch.t_start[i] = t0 + f * dt;
+
+    const double drift_length = tpc_length / 2. - std::abs(batch.z_start[i]);
+    const double sqrt_length = std::sqrt(drift_length);
+    batch.rantrans[i] = diffusion_trans * sqrt_length * batch.gaus[0][i] + added_smear_sigma_trans * batch.gaus[1][i];
+    batch.t_sigma[i] = diffusion_long * sqrt_length / drift_velocity;
+    batch.t_final[i] = batch.t_start[i] + drift_length / drift_velocity + batch.t_sigma[i] * batch.gaus[2][i] + added_smear_sigma_long * batch.gaus[3][i] / drift_velocity;
+
+    const double zsign = std::copysign(1., batch.z_start[i]);
+    batch.z_final[i] = zsign * (tpc_length / 2. - batch.t_final[i] * drift_velocity);
+    batch.x_final[i] = batch.x_start[i] + batch.rantrans[i] * std::cos(batch.ranphi[i]);
+    batch.y_final[i] = batch.y_start[i] + batch.rantrans[i] * std::sin(batch.ranphi[i]);
+  }
+
+  // time window, distortions and acceptance, electron by electron
+  int notReachingReadout = 0;
+  drifted.clear();
+  for (unsigned int i = 0; i < n_electrons; ++i)
+  {
+    double t_final = batch.t_final[i];
+    if (t_final < min_time || t_final > max_time)
+    {
+      continue;
+    }
+
+    const double x_start = batch.x_start[i];
+    const double y_start = batch.y_start[i];
+    const double z_start = batch.z_start[i];
+    const double rantrans = batch.rantrans[i];
+    double x_final = batch.x_final[i];
+    double y_final = batch.y_final[i];
+    double z_final = batch.z_final[i];
+
+    const double radstart = std::sqrt(square(x_start) + square(y_start));
+    const double phistart = std::atan2(y_start, x_start);
+    double rad_final = std::sqrt(square(x_final) + square(y_final));
+    double phi_final = std::atan2(y_final, x_final);
+
+    if (do_ElectronDriftQAHistos)
+    {
+      z_startmap->Fill(z_start, radstart);
+      deltaphinodist->Fill(phistart, rantrans / rad_final);
+      deltarnodist->Fill(radstart, rantrans);
+    }
+
+    if (m_distortionMap && !distort_electron(radstart, phistart, x_start, y_start, z_start, drift_velocity,
+                                             rad_final, phi_final, x_final, y_final, z_final, t_final))
+    {
+      notReachingReadout++;
+      continue;
+    }
+
+    if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
+    {
+      continue;
+    }
+
+    if (Verbosity() > 0)
+    {
+      assert(nt);
+      nt->Fill(ihit, batch.t_start[i], t_final, batch.t_sigma[i], rad_final, z_start, z_final);
+    }
+
+    const unsigned int side = (z_start > 0) ? 1 : 0;
+    drifted.push_back(x_final, y_final, t_final, side);
+  }
+
+  return notReachingReadout;
+}
+
 void PHG4TpcElectronDrift::set_seed(const unsigned int seed)
 {
+  m_seed = seed;
   gsl_rng_set(RandomGenerator.get(), seed);
 }
 
@@ -3,6 +3,7 @@
 #ifndef G4TPC_PHG4TPCELECTRONDRIFT_H
 #define G4TPC_PHG4TPCELECTRONDRIFT_H
 
+#include "PHG4TpcPadPlane.h"
 #include "TpcClusterBuilder.h"
 
 #include <trackbase/ActsGeometry.h>
@@ -17,13 +18,17 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <fstream>
+#include <initializer_list>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
-class PHG4TpcPadPlane;
+class PHG4TpcCounterRng;
 class PHG4TpcDistortion;
+class PHThreadPool;
 class PHCompositeNode;
 class TH1;
 class TH2;
@@ -43,7 +48,7 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
 {
  public:
   PHG4TpcElectronDrift(const std::string &name = "PHG4TpcElectronDrift");
-  ~PHG4TpcElectronDrift() override = default;
+  ~PHG4TpcElectronDrift() override;
   int Init(PHCompositeNode *) override;
   int InitRun(PHCompositeNode *) override;
   int process_event(PHCompositeNode *) override;
@@ -66,6 +71,29 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   //! random seed
   void set_seed(const unsigned int iseed);
 
+  //! drift the electrons of each g4hit as one batch
+  /*!
+    the random numbers are drawn from a counter based generator keyed on
+    (seed, event, g4hit key, electron index), the diffusion is computed in
+    branch free loops over all electrons of the g4hit and the pad plane gets
+    all surviving electrons in one call. The results are statistically
+    equivalent to, but not identical with, the default electron by electron mode
+  */
+  void set_batch_drift(bool flag) { m_batch_drift = flag; }
+
+  //! drift the g4hits on a pool of worker threads, implies batch drift
+  /*!
+    the g4hits are drifted in blocks ahead of the pad plane mapping, one
+    g4hit per work item. The pad plane mapping, truth clustering and the
+    merge into the node tree stay on the calling thread in g4hit order, so the
+    output does not depend on the number of threads. Falls back to the
+    single threaded batch drift when QA histograms or the ntuples are filled
+  */
+  void set_threaded_drift(bool flag) { m_threaded_drift = flag; }
+
+  //! number of worker threads for the threaded drift. 0 means one per hardware thread
+  void set_nthreads(unsigned int n) { m_nthreads = n; }
+
   //! setup TPC distortion
   void setTpcDistortion(PHG4TpcDistortion *);
 
@@ -86,6 +114,68 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
 
  private:
+  //! per electron work arrays of the batch mode, reused between g4hits
+  struct ElectronBatch
+  {
+    std::vector<double> f;
+    std::vector<double> ranphi;
+    std::array<std::vector<double>, 4> gaus;
+    std::vector<double> x_start;
+    std::vector<double> y_start;
+    std::vector<double> z_start;
+    std::vector<double> t_start;
+    std::vector<double> t_sigma;
+    std::vector<double> rantrans;
+    std::vector<double> x_final;
+    std::vector<double> y_final;
+    std::vector<double> z_final;
+    std::vector<double> t_final;
+
+    void resize(const std::size_t n)
+    {
+      for (auto *v : {&f, &ranphi, &gaus[0], &gaus[1], &gaus[2], &gaus[3], &x_start, &y_start, &z_start, &t_start, &t_sigma, &rantrans, &x_final, &y_final, &z_final, &t_final})
+      {
+        v->resize(n);
+      }
+    }
+  };
+
+  //! apply the distortions to one electron. Returns false if it does not reach the readout
+  bool distort_electron(const double radstart, const double phistart, const double x_start, const double y_start, const double z_start,
+                        const double drift_velocity, double &rad_final, double &phi_final, double &x_final, double &y_final, double &z_final, double &t_final) const;
+
+  //! number of electrons of one g4hit in batch mode
+  unsigned int draw_n_electrons(const PHG4TpcCounterRng &rng, PHG4HitContainer::ConstIterator hiter) const;
+
+  //! drift all electrons of one g4hit in batch mode. Returns the number of electrons not reaching the readout
+  int drift_electrons_batch(const PHG4TpcCounterRng &rng, const double drift_velocity, PHG4HitContainer::ConstIterator hiter, const unsigned int n_electrons, const double ihit,
+                            ElectronBatch &batch, PHG4TpcPadPlane::DriftedElectrons &drifted) const;
+
+  //! drift the g4hits starting at first on the worker pool
+  void drift_block(const PHG4TpcCounterRng &rng, const double drift_velocity, const std::vector<PHG4HitContainer::ConstIterator> &g4hits, const std::size_t first);
+
+  ElectronBatch m_batch;
+  PHG4TpcPadPlane::DriftedElectrons m_drifted;
+
+  //! result of the threaded drift for one g4hit
+  struct DriftedG4Hit
+  {
+    unsigned int n_electrons{0};
+    int not_reaching_readout{0};
+    PHG4TpcPadPlane::DriftedElectrons electrons;
+  };
+
+  //! g4hits drifted ahead by the worker pool
+  std::vector<DriftedG4Hit> m_drift_block;
+
+  //! work arrays of each worker thread
+  std::vector<ElectronBatch> m_worker_batch;
+
+  //! number of g4hits drifted per block by the worker pool
+  std::size_t m_drift_block_size{4096};
+
+  std::unique_ptr<PHThreadPool> m_pool;
+
   TrkrHitSetContainer *hitsetcontainer{nullptr};
   TrkrHitTruthAssoc *hittruthassoc{nullptr};
   TrkrTruthTrackContainer *truthtracks{nullptr};
@@ -121,6 +211,7 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   //@}
 
   int event_num{0};
+  unsigned int m_seed{0};
 
   float max_g4hitstep{7.};
   float thresholdforreachesreadout{0.5};
@@ -142,7 +233,11 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   bool do_getReachReadout{false};
   bool zero_bfield{false};
   bool m_use_PDG_gas_params{false};
+  bool m_batch_drift{false};
+  bool m_threaded_drift{false};
+  unsigned int m_nthreads{0};
 
+  // transient hits, packed TrkrHitSetv2 hitsets reused from one g4hit to the next (TrkrHitSetContainerv3)
   std::unique_ptr<TrkrHitSetContainer> temp_hitsetcontainer;
   std::unique_ptr<TrkrHitSetContainer> single_hitsetcontainer;
   std::unique_ptr<PHG4TpcPadPlane> padplane;
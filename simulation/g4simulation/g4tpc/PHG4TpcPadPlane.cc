@@ -9,6 +9,7 @@
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
 
+#include <cstddef>
 #include <string>
 
 PHG4TpcPadPlane::PHG4TpcPadPlane(const std::string &name)
@@ -47,3 +48,13 @@ int PHG4TpcPadPlane::InitRun(PHCompositeNode *topNode)
   UpdateInternalParameters();
   return Fun4AllReturnCodes::EVENT_OK;
 }
+
+void PHG4TpcPadPlane::MapToPadPlane(TpcClusterBuilder &builder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const DriftedElectrons &electrons, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
+{
+  for (std::size_t i = 0; i < electrons.size(); ++i)
+  {
+    MapToPadPlane(builder, single_hitsetcontainer, hitsetcontainer, hittruthassoc,
+                  electrons.x[i], electrons.y[i], electrons.t[i], electrons.side[i],
+                  hiter, ntpad, nthit);
+  }
+}
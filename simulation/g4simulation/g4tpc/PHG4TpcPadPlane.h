@@ -9,7 +9,9 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <cstddef>
 #include <string>  // for string
+#include <vector>
 
 class TrkrHitSetContainer;
 class TrkrHitTruthAssoc;
@@ -33,6 +35,36 @@ class PHG4TpcPadPlane : public SubsysReco, public PHParameterInterface
   virtual void UpdateInternalParameters() { return; }
   //  virtual void MapToPadPlane(PHG4CellContainer * /*g4cells*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) {}
   virtual void MapToPadPlane(TpcClusterBuilder & /*builder*/, TrkrHitSetContainer * /*single_hitsetcontainer*/, TrkrHitSetContainer * /*hitsetcontainer*/, TrkrHitTruthAssoc * /*hittruthassoc*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) = 0;  // { return {}; }
+
+  //! drifted electrons of one g4hit at the gem stack
+  struct DriftedElectrons
+  {
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> t;
+    std::vector<unsigned int> side;
+
+    std::size_t size() const { return x.size(); }
+    void clear()
+    {
+      x.clear();
+      y.clear();
+      t.clear();
+      side.clear();
+    }
+    void push_back(const double x_gem, const double y_gem, const double t_gem, const unsigned int side_gem)
+    {
+      x.push_back(x_gem);
+      y.push_back(y_gem);
+      t.push_back(t_gem);
+      side.push_back(side_gem);
+    }
+  };
+
+  //! map all drifted electrons of one g4hit in one call
+  /*! the default calls the single electron MapToPadPlane for every electron, in order */
+  virtual void MapToPadPlane(TpcClusterBuilder &builder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, const DriftedElectrons &electrons, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit);
+
   void Detector(const std::string &name) { detector = name; }
 
  protected:
@@ -20,6 +20,7 @@
 #include <trackbase/TrkrHit.h>   // for TrkrHit
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
+#include <trackbase/TrkrHitSetv2.h>
 #include <trackbase/TrkrHitv2.h>  // for TrkrHit
 
 #include <g4tracking/TrkrTruthTrack.h>
@@ -72,6 +73,28 @@ namespace
 
   constexpr unsigned int print_layer = 18;
 
+  //! add energy to a hit, creating it if needed
+  /*! packed hitsets (TrkrHitSetContainerv3) are filled in place, without TrkrHit objects */
+  void add_energy(TrkrHitSet *hitset, TrkrDefs::hitkey hitkey, double energy)
+  {
+    if (auto *packed = dynamic_cast<TrkrHitSetv2 *>(hitset))
+    {
+      packed->addEnergy(hitkey, energy);
+      return;
+    }
+
+    // See if this hit already exists
+    TrkrHit *hit = hitset->getHit(hitkey);
+    if (!hit)
+    {
+      // create a new one
+      hit = new TrkrHitv2();
+      hitset->addHitSpecificKey(hitkey, hit);
+    }
+    // Either way, add the energy to it
+    hit->addEnergy(energy);
+  }
+
 }  // namespace
 
 PHG4TpcPadPlaneReadout::PHG4TpcPadPlaneReadout(const std::string &name)
@@ -646,32 +669,13 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
       // generate the key for this hit, requires tbin and phibin
       hitkey = TpcDefs::genHitKey((unsigned int) pad_num, (unsigned int) tbin_num);
 
-      // See if this hit already exists
-      TrkrHit *hit = nullptr;
-      hit = hitsetit->second->getHit(hitkey);
-      if (!hit)
-      {
-        // create a new one
-        hit = new TrkrHitv2();
-        hitsetit->second->addHitSpecificKey(hitkey, hit);
-      }
-      // Either way, add the energy to it  -- adc values will be added at digitization
-      hit->addEnergy(neffelectrons);
+      // add the energy to the hit -- adc values will be added at digitization
+      add_energy(hitsetit->second, hitkey, neffelectrons);
 
       tpc_truth_clusterer.addhitset(hitsetkey, hitkey, neffelectrons);
 
       // repeat for the single_hitsetcontainer
-      // See if this hit already exists
-      TrkrHit *single_hit = nullptr;
-      single_hit = single_hitsetit->second->getHit(hitkey);
-      if (!single_hit)
-      {
-        // create a new one
-        single_hit = new TrkrHitv2();
-        single_hitsetit->second->addHitSpecificKey(hitkey, single_hit);
-      }
-      // Either way, add the energy to it  -- adc values will be added at digitization
-      single_hit->addEnergy(neffelectrons);
+      add_energy(single_hitsetit->second, hitkey, neffelectrons);
 
       /*
       if (Verbosity() > 0)